@@ -0,0 +1,184 @@
+// TicTacToeApi.cpp
+//   C interface to the game rules - batch evaluation, moves & best moves over packed positions
+//   <blank line>
+
+#include <bitset>
+#include "TicTacToeApi.h"
+#include "../TicTacToe_TestPracticum/TicTacToeBoard.h"
+
+/*
+ * No instance variables - the lookup tables are built once, on first use, by rules() (thread safe static)
+ *   hasLine - 512 entries, true if the squares contain a winning pattern (TicTacToeBoard::containsWinningPattern)
+ *   base3 - 512 entries, the squares as a base 3 number with 1 per square, X = base3, O = 2 * base3
+ *   values - game value for the player to move, per base 3 position number & player to move
+ */
+
+namespace {
+	constexpr int SQUARE_COUNT = TicTacToeBoard::BOARD_NUM_ROWS * TicTacToeBoard::BOARD_NUM_COLS;
+	constexpr int MASK_COUNT = 1 << SQUARE_COUNT;
+	constexpr int POSITIONS_PER_PLAYER = 19683;                 // 3^9
+	constexpr uint32_t UNUSED_BITS = ~((1u << (TTT_PLAYER_SHIFT + 1)) - 1);
+	const int MOVE_ORDER[SQUARE_COUNT] = { 4, 0, 2, 6, 8, 1, 3, 5, 7 };   // centre, corners, edges
+
+	struct Rules {
+		bool hasLine[MASK_COUNT];
+		int base3[MASK_COUNT];
+		int8_t values[2 * POSITIONS_PER_PLAYER];
+
+		Rules();
+		int index(unsigned xSquares, unsigned oSquares, unsigned player) const {
+			return base3[xSquares] + 2 * base3[oSquares] + player * POSITIONS_PER_PLAYER;
+		}
+	};
+
+	// Win table from the board's own rules, then every position solved from the full board back to the empty one
+	//   (a position's children have one more square taken, so they are always solved first)
+	Rules::Rules() {
+		for (int squares = 0; squares < MASK_COUNT; squares++) {
+			hasLine[squares] = TicTacToeBoard::containsWinningPattern(static_cast<uint16_t>(squares));
+			base3[squares] = 0;
+			for (int pos = SQUARE_COUNT - 1; pos >= 0; pos--)
+				base3[squares] = base3[squares] * 3 + ((squares >> pos) & 1);
+		}
+
+		for (int taken = SQUARE_COUNT; taken >= 0; taken--) {
+			for (unsigned xSquares = 0; xSquares < MASK_COUNT; xSquares++) {
+				for (unsigned oSquares = 0; oSquares < MASK_COUNT; oSquares++) {
+					if ((xSquares & oSquares) || (static_cast<int>(std::bitset<SQUARE_COUNT>(xSquares | oSquares).count()) != taken))
+						continue;
+					for (unsigned player = 0; player < 2; player++) {
+						unsigned mover = player ? oSquares : xSquares;
+						unsigned opponent = player ? xSquares : oSquares;
+						int8_t value;
+						if (hasLine[opponent])
+							value = -1;
+						else if (hasLine[mover])
+							value = 1;
+						else if (taken == SQUARE_COUNT)
+							value = 0;
+						else {
+							value = -1;
+							for (int pos = 0; pos < SQUARE_COUNT; pos++) {
+								unsigned bit = 1u << pos;
+								if ((xSquares | oSquares) & bit)
+									continue;
+								int child = player ? index(xSquares, oSquares | bit, 0) : index(xSquares | bit, oSquares, 1);
+								if (-values[child] > value)
+									value = static_cast<int8_t>(-values[child]);
+							}
+						}
+						values[index(xSquares, oSquares, player)] = value;
+					}
+				}
+			}
+		}
+	}
+
+	const Rules& rules() {
+		static const Rules built;            // initialized once, by the first caller, even with many threads
+		return built;
+	}
+
+	// Fields of a packed position, validated - false if it can't arise in a game
+	//   the player to move can't have a line (the game ended when the other player moved)
+	bool unpack(uint32_t position, unsigned& xSquares, unsigned& oSquares, unsigned& player) {
+		xSquares = (position >> TTT_X_SHIFT) & TTT_SQUARES_MASK;
+		oSquares = (position >> TTT_O_SHIFT) & TTT_SQUARES_MASK;
+		player = (position >> TTT_PLAYER_SHIFT) & 1;
+		if ((position & UNUSED_BITS) || (xSquares & oSquares))
+			return false;
+		int xCount = static_cast<int>(std::bitset<SQUARE_COUNT>(xSquares).count());
+		int oCount = static_cast<int>(std::bitset<SQUARE_COUNT>(oSquares).count());
+		int moverCount = player ? oCount : xCount;
+		int opponentCount = player ? xCount : oCount;
+		if ((moverCount != opponentCount) && (moverCount + 1 != opponentCount))
+			return false;
+		return !rules().hasLine[player ? oSquares : xSquares];
+	}
+
+	uint32_t pack(unsigned xSquares, unsigned oSquares, unsigned player) {
+		return (xSquares << TTT_X_SHIFT) | (oSquares << TTT_O_SHIFT) | (player << TTT_PLAYER_SHIFT);
+	}
+
+	int gameStatus(unsigned xSquares, unsigned oSquares) {
+		if (rules().hasLine[xSquares])
+			return TTT_STATUS_X_WINS;
+		if (rules().hasLine[oSquares])
+			return TTT_STATUS_O_WINS;
+		return ((xSquares | oSquares) == TTT_SQUARES_MASK) ? TTT_STATUS_DRAW : TTT_STATUS_IN_PROGRESS;
+	}
+}
+
+int ttt_api_version(void) {
+	return TTT_API_VERSION;
+}
+
+int ttt_evaluate(const uint32_t* positions, int8_t* status, size_t count) {
+	if ((positions == nullptr) || (status == nullptr))
+		return TTT_ERROR_NULL_ARGUMENT;
+	int invalid = 0;
+	unsigned xSquares, oSquares, player;
+	for (size_t i = 0; i < count; i++) {
+		if (unpack(positions[i], xSquares, oSquares, player))
+			status[i] = static_cast<int8_t>(gameStatus(xSquares, oSquares));
+		else {
+			status[i] = TTT_STATUS_INVALID;
+			invalid++;
+		}
+	}
+	return invalid;
+}
+
+int ttt_play(const uint32_t* positions, const uint8_t* squares, uint32_t* results, size_t count) {
+	if ((positions == nullptr) || (squares == nullptr) || (results == nullptr))
+		return TTT_ERROR_NULL_ARGUMENT;
+	int invalid = 0;
+	unsigned xSquares, oSquares, player;
+	for (size_t i = 0; i < count; i++) {
+		unsigned bit = (squares[i] < SQUARE_COUNT) ? (1u << squares[i]) : 0;
+		if ((bit == 0) || !unpack(positions[i], xSquares, oSquares, player) ||
+			(gameStatus(xSquares, oSquares) != TTT_STATUS_IN_PROGRESS) || ((xSquares | oSquares) & bit)) {
+			results[i] = TTT_INVALID_POSITION;
+			invalid++;
+			continue;
+		}
+		if (player)
+			oSquares |= bit;
+		else
+			xSquares |= bit;
+		results[i] = pack(xSquares, oSquares, player ^ 1);
+	}
+	return invalid;
+}
+
+int ttt_best_move(const uint32_t* positions, int8_t* moves, int8_t* values, size_t count) {
+	if ((positions == nullptr) || (moves == nullptr))
+		return TTT_ERROR_NULL_ARGUMENT;
+	const Rules& solved = rules();
+	int invalid = 0;
+	unsigned xSquares, oSquares, player;
+	for (size_t i = 0; i < count; i++) {
+		moves[i] = -1;
+		int8_t value = 0;
+		if (!unpack(positions[i], xSquares, oSquares, player))
+			invalid++;
+		else {
+			value = solved.values[solved.index(xSquares, oSquares, player)];
+			if (gameStatus(xSquares, oSquares) == TTT_STATUS_IN_PROGRESS) {
+				for (int pos : MOVE_ORDER) {
+					unsigned bit = 1u << pos;
+					if ((xSquares | oSquares) & bit)
+						continue;
+					int child = player ? solved.index(xSquares, oSquares | bit, 0) : solved.index(xSquares | bit, oSquares, 1);
+					if (-solved.values[child] == value) {
+						moves[i] = static_cast<int8_t>(pos);
+						break;
+					}
+				}
+			}
+		}
+		if (values != nullptr)
+			values[i] = value;
+	}
+	return invalid;
+}
@@ -0,0 +1,88 @@
+#pragma once
+/*****************************************************************//**
+ * \file   TicTacToeApi.h
+ * \brief  C interface to the game rules - TicTacToeApi (shared library: TicTacToeApi.dll / libtictactoe.so)
+ *     Scope - batch rule checks, win/draw detection & best move queries for services in other languages
+ *        (Python ctypes/cffi, Go cgo, ...), one call per array of positions rather than a process per position
+ *
+ * \date   updated: October 2026
+ *
+ * Implementation notes:
+ *     - plain C: fixed width integer types, no structs, no C++ types or exceptions cross the interface,
+ *          the functions are extern "C" so the exported names are not mangled
+ *     - callers own all the buffers, results are written into the arrays passed in (no copies, no allocation),
+ *          each function handles count positions in one call
+ *     - a packed position is a uint32: bits 0-8 squares taken by X, bits 9-17 squares taken by O,
+ *          bit 18 player to move (0 = X, 1 = O), higher bits 0 - square numbering as TicTacToeBoard
+ *          (row * 3 + column)
+ *     - rules are TicTacToeBoard's (winPatterns, loser of the last game may start - either player can
+ *          have one move more), a position is invalid if squares overlap, the move counts don't fit the
+ *          player to move, the player to move already has a line (the game ended) or unused bits are set
+ *     - the win table & a table of the value of every position are built by the first call (thread safe),
+ *          later calls are lookups only - every function may be called from any number of threads
+ *     - the interface is versioned, TTT_API_VERSION changes if a signature or the packing changes
+ *
+ * int ttt_api_version()                                   - TTT_API_VERSION the library was built with
+ * int ttt_evaluate(positions, status, count)              - TTT_STATUS_* per position
+ * int ttt_play(positions, squares, results, count)        - position after the player to move takes the square
+ * int ttt_best_move(positions, moves, values, count)      - a best square (-1 if none) & the game value
+ *   the batch functions return the # of invalid positions / moves, or TTT_ERROR_NULL_ARGUMENT
+ **/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define TTT_API_VERSION 1
+
+// exports when building the library, imports when using it, nothing when compiled into the caller (tests)
+#if defined(TICTACTOE_API_STATIC)
+#define TTT_API
+#elif defined(_WIN32)
+#ifdef TICTACTOE_API_EXPORTS
+#define TTT_API __declspec(dllexport)
+#else
+#define TTT_API __declspec(dllimport)
+#endif
+#else
+#define TTT_API __attribute__((visibility("default")))
+#endif
+
+// packed position fields
+#define TTT_X_SHIFT 0
+#define TTT_O_SHIFT 9
+#define TTT_PLAYER_SHIFT 18
+#define TTT_SQUARES_MASK 0x1FFu
+
+// ttt_evaluate() status
+#define TTT_STATUS_INVALID -1
+#define TTT_STATUS_IN_PROGRESS 0
+#define TTT_STATUS_X_WINS 1
+#define TTT_STATUS_O_WINS 2
+#define TTT_STATUS_DRAW 3
+
+// ttt_play() result for a move that isn't allowed (game over, square taken or off the board, invalid position)
+#define TTT_INVALID_POSITION 0xFFFFFFFFu
+
+#define TTT_ERROR_NULL_ARGUMENT -1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+TTT_API int ttt_api_version(void);
+
+// status[i] = TTT_STATUS_* of positions[i]
+TTT_API int ttt_evaluate(const uint32_t* positions, int8_t* status, size_t count);
+
+// results[i] = positions[i] after the player to move takes squares[i] (0-8), the turn passes to the other player
+//   TTT_INVALID_POSITION if the move isn't allowed
+TTT_API int ttt_play(const uint32_t* positions, const uint8_t* squares, uint32_t* results, size_t count);
+
+// moves[i] = a square that achieves the game value (centre, then corners, then edges), -1 if the game is over
+//   or the position is invalid, values[i] = +1 win / 0 draw / -1 loss for the player to move with perfect play
+//   (for a finished game, the result for the player to move), values may be NULL
+TTT_API int ttt_best_move(const uint32_t* positions, int8_t* moves, int8_t* values, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
@@ -106,6 +106,38 @@ namespace TicTacToeTest
 			Assert::IsFalse(board.isWinner(TicTacToeBoard::X), L"Post final move, expect no one has won, but X did win");
 		}
 		
+		// Forced draw - the last open line is blocked with squares still empty, getGameStatus() reports it at once
+		//   isDraw() keeps waiting for a full board
+		//   scenario:   X  O  X
+		//               X  O  O
+		//               O  X  -     after O's move at (2,0) every line holds an X & an O
+		TEST_METHOD(ForcedDrawBeforeFullBoard) {
+			Assert::AreEqual(static_cast<int>(TicTacToeBoard::IN_PROGRESS), static_cast<int>(board.getGameStatus()));
+			const int moves[8][2] = { { 0, 0 }, { 0, 1 }, { 0, 2 }, { 1, 1 }, { 1, 0 }, { 1, 2 }, { 2, 1 }, { 2, 0 } };
+			for (int i = 0; i < 8; i++) {
+				Assert::AreEqual(static_cast<int>(TicTacToeBoard::IN_PROGRESS), static_cast<int>(board.getGameStatus()),
+					L"game should be open until the last line is blocked");
+				board.writeSquare(moves[i][0], moves[i][1], board.getPlayer());
+				board.nextPlayer();
+			}
+			Assert::AreEqual(static_cast<int>(TicTacToeBoard::FORCED_DRAW), static_cast<int>(board.getGameStatus()),
+				L"no line left to win, expected a forced draw");
+			Assert::IsFalse(board.isDraw(), L"isDraw() should still need a full board");
+			board.writeSquare(2, 2, board.getPlayer());
+			Assert::AreEqual(static_cast<int>(TicTacToeBoard::DRAW), static_cast<int>(board.getGameStatus()));
+			board.resetBoard();
+			Assert::AreEqual(static_cast<int>(TicTacToeBoard::IN_PROGRESS), static_cast<int>(board.getGameStatus()),
+				L"reset should reopen every line");
+
+			// a win is reported as a win, not a draw
+			board.writeSquare(0, 0, TicTacToeBoard::X);
+			board.writeSquare(1, 0, TicTacToeBoard::O);
+			board.writeSquare(0, 1, TicTacToeBoard::X);
+			board.writeSquare(1, 1, TicTacToeBoard::O);
+			board.writeSquare(0, 2, TicTacToeBoard::X);
+			Assert::AreEqual(static_cast<int>(TicTacToeBoard::X_WINS), static_cast<int>(board.getGameStatus()));
+		}
+
 		// Testing X winning a game
 		// scenario:   X  O  X
 		//             O  X  X
@@ -0,0 +1,107 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "../TicTacToe_TestPracticum/TicTacToeBoard.h"
+#include "../TicTacToe_TestPracticum/AllocationCounter.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace TicTacToeTest
+{
+	TEST_CLASS(TicTacToeAllocationTests)
+	{
+	public:
+
+		TEST_CLASS_INITIALIZE(_Setup_AllocationTest)
+		{
+			// this method is run once for the class - nothing to initialize, each test builds its own board
+			//   asserts are made after a guard is gone, the test framework may allocate
+			Logger::WriteMessage("Allocation test class initialized\n");
+		}
+
+		// The counter sees allocations made on this thread, & a FAIL_FAST guard stops them at the allocation
+		TEST_METHOD(CounterSeesAllocations) {
+			uint64_t allocations;
+			{
+				AllocationGuard guard;
+				std::vector<int> squares(9);
+				allocations = guard.getAllocations();
+			}
+			Assert::AreEqual(static_cast<uint64_t>(1), allocations, L"vector should allocate once");
+
+			bool stopped = false;
+			{
+				AllocationGuard guard(AllocationGuard::FAIL_FAST);
+				try {
+					std::vector<int> squares(9);
+				}
+				catch (const AllocationGuard::Violation&) { stopped = true; }
+			}
+			Assert::IsTrue(stopped, L"allocation should throw inside a FAIL_FAST guard");
+			std::vector<int> squares(9);           // allowed again once the guard is gone
+		}
+
+		// The per move methods don't allocate
+		TEST_METHOD(BoardMethodsDontAllocate) {
+			TicTacToeBoard board;
+			bool result = true;
+			uint64_t allocations;
+			{
+				AllocationGuard guard(AllocationGuard::FAIL_FAST);
+				for (int position = 0; position < 9; position++) {
+					result = result && board.writeSquare(position / 3, position % 3, board.getPlayer());
+					board.nextPlayer();
+					board.isWinner(TicTacToeBoard::X);
+					board.isWinner(TicTacToeBoard::O);
+					board.matchesWinningPattern(TicTacToeBoard::X);
+					board.isDraw();
+					board.getGameStatus();
+					board.getSnapshot();
+				}
+				board.resetBoard();
+				allocations = guard.getAllocations();
+			}
+			Assert::IsTrue(result, L"every square should have been written");
+			Assert::AreEqual(static_cast<uint64_t>(0), allocations, L"board methods shouldn't allocate");
+
+			// the error message is built without the heap, at most the exception copies it
+			bool thrown = false;
+			{
+				AllocationGuard guard;
+				try {
+					board.writeSquare(3, 0, TicTacToeBoard::X);
+				}
+				catch (const std::invalid_argument&) { thrown = true; }
+				allocations = guard.getAllocations();
+			}
+			Assert::IsTrue(thrown, L"Expected std::invalid_argument not thrown");
+			Assert::IsTrue(allocations <= 1, L"invalid row or column should allocate no more than the exception");
+		}
+
+		// Whole random games, as the simulations play them, don't allocate
+		TEST_METHOD(SimulatedGamesDontAllocate) {
+			TicTacToeBoard board;
+			std::mt19937 generator(42);
+			std::uniform_int_distribution<int> squares(0, 8);
+			int finished = 0;
+			uint64_t allocations;
+			{
+				AllocationGuard guard(AllocationGuard::FAIL_FAST);
+				for (int game = 0; game < 1000; game++) {
+					board.resetBoard();
+					while (board.getGameStatus() == TicTacToeBoard::IN_PROGRESS) {
+						int position = squares(generator);
+						if (board.writeSquare(position / 3, position % 3, board.getPlayer()))
+							board.nextPlayer();
+					}
+					finished++;
+				}
+				allocations = guard.getAllocations();
+			}
+			Assert::AreEqual(1000, finished);
+			Assert::AreEqual(static_cast<uint64_t>(0), allocations, L"simulated games shouldn't allocate");
+		}
+	};
+}
@@ -0,0 +1,80 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <vector>
+#define TICTACTOE_API_STATIC       // library source compiled into the test project, not imported from the DLL
+#include "../TicTacToeApi/TicTacToeApi.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace TicTacToeTest
+{
+	TEST_CLASS(TicTacToeApiTests)
+	{
+	public:
+
+		TEST_CLASS_INITIALIZE(_Setup_ApiTest)
+		{
+			// this method is run once for the class - the library builds its tables on the first call
+			Logger::WriteMessage("C interface test class initialized\n");
+		}
+
+		// packed position helper - square numbers as TicTacToeBoard (row * 3 + column)
+		static uint32_t pack(std::vector<int> xSquares, std::vector<int> oSquares, int player) {
+			uint32_t position = static_cast<uint32_t>(player) << TTT_PLAYER_SHIFT;
+			for (int square : xSquares)
+				position |= 1u << (TTT_X_SHIFT + square);
+			for (int square : oSquares)
+				position |= 1u << (TTT_O_SHIFT + square);
+			return position;
+		}
+
+		// one batch call: in progress, X wins (top row), a draw & two invalid positions
+		//   draw:   X  O  X
+		//           X  O  O
+		//           O  X  X
+		TEST_METHOD(EvaluateBatch) {
+			uint32_t positions[5] = {
+				pack({ 0, 4 }, { 8 }, 1),
+				pack({ 0, 1, 2 }, { 3, 4 }, 1),
+				pack({ 0, 2, 3, 7, 8 }, { 1, 4, 5, 6 }, 1),
+				pack({ 0 }, { 0 }, 1),                    // square taken by both players
+				pack({ 0, 1, 2 }, { 3, 4 }, 0) };         // X to move after X has won
+			int8_t status[5];
+			Assert::AreEqual(2, ttt_evaluate(positions, status, 5), L"two positions should be invalid");
+			Assert::AreEqual(TTT_STATUS_IN_PROGRESS, static_cast<int>(status[0]));
+			Assert::AreEqual(TTT_STATUS_X_WINS, static_cast<int>(status[1]));
+			Assert::AreEqual(TTT_STATUS_DRAW, static_cast<int>(status[2]));
+			Assert::AreEqual(TTT_STATUS_INVALID, static_cast<int>(status[3]));
+			Assert::AreEqual(TTT_STATUS_INVALID, static_cast<int>(status[4]));
+			Assert::AreEqual(TTT_ERROR_NULL_ARGUMENT, ttt_evaluate(nullptr, status, 5));
+		}
+
+		// moves follow the rules - the turn passes, taken squares & finished games are refused
+		TEST_METHOD(PlayBatch) {
+			uint32_t positions[3] = { pack({}, {}, 0), pack({ 4 }, {}, 1), pack({ 0, 1, 2 }, { 3, 4 }, 1) };
+			uint8_t squares[3] = { 4, 4, 5 };
+			uint32_t results[3];
+			Assert::AreEqual(2, ttt_play(positions, squares, results, 3));
+			Assert::IsTrue(results[0] == pack({ 4 }, {}, 1), L"X should take the centre & O be next");
+			Assert::IsTrue(results[1] == TTT_INVALID_POSITION, L"centre already taken");
+			Assert::IsTrue(results[2] == TTT_INVALID_POSITION, L"game already over");
+		}
+
+		// X to move takes the win, O to move must block, the empty board is a draw
+		//   X  X  -        X  X  -
+		//   O  O  -        -  O  -
+		//   -  -  -        -  -  -
+		TEST_METHOD(BestMoveBatch) {
+			uint32_t positions[3] = { pack({ 0, 1 }, { 3, 4 }, 0), pack({ 0, 1 }, { 4 }, 1), pack({}, {}, 0) };
+			int8_t moves[3];
+			int8_t values[3];
+			Assert::AreEqual(0, ttt_best_move(positions, moves, values, 3));
+			Assert::AreEqual(2, static_cast<int>(moves[0]), L"X should complete the top row");
+			Assert::AreEqual(1, static_cast<int>(values[0]), L"X to move wins");
+			Assert::AreEqual(2, static_cast<int>(moves[1]), L"O must block the top row");
+			Assert::AreEqual(0, static_cast<int>(values[1]), L"O blocks & holds the draw");
+			Assert::AreEqual(0, static_cast<int>(values[2]), L"perfect play from the empty board is a draw");
+			Assert::AreEqual(4, static_cast<int>(moves[2]), L"centre is the first optimal move tried");
+		}
+	};
+}
@@ -0,0 +1,75 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include "../TicTacToe_TestPracticum/MappedFile.h"
+#include "../TicTacToe_TestPracticum/CheckpointFile.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace TicTacToeTest
+{
+	TEST_CLASS(TicTacToeCheckpointFileTests)
+	{
+	public:
+
+		TEST_CLASS_INITIALIZE(_Setup_CheckpointFileTest)
+		{
+			// this method is run once for the class - each test uses its own file, removed at the end of the test
+			Logger::WriteMessage("Checkpoint file test class initialized\n");
+		}
+
+		// The latest checkpoint survives reopening the file, & a damaged latest checkpoint falls back to the one
+		//   before it (the slot that wasn't being written)
+		TEST_METHOD(LatestCompleteCheckpoint) {
+			const char* path = "checkpoint_file_test.bin";
+			const size_t capacity = 256;
+			std::remove(path);
+			{
+				CheckpointFile checkpoints(path, capacity);
+				const uint8_t* data;
+				size_t size;
+				Assert::IsFalse(checkpoints.load(data, size), L"new file should hold no checkpoint");
+				memcpy(checkpoints.beginWrite(), "first", 5);
+				checkpoints.commit(5);
+				memcpy(checkpoints.beginWrite(), "second!", 7);
+				checkpoints.commit(7);
+				Assert::AreEqual(static_cast<uint64_t>(2), checkpoints.getSequence());
+				try {
+					checkpoints.beginWrite();
+					checkpoints.commit(capacity + 1);
+					Assert::Fail(L"Expected std::invalid_argument not thrown");
+				}
+				catch (const std::invalid_argument& ex) { Logger::WriteMessage(ex.what()); }
+			}
+			{
+				CheckpointFile checkpoints(path, capacity);
+				const uint8_t* data;
+				size_t size;
+				Assert::IsTrue(checkpoints.load(data, size), L"reopened file should hold the checkpoints");
+				Assert::AreEqual(static_cast<size_t>(7), size);
+				Assert::IsTrue(memcmp(data, "second!", 7) == 0, L"latest checkpoint should be read back");
+			}
+			{
+				// damage the second checkpoint (slot 1) as a crash part way through writing it could
+				MappedFile file(path, MappedFile::OPEN_OR_CREATE, 1);
+				file.getData()[64 + (64 + capacity) + 64 + 3] ^= 0xFF;
+			}
+			{
+				CheckpointFile checkpoints(path, capacity);
+				const uint8_t* data;
+				size_t size;
+				Assert::IsTrue(checkpoints.load(data, size), L"earlier checkpoint should still be complete");
+				Assert::AreEqual(static_cast<uint64_t>(1), checkpoints.getSequence());
+				Assert::IsTrue((size == 5) && (memcmp(data, "first", 5) == 0), L"earlier checkpoint should be read");
+			}
+			{
+				// a file too small for the capacity is started again
+				CheckpointFile checkpoints(path, 4 * capacity);
+				Assert::AreEqual(static_cast<uint64_t>(0), checkpoints.getSequence(), L"file should be started again");
+			}
+			std::remove(path);
+		}
+	};
+}
@@ -0,0 +1,99 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+#include "../TicTacToe_TestPracticum/MnkBoard.h"
+#include "../TicTacToe_TestPracticum/DfpnSolver.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace TicTacToeTest
+{
+	TEST_CLASS(TicTacToeDfpnSolverTests)
+	{
+	public:
+
+		TEST_CLASS_INITIALIZE(_Setup_DfpnSolverTest)
+		{
+			// this method is run once for the class - nothing to initialize, each test builds its own boards
+			Logger::WriteMessage("Proof-number solver test class initialized\n");
+		}
+
+		// Known values: 3x3 is a draw, 4x4 three in a row a first player win (with a winning first move)
+		TEST_METHOD(KnownVariantValues) {
+			DfpnSolver solver;
+			DfpnSolver::Result result = solver.solve(MnkBoard(3, 3, 3), std::chrono::seconds(10));
+			Assert::IsTrue(result.value == DfpnSolver::DRAW, L"3x3 should be a draw");
+			Assert::AreEqual(-1, result.bestMove, L"no winning move in a draw");
+
+			MnkBoard board(4, 4, 3);
+			result = solver.solve(board, std::chrono::seconds(10));
+			Assert::IsTrue(result.value == DfpnSolver::WIN, L"4x4 three in a row should be a first player win");
+			Assert::IsTrue(board.isSquareEmpty(result.bestMove), L"winning move should be a legal move");
+			board.play(result.bestMove);
+			result = solver.solve(board, std::chrono::seconds(10));
+			Assert::IsTrue(result.value == DfpnSolver::LOSS, L"O should lose after the winning move");
+		}
+
+		// X to move must block 8, then O's block at 4 makes two threats
+		//   scenario:   X  X  O
+		//               -  -  O
+		//               -  -  -
+		TEST_METHOD(ForcedLoss) {
+			MnkBoard board(3, 3, 3);
+			const int moves[4] = { 0, 2, 1, 5 };
+			for (int move : moves)
+				board.play(move);
+			DfpnSolver solver;
+			Assert::IsTrue(solver.solve(board, std::chrono::seconds(10)).value == DfpnSolver::LOSS,
+				L"X should lose with best play");
+
+			// a finished game can't be solved
+			board.play(8);
+			board.play(3);
+			board.play(4);
+			try {
+				solver.solve(board, std::chrono::seconds(10));
+				Assert::Fail(L"Expected std::invalid_argument not thrown");
+			}
+			catch (const std::invalid_argument& ex) { Logger::WriteMessage(ex.what()); }
+		}
+
+		// A table far too small for the proof is garbage collected & the proof still completes with the same value
+		TEST_METHOD(GarbageCollectedTable) {
+			DfpnSolver solver(64);
+			DfpnSolver::Result result = solver.solve(MnkBoard(4, 4, 3), std::chrono::seconds(10));
+			Assert::IsTrue(result.value == DfpnSolver::WIN, L"value shouldn't depend on the table size");
+			Assert::IsTrue(result.collections > 0, L"the table should have been collected");
+			Assert::IsTrue(result.peakEntries <= 64, L"the table should stay within its bound");
+		}
+
+		// A solve stopped by its budget resumes from the checkpoint, & a finished solve answers from it
+		TEST_METHOD(ResumeFromCheckpoint) {
+			const char* path = "dfpn_checkpoint_test.bin";
+			std::remove(path);
+			MnkBoard board(4, 4, 4);
+			DfpnSolver solver;
+			solver.enableCheckpoints(path, std::chrono::seconds(60));
+			DfpnSolver::Result result = solver.solve(board, std::chrono::milliseconds(0));
+			Assert::IsTrue(result.value == DfpnSolver::UNKNOWN, L"no time to solve 4x4");
+			Assert::IsFalse(result.resumed, L"nothing to resume from");
+			Assert::AreEqual(1, result.checkpoints, L"progress should be saved when the budget runs out");
+			uint64_t stoppedNodes = result.nodes;
+
+			DfpnSolver restarted;
+			restarted.enableCheckpoints(path, std::chrono::seconds(60));
+			result = restarted.solve(board, std::chrono::seconds(30));
+			Assert::IsTrue(result.resumed, L"solve should pick up from the checkpoint");
+			Assert::IsTrue(result.value == DfpnSolver::DRAW, L"4x4 four in a row should be a draw");
+			Assert::IsTrue(result.nodes > stoppedNodes, L"node count should carry on from the checkpoint");
+
+			result = restarted.solve(board, std::chrono::milliseconds(0));
+			Assert::IsTrue(result.value == DfpnSolver::DRAW, L"finished solve should be answered from the checkpoint");
+			Assert::IsTrue(restarted.solve(MnkBoard(3, 3, 3), std::chrono::seconds(10)).value == DfpnSolver::DRAW,
+				L"another position shouldn't use the checkpoint");
+			std::remove(path);
+		}
+	};
+}
@@ -0,0 +1,130 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include "../TicTacToe_TestPracticum/MappedFile.h"
+#include "../TicTacToe_TestPracticum/GameStore.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace TicTacToeTest
+{
+	TEST_CLASS(TicTacToeGameStoreTests)
+	{
+	public:
+
+		TEST_CLASS_INITIALIZE(_Setup_GameStoreTest)
+		{
+			// this method is run once for the class - each test uses its own file, removed at the end of the test
+			Logger::WriteMessage("Game store test class initialized\n");
+		}
+
+		// A restored snapshot plays on like the original board - win detection & forced draws included
+		TEST_METHOD(RestoreSnapshot) {
+			TicTacToeBoard board;
+			board.writeSquare(1, 1, TicTacToeBoard::X);
+			board.writeSquare(0, 0, TicTacToeBoard::O);
+			board.writeSquare(0, 2, TicTacToeBoard::X);
+			board.nextPlayer();
+			TicTacToeBoard restored;
+			restored.restoreSnapshot(board.getSnapshot());
+			Assert::AreEqual(static_cast<int>(TicTacToeBoard::O), static_cast<int>(restored.getPlayer()));
+			Assert::AreEqual('X', restored.getSquareContents(0, 2));
+			Assert::IsFalse(restored.isSquareEmpty(0, 0), L"O's square should be restored");
+			restored.writeSquare(2, 0, TicTacToeBoard::X);
+			Assert::IsTrue(restored.isWinner(TicTacToeBoard::X), L"restored squares should count towards a win");
+			Assert::IsTrue(restored.matchesWinningPattern(TicTacToeBoard::X), L"move sets should be restored");
+
+			TicTacToeBoard::Snapshot bad[] = { { 0x001, 0x001, TicTacToeBoard::X, 2 }, { 0x200, 0, TicTacToeBoard::O, 1 },
+				{ 0x001, 0, TicTacToeBoard::EMPTY, 1 }, { 0x003, 0x004, TicTacToeBoard::X, 2 } };
+			for (const TicTacToeBoard::Snapshot& snapshot : bad) {
+				try {
+					restored.restoreSnapshot(snapshot);
+					Assert::Fail(L"Expected std::invalid_argument not thrown");
+				}
+				catch (const std::invalid_argument& ex) { Logger::WriteMessage(ex.what()); }
+			}
+			Assert::IsTrue(restored.isWinner(TicTacToeBoard::X), L"a rejected snapshot shouldn't change the board");
+		}
+
+		// Games survive reopening the store, removed slots are reused, a full store & free slots are reported
+		TEST_METHOD(GamesSurviveReopen) {
+			const char* path = "game_store_test.bin";
+			std::remove(path);
+			TicTacToeBoard board;
+			board.writeSquare(1, 1, TicTacToeBoard::X);
+			board.nextPlayer();
+			{
+				GameStore store(path, 3);
+				Assert::AreEqual(0u, store.add(100, board));
+				board.writeSquare(0, 0, TicTacToeBoard::O);
+				board.nextPlayer();
+				Assert::AreEqual(1u, store.add(101, board));
+				Assert::AreEqual(2u, store.add(102, board));
+				try {
+					store.add(103, board);
+					Assert::Fail(L"Expected std::runtime_error not thrown");
+				}
+				catch (const std::runtime_error& ex) { Logger::WriteMessage(ex.what()); }
+				store.remove(1);
+				Assert::AreEqual(1u, store.add(104, board), L"removed slot should be reused");
+				store.remove(2);
+				store.sync();
+			}
+			{
+				GameStore store(path, 3);
+				Assert::IsFalse(store.wasRecovered(), L"synced store shouldn't need recovery");
+				Assert::AreEqual(2u, store.getLiveCount());
+				Assert::AreEqual(static_cast<uint64_t>(104), store.getSessionId(1));
+				TicTacToeBoard loaded;
+				Assert::IsTrue(store.load(0, loaded));
+				Assert::AreEqual(static_cast<int>(TicTacToeBoard::O), static_cast<int>(loaded.getPlayer()));
+				Assert::IsTrue(loaded.isSquareEmpty(0, 0), L"first game was saved before O's move");
+				Assert::IsTrue(store.load(1, loaded));
+				Assert::AreEqual('O', loaded.getSquareContents(0, 0));
+				Assert::IsFalse(store.load(2, loaded), L"removed game shouldn't load");
+				try {
+					store.save(2, loaded);
+					Assert::Fail(L"Expected std::invalid_argument not thrown");
+				}
+				catch (const std::invalid_argument& ex) { Logger::WriteMessage(ex.what()); }
+			}
+			std::remove(path);
+		}
+
+		// A store not synced (clean flag off on disk) is rebuilt from its records when it is opened
+		TEST_METHOD(RecoverNotSynced) {
+			const char* path = "game_store_recover_test.bin";
+			std::remove(path);
+			TicTacToeBoard board;
+			{
+				GameStore store(path, 4);
+				for (uint64_t session = 1; session <= 4; session++)
+					store.add(session, board);
+				store.remove(1);
+				store.remove(3);
+			}
+			{
+				// clear the clean flag & damage the live count & free list, as a crash before sync() could
+				MappedFile file(path, MappedFile::OPEN_OR_CREATE, 1);
+				uint32_t notClean = 0;
+				uint64_t liveCount = 99;
+				uint32_t freeHead = 7;
+				memcpy(file.getData() + 24, &liveCount, sizeof(liveCount));
+				memcpy(file.getData() + 32, &freeHead, sizeof(freeHead));
+				memcpy(file.getData() + 36, &notClean, sizeof(notClean));
+			}
+			{
+				GameStore store(path, 4);
+				Assert::IsTrue(store.wasRecovered(), L"store should be recovered");
+				Assert::AreEqual(2u, store.getLiveCount());
+				Assert::AreEqual(3u, store.getHighWater(), L"no live game after slot 2");
+				Assert::AreEqual(static_cast<uint64_t>(3), store.getSessionId(2));
+				Assert::AreEqual(1u, store.add(5, board), L"free list rebuilt lowest slot first");
+				Assert::AreEqual(3u, store.add(6, board));
+			}
+			std::remove(path);
+		}
+	};
+}
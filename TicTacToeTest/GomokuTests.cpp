@@ -0,0 +1,76 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <chrono>
+#include "../TicTacToe_TestPracticum/GomokuBoard.h"
+#include "../TicTacToe_TestPracticum/GomokuSearch.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace TicTacToeTest
+{
+	TEST_CLASS(TicTacToeGomokuTests)
+	{
+	public:
+
+		TEST_CLASS_INITIALIZE(_Setup_GomokuTest)
+		{
+			// this method is run once for the class - nothing to initialize, each test builds its own boards
+			Logger::WriteMessage("Gomoku test class initialized\n");
+		}
+
+		// plays the moves in turn (X first), each move given as row, column
+		static void playMoves(GomokuBoard& board, const int moves[][2], int count) {
+			for (int i = 0; i < count; i++)
+				Assert::IsTrue(board.play(GomokuBoard::cellIndex(moves[i][0], moves[i][1])), L"scripted move should be legal");
+		}
+
+		// X on row 7, columns 6 & 7 (O far away): column 8 makes an open three, then 5 makes an open four
+		//   an O stone on column 4 closes the four - one cell left to make five
+		TEST_METHOD(ShapesAroundMove) {
+			GomokuBoard board;
+			const int moves[4][2] = { { 7, 6 }, { 0, 0 }, { 7, 7 }, { 0, 14 } };
+			playMoves(board, moves, 4);
+			GomokuBoard::Shapes shapes = board.getShapes(GomokuBoard::cellIndex(7, 8), TicTacToeBoard::X);
+			Assert::AreEqual(1, static_cast<int>(shapes.openThrees), L"_XXX_ should be an open three");
+			Assert::AreEqual(0, static_cast<int>(shapes.fours));
+			Assert::AreEqual(1, static_cast<int>(shapes.threeDirections), L"three should be along the row");
+
+			board.play(GomokuBoard::cellIndex(7, 8));
+			shapes = board.getShapes(GomokuBoard::cellIndex(7, 5), TicTacToeBoard::X);
+			Assert::AreEqual(1, static_cast<int>(shapes.openFours), L"_XXXX_ should be an open four");
+			board.play(GomokuBoard::cellIndex(7, 4));
+			shapes = board.getShapes(GomokuBoard::cellIndex(7, 5), TicTacToeBoard::X);
+			Assert::AreEqual(0, static_cast<int>(shapes.openFours), L"O on column 4 closes the four");
+			Assert::AreEqual(1, static_cast<int>(shapes.fours));
+			Assert::AreEqual(0, static_cast<int>(shapes.fives));
+		}
+
+		// Windows are cut at the edge of the board & never mix directions: a five on the anti-diagonal through the
+		//   corner, a four on the bottom row with only one cell to complete it
+		TEST_METHOD(EdgesAndDirections) {
+			GomokuBoard board;
+			const int moves[9][2] = { { 4, 0 }, { 14, 11 }, { 3, 1 }, { 14, 12 }, { 2, 2 }, { 14, 13 }, { 1, 3 }, { 14, 14 },
+				{ 0, 4 } };
+			playMoves(board, moves, 9);
+			Assert::IsTrue(board.isWinningMove(GomokuBoard::cellIndex(0, 4)), L"anti-diagonal five should win");
+			Assert::IsFalse(board.isWinningMove(GomokuBoard::cellIndex(14, 14)), L"four is not a five");
+			int cells[GomokuBoard::MAX_FIVE_CELLS];
+			Assert::AreEqual(1, board.getFiveCells(GomokuBoard::cellIndex(14, 14), TicTacToeBoard::O, cells));
+			Assert::AreEqual(GomokuBoard::cellIndex(14, 10), cells[0], L"only column 10 completes the bottom row");
+		}
+
+		// X has a closed three on row 7 & a closed three on column 8: (7, 8) makes two fours at once
+		TEST_METHOD(VcfFindsDoubleFour) {
+			GomokuBoard board;
+			const int moves[12][2] = { { 7, 5 }, { 7, 4 }, { 7, 6 }, { 11, 8 }, { 7, 7 }, { 0, 0 }, { 8, 8 }, { 0, 14 },
+				{ 9, 8 }, { 14, 0 }, { 10, 8 }, { 14, 14 } };
+			playMoves(board, moves, 12);
+			GomokuSearch engine;
+			int move = -1;
+			Assert::IsTrue(engine.findVcf(board, GomokuSearch::VCF_DEPTH, move), L"X should win by fours");
+			Assert::AreEqual(GomokuBoard::cellIndex(7, 8), move, L"double four at row 7, column 8");
+			GomokuSearch::Result result = engine.search(board, std::chrono::milliseconds(200));
+			Assert::IsTrue(result.forcedWin && (result.bestMove == move), L"search should play the VCF");
+		}
+	};
+}
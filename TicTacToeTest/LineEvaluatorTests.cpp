@@ -0,0 +1,149 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+#include "../TicTacToe_TestPracticum/TicTacToeBoard.h"
+#include "../TicTacToe_TestPracticum/MnkBoard.h"
+#include "../TicTacToe_TestPracticum/LineEvaluator.h"
+#include "../TicTacToe_TestPracticum/SearchEngine.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace TicTacToeTest
+{
+	TEST_CLASS(TicTacToeLineEvaluatorTests)
+	{
+	public:
+
+		TEST_CLASS_INITIALIZE(_Setup_LineEvaluatorTest)
+		{
+			// this method is run once for the class - nothing to initialize, each test builds its own boards
+			Logger::WriteMessage("Line evaluator test class initialized\n");
+		}
+
+		// The vector kernel counts the same histogram as the scalar loop - 37 lines, so 2 vector steps & a tail
+		TEST_METHOD(KernelMatchesScalar) {
+			const int lines = 37;
+			const int k = 4;
+			std::mt19937 generator(7);
+			std::uniform_int_distribution<int> count(0, k);
+			for (int trial = 0; trial < 100; trial++) {
+				std::vector<uint8_t> mine(lines), theirs(lines);
+				for (int line = 0; line < lines; line++) {
+					mine[line] = static_cast<uint8_t>(count(generator));
+					theirs[line] = static_cast<uint8_t>(count(generator) / 2);      // plenty of open lines
+				}
+				int32_t vector[LineEvaluator::MAX_K + 1] = {};
+				int32_t scalar[LineEvaluator::MAX_K + 1] = {};
+				LineEvaluator::countOpenLines(mine.data(), theirs.data(), lines, k, vector);
+				LineEvaluator::countOpenLinesScalar(mine.data(), theirs.data(), lines, k, scalar);
+				for (int length = 0; length <= k; length++)
+					Assert::AreEqual(scalar[length], vector[length], L"kernel & scalar histograms should match");
+			}
+			Logger::WriteMessage(LineEvaluator::getKernelName());
+		}
+
+		// X in the centre of 3x3: the 4 lines through it are open to X with 1 square, O is down by 4
+		TEST_METHOD(CentreOpensFourLines) {
+			MnkBoard board(3, 3, 3);
+			LineEvaluator evaluator(board);
+			Assert::AreEqual(8, evaluator.getLineCount(), L"3x3 has 8 winning lines");
+			Assert::AreEqual(0, evaluator.evaluate(TicTacToeBoard::X), L"empty board should score 0");
+
+			evaluator.play(4, board.getPlayer());
+			board.play(4);
+			Assert::AreEqual(4, evaluator.getOpenLines(TicTacToeBoard::X, 1), L"4 lines run through the centre");
+			Assert::AreEqual(0, evaluator.getOpenLines(TicTacToeBoard::O, 1), L"O has no squares");
+			Assert::AreEqual(-4, evaluator.evaluate(TicTacToeBoard::O), L"O to move is 4 single lines down");
+
+			// O in the corner closes the diagonal, X is left with 3 lines & O has 2 (row & column)
+			evaluator.play(0, board.getPlayer());
+			board.play(0);
+			Assert::AreEqual(3, evaluator.getOpenLines(TicTacToeBoard::X, 1), L"the diagonal should be closed");
+			Assert::AreEqual(2, evaluator.getOpenLines(TicTacToeBoard::O, 1), L"O's row & column should be open");
+			Assert::AreEqual(1, evaluator.evaluate(TicTacToeBoard::X), L"X to move is 1 line up");
+
+			board.undo(0);
+			evaluator.undo(0, board.getPlayer());
+			board.undo(4);
+			evaluator.undo(4, board.getPlayer());
+			Assert::AreEqual(0, evaluator.getOpenLines(TicTacToeBoard::X, 1), L"undo should take the lines back");
+			Assert::AreEqual(0, evaluator.evaluate(TicTacToeBoard::X), L"undo should take the score back");
+		}
+
+		// Random games played & taken back move by move keep the same score as counting from scratch
+		TEST_METHOD(IncrementalMatchesReset) {
+			const int geometries[2][3] = { { 5, 5, 4 }, { 8, 8, 5 } };
+			std::mt19937 generator(11);
+			for (const int* geometry : geometries) {
+				MnkBoard board(geometry[0], geometry[1], geometry[2]);
+				LineEvaluator evaluator(board);
+				LineEvaluator fresh;
+				std::vector<int> squares(board.getSquareCount());
+				for (int pos = 0; pos < board.getSquareCount(); pos++)
+					squares[pos] = pos;
+				for (int game = 0; game < 20; game++) {
+					std::shuffle(squares.begin(), squares.end(), generator);
+					for (int pos : squares) {
+						evaluator.play(pos, board.getPlayer());
+						board.play(pos);
+						fresh.reset(board);
+						Assert::AreEqual(fresh.evaluate(TicTacToeBoard::X), evaluator.evaluate(TicTacToeBoard::X),
+							L"incremental score should match a recount after play");
+						Assert::AreEqual(fresh.getOpenLines(TicTacToeBoard::O, 2),
+							evaluator.getOpenLines(TicTacToeBoard::O, 2), L"open lines should match a recount");
+					}
+					for (auto pos = squares.rbegin(); pos != squares.rend(); ++pos) {
+						board.undo(*pos);
+						evaluator.undo(*pos, board.getPlayer());
+						fresh.reset(board);
+						Assert::AreEqual(fresh.evaluate(TicTacToeBoard::O), evaluator.evaluate(TicTacToeBoard::O),
+							L"incremental score should match a recount after undo");
+					}
+					Assert::AreEqual(0, evaluator.evaluate(TicTacToeBoard::X), L"every move undone should score 0");
+				}
+			}
+		}
+
+		// The evaluation only orders positions at the depth limit - the engine still takes a win & solves 3x3
+		TEST_METHOD(EvaluatingEngineStillExact) {
+			MnkBoard board(3, 3, 3);
+			const int moves[4] = { 0, 3, 1, 4 };
+			for (int move : moves)
+				board.play(move);
+			std::atomic<bool> cancel(false);
+			SearchEngine engine(SearchEngine::OPEN_LINES);
+			SearchEngine::Result result = engine.search(board, std::chrono::steady_clock::now() + std::chrono::seconds(5),
+				cancel);
+			Assert::AreEqual(2, result.bestMove, L"X should win on the top right square");
+			Assert::IsTrue(result.exact, L"a forced win should end the search");
+
+			result = engine.search(MnkBoard(3, 3, 3), std::chrono::steady_clock::now() + std::chrono::seconds(5), cancel);
+			Assert::IsTrue(result.exact, L"3x3 tree should be searched to the end");
+			Assert::AreEqual(0, result.score, L"perfect play should be a draw");
+
+			// depth limited on a larger board: a legal move & a score within the evaluation's range
+			result = engine.search(MnkBoard(5, 5, 4), std::chrono::steady_clock::now() + std::chrono::seconds(5), cancel, 3);
+			Assert::IsTrue(!result.exact, L"3 plies can't finish 5x5");
+			Assert::IsTrue(std::abs(result.score) <= LineEvaluator::MAX_SCORE, L"score should come from the evaluation");
+		}
+
+		// k beyond MAX_K & lengths outside 1 - k throw
+		TEST_METHOD(InvalidArgumentsThrow) {
+			try {
+				LineEvaluator evaluator(MnkBoard(1, LineEvaluator::MAX_K + 1, LineEvaluator::MAX_K + 1));
+				Assert::Fail(L"Expected std::invalid_argument not thrown");
+			}
+			catch (const std::invalid_argument& ex) { Logger::WriteMessage(ex.what()); }
+
+			LineEvaluator evaluator(MnkBoard(3, 3, 3));
+			try {
+				evaluator.getOpenLines(TicTacToeBoard::X, 4);
+				Assert::Fail(L"Expected std::invalid_argument not thrown");
+			}
+			catch (const std::invalid_argument& ex) { Logger::WriteMessage(ex.what()); }
+		}
+	};
+}
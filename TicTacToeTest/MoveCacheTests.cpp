@@ -0,0 +1,149 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include "../TicTacToe_TestPracticum/MnkBoard.h"
+#include "../TicTacToe_TestPracticum/SearchEngine.h"
+#include "../TicTacToe_TestPracticum/MoveCache.h"
+#include "../TicTacToe_TestPracticum/AsyncMoveSearch.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace TicTacToeTest
+{
+	TEST_CLASS(TicTacToeMoveCacheTests)
+	{
+	public:
+
+		TEST_CLASS_INITIALIZE(_Setup_MoveCacheTest)
+		{
+			// this method is run once for the class - nothing to initialize, each test builds its own cache
+			Logger::WriteMessage("Move cache test class initialized\n");
+		}
+
+		// Rotations & reflections of a position share its entry, the best move is mapped onto the board looked up
+		//   scenario:   X  O  -     best move 3 (row 1, column 0)
+		//               -  -  -
+		//               -  -  -
+		TEST_METHOD(SymmetricPositionsShareEntry) {
+			MoveCache cache;
+			MnkBoard board(3, 3, 3);
+			board.play(0);
+			board.play(1);
+			SearchEngine::Result result;
+			result.bestMove = 3;
+			result.score = 7;
+			result.depth = 4;
+			cache.store(board, result);
+
+			MnkBoard mirrored(3, 3, 3);              // columns flipped: X at 2, O at 1
+			mirrored.play(2);
+			mirrored.play(1);
+			SearchEngine::Result cached;
+			Assert::IsTrue(cache.lookup(mirrored, cached), L"mirror image should be found");
+			Assert::AreEqual(5, cached.bestMove, L"best move should be mirrored too");
+			Assert::AreEqual(7, cached.score);
+			Assert::AreEqual(4, cached.depth);
+
+			MnkBoard transposed(3, 3, 3);            // rows & columns swapped: X at 0, O at 3
+			transposed.play(0);
+			transposed.play(3);
+			Assert::IsTrue(cache.lookup(transposed, cached), L"transposed position should be found");
+			Assert::AreEqual(1, cached.bestMove, L"best move should be transposed too");
+
+			MnkBoard larger(4, 4, 3);                // same squares, another variant
+			larger.play(0);
+			larger.play(1);
+			Assert::IsFalse(cache.lookup(larger, cached), L"board size is part of the key");
+			Assert::AreEqual(static_cast<uint64_t>(2), cache.getStats().hits);
+			Assert::AreEqual(static_cast<uint64_t>(1), cache.getStats().misses);
+		}
+
+		// Only a better result replaces a cached one, & the cache stays within its capacity by evicting
+		TEST_METHOD(ReplacementAndEviction) {
+			MoveCache cache(MoveCache::SHARDS);      // one slot per shard
+			MnkBoard board(4, 4, 4);
+			SearchEngine::Result result;
+			result.bestMove = 5;
+			result.depth = 5;
+			cache.store(board, result);
+			result.depth = 3;
+			cache.store(board, result);
+			SearchEngine::Result cached;
+			Assert::IsTrue(cache.lookup(board, cached));
+			Assert::AreEqual(5, cached.depth, L"a shallower result shouldn't replace a deeper one");
+			result.exact = true;
+			cache.store(board, result);
+			Assert::IsTrue(cache.lookup(board, cached) && cached.exact, L"an exact result should replace it");
+
+			for (int first = 0; first < board.getSquareCount(); first++) {
+				for (int second = 0; second < board.getSquareCount(); second++) {
+					if (first == second)
+						continue;
+					MnkBoard position(4, 4, 4);
+					position.play(first);
+					position.play(second);
+					cache.store(position, result);
+				}
+			}
+			MoveCache::Stats stats = cache.getStats();
+			Assert::IsTrue(stats.entries <= cache.getCapacity(), L"cache should stay within its capacity");
+			Assert::IsTrue(stats.evictions > 0, L"entries should have been evicted");
+			try {
+				MoveCache empty(0);
+				Assert::Fail(L"Expected std::invalid_argument not thrown");
+			}
+			catch (const std::invalid_argument& ex) { Logger::WriteMessage(ex.what()); }
+		}
+
+		// A saved cache warm loads another, a missing file loads nothing, a file of another kind is rejected
+		TEST_METHOD(WarmLoadFromFile) {
+			const char* path = "move_cache_test.bin";
+			std::remove(path);
+			MoveCache cache;
+			Assert::AreEqual(static_cast<size_t>(0), cache.load(path), L"missing file should load nothing");
+			MnkBoard board(3, 3, 3);
+			board.play(4);
+			SearchEngine::Result result;
+			result.bestMove = 0;
+			result.exact = true;
+			cache.store(board, result);
+			Assert::AreEqual(static_cast<size_t>(1), cache.save(path));
+
+			MoveCache warm;
+			Assert::AreEqual(static_cast<size_t>(1), warm.load(path));
+			SearchEngine::Result cached;
+			Assert::IsTrue(warm.lookup(board, cached), L"loaded position should be found");
+			Assert::IsTrue(cached.exact, L"loaded result should be exact");
+			Assert::IsTrue((cached.bestMove == 0) || (cached.bestMove == 2) || (cached.bestMove == 6) ||
+				(cached.bestMove == 8), L"best move should be a corner");
+
+			{
+				std::ofstream other(path, std::ios::binary | std::ios::trunc);
+				other << "not a move cache";
+			}
+			try {
+				warm.load(path);
+				Assert::Fail(L"Expected std::runtime_error not thrown");
+			}
+			catch (const std::runtime_error& ex) { Logger::WriteMessage(ex.what()); }
+			std::remove(path);
+		}
+
+		// A repeated request is answered from the cache, no search
+		TEST_METHOD(AsyncSearchUsesCache) {
+			std::shared_ptr<MoveCache> cache = std::make_shared<MoveCache>();
+			AsyncMoveSearch search(cache);
+			MnkBoard board(3, 3, 3);
+			SearchEngine::Result searched = search.requestMove(board, std::chrono::seconds(10)).get();
+			Assert::IsTrue(searched.exact && (searched.nodes > 0), L"first request should be searched");
+			SearchEngine::Result cached = search.requestMove(board, std::chrono::seconds(10)).get();
+			Assert::AreEqual(static_cast<uint64_t>(0), cached.nodes, L"second request should be a cache hit");
+			Assert::AreEqual(searched.score, cached.score);
+			Assert::IsTrue(board.isSquareEmpty(cached.bestMove), L"cached move should be legal");
+		}
+	};
+}
@@ -0,0 +1,116 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include "../TicTacToe_TestPracticum/OpeningStats.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace TicTacToeTest
+{
+	TEST_CLASS(TicTacToeOpeningStatsTests)
+	{
+	public:
+
+		TEST_CLASS_INITIALIZE(_Setup_OpeningStatsTest)
+		{
+			// this method is run once for the class - nothing to initialize, each test builds its own trie
+			Logger::WriteMessage("Opening statistics test class initialized\n");
+		}
+
+		// Every prefix of a game counts its result, unseen prefixes have none, next moves come in cell order
+		TEST_METHOD(PrefixCountsAndContinuations) {
+			OpeningTrie trie;
+			const int centreCorner[] = { 4, 0, 2, 6, 3, 5, 8 };
+			const int centreEdge[] = { 4, 1, 0, 8, 2, 6, 7, 3, 5 };
+			const int cornerFirst[] = { 0, 4, 8, 2, 6, 3, 5 };
+			trie.addGame(centreCorner, 7, TicTacToeBoard::X_WINS);
+			trie.addGame(centreEdge, 9, TicTacToeBoard::DRAW);
+			trie.addGame(cornerFirst, 7, TicTacToeBoard::O_WINS);
+
+			OpeningTrie::Counts all = trie.query(nullptr, 0);
+			Assert::AreEqual(static_cast<uint64_t>(3), all.getGames(), L"the empty prefix counts every game");
+			OpeningTrie::Counts centre = trie.query(centreCorner, 1);
+			Assert::AreEqual(static_cast<uint64_t>(1), centre.xWins);
+			Assert::AreEqual(static_cast<uint64_t>(1), centre.draws);
+			Assert::AreEqual(0.5, centre.getRate(centre.xWins), 1e-9);
+			Assert::AreEqual(static_cast<uint64_t>(1), trie.query(centreEdge, 9).draws, L"the whole game is a prefix");
+			const int unseen[] = { 4, 8 };
+			Assert::AreEqual(static_cast<uint64_t>(0), trie.query(unseen, 2).getGames(), L"never played");
+			Assert::AreEqual(0.0, trie.query(unseen, 2).getRate(0), 1e-9, L"no games, no rate");
+
+			std::vector<OpeningTrie::Continuation> replies = trie.continuations(centreCorner, 1);
+			Assert::AreEqual(static_cast<size_t>(2), replies.size());
+			Assert::AreEqual(0, replies[0].cell, L"replies in cell order");
+			Assert::AreEqual(1, replies[1].cell);
+			Assert::AreEqual(static_cast<uint64_t>(1), replies[1].counts.draws);
+			Assert::AreEqual(static_cast<size_t>(2), trie.continuations(nullptr, 0).size(), L"two first moves");
+			Assert::AreEqual(static_cast<size_t>(1 + 7 + 8 + 7), trie.getNodeCount(), L"a node per distinct prefix");
+
+			const int badCells[][2] = { { 4, 9 }, { 4, -1 }, { 4, 4 } };
+			for (const int* cells : badCells) {
+				try {
+					trie.addGame(cells, 2, TicTacToeBoard::DRAW);
+					Assert::Fail(L"Expected std::invalid_argument not thrown");
+				}
+				catch (const std::invalid_argument& ex) { Logger::WriteMessage(ex.what()); }
+			}
+			try {
+				trie.addGame(centreCorner, 3, TicTacToeBoard::IN_PROGRESS);
+				Assert::Fail(L"Expected std::invalid_argument not thrown");
+			}
+			catch (const std::invalid_argument& ex) { Logger::WriteMessage(ex.what()); }
+		}
+
+		// Prefixes beyond maxDepth aren't stored, merging shards gives the same trie as ingesting serially
+		TEST_METHOD(DepthLimitAndShardMerge) {
+			const int games[][9] = { { 4, 0, 2, 6, 3, 5, 8 }, { 0, 4, 8, 2, 6, 3, 5 }, { 4, 1, 0, 8, 2, 6, 7, 3, 5 },
+				{ 4, 0, 2, 6, 8, 5, 3 }, { 2, 4, 6, 0, 8, 5, 7 } };
+			const int moves[] = { 7, 7, 9, 7, 7 };
+			const TicTacToeBoard::GameStatus results[] = { TicTacToeBoard::X_WINS, TicTacToeBoard::O_WINS,
+				TicTacToeBoard::DRAW, TicTacToeBoard::X_WINS, TicTacToeBoard::X_WINS };
+
+			OpeningTrie serial(2);
+			OpeningStats stats(3, 2);
+			for (int game = 0; game < 5; game++) {
+				serial.addGame(games[game], moves[game], results[game]);
+				stats.getShard(game % 3).addGame(games[game], moves[game], results[game]);
+			}
+			Assert::AreEqual(static_cast<uint64_t>(0), serial.query(games[0], 3).getGames(), L"beyond the depth limit");
+			Assert::AreEqual(static_cast<size_t>(1 + 3 + 4), serial.getNodeCount());
+
+			const OpeningTrie& merged = stats.merge();
+			Assert::AreEqual(serial.getNodeCount(), merged.getNodeCount(), L"merged shards should match serial");
+			Assert::AreEqual(static_cast<uint64_t>(5), merged.query(nullptr, 0).getGames());
+			Assert::AreEqual(static_cast<uint64_t>(2), merged.query(games[0], 2).xWins);
+			Assert::AreEqual(static_cast<uint64_t>(0), stats.getShard(1).query(nullptr, 0).getGames(),
+				L"merged shards are emptied");
+			try {
+				OpeningStats(0);
+				Assert::Fail(L"Expected std::invalid_argument not thrown");
+			}
+			catch (const std::invalid_argument& ex) { Logger::WriteMessage(ex.what()); }
+		}
+
+		// Game logs - comments & blank lines skipped, a bad line reports its line #
+		TEST_METHOD(IngestLog) {
+			OpeningTrie trie;
+			std::istringstream log("# from the tournament\n40215 X\r\n\n015482 O\n401 D\n");
+			Assert::AreEqual(static_cast<size_t>(3), OpeningStats::ingestLog(log, trie));
+			const int centre[] = { 4 };
+			Assert::AreEqual(static_cast<uint64_t>(2), trie.query(centre, 1).getGames());
+			Assert::AreEqual(static_cast<uint64_t>(1), trie.query(nullptr, 0).oWins);
+
+			const char* badLogs[] = { "40215 X\n40215\n", "40215 W\n", "4a215 X\n", "44 D\n" };
+			for (const char* bad : badLogs) {
+				std::istringstream badLog(bad);
+				try {
+					OpeningStats::ingestLog(badLog, trie);
+					Assert::Fail(L"Expected std::invalid_argument not thrown");
+				}
+				catch (const std::invalid_argument& ex) { Logger::WriteMessage(ex.what()); }
+			}
+		}
+	};
+}
@@ -0,0 +1,88 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "../TicTacToe_TestPracticum/PositionExporter.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace TicTacToeTest
+{
+	TEST_CLASS(TicTacToePositionExporterTests)
+	{
+	public:
+
+		TEST_CLASS_INITIALIZE(_Setup_PositionExporterTest)
+		{
+			// this method is run once for the class - each test writes & removes its own file
+			Logger::WriteMessage("Position exporter test class initialized\n");
+		}
+
+		// Every reachable 3x3 position exactly once, the empty board is a draw where every move is optimal
+		TEST_METHOD(ExportAllStandardBoard) {
+			const char* path = "export_all_test.tttc";
+			PositionExporter exporter(3, 3, 3, 2);
+			PositionExporter::Result result = exporter.exportAll(path);
+			Assert::IsTrue(result.rows == 5478, L"expected 5478 reachable positions");
+
+			std::vector<unsigned char> file = readFile(path);
+			std::remove(path);
+			Assert::IsTrue(file.size() == result.bytes, L"file size should match the bytes reported");
+			Assert::IsTrue(std::string(file.begin(), file.begin() + 4) == "TTTC", L"file should start with TTTC");
+			Assert::AreEqual(6, static_cast<int>(file[9]), L"expected 6 columns");
+
+			// 3x3 - square masks 2 bytes, labels 1 byte: x, o, value, optimal, ply, side = 9 bytes per row
+			size_t offset = 10 + 6 * 18;
+			uint64_t rows = 0;
+			bool emptyBoardFound = false;
+			while (true) {
+				uint32_t rowCount = file[offset] | (file[offset + 1] << 8) | (file[offset + 2] << 16) | (file[offset + 3] << 24);
+				offset += 4;
+				if (rowCount == 0)
+					break;
+				const unsigned char* x = &file[offset];
+				const unsigned char* o = x + 2 * rowCount;
+				const unsigned char* value = o + 2 * rowCount;
+				const unsigned char* optimal = value + rowCount;
+				const unsigned char* ply = optimal + 2 * rowCount;
+				for (uint32_t row = 0; row < rowCount; row++) {
+					if ((x[2 * row] | x[2 * row + 1] | o[2 * row] | o[2 * row + 1]) == 0) {
+						emptyBoardFound = true;
+						Assert::AreEqual(0, static_cast<int>(static_cast<signed char>(value[row])), L"empty board should be a draw");
+						Assert::AreEqual(0x1FF, optimal[2 * row] | (optimal[2 * row + 1] << 8), L"every first move draws");
+						Assert::AreEqual(0, static_cast<int>(ply[row]));
+					}
+				}
+				rows += rowCount;
+				offset += 9 * rowCount;
+			}
+			Assert::IsTrue(emptyBoardFound, L"empty board should be exported");
+			Assert::IsTrue(rows == result.rows, L"rows in the file should match the rows reported");
+			Assert::IsTrue(offset == file.size(), L"end marker should be the last thing in the file");
+		}
+
+		// Random games - 6 to 10 rows per game: the empty board, then at least 5 moves (earliest win) & at most 9
+		TEST_METHOD(ExportSelfPlayGames) {
+			const char* path = "export_self_play_test.tttc";
+			PositionExporter exporter(3, 3, 3, 2);
+			PositionExporter::Result result = exporter.exportSelfPlay(path, 1000, 42);
+			std::remove(path);
+			Assert::IsTrue(result.rows >= 6 * 1000 && result.rows <= 10 * 1000, L"unexpected number of rows");
+			try {
+				PositionExporter tooLarge(5, 5, 4, 1);
+				Assert::Fail(L"Expected std::invalid_argument not thrown");
+			}
+			catch (const std::invalid_argument& ex) { Logger::WriteMessage(ex.what()); }
+			catch (...) { Assert::Fail(L"Unexpected exception type thrown"); }
+		}
+
+	private:
+		static std::vector<unsigned char> readFile(const char* path) {
+			std::ifstream file(path, std::ios::binary);
+			return std::vector<unsigned char>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+		}
+	};
+}
@@ -0,0 +1,86 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <chrono>
+#include <stdexcept>
+#include "../TicTacToe_TestPracticum/QubicBoard.h"
+#include "../TicTacToe_TestPracticum/QubicSearch.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace TicTacToeTest
+{
+	TEST_CLASS(TicTacToeQubicTests)
+	{
+	public:
+
+		TEST_CLASS_INITIALIZE(_Setup_QubicTest)
+		{
+			// this method is run once for the class - nothing to initialize, each test builds its own boards
+			Logger::WriteMessage("Qubic test class initialized\n");
+		}
+
+		// 76 lines of 4 cells, corners & the 8 centre cells are on 7 lines, every other cell on 4
+		TEST_METHOD(LineTable) {
+			int incidences = 0;
+			for (int line = 0; line < QubicBoard::LINE_COUNT; line++) {
+				uint64_t mask = QubicBoard::getLine(line);
+				int cells = 0;
+				for (int cell = 0; cell < QubicBoard::CELLS; cell++)
+					cells += (mask >> cell) & 1;
+				Assert::AreEqual(QubicBoard::SIZE, cells, L"every line should have 4 cells");
+			}
+			for (int cell = 0; cell < QubicBoard::CELLS; cell++) {
+				const uint8_t* lines;
+				incidences += QubicBoard::getLinesThrough(cell, lines);
+			}
+			const uint8_t* lines;
+			Assert::AreEqual(QubicBoard::LINE_COUNT * QubicBoard::SIZE, incidences);
+			Assert::AreEqual(7, QubicBoard::getLinesThrough(QubicBoard::cellIndex(0, 0, 0), lines), L"corner");
+			Assert::AreEqual(7, QubicBoard::getLinesThrough(QubicBoard::cellIndex(1, 1, 2), lines), L"centre cell");
+			Assert::AreEqual(4, QubicBoard::getLinesThrough(QubicBoard::cellIndex(0, 0, 1), lines), L"edge cell");
+		}
+
+		// X builds the space diagonal 0, 21, 42, 63 - the last cell is a threat, then a win, undo takes it back
+		TEST_METHOD(SpaceDiagonalThreatAndWin) {
+			QubicBoard board;
+			const int moves[6] = { 0, 1, 21, 2, 42, 5 };
+			for (int move : moves)
+				Assert::IsTrue(board.play(move));
+			Assert::IsTrue(board.getThreats(TicTacToeBoard::X) == (1ull << 63), L"63 should complete the diagonal");
+			Assert::IsTrue(board.getThreats(TicTacToeBoard::O) == 0);
+			Assert::IsTrue(board.play(63));
+			Assert::IsTrue(board.isWinningMove(63) && board.isWinner(TicTacToeBoard::X), L"X should have won");
+			board.undo(63);
+			Assert::IsFalse(board.isWinner(TicTacToeBoard::X));
+			Assert::IsFalse(board.play(21), L"cell already taken");
+			try {
+				board.play(QubicBoard::CELLS);
+				Assert::Fail(L"Expected std::invalid_argument not thrown");
+			}
+			catch (const std::invalid_argument& ex) { Logger::WriteMessage(ex.what()); }
+		}
+
+		// X to play can make two threats at once on cell 0 (row 0-3 & column 0, 4, 8, 12 of level 0)
+		//   the engine should see the forced win well within its 100 ms, & O should block a single threat
+		TEST_METHOD(EngineFindsForkAndBlocks) {
+			QubicBoard board;
+			const int moves[8] = { 1, 63, 2, 42, 4, 30, 8, 55 };
+			for (int move : moves)
+				board.play(move);
+			QubicSearch engine;
+			QubicSearch::Result result = engine.search(board, std::chrono::milliseconds(100));
+			Assert::IsTrue(result.exact && (result.score > 0), L"X should have a forced win");
+			Assert::AreEqual(0, result.bestMove, L"cell 0 makes two threats");
+
+			board.play(0);
+			result = engine.search(board, std::chrono::milliseconds(100));
+			Assert::IsTrue(result.exact && (result.score < 0), L"O can only block one threat");
+
+			QubicBoard single;
+			const int threat[5] = { 0, 1, 21, 2, 42 };
+			for (int move : threat)
+				single.play(move);
+			Assert::AreEqual(63, engine.search(single, std::chrono::milliseconds(100)).bestMove, L"O should block 63");
+		}
+	};
+}
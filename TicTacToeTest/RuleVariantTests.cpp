@@ -0,0 +1,107 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <random>
+#include <stdexcept>
+#include "../TicTacToe_TestPracticum/TicTacToeBoard.h"
+#include "../TicTacToe_TestPracticum/RuleVariantBoard.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace TicTacToeTest
+{
+	TEST_CLASS(TicTacToeRuleVariantTests)
+	{
+	public:
+
+		TEST_CLASS_INITIALIZE(_Setup_RuleVariantTest)
+		{
+			// this method is run once for the class - nothing to initialize, each test builds its own boards
+			Logger::WriteMessage("Rule variant board test class initialized\n");
+		}
+
+		// Standard rules give the same result as TicTacToeBoard, move by move, over random games
+		TEST_METHOD(StandardMatchesBoard) {
+			std::mt19937 generator(40);
+			std::uniform_int_distribution<int> squares(0, StandardBoard::SQUARES - 1);
+			StandardBoard variant;
+			TicTacToeBoard board;
+			for (int game = 0; game < 2000; game++) {
+				variant.reset();
+				board.resetBoard();
+				while (variant.getGameStatus() == TicTacToeBoard::IN_PROGRESS) {
+					int position = squares(generator);
+					if (!variant.isSquareEmpty(position))
+						continue;
+					// resetBoard() leaves the player to the caller, so the board follows the variant's player
+					board.writeSquare(position / 3, position % 3, variant.getPlayer());
+					variant.play(position);
+					Assert::AreEqual(static_cast<int>(board.getGameStatus()), static_cast<int>(variant.getGameStatus()),
+						L"game status should match TicTacToeBoard");
+				}
+			}
+			Assert::IsFalse(variant.play(0), L"no moves after the game is over");
+			try {
+				variant.isSquareEmpty(StandardBoard::SQUARES);
+				Assert::Fail(L"Expected std::invalid_argument not thrown");
+			}
+			catch (const std::invalid_argument& ex) { Logger::WriteMessage(ex.what()); }
+		}
+
+		// Misère - completing a line loses
+		//   scenario:   X  X  X
+		//               O  O  -
+		//               -  -  -
+		TEST_METHOD(MisereLineLoses) {
+			MisereBoard board;
+			const int moves[5] = { 0, 3, 1, 4, 2 };
+			for (int move : moves)
+				Assert::IsTrue(board.play(move), L"move should be played");
+			Assert::AreEqual(static_cast<int>(TicTacToeBoard::O_WINS), static_cast<int>(board.getGameStatus()),
+				L"X completed a line, O should win");
+		}
+
+		// Wild - either symbol, the player completing a line of either symbol wins, standard rules don't allow it
+		//   scenario:   O  O  O   <- X plays the third O
+		//               X  -  -
+		//               -  -  -
+		TEST_METHOD(WildEitherSymbol) {
+			WildBoard board;
+			Assert::IsTrue(board.play(0, TicTacToeBoard::O), L"X may play an O");
+			Assert::IsTrue(board.play(3, TicTacToeBoard::X), L"O may play an X");
+			Assert::IsTrue(board.play(1, TicTacToeBoard::O));
+			Assert::AreEqual(static_cast<int>(TicTacToeBoard::IN_PROGRESS), static_cast<int>(board.getGameStatus()));
+			Assert::IsTrue(board.getPlayer() == TicTacToeBoard::O, L"O to move");
+			Assert::IsTrue(board.play(2, TicTacToeBoard::O));
+			Assert::AreEqual(static_cast<int>(TicTacToeBoard::O_WINS), static_cast<int>(board.getGameStatus()),
+				L"O completed the line of Os, O should win");
+
+			StandardBoard standard;
+			try {
+				standard.play(0, TicTacToeBoard::O);
+				Assert::Fail(L"Expected std::invalid_argument not thrown");
+			}
+			catch (const std::invalid_argument& ex) { Logger::WriteMessage(ex.what()); }
+		}
+
+		// Custom starts - starting player & stones on the board before the first move
+		TEST_METHOD(CustomStart) {
+			OStartsBoard oStarts;
+			Assert::IsTrue(oStarts.getPlayer() == TicTacToeBoard::O, L"O should move first");
+			oStarts.play(4);
+			Assert::AreEqual(static_cast<int>(0x010), static_cast<int>(oStarts.getSquares(TicTacToeBoard::O)));
+
+			CentreTakenBoard centre;
+			Assert::IsTrue(centre.getPlayer() == TicTacToeBoard::O, L"O should move first");
+			Assert::AreEqual(1, centre.getPly(), L"the centre X counts as a move");
+			Assert::IsFalse(centre.play(4), L"centre is taken");
+			const int moves[4] = { 0, 2, 1, 6 };
+			for (int move : moves)
+				centre.play(move);
+			Assert::AreEqual(static_cast<int>(TicTacToeBoard::X_WINS), static_cast<int>(centre.getGameStatus()),
+				L"X completed the diagonal through the centre");
+			centre.reset();
+			Assert::AreEqual(static_cast<int>(0x010), static_cast<int>(centre.getSquares(TicTacToeBoard::X)),
+				L"reset should go back to the start position");
+		}
+	};
+}
@@ -0,0 +1,145 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <chrono>
+#include <future>
+#include "../TicTacToe_TestPracticum/TicTacToeBoard.h"
+#include "../TicTacToe_TestPracticum/MnkBoard.h"
+#include "../TicTacToe_TestPracticum/SearchEngine.h"
+#include "../TicTacToe_TestPracticum/AsyncMoveSearch.h"
+#include "../TicTacToe_TestPracticum/TranspositionTable.h"
+#include "../TicTacToe_TestPracticum/ParallelSearch.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace TicTacToeTest
+{
+	TEST_CLASS(TicTacToeSearchEngineTests)
+	{
+	public:
+
+		TEST_CLASS_INITIALIZE(_Setup_SearchEngineTest)
+		{
+			// this method is run once for the class - nothing to initialize, each test builds its own boards
+			Logger::WriteMessage("Search engine test class initialized\n");
+		}
+
+		// X to play should complete the top row rather than block O
+		//   scenario:   X  X  -
+		//               O  O  -
+		//               -  -  -
+		TEST_METHOD(EngineTakesTheWin) {
+			MnkBoard board(3, 3, 3);
+			const int moves[4] = { 0, 3, 1, 4 };
+			for (int move : moves)
+				board.play(move);
+			std::atomic<bool> cancel(false);
+			SearchEngine engine;
+			SearchEngine::Result result = engine.search(board, std::chrono::steady_clock::now() + std::chrono::seconds(5),
+				cancel);
+			Assert::AreEqual(2, result.bestMove, L"X should win on the top right square");
+			Assert::IsTrue(result.score > 0, L"score should show a win for the player to move");
+			Assert::IsTrue(result.exact, L"a forced win should end the search");
+		}
+
+		// Perfect play from the empty board is a draw, the engine should search the whole tree well within 5 s
+		TEST_METHOD(EmptyBoardIsADraw) {
+			MnkBoard board(3, 3, 3);
+			std::atomic<bool> cancel(false);
+			SearchEngine engine;
+			SearchEngine::Result result = engine.search(board, std::chrono::steady_clock::now() + std::chrono::seconds(5),
+				cancel);
+			Assert::IsTrue(result.exact, L"3x3 tree should be searched to the end");
+			Assert::AreEqual(0, result.score, L"perfect play should be a draw");
+		}
+
+		// A search past its deadline still returns a legal move (best so far), as does a cancelled async request
+		//   4x4 / k=4 can't be searched to the end in the time allowed
+		TEST_METHOD(DeadlineAndCancelReturnAMove) {
+			MnkBoard board(4, 4, 4);
+			std::atomic<bool> cancel(false);
+			SearchEngine engine;
+			SearchEngine::Result result = engine.search(board, std::chrono::steady_clock::now(), cancel);
+			Assert::IsTrue(board.isSquareEmpty(result.bestMove), L"expired deadline should still give a legal move");
+
+			AsyncMoveSearch search;
+			std::future<SearchEngine::Result> move = search.requestMove(board, std::chrono::seconds(60));
+			search.cancel();
+			Assert::IsTrue(move.wait_for(std::chrono::seconds(5)) == std::future_status::ready,
+				L"cancelled search should finish promptly");
+			result = move.get();
+			Assert::IsTrue(board.isSquareEmpty(result.bestMove), L"cancelled search should still give a legal move");
+
+			// a finished game is reported through the future
+			MnkBoard full(1, 1, 1);
+			full.play(0);
+			move = search.requestMove(full, std::chrono::milliseconds(100));
+			try {
+				move.get();
+				Assert::Fail(L"Expected std::invalid_argument not thrown");
+			}
+			catch (const std::invalid_argument& ex) { Logger::WriteMessage(ex.what()); }
+			catch (...) { Assert::Fail(L"Unexpected exception type thrown"); }
+		}
+
+		// Entries round trip through the packed slots, a deeper entry for another position keeps its slot until
+		//   the next search, the same position is always replaced
+		TEST_METHOD(TranspositionTableReplacement) {
+			TranspositionTable table(16);
+			TranspositionTable::Entry entry;
+			entry.score = -997;
+			entry.depth = 12;
+			entry.bound = TranspositionTable::LOWER;
+			entry.move = 7;
+			table.store(3, entry);
+
+			TranspositionTable::Entry found;
+			Assert::IsTrue(table.probe(3, found), L"stored entry should be found");
+			Assert::AreEqual(-997, found.score, L"score should round trip");
+			Assert::AreEqual(12, found.depth, L"depth should round trip");
+			Assert::IsTrue(found.bound == TranspositionTable::LOWER, L"bound should round trip");
+			Assert::AreEqual(7, found.move, L"move should round trip");
+			Assert::IsFalse(table.probe(19, found), L"another key in the same slot should miss");
+
+			TranspositionTable::Entry shallow;
+			shallow.depth = 4;
+			shallow.bound = TranspositionTable::EXACT;
+			table.store(19, shallow);
+			Assert::IsTrue(table.probe(3, found), L"shallower entry shouldn't replace a deeper one");
+			table.newSearch();
+			table.store(19, shallow);
+			Assert::IsTrue(table.probe(19, found), L"entries of an earlier search should be replaced");
+			Assert::AreEqual(static_cast<int>(TranspositionTable::NO_MOVE), found.move, L"no move should round trip");
+			table.store(19, entry);
+			Assert::AreEqual(7, table.probe(19, found) ? found.move : 0, L"same position should always be replaced");
+
+			try {
+				TranspositionTable empty(0);
+				Assert::Fail(L"Expected std::invalid_argument not thrown");
+			}
+			catch (const std::invalid_argument& ex) { Logger::WriteMessage(ex.what()); }
+		}
+
+		// Several threads sharing the table should find the same results as SearchEngine, the draw of the
+		//   empty board (whole tree) & the win on the top row
+		TEST_METHOD(ParallelSearchMatchesEngine) {
+			MnkBoard board(3, 3, 3);
+			ParallelSearch search(4, 1 << 12);
+			ParallelSearch::Result result = search.search(board, std::chrono::seconds(5));
+			Assert::IsTrue(result.exact, L"3x3 tree should be searched to the end");
+			Assert::AreEqual(0, result.score, L"perfect play should be a draw");
+			Assert::AreEqual(4, result.threads, L"every thread should take part");
+
+			const int moves[4] = { 0, 3, 1, 4 };
+			for (int move : moves)
+				board.play(move);
+			result = search.search(board, std::chrono::seconds(5));
+			Assert::AreEqual(2, result.bestMove, L"X should win on the top right square");
+			Assert::AreEqual(SearchEngine::WIN_SCORE - 5, result.score, L"score should be the immediate win");
+
+			// 4x4 / k=4 needs a few seconds, stopped by the deadline with a legal move
+			MnkBoard large(4, 4, 4);
+			result = search.search(large, std::chrono::milliseconds(0));
+			Assert::IsTrue(large.isSquareEmpty(result.bestMove), L"expired deadline should still give a legal move");
+		}
+	};
+}
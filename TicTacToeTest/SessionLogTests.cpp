@@ -0,0 +1,88 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <cstdio>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include "../TicTacToe_TestPracticum/SessionLog.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace TicTacToeTest
+{
+	TEST_CLASS(TicTacToeSessionLogTests)
+	{
+	public:
+
+		TEST_CLASS_INITIALIZE(_Setup_SessionLogTest)
+		{
+			// this method is run once for the class - each test uses its own file, removed at the end of the test
+			Logger::WriteMessage("Session log test class initialized\n");
+		}
+
+		// Events keep their bytes (escape sequences, tabs, newlines), damaged events are rejected
+		TEST_METHOD(EventFormat) {
+			std::stringstream log;
+			SessionLog::writeEvent(log, { SessionLog::OUTPUT_EVENT, 12, "\x1b[H\x1b[2J\n\t\t X |\n" });
+			SessionLog::writeEvent(log, { SessionLog::INPUT_EVENT, 3400, "" });
+			SessionLog::Event event;
+			Assert::IsTrue(SessionLog::readEvent(log, event));
+			Assert::AreEqual(static_cast<int>(SessionLog::OUTPUT_EVENT), static_cast<int>(event.type));
+			Assert::AreEqual(static_cast<int64_t>(12), event.microseconds);
+			Assert::IsTrue(event.text == "\x1b[H\x1b[2J\n\t\t X |\n", L"frame bytes should be kept as is");
+			Assert::IsTrue(SessionLog::readEvent(log, event));
+			Assert::IsTrue(event.text.empty(), L"an empty input line is an event");
+			Assert::IsFalse(SessionLog::readEvent(log, event), L"end of the log");
+
+			const char* damaged[] = { "X 1 2\nab\n", "I -1 2\nab\n", "I 1\nab\n", "I 1 2x\nab\n", "O 1 5\nab\n" };
+			for (const char* text : damaged) {
+				std::istringstream in(text);
+				try {
+					SessionLog::readEvent(in, event);
+					Assert::Fail(L"Expected std::invalid_argument not thrown");
+				}
+				catch (const std::invalid_argument& ex) { Logger::WriteMessage(ex.what()); }
+			}
+		}
+
+		// A recorded session replays its inputs, identical frames match, a changed frame is reported
+		TEST_METHOD(RecordAndReplay) {
+			const char* path = "session_log_test.txt";
+			{
+				SessionLog recording(path, SessionLog::RECORD);
+				recording.getFrame() += "board\nPlayer X to play: ";
+				recording.recordInput("1 1");
+				recording.getFrame() += "Player O to play: ";
+				recording.recordInput("Q");
+				recording.getFrame() += "Thank you for playing\n";
+				recording.endSession();
+			}
+
+			SessionLog replay(path, SessionLog::REPLAY);
+			std::string input;
+			replay.getFrame() += "board\nPlayer X to play: ";
+			Assert::IsTrue(replay.replayInput(input));
+			Assert::IsTrue(input == "1 1", L"first recorded input");
+			replay.getFrame() += "Player X to play: ";         // not what was recorded
+			Assert::IsTrue(replay.replayInput(input));
+			Assert::IsTrue(input == "Q", L"inputs are replayed as typed");
+			replay.getFrame() += "Thank you for playing\n";
+			Assert::IsFalse(replay.replayInput(input), L"the recording has no more input");
+
+			SessionLog::Report report = replay.getReport();
+			Assert::AreEqual(3, report.frames);
+			Assert::AreEqual(2, report.inputs);
+			Assert::AreEqual(1, report.mismatches);
+			Assert::AreEqual(1, report.firstMismatch, L"second frame differs");
+			Assert::AreEqual(0, report.unusedEvents);
+			Assert::IsTrue(report.maxUs >= report.p50Us, L"frame time percentiles in order");
+
+			std::remove(path);
+			try {
+				SessionLog missing(path, SessionLog::REPLAY);
+				Assert::Fail(L"Expected std::runtime_error not thrown");
+			}
+			catch (const std::runtime_error& ex) { Logger::WriteMessage(ex.what()); }
+		}
+	};
+}
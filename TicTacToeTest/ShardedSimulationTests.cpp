@@ -0,0 +1,118 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "../TicTacToe_TestPracticum/TicTacToeBoard.h"
+#include "../TicTacToe_TestPracticum/ShardedSimulation.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace TicTacToeTest
+{
+	TEST_CLASS(TicTacToeShardedSimulationTests)
+	{
+	public:
+
+		TEST_CLASS_INITIALIZE(_Setup_ShardedSimulationTest)
+		{
+			// this method is run once for the class - workers are threads here, the socket file is removed after each run
+			Logger::WriteMessage("Sharded simulation test class initialized\n");
+		}
+
+		// A unit's games depend only on its seed, & every game is counted once in each table
+		TEST_METHOD(SimulateIsDeterministic) {
+			ShardTotals totals = ShardTotals::simulate(42, 5000);
+			Assert::IsTrue(totals == ShardTotals::simulate(42, 5000), L"same seed should play the same games");
+			Assert::IsFalse(totals == ShardTotals::simulate(43, 5000), L"another seed should play other games");
+
+			uint64_t results = 0, firstMoves = 0, lengths = 0;
+			for (int result = 0; result < ShardTotals::RESULTS; result++) {
+				results += totals.results[result];
+				for (int cell = 0; cell < ShardTotals::CELLS; cell++)
+					firstMoves += totals.firstMoves[cell][result];
+			}
+			for (int length = 0; length <= ShardTotals::CELLS; length++)
+				lengths += totals.lengths[length];
+			Assert::AreEqual(5000ull, static_cast<unsigned long long>(results), L"each game should have a result");
+			Assert::AreEqual(5000ull, static_cast<unsigned long long>(firstMoves), L"each game should have a first move");
+			Assert::AreEqual(5000ull, static_cast<unsigned long long>(lengths), L"each game should have a length");
+			Assert::AreEqual(0ull, static_cast<unsigned long long>(totals.lengths[4]), L"no game ends before move 5");
+
+			ShardTotals merged = totals;
+			merged.merge(totals);
+			Assert::AreEqual(10000ull, static_cast<unsigned long long>(merged.games), L"merge should add the games");
+			Assert::AreEqual(static_cast<unsigned long long>(2 * totals.getResult(TicTacToeBoard::X_WINS)),
+				static_cast<unsigned long long>(merged.getResult(TicTacToeBoard::X_WINS)), L"merge should add results");
+		}
+
+		// Three workers get the same totals as one, every unit played once
+		TEST_METHOD(WorkersMatchSingleWorker) {
+			const char* path = "ShardTest.sock";
+			ShardTotals expected = runWorkers(path, { -1 }, nullptr);
+			ShardCoordinator::Report report;
+			ShardTotals totals = runWorkers(path, { -1, -1, -1 }, &report);
+			Assert::IsTrue(totals == expected, L"merged totals should not depend on the # of workers");
+			Assert::AreEqual(3, report.workers, L"all three workers should connect");
+			Assert::AreEqual(0, report.reassigned, L"no unit should be handed out twice");
+			Assert::AreEqual(static_cast<unsigned long long>(UNITS * UNIT_GAMES),
+				static_cast<unsigned long long>(totals.games), L"every unit should be merged once");
+		}
+
+		// A worker dropping out mid run - its units go to the other worker, the totals are unchanged
+		//   the failing worker connects first, so it is sure to be handed units before the run ends
+		TEST_METHOD(LostWorkerUnitsReassigned) {
+			const char* path = "ShardTest.sock";
+			ShardTotals expected = runWorkers(path, { -1 }, nullptr);
+			ShardCoordinator::Report report;
+			ShardTotals totals = runWorkers(path, { 1, -1 }, &report);
+			Assert::IsTrue(totals == expected, L"lost units should be played by the other worker");
+			Assert::AreEqual(1, report.workersLost, L"the failing worker should be lost");
+			Assert::IsTrue(report.reassigned >= 1, L"the abandoned unit should be handed out again");
+		}
+
+		// No worker to hand the units to gives up after the timeout, a run without units is rejected
+		TEST_METHOD(NoWorkersTimesOut) {
+			const char* path = "ShardTest.sock";
+			try {
+				ShardCoordinator coordinator(path, 1, 1, 10, std::chrono::milliseconds(200));
+				coordinator.run();
+				Assert::Fail(L"Expected std::runtime_error not thrown");
+			}
+			catch (const std::runtime_error& ex) { Logger::WriteMessage(ex.what()); }
+
+			try {
+				ShardCoordinator coordinator(path, 1, 0, 10);
+				Assert::Fail(L"Expected std::invalid_argument not thrown");
+			}
+			catch (const std::invalid_argument& ex) { Logger::WriteMessage(ex.what()); }
+			std::remove(path);
+		}
+
+	private:
+		static constexpr uint32_t UNITS = 12;
+		static constexpr uint32_t UNIT_GAMES = 1000;
+
+		// a run with a worker thread per entry (its failAfter, -1 never fails), connected in order before the run
+		static ShardTotals runWorkers(const char* path, const std::vector<int>& failAfter,
+			ShardCoordinator::Report* report) {
+			std::remove(path);
+			ShardCoordinator coordinator(path, 7, UNITS, UNIT_GAMES);
+			std::vector<std::unique_ptr<ShardWorker>> workers;
+			std::vector<std::thread> threads;
+			for (size_t worker = 0; worker < failAfter.size(); worker++)
+				workers.emplace_back(new ShardWorker(path));
+			for (size_t worker = 0; worker < failAfter.size(); worker++)
+				threads.emplace_back(&ShardWorker::run, workers[worker].get(), failAfter[worker]);
+			ShardCoordinator::Report result = coordinator.run();
+			for (std::thread& thread : threads)
+				thread.join();
+			if (report != nullptr)
+				*report = result;
+			return result.totals;
+		}
+	};
+}
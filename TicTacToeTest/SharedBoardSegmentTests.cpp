@@ -0,0 +1,127 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include "../TicTacToe_TestPracticum/TicTacToeBoard.h"
+#include "../TicTacToe_TestPracticum/SharedBoardSegment.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace TicTacToeTest
+{
+	TEST_CLASS(TicTacToeSharedBoardSegmentTests)
+	{
+	public:
+
+		TEST_CLASS_INITIALIZE(_Setup_SharedBoardSegmentTest)
+		{
+			// this method is run once for the class - each test uses its own segment name, removed by the test
+			Logger::WriteMessage("Shared board segment test class initialized\n");
+		}
+
+		// A board published by the creator reads back the same through an attached viewer
+		TEST_METHOD(CreateAttachRoundTrip) {
+			SharedBoardSegment publisher("ttt_segment_round_trip", SharedBoardSegment::CREATE, 3);
+			SharedBoardSegment viewer("ttt_segment_round_trip", SharedBoardSegment::ATTACH);
+			Assert::AreEqual(3, viewer.getGameCount(), L"viewer should see the publisher's # of games");
+
+			TicTacToeBoard board;
+			board.writeSquare(0, 1, TicTacToeBoard::X);
+			board.nextPlayer();
+			board.writeSquare(2, 2, TicTacToeBoard::O);
+			publisher.publish(2, board, 70000);
+
+			TicTacToeBoard::Snapshot snapshot;
+			unsigned gameNumber = 0;
+			Assert::IsTrue(viewer.read(2, snapshot, gameNumber), L"no write in progress, read should succeed");
+			TicTacToeBoard::Snapshot expected = board.getSnapshot();
+			Assert::AreEqual(static_cast<int>(expected.xSquares), static_cast<int>(snapshot.xSquares));
+			Assert::AreEqual(static_cast<int>(expected.oSquares), static_cast<int>(snapshot.oSquares));
+			Assert::AreEqual(static_cast<int>(expected.player), static_cast<int>(snapshot.player));
+			Assert::AreEqual(static_cast<int>(expected.takenSquareCount), static_cast<int>(snapshot.takenSquareCount));
+			Assert::AreEqual(70000u, gameNumber, L"the game # is kept in full");
+
+			Assert::IsTrue(viewer.read(0, snapshot, gameNumber), L"unpublished slot reads as an empty board");
+			Assert::AreEqual(0, static_cast<int>(snapshot.takenSquareCount));
+			Assert::AreEqual(0u, gameNumber);
+
+			try {
+				viewer.read(3, snapshot, gameNumber);
+				Assert::Fail(L"Expected std::invalid_argument not thrown");
+			}
+			catch (const std::invalid_argument& ex) { Logger::WriteMessage(ex.what()); }
+		}
+
+		// Attaching needs a segment with board slots, creating needs a name nobody is using
+		TEST_METHOD(AttachAndCreateRejected) {
+			expectRuntimeError("ttt_segment_missing", SharedBoardSegment::ATTACH);
+			{
+				RawSegment tooSmall("ttt_segment_small", 4);
+				expectRuntimeError("ttt_segment_small", SharedBoardSegment::ATTACH);
+			}
+			{
+				RawSegment foreign("ttt_segment_foreign", 4096);      // zero filled, no magic
+				expectRuntimeError("ttt_segment_foreign", SharedBoardSegment::ATTACH);
+			}
+			{
+				SharedBoardSegment publisher("ttt_segment_in_use", SharedBoardSegment::CREATE, 2);
+				expectRuntimeError("ttt_segment_in_use", SharedBoardSegment::CREATE);
+				SharedBoardSegment viewer("ttt_segment_in_use", SharedBoardSegment::ATTACH);
+				Assert::AreEqual(2, viewer.getGameCount(), L"a rejected publisher leaves the segment as it was");
+			}
+			expectRuntimeError("ttt_segment_in_use", SharedBoardSegment::ATTACH);   // name removed with its creator
+		}
+
+	private:
+		static void expectRuntimeError(const char* name, SharedBoardSegment::Mode mode) {
+			try {
+				SharedBoardSegment segment(name, mode, 1);
+				Assert::Fail(L"Expected std::runtime_error not thrown");
+			}
+			catch (const std::runtime_error& ex) { Logger::WriteMessage(ex.what()); }
+		}
+
+		// shared memory of the given size that isn't a board segment, removed when it goes out of scope
+		//   (on Windows the size is rounded up to a page, so only the foreign layout is rejected)
+		class RawSegment {
+		public:
+			RawSegment(const std::string& name, size_t bytes) : name(name) {
+#ifdef _WIN32
+				handle = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, static_cast<DWORD>(bytes),
+					("Local\\" + name).c_str());
+#else
+				int fd = shm_open(("/" + name).c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+				if (fd >= 0) {
+					if (ftruncate(fd, static_cast<off_t>(bytes)) != 0)
+						Logger::WriteMessage("Unable to size the raw segment\n");
+					close(fd);
+				}
+#endif
+			}
+			~RawSegment() {
+#ifdef _WIN32
+				if (handle != nullptr)
+					CloseHandle(handle);
+#else
+				shm_unlink(("/" + name).c_str());
+#endif
+			}
+		private:
+			std::string name;
+#ifdef _WIN32
+			HANDLE handle;
+#endif
+		};
+	};
+}
@@ -0,0 +1,86 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <sstream>
+#include <string>
+#include "../TicTacToe_TestPracticum/TicTacToeBoard.h"
+#include "../TicTacToe_TestPracticum/SpectatorDashboard.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace TicTacToeTest
+{
+	TEST_CLASS(TicTacToeSpectatorDashboardTests)
+	{
+	public:
+
+		TEST_CLASS_INITIALIZE(_Setup_SpectatorDashboardTest)
+		{
+			// this method is run once for the class - frames are rendered to a string stream, nothing goes to the console
+			Logger::WriteMessage("Spectator dashboard test class initialized\n");
+		}
+
+		// A published board reads back as published, the games started total doesn't wrap with the packed game #
+		TEST_METHOD(PublishAndRead) {
+			SpectatorDashboard dashboard(2);
+			TicTacToeBoard board;
+			board.writeSquare(0, 0, TicTacToeBoard::X);
+			board.nextPlayer();
+			board.writeSquare(2, 1, TicTacToeBoard::O);
+			dashboard.publish(1, board, 70000);
+
+			unsigned gameNumber = 0;
+			TicTacToeBoard::Snapshot snapshot = dashboard.readSnapshot(1, gameNumber);
+			TicTacToeBoard::Snapshot expected = board.getSnapshot();
+			Assert::AreEqual(static_cast<int>(expected.xSquares), static_cast<int>(snapshot.xSquares));
+			Assert::AreEqual(static_cast<int>(expected.oSquares), static_cast<int>(snapshot.oSquares));
+			Assert::AreEqual(static_cast<int>(expected.player), static_cast<int>(snapshot.player));
+			Assert::AreEqual(static_cast<int>(expected.takenSquareCount), static_cast<int>(snapshot.takenSquareCount));
+			Assert::AreEqual(70000u & 0xFFFF, gameNumber, L"the slot keeps the low 16 bits of the game #");
+
+			dashboard.readSnapshot(0, gameNumber);
+			Assert::AreEqual(0u, gameNumber, L"an unpublished slot is game 0");
+			dashboard.publish(0, board, 70001);
+			dashboard.publish(0, board, 70001);       // same game, not counted again
+			Assert::AreEqual(140001ull, static_cast<unsigned long long>(dashboard.getGamesStarted()),
+				L"games started should be the full game #s");
+		}
+
+		// First frame is a full redraw, later frames repaint only changed cells, invalidate() redraws everything
+		TEST_METHOD(RenderRepaintsChanges) {
+			SpectatorDashboard dashboard(3);
+			TicTacToeBoard board;
+			board.writeSquare(1, 1, TicTacToeBoard::X);
+			board.nextPlayer();
+			dashboard.publish(2, board, 3);
+
+			std::ostringstream first;
+			dashboard.renderFrame(first);
+			Assert::IsTrue(first.str().find(CLEAR_SCREEN) != std::string::npos, L"first frame clears the screen");
+			Assert::IsTrue(first.str().find("games started: 3") != std::string::npos, L"header shows the games started");
+			Assert::IsTrue(first.str().find("#3    O") != std::string::npos, L"tile title shows the game & player");
+			Assert::IsTrue(first.str().find("   | X |  ") != std::string::npos, L"tile shows the board");
+
+			std::ostringstream unchanged;
+			dashboard.renderFrame(unchanged);
+			Assert::IsTrue(unchanged.str().find(" X ") == std::string::npos, L"nothing on the boards changed");
+
+			board.writeSquare(0, 2, TicTacToeBoard::O);
+			dashboard.publish(2, board, 3);
+			std::ostringstream changed;
+			dashboard.renderFrame(changed);
+			Assert::IsTrue(changed.str().find(CLEAR_SCREEN) == std::string::npos, L"a move isn't a full redraw");
+			Assert::IsTrue(changed.str().find('O') != std::string::npos, L"the move should be painted");
+			Assert::IsTrue(changed.str().find('X') == std::string::npos, L"unchanged cells should be left alone");
+			Assert::IsTrue(changed.str().size() < first.str().size() / 4, L"only the changes should be written");
+
+			dashboard.invalidate();
+			std::ostringstream redraw;
+			dashboard.renderFrame(redraw);
+			Assert::IsTrue(redraw.str().find(CLEAR_SCREEN) != std::string::npos, L"invalidate() forces a full redraw");
+			Assert::IsTrue(redraw.str().find("   | X |  ") != std::string::npos, L"full redraw shows every board");
+		}
+
+	private:
+		static constexpr const char* CLEAR_SCREEN = "\x1b[H\x1b[2J";
+	};
+}
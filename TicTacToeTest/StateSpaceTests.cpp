@@ -0,0 +1,82 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <iostream>
+#include "../TicTacToe_TestPracticum/TicTacToeBoard.h"
+#include "../TicTacToe_TestPracticum/MnkBoard.h"
+#include "../TicTacToe_TestPracticum/StateSpaceEnumerator.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace TicTacToeTest
+{
+	TEST_CLASS(TicTacToeStateSpaceTests)
+	{
+	public:
+
+		TEST_CLASS_INITIALIZE(_Setup_StateSpaceTest)
+		{
+			// this method is run once for the class - nothing to initialize, each test builds its own boards
+			Logger::WriteMessage("State space test class initialized\n");
+		}
+
+		// MnkBoard 3x3/k=3 should generate exactly the 8 winPatterns & agree with TicTacToeBoard on a simple win
+		//   scenario:   X  O  -
+		//               X  O  -
+		//               X  -  -
+		TEST_METHOD(MnkBoardMatchesStandardBoard) {
+			Logger::WriteMessage("Comparing MnkBoard 3x3 with TicTacToeBoard\n");
+			MnkBoard mnk(3, 3, 3);
+			TicTacToeBoard board;
+			Assert::AreEqual(8, static_cast<int>(mnk.getLines().size()), L"3x3 board should have 8 winning lines");
+
+			const int moves[5][2] = { { 0, 0 }, { 0, 1 }, { 1, 0 }, { 1, 1 }, { 2, 0 } };
+			for (const auto& move : moves) {
+				board.writeSquare(move[0], move[1], board.getPlayer());
+				board.nextPlayer();
+				Assert::IsTrue(mnk.play(mnk.rowColToPosition(move[0], move[1])));
+			}
+			Assert::IsTrue(board.isWinner(TicTacToeBoard::X), L"X should have won the first column");
+			Assert::IsTrue(mnk.isWinner(TicTacToeBoard::X), L"MnkBoard should agree X won");
+			Assert::IsTrue(mnk.isWinningMove(mnk.rowColToPosition(2, 0)), L"last move should be the winning move");
+			Assert::IsFalse(mnk.isWinner(TicTacToeBoard::O), L"O should not have won");
+
+			// copy of the board should be the same position
+			MnkBoard copy = MnkBoard::fromBoard(board);
+			Assert::IsTrue(copy.getSquares(TicTacToeBoard::X) == mnk.getSquares(TicTacToeBoard::X));
+			Assert::IsTrue(copy.getSquares(TicTacToeBoard::O) == mnk.getSquares(TicTacToeBoard::O));
+			Assert::IsTrue(copy.getPositionIndex() == mnk.getPositionIndex());
+		}
+
+		// play() refuses an occupied square (as writeSquare does), undo() restores the position
+		TEST_METHOD(MnkBoardPlayAndUndo) {
+			MnkBoard mnk(4, 4, 3);
+			uint64_t emptyIndex = mnk.getPositionIndex();
+			Assert::IsTrue(mnk.play(5));
+			Assert::IsFalse(mnk.play(5), L"square already taken, play() should return false");
+			Assert::AreEqual(static_cast<int>(TicTacToeBoard::O), static_cast<int>(mnk.getPlayer()));
+			mnk.undo(5);
+			Assert::IsTrue(mnk.getPositionIndex() == emptyIndex, L"undo should restore the position index");
+			Assert::AreEqual(0, mnk.getPly());
+			try {
+				mnk.play(16);
+				Assert::Fail(L"Expected std::invalid_argument not thrown");
+			}
+			catch (const std::invalid_argument& ex) { Logger::WriteMessage(ex.what()); }
+			catch (...) { Assert::Fail(L"Unexpected exception type thrown"); }
+		}
+
+		// every reachable 3x3 position, all win check implementations must agree
+		//   known counts: 5478 positions, 626 X wins, 316 O wins, 16 draws
+		TEST_METHOD(EnumerateStandardBoard) {
+			Logger::WriteMessage("Enumerating all reachable 3x3 positions\n");
+			StateSpaceEnumerator enumerator(3, 3, 3, 2);
+			StateSpaceEnumerator::Result result = enumerator.run();
+			Logger::WriteMessage(result.firstMismatch.c_str());
+			Assert::IsTrue(result.mismatches == 0, L"win check implementations disagree");
+			Assert::IsTrue(result.positions == 5478, L"expected 5478 reachable positions");
+			Assert::IsTrue(result.xWins == 626, L"expected 626 positions won by X");
+			Assert::IsTrue(result.oWins == 316, L"expected 316 positions won by O");
+			Assert::IsTrue(result.draws == 16, L"expected 16 drawn positions");
+		}
+	};
+}
@@ -0,0 +1,93 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "../TicTacToe_TestPracticum/TicTacToeBoard.h"
+#include "../TicTacToe_TestPracticum/TerminalRenderer.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace TicTacToeTest
+{
+	TEST_CLASS(TicTacToeTerminalRendererTests)
+	{
+	public:
+
+		TEST_CLASS_INITIALIZE(_Setup_TerminalRendererTest)
+		{
+			// this method is run once for the class - frames written to std::cout are captured in a string stream
+			Logger::WriteMessage("Terminal renderer test class initialized\n");
+		}
+
+		// Only the squares changed since the last frame are repainted
+		TEST_METHOD(RepaintsChangedSquares) {
+			CapturedOutput frames;
+			TerminalRenderer renderer;
+			TicTacToeBoard board;
+			Assert::IsTrue(renderer.renderBoard(board) > 0, L"first frame is a full redraw");
+
+			frames.clear();
+			board.writeSquare(1, 2, TicTacToeBoard::X);
+			renderer.renderBoard(board);
+			Assert::IsTrue(frames.contains(moveTo(1, 2) + "X"), L"the new square should be painted");
+			Assert::IsFalse(frames.contains(moveTo(0, 0)), L"unchanged squares should be left alone");
+		}
+
+		// Game over - the final position stays on screen after the board is reset, until the next game's first move
+		TEST_METHOD(HeldBoardKeptUntilNextMove) {
+			CapturedOutput frames;
+			TerminalRenderer renderer;
+			TicTacToeBoard board;
+			renderer.renderBoard(board);
+			for (int col = 0; col < TicTacToeBoard::BOARD_NUM_COLS; col++)
+				board.writeSquare(0, col, TicTacToeBoard::X);
+			board.writeSquare(1, 1, TicTacToeBoard::O);
+			renderer.renderBoard(board);
+			renderer.renderStatus("Player X wins");
+
+			// as someoneWins() - hold, reset, then the game loop draws the (empty) board again
+			renderer.holdBoard();
+			board.resetBoard();
+			frames.clear();
+			renderer.renderBoard(board);
+			renderer.renderBoard(board);
+			Assert::IsFalse(frames.contains(moveTo(0, 0)), L"held squares should not be erased");
+			Assert::IsFalse(frames.contains(moveTo(1, 1)), L"held squares should not be erased");
+
+			// first move of the next game - the old squares are cleared & the move drawn
+			board.writeSquare(2, 2, TicTacToeBoard::X);
+			renderer.renderBoard(board);
+			Assert::IsTrue(frames.contains(moveTo(0, 0) + " "), L"old squares should be cleared");
+			Assert::IsTrue(frames.contains(moveTo(1, 1) + " "), L"old squares should be cleared");
+			Assert::IsTrue(frames.contains(moveTo(2, 2) + "X"), L"the move should be painted");
+
+			// not held - an empty board repaints straight away
+			board.resetBoard();
+			frames.clear();
+			renderer.renderBoard(board);
+			Assert::IsTrue(frames.contains(moveTo(2, 2) + " "), L"reset board should be repainted");
+		}
+
+	private:
+		// std::cout goes to a string stream while in scope
+		class CapturedOutput {
+		public:
+			CapturedOutput() : saved(std::cout.rdbuf(text.rdbuf())) {}
+			~CapturedOutput() { std::cout.rdbuf(saved); }
+			void clear() { text.str(""); }
+			bool contains(const std::string& sequence) const { return text.str().find(sequence) != std::string::npos; }
+		private:
+			std::ostringstream text;
+			std::streambuf* saved;
+		};
+
+		// cursor position sequence ESC[row;colH for a square
+		static std::string moveTo(int row, int col) {
+			char sequence[24];
+			snprintf(sequence, sizeof(sequence), "\x1b[%d;%dH", TerminalRenderer::cellRow(row), TerminalRenderer::cellCol(col));
+			return sequence;
+		}
+	};
+}
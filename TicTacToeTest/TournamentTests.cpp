@@ -0,0 +1,99 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+#include "../TicTacToe_TestPracticum/Tournament.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace TicTacToeTest
+{
+	TEST_CLASS(TicTacToeTournamentTests)
+	{
+	public:
+
+		TEST_CLASS_INITIALIZE(_Setup_TournamentTest)
+		{
+			// this method is run once for the class - nothing to initialize, each test builds its own tournament
+			Logger::WriteMessage("Tournament test class initialized\n");
+		}
+
+		// Player specs, schedules & the Elo scale
+		TEST_METHOD(PlayersAndSchedules) {
+			std::vector<Tournament::Player> players;
+			const char* specs[] = { "perfect", "mcts:50", "script:402681357", "random" };
+			for (const char* spec : specs)
+				players.push_back(Tournament::parsePlayer(spec));
+			Assert::IsTrue(players[1].kind == Tournament::MCTS, L"mcts spec should parse");
+			Assert::AreEqual(50, players[1].playouts);
+			Assert::AreEqual(static_cast<size_t>(9), players[2].script.size());
+
+			Assert::AreEqual(static_cast<size_t>(6),
+				Tournament(players, Tournament::ROUND_ROBIN, 1).run(0, 1).pairings.size(), L"every pair");
+			Assert::AreEqual(static_cast<size_t>(3),
+				Tournament(players, Tournament::GAUNTLET, 1).run(0, 1).pairings.size(), L"first against the others");
+
+			Assert::AreEqual(0.0, Tournament::eloFromScore(0.5), 1e-9, L"an even score is no difference");
+			Assert::AreEqual(190.85, Tournament::eloFromScore(0.75), 0.01);
+
+			const char* badSpecs[] = { "alphazero", "mcts:", "mcts:0", "script:9" };
+			for (const char* spec : badSpecs) {
+				try {
+					Tournament::parsePlayer(spec);
+					Assert::Fail(L"Expected std::invalid_argument not thrown");
+				}
+				catch (const std::invalid_argument& ex) { Logger::WriteMessage(ex.what()); }
+			}
+			try {
+				Tournament(std::vector<Tournament::Player>(1, players[0]), Tournament::ROUND_ROBIN, 1);
+				Assert::Fail(L"Expected std::invalid_argument not thrown");
+			}
+			catch (const std::invalid_argument& ex) { Logger::WriteMessage(ex.what()); }
+		}
+
+		// The perfect player never loses, draws itself every game, & results don't depend on the # of threads
+		TEST_METHOD(PerfectPlayerNeverLoses) {
+			std::vector<Tournament::Player> players = { Tournament::parsePlayer("perfect"),
+				Tournament::parsePlayer("perfect"), Tournament::parsePlayer("random") };
+			Tournament::Result result = Tournament(players, Tournament::ROUND_ROBIN, 4).run(200, 7);
+			Assert::AreEqual(600, result.games);
+			Assert::AreEqual(200, result.pairings[0].rating.draws, L"perfect against perfect should always draw");
+			Assert::AreEqual(0, result.pairings[1].rating.losses, L"perfect shouldn't lose to random");
+			Assert::AreEqual(0, result.pairings[2].rating.losses, L"perfect shouldn't lose to random");
+			Assert::IsTrue(result.pairings[1].rating.eloLow > 0, L"perfect should be rated above random");
+
+			Tournament::Result serial = Tournament(players, Tournament::ROUND_ROBIN, 1).run(200, 7);
+			Assert::AreEqual(result.pairings[1].rating.wins, serial.pairings[1].rating.wins,
+				L"same seed, same games whatever the # of threads");
+		}
+
+		// A clean sweep (no score variance) still gets an interval below its Elo
+		TEST_METHOD(CleanSweepInterval) {
+			std::vector<Tournament::Player> players = { Tournament::parsePlayer("perfect"),
+				Tournament::parsePlayer("script:012345678") };
+			Tournament::Rating rating = Tournament(players, Tournament::ROUND_ROBIN, 1).run(20, 1).pairings[0].rating;
+			Assert::AreEqual(20, rating.wins, L"perfect should win every game against the first empty square");
+			Assert::IsTrue(rating.eloLow < rating.elo, L"a clean sweep should have an interval of some width");
+			Assert::IsTrue(rating.eloLow > 0, L"20 wins should be rated above an even score");
+			Assert::IsTrue(rating.eloHigh >= rating.elo);
+		}
+
+		// SPRT stops a clear pairing long before its games are used up, & accepts the right hypothesis
+		TEST_METHOD(SprtStopsEarly) {
+			std::vector<Tournament::Player> players = { Tournament::parsePlayer("perfect"),
+				Tournament::parsePlayer("random"), Tournament::parsePlayer("perfect") };
+			Tournament tournament(players, Tournament::GAUNTLET, 2);
+			tournament.enableSprt(0, 20, 0.05, 0.05);
+			Tournament::Result result = tournament.run(10000, 3);
+			Assert::IsTrue(result.pairings[0].sprt == Tournament::ACCEPT_H1, L"perfect is clearly stronger than random");
+			Assert::IsTrue(result.pairings[1].sprt == Tournament::ACCEPT_H0, L"perfect isn't stronger than itself");
+			Assert::IsTrue(result.games < 2000, L"SPRT should stop both pairings early");
+			try {
+				tournament.enableSprt(20, 0, 0.05, 0.05);
+				Assert::Fail(L"Expected std::invalid_argument not thrown");
+			}
+			catch (const std::invalid_argument& ex) { Logger::WriteMessage(ex.what()); }
+		}
+	};
+}
@@ -0,0 +1,65 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <chrono>
+#include "../TicTacToe_TestPracticum/UltimateBoard.h"
+#include "../TicTacToe_TestPracticum/UltimateMcts.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace TicTacToeTest
+{
+	TEST_CLASS(TicTacToeUltimateTests)
+	{
+	public:
+
+		TEST_CLASS_INITIALIZE(_Setup_UltimateTest)
+		{
+			// this method is run once for the class - nothing to initialize, each test builds its own boards
+			Logger::WriteMessage("Ultimate test class initialized\n");
+		}
+
+		// the cell played sends the opponent to that sub-board, any sub-board if it is closed
+		TEST_METHOD(SendToBoardRule) {
+			UltimateBoard board;
+			uint8_t moves[UltimateBoard::MAX_MOVES];
+			Assert::AreEqual(81, board.getLegalMoves(moves), L"first move can be anywhere");
+			Assert::IsTrue(board.play(4 * 9 + 2), L"X plays centre board, top right cell");
+			Assert::AreEqual(2, board.getNextBoard(), L"O should be sent to the top right board");
+			Assert::AreEqual(9, board.getLegalMoves(moves));
+			Assert::IsFalse(board.play(4 * 9 + 0), L"O may not play outside the top right board");
+			Assert::IsTrue(board.play(2 * 9 + 4));
+			Assert::IsFalse(board.play(4 * 9 + 2), L"cell already taken");
+			Assert::IsFalse(board.play(81), L"move off the board");
+		}
+
+		// O wins sub-board 0 with its middle row, the meta board records it & sub-board 0 is closed
+		//   X's moves are all cell 0 of another board, sending O back to board 0 each time
+		TEST_METHOD(SubBoardWinUpdatesMetaBoard) {
+			UltimateBoard board;
+			uint8_t moves[UltimateBoard::MAX_MOVES];
+			const int script[6] = { 1 * 9 + 0, 0 * 9 + 3, 3 * 9 + 0, 0 * 9 + 4, 4 * 9 + 0, 0 * 9 + 5 };
+			for (int move : script)
+				Assert::IsTrue(board.play(move), L"scripted move should be legal");
+			Assert::AreEqual(1, static_cast<int>(board.getWonBoards(TicTacToeBoard::O)), L"O should have won board 0");
+			Assert::AreEqual(1, static_cast<int>(board.getClosedBoards()), L"only board 0 should be closed");
+			Assert::AreEqual(5, board.getNextBoard(), L"X should be sent to board 5");
+
+			Assert::IsTrue(board.play(5 * 9 + 0), L"X sends O to board 0, which is closed");
+			Assert::AreEqual(static_cast<int>(UltimateBoard::ANY_BOARD), board.getNextBoard());
+			Assert::AreEqual(81 - 9 - 4, board.getLegalMoves(moves), L"any open cell outside board 0");
+			Assert::IsTrue(board.getResult() == UltimateBoard::IN_PROGRESS);
+		}
+
+		// Random playouts always end, & the engine returns a legal move within its iteration limit
+		TEST_METHOD(EngineReturnsLegalMove) {
+			UltimateMcts engine(1 << 14, 12345);
+			UltimateBoard board;
+			for (int game = 0; game < 100; game++)
+				Assert::IsTrue(engine.playout(board) != UltimateBoard::IN_PROGRESS, L"playout should finish the game");
+			UltimateMcts::Result result = engine.search(board, std::chrono::seconds(10), 2000);
+			Assert::IsTrue(result.iterations == 2000, L"iteration limit should stop the search");
+			Assert::IsTrue(result.nodes <= (1 << 14), L"tree should stay within the pool");
+			Assert::IsTrue(board.play(result.bestMove), L"best move should be legal");
+		}
+	};
+}
@@ -0,0 +1,115 @@
+// AllocationCounter.cpp
+//   Counting replacements for the global operator new & delete, per thread counters & scoped guards
+//   <blank line>
+
+#include <cstdlib>
+#include "AllocationCounter.h"
+
+/*
+ * Per thread state (thread_local, plain data so it needs no construction - operator new may be called first)
+ *   allocations, bytes - calls to operator new & bytes requested, since the thread started
+ *   failFast - set while a FAIL_FAST guard is alive, operator new throws instead of allocating
+ */
+
+namespace {
+	struct ThreadCounts {
+		uint64_t allocations;
+		uint64_t bytes;
+		bool failFast;
+	};
+
+	thread_local ThreadCounts counts = { 0, 0, false };
+
+	// count the allocation, then malloc - nullptr if out of memory, or if a FAIL_FAST guard is alive (failFast set)
+	void* countedAllocate(size_t size, bool& failFast) {
+		failFast = counts.failFast;
+		if (failFast)
+			return nullptr;
+		counts.allocations++;
+		counts.bytes += size;
+		return std::malloc((size == 0) ? 1 : size);
+	}
+
+	void* allocateOrThrow(size_t size) {
+		bool failFast;
+		void* memory = countedAllocate(size, failFast);
+		if (failFast)
+			throw AllocationGuard::Violation();
+		if (memory == nullptr)
+			throw std::bad_alloc();
+		return memory;
+	}
+}
+
+uint64_t AllocationCounter::getAllocations() {
+	return counts.allocations;
+}
+
+uint64_t AllocationCounter::getBytes() {
+	return counts.bytes;
+}
+
+const char* AllocationGuard::Violation::what() const noexcept {
+	return "Heap allocation inside an AllocationGuard (FAIL_FAST)\n";
+}
+
+AllocationGuard::AllocationGuard(Mode mode)
+	: startAllocations(counts.allocations), startBytes(counts.bytes), previousFailFast(counts.failFast) {
+	counts.failFast = (mode == FAIL_FAST);
+}
+
+AllocationGuard::~AllocationGuard() {
+	counts.failFast = previousFailFast;
+}
+
+uint64_t AllocationGuard::getAllocations() const {
+	return counts.allocations - startAllocations;
+}
+
+uint64_t AllocationGuard::getBytes() const {
+	return counts.bytes - startBytes;
+}
+
+//                                     ***  global operator new & delete replacements ***
+
+void* operator new(size_t size) {
+	return allocateOrThrow(size);
+}
+
+void* operator new[](size_t size) {
+	return allocateOrThrow(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+	bool failFast;
+	return countedAllocate(size, failFast);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+	bool failFast;
+	return countedAllocate(size, failFast);
+}
+
+void operator delete(void* memory) noexcept {
+	std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+	std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+	std::free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept {
+	std::free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept {
+	std::free(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept {
+	std::free(memory);
+}
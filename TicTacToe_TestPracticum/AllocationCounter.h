@@ -0,0 +1,60 @@
+#pragma once
+/*****************************************************************//**
+ * \file   AllocationCounter.h
+ * \brief  heap allocation instrumentation - AllocationCounter, AllocationGuard
+ *     Scope - counts the heap allocations made by each thread, so tests can prove hot paths (writeSquare(),
+ *        isWinner(), whole simulated games ...) don't allocate, & fail fast when an allocation creeps back in
+ *
+ * \date   updated: October 2026
+ *
+ * Implementation notes:
+ *     - AllocationCounter.cpp replaces the global operator new & delete (all forms: array, nothrow, sized) with
+ *          versions that count, then call malloc / free - the counters are thread_local, so allocations made by
+ *          other threads (test framework, worker threads) never show up in this thread's counts
+ *     - linked into the unit tests only, the game itself keeps the standard allocator - link AllocationCounter.cpp
+ *          into another program to diagnose it
+ *     - AllocationGuard is scoped: the allocations & bytes counted since it was constructed, on this thread
+ *     - FAIL_FAST mode: while the guard is alive any allocation on this thread throws AllocationGuard::Violation
+ *          (a std::bad_alloc) from operator new, at the allocation, so the failing call is in the stack - guards
+ *          nest, the outer mode is restored when the inner guard goes
+ *     - only operator new is seen, not malloc called directly, nor the memory the runtime takes for exceptions
+ *
+ * static uint64_t getAllocations(), getBytes()  - this thread's totals since it started
+ * AllocationGuard(mode)                         - COUNT (default) or FAIL_FAST, see notes
+ * uint64_t getAllocations(), getBytes()          - counted since the guard was constructed
+ **/
+
+#include <cstdint>
+#include <new>
+
+class AllocationCounter
+{
+public:
+	static uint64_t getAllocations();             // calls to operator new by this thread
+	static uint64_t getBytes();                   // bytes requested by those calls
+};
+
+class AllocationGuard
+{
+public:
+	enum Mode { COUNT, FAIL_FAST };
+
+	// thrown by operator new while a FAIL_FAST guard is alive
+	class Violation : public std::bad_alloc {
+	public:
+		const char* what() const noexcept override;
+	};
+
+	AllocationGuard(Mode mode = COUNT);
+	~AllocationGuard();
+	AllocationGuard(const AllocationGuard&) = delete;
+	AllocationGuard& operator=(const AllocationGuard&) = delete;
+
+	uint64_t getAllocations() const;
+	uint64_t getBytes() const;
+
+private:
+	uint64_t startAllocations;
+	uint64_t startBytes;
+	bool previousFailFast;                        // restored by the destructor
+};
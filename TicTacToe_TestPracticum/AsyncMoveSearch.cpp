@@ -0,0 +1,91 @@
+// AsyncMoveSearch.cpp
+//   Engine move requests served by a worker thread, results delivered through std::future
+//   <blank line>
+
+#include <algorithm>
+#include "AsyncMoveSearch.h"
+
+/*
+ * Instance variables (declared in header file)
+ *   engine - search state, only touched by the worker thread
+ *   cache - results of earlier searches (thread-safe, may be shared), nullptr if not used
+ *   minCachedDepth - a cached result that isn't exact is used if searched at least this deep (or maxDepth)
+ *   requests - queued positions with their deadlines & promises, guarded by requestLock
+ *   requestReady - signalled when a request is queued or the object is shutting down
+ *   cancelled - set by cancel(), stops the running search, cleared before each new request is started
+ *   shuttingDown - set by the destructor, the worker cancels what is left & exits
+ *   worker - the thread running runWorker()
+ */
+
+// Constructor - starts the worker thread (declared last, so everything it uses is initialized first)
+AsyncMoveSearch::AsyncMoveSearch(std::shared_ptr<MoveCache> cache, int minCachedDepth)
+	: cache(std::move(cache)), minCachedDepth(minCachedDepth), cancelled(false),
+	worker(&AsyncMoveSearch::runWorker, this) {
+}
+
+// Destructor - outstanding requests are cancelled (their futures still get a move), then the worker is joined
+AsyncMoveSearch::~AsyncMoveSearch() {
+	{
+		std::lock_guard<std::mutex> guard(requestLock);
+		shuttingDown = true;
+	}
+	cancelled.store(true);
+	requestReady.notify_one();
+	worker.join();
+}
+
+// Queue a search of the position, the future is ready no later than budget from now (plus one poll interval)
+//   throws invalid_argument (from the future's get()) if the game is already over
+std::future<SearchEngine::Result> AsyncMoveSearch::requestMove(const MnkBoard& board, std::chrono::milliseconds budget,
+	int maxDepth) {
+	Request request = { board, std::chrono::steady_clock::now() + budget, maxDepth, std::promise<SearchEngine::Result>() };
+	std::future<SearchEngine::Result> result = request.promise.get_future();
+	{
+		std::lock_guard<std::mutex> guard(requestLock);
+		requests.push_back(std::move(request));
+	}
+	requestReady.notify_one();
+	return result;
+}
+
+// Stop the running search & the queued ones - each returns the best move found so far (or the first legal move)
+void AsyncMoveSearch::cancel() {
+	std::lock_guard<std::mutex> guard(requestLock);
+	for (Request& request : requests)
+		request.deadline = std::chrono::steady_clock::now();
+	cancelled.store(true);
+}
+
+//                                     ***  AsyncMoveSearch helper functions ***
+
+// Worker thread - takes requests in order until shutdown, any exception is passed on through the future
+//   a position with a good enough cached result (see the header notes) is answered from the cache
+void AsyncMoveSearch::runWorker() {
+	while (true) {
+		std::unique_lock<std::mutex> guard(requestLock);
+		requestReady.wait(guard, [this] { return shuttingDown || !requests.empty(); });
+		if (requests.empty())
+			return;                           // shutting down & nothing left to answer
+		Request request = std::move(requests.front());
+		requests.pop_front();
+		if (!shuttingDown)
+			cancelled.store(false);           // a cancel() only applies to searches queued before it
+		guard.unlock();
+
+		try {
+			SearchEngine::Result result;
+			if (cache && cache->lookup(request.board, result) &&
+				(result.exact || (result.depth >= std::min(request.maxDepth, minCachedDepth)))) {
+				request.promise.set_value(result);
+				continue;
+			}
+			result = engine.search(request.board, request.deadline, cancelled, request.maxDepth);
+			if (cache)
+				cache->store(request.board, result);
+			request.promise.set_value(result);
+		}
+		catch (...) {
+			request.promise.set_exception(std::current_exception());
+		}
+	}
+}
@@ -0,0 +1,69 @@
+#pragma once
+/*****************************************************************//**
+ * \file   AsyncMoveSearch.h
+ * \brief  asynchronous engine moves - AsyncMoveSearch
+ *     Scope - runs SearchEngine on a worker thread so the caller (UI loop, opponent service) never blocks
+ *
+ * \date   updated: October 2026
+ *
+ * Implementation notes:
+ *     - future based (the project builds as C++14, no coroutines) - requestMove() queues the request & returns
+ *          a std::future, the caller polls it with wait_for() between redraws / input checks
+ *     - one worker thread, started by the constructor, serves the requests in order
+ *     - every request has its own deadline (now + time budget), the search stops there & the future receives
+ *          the best move found so far - latency is bounded by the budget whatever the board size
+ *     - cancel() stops the running search & any queued requests early, their futures still receive a move
+ *     - the destructor cancels outstanding requests & joins the worker
+ *     - optional MoveCache (may be shared with other searches): a request whose position is cached is answered
+ *          from the cache without a search if the cached result is exact, or was searched at least
+ *          min(maxDepth, minCachedDepth) deep - every completed search is stored in the cache
+ *
+ * AsyncMoveSearch(cache, minCachedDepth)          - cache defaults to none
+ * std::future<Result> requestMove(board, budget) - search the position for at most budget
+ * void cancel()                                   - stop the current & queued searches now
+ **/
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "MnkBoard.h"
+#include "MoveCache.h"
+#include "SearchEngine.h"
+
+class AsyncMoveSearch
+{
+public:
+	AsyncMoveSearch(std::shared_ptr<MoveCache> cache = nullptr, int minCachedDepth = SearchEngine::UNLIMITED_DEPTH);
+	~AsyncMoveSearch();
+	AsyncMoveSearch(const AsyncMoveSearch&) = delete;
+	AsyncMoveSearch& operator=(const AsyncMoveSearch&) = delete;
+
+	std::future<SearchEngine::Result> requestMove(const MnkBoard& board, std::chrono::milliseconds budget,
+		int maxDepth = SearchEngine::UNLIMITED_DEPTH);
+	void cancel();
+
+private:
+	struct Request {
+		MnkBoard board;
+		std::chrono::steady_clock::time_point deadline;
+		int maxDepth;
+		std::promise<SearchEngine::Result> promise;
+	};
+
+	SearchEngine engine;                  // only used by the worker thread
+	std::shared_ptr<MoveCache> cache;     // nullptr = no cache
+	int minCachedDepth;
+	std::deque<Request> requests;
+	std::mutex requestLock;               // guards requests & shuttingDown
+	std::condition_variable requestReady;
+	std::atomic<bool> cancelled;          // polled by the engine, cleared when the worker takes a new request
+	bool shuttingDown = false;
+	std::thread worker;
+
+	void runWorker();
+};
@@ -0,0 +1,46 @@
+#pragma once
+/*****************************************************************//**
+ * \file   BitHelpers.h
+ * \brief  bit board & hashing helpers shared by the boards, engines & solvers
+ *     Scope - square masks (MnkBoard, QubicBoard, GomokuBoard lanes), position hashes & seeds, turn order
+ *
+ * \date   updated: October 2026
+ *
+ * Implementation notes:
+ *     - plain loops rather than compiler intrinsics, the masks are sparse & the code has to build with MSVC & gcc
+ *     - mix() is the splitmix64 finalizer - hash of a position / seed of a unit, every caller relies on the same constants
+ *
+ * int bitCount(bits)                      - # of set bits
+ * int lowestBit(bits)                     - index of the lowest set bit (bits must not be 0)
+ * uint64_t mix(value)                     - splitmix64 finalizer
+ * Player opponentOf(player)               - the other player
+ **/
+
+#include <cstdint>
+#include "TicTacToeBoard.h"
+
+inline int bitCount(uint64_t bits) {
+	int count = 0;
+	for (; bits != 0; bits &= bits - 1)
+		count++;
+	return count;
+}
+
+inline int lowestBit(uint64_t bits) {
+	int position = 0;
+	while ((bits & 1) == 0) {
+		bits >>= 1;
+		position++;
+	}
+	return position;
+}
+
+inline uint64_t mix(uint64_t value) {
+	value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+	value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+	return value ^ (value >> 31);
+}
+
+inline TicTacToeBoard::Player opponentOf(TicTacToeBoard::Player player) {
+	return (player == TicTacToeBoard::X) ? TicTacToeBoard::O : TicTacToeBoard::X;
+}
@@ -0,0 +1,111 @@
+// CheckpointFile.cpp
+//   Crash consistent checkpoints of a job's state, two slots in a memory mapped file
+//   <blank line>
+
+#include <cstring>
+#include <stdexcept>
+#include "CheckpointFile.h"
+
+/*
+ * Instance variables (declared in header file)
+ *   capacity - most state bytes per checkpoint (the file's, if an existing file has room for more)
+ *   file - the mapping, file header followed by the two slots
+ *   latestSlot - slot of the latest complete checkpoint (-1 = none), the next checkpoint goes in the other one
+ */
+
+// Opens the file & finds the latest complete checkpoint, starting the file again if it doesn't hold checkpoints
+//   of at least capacity bytes
+CheckpointFile::CheckpointFile(const std::string& path, size_t capacity)
+	: capacity(capacity), file(path, MappedFile::OPEN_OR_CREATE, fileSize(capacity)) {
+	static_assert((sizeof(FileHeader) == 64) && (sizeof(SlotHeader) == 64), "headers should fill one cache line");
+
+	FileHeader* header = reinterpret_cast<FileHeader*>(file.getData());
+	if ((header->magic == FILE_MAGIC) && (header->capacity >= capacity) &&
+		(fileSize(header->capacity) <= file.getSize()))
+		this->capacity = static_cast<size_t>(header->capacity);
+	else {
+		memset(file.getData(), 0, sizeof(FileHeader) + 2 * sizeof(SlotHeader) + capacity);
+		header->capacity = capacity;
+		header->magic = FILE_MAGIC;
+		file.flush(0, file.getSize());
+	}
+
+	for (int slot = 0; slot < 2; slot++) {
+		if (isComplete(slot) && ((latestSlot < 0) || (slotHeader(slot)->sequence > slotHeader(latestSlot)->sequence)))
+			latestSlot = slot;
+	}
+}
+
+size_t CheckpointFile::getCapacity() const {
+	return capacity;
+}
+
+uint64_t CheckpointFile::getSequence() const {
+	return (latestSlot < 0) ? 0 : slotHeader(latestSlot)->sequence;
+}
+
+// The latest complete checkpoint - data points into the mapping, valid until the next beginWrite()
+bool CheckpointFile::load(const uint8_t*& data, size_t& size) const {
+	if (latestSlot < 0)
+		return false;
+	data = slotData(latestSlot);
+	size = static_cast<size_t>(slotHeader(latestSlot)->size);
+	return true;
+}
+
+// The slot for the next checkpoint - the older checkpoint in it fails its checksum once overwritten
+uint8_t* CheckpointFile::beginWrite() {
+	return slotData((latestSlot == 0) ? 1 : 0);
+}
+
+// Flush the state, then write & flush the header that makes it complete - see the header notes
+//   throws invalid_argument if the state is larger than the capacity, runtime_error if the flush fails
+void CheckpointFile::commit(size_t size) {
+	if (size > capacity)
+		throw std::invalid_argument("Checkpoint larger than the checkpoint file capacity: " + std::to_string(size) +
+			"\n");
+	int slot = (latestSlot == 0) ? 1 : 0;
+	uint8_t* data = slotData(slot);
+	file.flush(static_cast<size_t>(data - file.getData()), size);
+
+	SlotHeader* header = slotHeader(slot);
+	header->sequence = getSequence() + 1;
+	header->size = size;
+	header->checksum = checksum(header->sequence, size, data);
+	header->magic = SLOT_MAGIC;
+	file.flush(static_cast<size_t>(reinterpret_cast<uint8_t*>(header) - file.getData()), sizeof(SlotHeader));
+	latestSlot = slot;
+}
+
+//                                     ***  CheckpointFile helper functions ***
+
+CheckpointFile::SlotHeader* CheckpointFile::slotHeader(int slot) const {
+	return reinterpret_cast<SlotHeader*>(file.getData() + sizeof(FileHeader) + slot * (sizeof(SlotHeader) + capacity));
+}
+
+uint8_t* CheckpointFile::slotData(int slot) const {
+	return reinterpret_cast<uint8_t*>(slotHeader(slot) + 1);
+}
+
+// true if the slot holds a checkpoint that was committed in full
+bool CheckpointFile::isComplete(int slot) const {
+	const SlotHeader* header = slotHeader(slot);
+	return (header->magic == SLOT_MAGIC) && (header->size <= capacity) &&
+		(header->checksum == checksum(header->sequence, header->size, slotData(slot)));
+}
+
+size_t CheckpointFile::fileSize(size_t capacity) {
+	return sizeof(FileHeader) + 2 * (sizeof(SlotHeader) + capacity);
+}
+
+// FNV-1a over the sequence #, the size & the state bytes
+uint64_t CheckpointFile::checksum(uint64_t sequence, uint64_t size, const uint8_t* data) {
+	uint64_t hash = 0xCBF29CE484222325ull;
+	const uint64_t fields[2] = { sequence, size };
+	const uint8_t* fieldBytes = reinterpret_cast<const uint8_t*>(fields);
+	for (size_t i = 0; i < sizeof(fields); i++)
+		hash = (hash ^ fieldBytes[i]) * 0x100000001B3ull;
+	for (uint64_t i = 0; i < size; i++)
+		hash = (hash ^ data[i]) * 0x100000001B3ull;
+	return hash;
+}
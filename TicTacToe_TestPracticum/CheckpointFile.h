@@ -0,0 +1,71 @@
+#pragma once
+/*****************************************************************//**
+ * \file   CheckpointFile.h
+ * \brief  crash consistent checkpoints - CheckpointFile
+ *     Scope - saves the state of a long running job (e.g. DfpnSolver) to a MappedFile & reads the latest
+ *        complete checkpoint back after a restart, the job decides what its state bytes mean
+ *
+ * \date   updated: October 2026
+ *
+ * Implementation notes:
+ *     - two slots, each a header (sequence #, size, checksum) & up to capacity bytes of state: a checkpoint is
+ *          written into the slot NOT holding the latest one, so the latest complete checkpoint is never touched
+ *     - commit order: state bytes, flush, then the slot header, flush - a crash at any point leaves the header
+ *          of the slot being written old or torn, either way the checksum fails & the other slot is used
+ *     - checksum: FNV-1a (64 bit) of the sequence #, size & state bytes
+ *     - a file that doesn't hold checkpoints of at least capacity bytes (new, another format, too small) is
+ *          started again empty - state of another job of the same kind must be recognised by the job
+ *     - native byte order, a checkpoint is only for restarting the job on the same kind of host
+ *     - the two slots are capacity bytes each, so the file is a little over twice the capacity
+ *
+ * CheckpointFile(path, capacity)    - opens or creates the file, throws runtime_error if it can't be mapped
+ * bool load(data, size)             - the latest complete checkpoint, false if there is none
+ * uint8_t* beginWrite()             - capacity bytes to write the next checkpoint into
+ * void commit(size)                 - makes the bytes written the latest checkpoint, durable when it returns
+ **/
+
+#include <cstdint>
+#include <string>
+#include "MappedFile.h"
+
+class CheckpointFile
+{
+public:
+	static constexpr uint32_t FILE_MAGIC = 0x4B435454;      // "TTCK"
+	static constexpr uint32_t SLOT_MAGIC = 0x544F4C53;      // "SLOT"
+
+	CheckpointFile(const std::string& path, size_t capacity);
+
+	size_t getCapacity() const;
+	uint64_t getSequence() const;                           // of the latest checkpoint, 0 = none
+	bool load(const uint8_t*& data, size_t& size) const;
+	uint8_t* beginWrite();
+	void commit(size_t size);
+
+private:
+	// layout - file header, then two slots of (slot header, capacity bytes)
+	struct FileHeader {
+		uint32_t magic;
+		uint32_t padding;
+		uint64_t capacity;
+		char reserved[48];
+	};
+	struct SlotHeader {
+		uint32_t magic;
+		uint32_t padding;
+		uint64_t sequence;
+		uint64_t size;
+		uint64_t checksum;
+		char reserved[32];
+	};
+
+	size_t capacity;
+	MappedFile file;
+	int latestSlot = -1;                          // slot holding the latest complete checkpoint, -1 = none
+
+	SlotHeader* slotHeader(int slot) const;
+	uint8_t* slotData(int slot) const;
+	bool isComplete(int slot) const;
+	static size_t fileSize(size_t capacity);
+	static uint64_t checksum(uint64_t sequence, uint64_t size, const uint8_t* data);
+};
@@ -0,0 +1,431 @@
+// DfpnSolver.cpp
+//   Depth-first proof-number search over an MnkBoard, memory bounded by garbage collecting the table
+//   <blank line>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include "DfpnSolver.h"
+#include "BitHelpers.h"
+
+/*
+ * Instance variables (declared in header file)
+ *   maxEntries - most positions kept in the table before a garbage collection
+ *   table - proof & disproof numbers of the positions searched, for the current proof
+ *   attacker - the player the current proof is trying to prove a win for
+ *   deadline - stop condition of the solve
+ *   nodes - positions expanded so far, also the clock for the work of an entry
+ *   stopped - set once the deadline passes, the search unwinds
+ *   stats - table size & garbage collection counts for the result
+ *   phase - proof in progress (player to move wins, opponent wins) or DONE, saved in checkpoints
+ *   checkpointPath, checkpointInterval - checkpoint file & how often to write it, no checkpoints if the path is empty
+ *   checkpoint, nextCheckpoint - the open checkpoint file during a solve & when the next one is due
+ *   root - the position being solved (during a solve), identifies the checkpoints
+ *   symmetries - square maps of the rotations & reflections of the board being solved (identity first)
+ */
+
+namespace {
+	// child threshold from the second best child, 1 + epsilon rather than + 1 so the search doesn't switch
+	//   back & forth between two close children (each switch searches a subtree again)
+	uint32_t widen(uint32_t second) {
+		return (second >= DfpnSolver::INFINITE - 1) ? DfpnSolver::INFINITE : second + second / 4 + 1;
+	}
+
+	// sum capped one short of INFINITE, only a solved node has an infinite number
+	uint32_t addNumbers(uint32_t a, uint32_t b) {
+		return std::min(a + b, DfpnSolver::INFINITE - 1);
+	}
+}
+
+DfpnSolver::DfpnSolver(size_t maxEntries)
+	: maxEntries(maxEntries) {
+	if (maxEntries < 2)
+		throw std::invalid_argument("DfpnSolver needs room for at least two positions\n");
+	table.reserve(maxEntries);
+}
+
+// Value of the position for the player to move - a win is proved for the player to move, then for the opponent
+//   UNKNOWN if the budget runs out first, picks up from the latest checkpoint of the position if enabled
+DfpnSolver::Result DfpnSolver::solve(const MnkBoard& root, std::chrono::milliseconds budget) {
+	if ((root.getEmptySquares() == 0) || root.isWinner(TicTacToeBoard::X) || root.isWinner(TicTacToeBoard::O))
+		throw std::invalid_argument("DfpnSolver::solve called on a finished game\n");
+
+	auto start = std::chrono::steady_clock::now();
+	deadline = start + budget;
+	nodes = 0;
+	stopped = false;
+	stats = Result();
+	phase = PROVE_PLAYER;
+	table.clear();
+	buildSymmetries(root);
+	this->root = &root;
+	if (!checkpointPath.empty()) {
+		checkpoint.reset(new CheckpointFile(checkpointPath, sizeof(CheckpointState) + maxEntries * sizeof(SavedEntry)));
+		stats.resumed = restoreCheckpoint();
+		nextCheckpoint = start + checkpointInterval;
+	}
+
+	TicTacToeBoard::Player player = root.getPlayer();
+	TicTacToeBoard::Player opponent = (player == TicTacToeBoard::X) ? TicTacToeBoard::O : TicTacToeBoard::X;
+	int bestMove = -1;
+	if (phase == PROVE_PLAYER) {
+		if (prove(root, player, bestMove)) {
+			stats.value = WIN;
+			stats.bestMove = bestMove;
+			phase = DONE;
+		}
+		else if (!stopped) {
+			phase = PROVE_OPPONENT;
+			table.clear();
+		}
+	}
+	if (phase == PROVE_OPPONENT) {
+		bool lost = prove(root, opponent, bestMove);
+		if (!stopped) {
+			stats.value = lost ? LOSS : DRAW;
+			phase = DONE;
+		}
+	}
+	if (stopped)
+		stats.value = UNKNOWN;
+	if (checkpoint) {
+		saveCheckpoint();                 // progress up to the deadline, or the result
+		checkpoint.reset();
+	}
+
+	table.clear();
+	this->root = nullptr;
+	stats.nodes = nodes;
+	stats.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	return stats;
+}
+
+// Checkpoint to the file every interval (& at the end of each solve), solves of the same position resume from it
+void DfpnSolver::enableCheckpoints(const std::string& path, std::chrono::milliseconds interval) {
+	checkpointPath = path;
+	checkpointInterval = interval;
+}
+
+//                                     ***  DfpnSolver helper functions ***
+
+// true if the attacker wins from the root (bestMove = a winning move if the attacker is to move), false if
+//   disproved or stopped
+bool DfpnSolver::prove(const MnkBoard& root, TicTacToeBoard::Player attacker, int& bestMove) {
+	this->attacker = attacker;
+	MnkBoard board = root;
+	uint64_t key = hashPosition(board);
+	Entry entry = lookup(key);
+	while ((entry.pn != 0) && (entry.dn != 0) && !stopped) {
+		mid(board, key, INFINITE, INFINITE);
+		entry = lookup(key);
+	}
+	if ((entry.pn != 0) || stopped || (board.getPlayer() != attacker))
+		return (entry.pn == 0) && !stopped;
+
+	// the winning move - a proved child, or the only move if the root was solved without children
+	std::vector<int> moves;
+	Entry rootEntry;
+	if (expand(board, rootEntry, moves) || (moves.size() == 1)) {
+		bestMove = moves[0];
+		return true;
+	}
+	for (int move : moves) {
+		board.play(move);
+		uint64_t childKey = hashPosition(board);
+		Entry child = lookup(childKey);
+		while ((child.pn != 0) && (child.dn != 0) && !stopped) {
+			mid(board, childKey, INFINITE, INFINITE);   // dropped by garbage collection, solve it again
+			child = lookup(childKey);
+		}
+		board.undo(move);
+		if (child.pn == 0) {
+			bestMove = move;
+			break;
+		}
+	}
+	return !stopped;
+}
+
+// Multiple iterative deepening - searches below the node until its proof number reaches thresholdPn or its
+//   disproof number reaches thresholdDn (or it is solved), always following the most proving child
+void DfpnSolver::mid(MnkBoard& board, uint64_t key, uint32_t thresholdPn, uint32_t thresholdDn) {
+	nodes++;
+	if ((nodes % NODES_PER_POLL == 0) && pollStop())
+		return;
+	uint64_t startNodes = nodes;
+	Entry entry = lookup(key);
+	std::vector<int> moves;
+	if (expand(board, entry, moves)) {
+		entry.work = 1;
+		save(key, entry);
+		return;
+	}
+
+	bool orNode = (board.getPlayer() == attacker);
+	// one child per position, moves leading to mirror images of the same position are searched once
+	std::vector<uint64_t> childKeys;
+	size_t unique = 0;
+	for (int move : moves) {
+		board.play(move);
+		uint64_t childKey = hashPosition(board);
+		board.undo(move);
+		if (std::find(childKeys.begin(), childKeys.end(), childKey) == childKeys.end()) {
+			childKeys.push_back(childKey);
+			moves[unique++] = move;
+		}
+	}
+	moves.resize(unique);
+
+	while (!stopped) {
+		// OR node (attacker to move): proved by any child, disproved by all - AND node the other way round
+		uint32_t minimum = INFINITE;
+		uint32_t second = INFINITE;
+		uint32_t sum = 0;
+		size_t best = 0;
+		Entry bestChild;
+		for (size_t i = 0; i < moves.size(); i++) {
+			Entry child = lookup(childKeys[i]);
+			uint32_t selecting = orNode ? child.pn : child.dn;
+			sum = addNumbers(sum, orNode ? child.dn : child.pn);
+			if (selecting < minimum) {
+				second = minimum;
+				minimum = selecting;
+				best = i;
+				bestChild = child;
+			}
+			else if (selecting < second)
+				second = selecting;
+		}
+		if (orNode) {
+			entry.pn = minimum;
+			entry.dn = (minimum == 0) ? INFINITE : sum;
+		}
+		else {
+			entry.dn = minimum;
+			entry.pn = (minimum == 0) ? INFINITE : sum;
+		}
+		if ((entry.pn >= thresholdPn) || (entry.dn >= thresholdDn))
+			break;
+
+		uint32_t childPn;
+		uint32_t childDn;
+		if (orNode) {
+			childPn = std::min(thresholdPn, widen(second));
+			childDn = thresholdDn - entry.dn + bestChild.dn;
+		}
+		else {
+			childDn = std::min(thresholdDn, widen(second));
+			childPn = thresholdPn - entry.pn + bestChild.pn;
+		}
+		board.play(moves[best]);
+		mid(board, childKeys[best], childPn, childDn);
+		board.undo(moves[best]);
+	}
+
+	entry.work += nodes - startNodes + 1;
+	if ((entry.pn == 0) || (entry.dn == 0)) {
+		// solved - the unsolved children are no longer needed (a transposition can search them again)
+		for (uint64_t childKey : childKeys) {
+			auto found = table.find(childKey);
+			if ((found != table.end()) && (found->second.pn != 0) && (found->second.dn != 0))
+				table.erase(found);
+		}
+	}
+	save(key, entry);
+}
+
+// Solves the node from its lines if it can (returns true, entry solved, moves[0] = the winning square if the
+//   player to move wins), otherwise the moves to search: the block of a single threat, or every empty square on
+//   a line either player can still complete (a stone anywhere else is a pass, never better than another move)
+bool DfpnSolver::expand(const MnkBoard& board, Entry& entry, std::vector<int>& moves) const {
+	TicTacToeBoard::Player player = board.getPlayer();
+	TicTacToeBoard::Player opponent = (player == TicTacToeBoard::X) ? TicTacToeBoard::O : TicTacToeBoard::X;
+	uint64_t mine = board.getSquares(player);
+	uint64_t theirs = board.getSquares(opponent);
+	uint64_t empty = board.getEmptySquares();
+	int needed = board.getK() - 1;
+	bool attackerToMove = (player == attacker);
+
+	uint64_t threats = 0;
+	uint64_t live = 0;                                // squares of lines still open to either player
+	bool attackerLive = false;                        // the attacker can still complete a line
+	moves.clear();
+	for (uint64_t line : board.getLines()) {
+		if ((line & theirs) == 0) {
+			if (bitCount(line & mine) == needed) {
+				moves.push_back(lowestBit(line & empty));
+				entry.pn = attackerToMove ? 0 : INFINITE;
+				entry.dn = attackerToMove ? INFINITE : 0;
+				return true;
+			}
+			live |= line;
+			attackerLive = attackerLive || attackerToMove;
+		}
+		if ((line & mine) == 0) {
+			if (bitCount(line & theirs) == needed)
+				threats |= line & empty;
+			live |= line;
+			attackerLive = attackerLive || !attackerToMove;
+		}
+	}
+
+	// two threats lose for the player to move, the attacker without an open line can't win (a draw at best)
+	int threatCount = bitCount(threats);
+	live &= empty;
+	if ((threatCount >= 2) || !attackerLive || (live == 0)) {
+		bool attackerWins = (threatCount >= 2) && !attackerToMove;
+		entry.pn = attackerWins ? 0 : INFINITE;
+		entry.dn = attackerWins ? INFINITE : 0;
+		return true;
+	}
+	uint64_t candidates = (threatCount == 1) ? threats : live;
+	for (; candidates != 0; candidates &= candidates - 1)
+		moves.push_back(lowestBit(candidates));
+	return false;
+}
+
+// The table entry, or a fresh leaf (1, 1) if the position isn't held
+DfpnSolver::Entry DfpnSolver::lookup(uint64_t key) const {
+	auto found = table.find(key);
+	return (found != table.end()) ? found->second : Entry();
+}
+
+void DfpnSolver::save(uint64_t key, const Entry& entry) {
+	if ((table.size() >= maxEntries) && (table.find(key) == table.end()))
+		collectGarbage();
+	table[key] = entry;
+	stats.peakEntries = std::max(stats.peakEntries, table.size());
+}
+
+// Drops the half of the table with the least work - small subtrees are cheap to search again
+void DfpnSolver::collectGarbage() {
+	std::vector<uint64_t> works;
+	works.reserve(table.size());
+	for (const auto& held : table)
+		works.push_back(held.second.work);
+	size_t drop = works.size() / 2;
+	std::nth_element(works.begin(), works.begin() + drop, works.end());
+	uint64_t threshold = works[drop];
+
+	size_t dropped = 0;
+	for (auto held = table.begin(); (held != table.end()) && (dropped < drop);) {
+		if (held->second.work <= threshold) {
+			held = table.erase(held);
+			dropped++;
+		}
+		else
+			++held;
+	}
+	stats.collections++;
+}
+
+// true once the deadline has passed - sets stopped so the search unwinds, also writes the checkpoints when due
+bool DfpnSolver::pollStop() {
+	auto now = std::chrono::steady_clock::now();
+	if (now >= deadline)
+		stopped = true;
+	else if (checkpoint && (now >= nextCheckpoint)) {
+		saveCheckpoint();
+		nextCheckpoint = std::chrono::steady_clock::now() + checkpointInterval;
+	}
+	return stopped;
+}
+
+// The table, the proof in progress & the counts, written to the slot after the latest checkpoint
+void DfpnSolver::saveCheckpoint() {
+	CheckpointState state = {};
+	state.magic = CHECKPOINT_MAGIC;
+	state.version = CHECKPOINT_VERSION;
+	state.rows = root->getRows();
+	state.cols = root->getCols();
+	state.k = root->getK();
+	state.phase = phase;
+	state.squares[TicTacToeBoard::X] = root->getSquares(TicTacToeBoard::X);
+	state.squares[TicTacToeBoard::O] = root->getSquares(TicTacToeBoard::O);
+	state.nodes = nodes;
+	state.collections = stats.collections;
+	state.value = stats.value;
+	state.bestMove = stats.bestMove;
+	state.entryCount = (phase == DONE) ? 0 : table.size();   // the result is all a finished solve needs
+
+	uint8_t* data = checkpoint->beginWrite();
+	memcpy(data, &state, sizeof(state));
+	uint8_t* next = data + sizeof(state);
+	for (auto held = table.begin(); (held != table.end()) && (phase != DONE); ++held) {
+		SavedEntry saved = { held->first, held->second.pn, held->second.dn, held->second.work };
+		memcpy(next, &saved, sizeof(saved));
+		next += sizeof(saved);
+	}
+	checkpoint->commit(static_cast<size_t>(next - data));
+	stats.checkpoints++;
+}
+
+// Restores the latest checkpoint if it is of the position being solved - false if there is none (or another's)
+bool DfpnSolver::restoreCheckpoint() {
+	const uint8_t* data;
+	size_t size;
+	CheckpointState state;
+	if (!checkpoint->load(data, size) || (size < sizeof(state)))
+		return false;
+	memcpy(&state, data, sizeof(state));
+	if ((state.magic != CHECKPOINT_MAGIC) || (state.version != CHECKPOINT_VERSION) ||
+		(state.rows != root->getRows()) || (state.cols != root->getCols()) || (state.k != root->getK()) ||
+		(state.squares[TicTacToeBoard::X] != root->getSquares(TicTacToeBoard::X)) ||
+		(state.squares[TicTacToeBoard::O] != root->getSquares(TicTacToeBoard::O)) ||
+		(state.phase > DONE) || (state.entryCount > (size - sizeof(state)) / sizeof(SavedEntry)))
+		return false;
+
+	phase = static_cast<Phase>(state.phase);
+	nodes = state.nodes;
+	stats.collections = state.collections;
+	stats.value = static_cast<Value>(state.value);
+	stats.bestMove = state.bestMove;
+	const uint8_t* next = data + sizeof(state);
+	for (uint64_t i = 0; i < state.entryCount; i++, next += sizeof(SavedEntry)) {
+		SavedEntry saved;
+		memcpy(&saved, next, sizeof(saved));
+		Entry entry;
+		entry.pn = saved.pn;
+		entry.dn = saved.dn;
+		entry.work = saved.work;
+		save(saved.key, entry);
+	}
+	return true;
+}
+
+// Square maps of the board's symmetries - the 8 rotations & reflections of a square board, 4 of a rectangle
+void DfpnSolver::buildSymmetries(const MnkBoard& board) {
+	int rows = board.getRows();
+	int cols = board.getCols();
+	symmetries.clear();
+	for (int symmetry = 0; symmetry < 8; symmetry++) {
+		bool transpose = (symmetry & 4) != 0;
+		if (transpose && (rows != cols))
+			break;
+		std::vector<int> map(rows * cols);
+		for (int row = 0; row < rows; row++) {
+			for (int col = 0; col < cols; col++) {
+				int mappedRow = (symmetry & 1) ? rows - 1 - row : row;
+				int mappedCol = (symmetry & 2) ? cols - 1 - col : col;
+				map[row * cols + col] = transpose ? mappedCol * cols + mappedRow : mappedRow * cols + mappedCol;
+			}
+		}
+		symmetries.push_back(map);
+	}
+}
+
+// Position key - the smallest hash of the two bit boards over the board's symmetries, so the mirror images of
+//   a position share its entry (the player to move follows from the bit boards)
+uint64_t DfpnSolver::hashPosition(const MnkBoard& board) const {
+	uint64_t key = ~0ull;
+	for (const std::vector<int>& map : symmetries) {
+		uint64_t mapped[2] = { 0, 0 };
+		for (int player = 0; player < 2; player++) {
+			uint64_t squares = board.getSquares(static_cast<TicTacToeBoard::Player>(player));
+			for (; squares != 0; squares &= squares - 1)
+				mapped[player] |= 1ull << map[lowestBit(squares)];
+		}
+		key = std::min(key, mix(mapped[TicTacToeBoard::X] ^ mix(mapped[TicTacToeBoard::O])));
+	}
+	return key;
+}
@@ -0,0 +1,126 @@
+#pragma once
+/*****************************************************************//**
+ * \file   DfpnSolver.h
+ * \brief  game solver - DfpnSolver (depth-first proof-number search)
+ *     Scope - proves the value (win, draw or loss for the player to move) of an MnkBoard position, for the
+ *        m,n,k variants too large for the alpha-beta engines to search to the end (e.g. 4x4/k=3, 5x5/k=4)
+ *
+ * \date   updated: October 2026
+ *
+ * Implementation notes:
+ *     - df-pn: proof & disproof numbers (the fewest leaves still to solve to prove / disprove a node), searched
+ *          depth first with thresholds so only the most proving path is expanded, results are kept in the table
+ *     - two proofs: "the player to move wins" (attacker = player to move), if disproved "the opponent wins" -
+ *          neither is a draw
+ *     - forced moves are found from the lines before a node is expanded: a square completing a line wins, two
+ *          opponent squares completing a line lose, one must be blocked (the only child)
+ *     - symmetric positions (rotations & reflections) share an entry: the key is the smallest hash of the two bit
+ *          boards over the board's symmetries
+ *     - bounded memory: at most maxEntries positions are kept, when full the half with the least search effort
+ *          (work) is dropped (garbage collected), a dropped position is searched again if needed
+ *     - a solved node no longer needs its unsolved children, their entries are dropped as soon as it is solved
+ *     - the deadline is polled every NODES_PER_POLL nodes, an unfinished proof is reported as UNKNOWN
+ *     - checkpoints (optional): the table, the proof in progress & the counts are saved to a CheckpointFile every
+ *          interval, when the budget runs out & when the solve finishes - a solve of the same position (same
+ *          geometry & stones) with the same file picks up from the latest checkpoint, the table is the whole
+ *          search state (df-pn finds its way back to the frontier from the root through the table)
+ *
+ * Result solve(board, budget)                 - value for the player to move, throws invalid_argument if the game is over
+ * void enableCheckpoints(path, interval)      - checkpoint to / resume from the file, throws runtime_error if the
+ *                                               file can't be mapped (when solve() opens it)
+ **/
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "CheckpointFile.h"
+#include "MnkBoard.h"
+
+class DfpnSolver
+{
+public:
+	static constexpr uint32_t INFINITE = 1u << 30;
+	static constexpr int NODES_PER_POLL = 4096;
+	static constexpr size_t DEFAULT_MAX_ENTRIES = 1 << 21;
+	static constexpr uint32_t CHECKPOINT_MAGIC = 0x4E504644;     // "DFPN"
+	static constexpr uint32_t CHECKPOINT_VERSION = 1;
+
+	enum Value { UNKNOWN, WIN, DRAW, LOSS };          // for the player to move
+
+	struct Result {
+		Value value = UNKNOWN;
+		int bestMove = -1;            // a winning move (WIN), otherwise -1
+		uint64_t nodes = 0;           // positions expanded, both proofs
+		size_t peakEntries = 0;       // most positions held in the table
+		int collections = 0;          // garbage collections run
+		int checkpoints = 0;          // checkpoints written by this solve
+		bool resumed = false;         // picked up from a checkpoint (nodes & collections include the earlier runs)
+		double milliseconds = 0;      // this solve only
+	};
+
+	explicit DfpnSolver(size_t maxEntries = DEFAULT_MAX_ENTRIES);
+	Result solve(const MnkBoard& root, std::chrono::milliseconds budget);
+	void enableCheckpoints(const std::string& path, std::chrono::milliseconds interval);
+
+private:
+	struct Entry {
+		uint32_t pn = 1;              // proof number, 0 = proved
+		uint32_t dn = 1;              // disproof number, 0 = disproved
+		uint64_t work = 0;            // nodes spent on the subtree, ranks entries for garbage collection
+	};
+
+	enum Phase : uint32_t { PROVE_PLAYER, PROVE_OPPONENT, DONE };
+
+	// checkpoint layout - the state, then entryCount saved entries
+	struct CheckpointState {
+		uint32_t magic;
+		uint32_t version;
+		int32_t rows;
+		int32_t cols;
+		int32_t k;
+		uint32_t phase;
+		uint64_t squares[2];          // the root's stones, X & O
+		uint64_t nodes;
+		int32_t collections;
+		int32_t value;
+		int32_t bestMove;
+		uint32_t padding;
+		uint64_t entryCount;
+	};
+	struct SavedEntry {
+		uint64_t key;
+		uint32_t pn;
+		uint32_t dn;
+		uint64_t work;
+	};
+
+	size_t maxEntries;
+	std::unordered_map<uint64_t, Entry> table;
+	TicTacToeBoard::Player attacker = TicTacToeBoard::X;
+	std::chrono::steady_clock::time_point deadline;
+	uint64_t nodes = 0;
+	bool stopped = false;
+	Result stats;
+	std::vector<std::vector<int>> symmetries;
+	Phase phase = PROVE_PLAYER;
+	std::string checkpointPath;                   // empty = no checkpoints
+	std::chrono::milliseconds checkpointInterval{ 0 };
+	std::chrono::steady_clock::time_point nextCheckpoint;
+	std::unique_ptr<CheckpointFile> checkpoint;   // open during a solve
+	const MnkBoard* root = nullptr;               // position being solved, during a solve
+
+	bool prove(const MnkBoard& root, TicTacToeBoard::Player attacker, int& bestMove);
+	void mid(MnkBoard& board, uint64_t key, uint32_t thresholdPn, uint32_t thresholdDn);
+	bool expand(const MnkBoard& board, Entry& entry, std::vector<int>& moves) const;
+	Entry lookup(uint64_t key) const;
+	void save(uint64_t key, const Entry& entry);
+	void collectGarbage();
+	bool pollStop();
+	void saveCheckpoint();
+	bool restoreCheckpoint();
+	void buildSymmetries(const MnkBoard& board);
+	uint64_t hashPosition(const MnkBoard& board) const;
+};
@@ -0,0 +1,217 @@
+// GameStore.cpp
+//   Games in progress as fixed size records of a memory mapped file, free list & durability points
+//   <blank line>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include "GameStore.h"
+
+/*
+ * Instance variables (declared in header file)
+ *   capacity - # of records (the file's, if an existing store has room for more)
+ *   file - the mapping, file header followed by the records
+ *   recovered - the store was opened not clean & rebuilt from its records
+ *   dirtyLow, dirtyHigh - range of records changed since the last sync(), flushed by the next one
+ */
+
+// Opens the store (recovering it if it wasn't synced), or starts it empty if the file isn't a game store
+GameStore::GameStore(const std::string& path, uint32_t capacity)
+	: capacity(capacity), file(path, MappedFile::OPEN_OR_CREATE, fileSize(capacity)) {
+	static_assert((sizeof(FileHeader) == 64) && (sizeof(Record) == 16), "file layout as in the header notes");
+
+	FileHeader* stored = header();
+	if ((stored->magic == FILE_MAGIC) && (stored->recordSize == sizeof(Record)) && (stored->capacity > 0) &&
+		(stored->capacity < NO_SLOT) && (fileSize(static_cast<uint32_t>(stored->capacity)) <= file.getSize())) {
+		// records past the stored capacity are zero bytes (FREE) from extending the file
+		this->capacity = std::max(capacity, static_cast<uint32_t>(stored->capacity));
+		if (!stored->clean)
+			recover();
+		if (stored->capacity != this->capacity) {
+			stored->capacity = this->capacity;
+			file.flush(0, sizeof(FileHeader));
+		}
+	}
+	else {
+		memset(stored, 0, sizeof(FileHeader));
+		memset(record(0), 0, fileSize(capacity) - sizeof(FileHeader));
+		stored->recordSize = sizeof(Record);
+		stored->capacity = capacity;
+		stored->freeHead = NO_SLOT;
+		stored->clean = 1;
+		stored->magic = FILE_MAGIC;
+		file.flush(0, file.getSize());
+	}
+}
+
+// Last durability point - flush errors can't be reported from here, the next open recovers
+GameStore::~GameStore() {
+	try {
+		sync();
+	}
+	catch (const std::exception&) {
+	}
+}
+
+uint32_t GameStore::getCapacity() const {
+	return capacity;
+}
+
+uint32_t GameStore::getLiveCount() const {
+	return static_cast<uint32_t>(header()->liveCount);
+}
+
+uint32_t GameStore::getHighWater() const {
+	return static_cast<uint32_t>(header()->highWater);
+}
+
+bool GameStore::wasRecovered() const {
+	return recovered;
+}
+
+// New game in a free slot (reused first) - throws runtime_error if every slot is live
+uint32_t GameStore::add(uint64_t sessionId, const TicTacToeBoard& board) {
+	FileHeader* stored = header();
+	uint32_t slot = stored->freeHead;
+	if ((slot == NO_SLOT) && (stored->highWater >= capacity))
+		throw std::runtime_error("Game store full: " + std::to_string(capacity) + " games in " + file.getPath() + "\n");
+
+	markChanged(slot == NO_SLOT ? static_cast<uint32_t>(stored->highWater) : slot);
+	if (slot == NO_SLOT)
+		slot = static_cast<uint32_t>(stored->highWater++);
+	else
+		stored->freeHead = static_cast<uint32_t>(record(slot)->sessionId);
+	Record* added = record(slot);
+	write(added, board);
+	added->sessionId = sessionId;
+	added->state = LIVE;
+	stored->liveCount++;
+	return slot;
+}
+
+void GameStore::save(uint32_t slot, const TicTacToeBoard& board) {
+	Record* stored = liveRecord(slot);
+	markChanged(slot);
+	write(stored, board);
+}
+
+// The stored game into the board (squares, player, # of squares played), false if no game is in the slot
+//   a damaged record throws invalid_argument (TicTacToeBoard::restoreSnapshot())
+bool GameStore::load(uint32_t slot, TicTacToeBoard& board) const {
+	if (!isLive(slot))
+		return false;
+	const Record* stored = record(slot);
+	TicTacToeBoard::Snapshot snapshot = {};
+	snapshot.xSquares = stored->xSquares;
+	snapshot.oSquares = stored->oSquares;
+	snapshot.player = stored->player;
+	snapshot.takenSquareCount = stored->takenSquareCount;
+	board.restoreSnapshot(snapshot);
+	return true;
+}
+
+bool GameStore::isLive(uint32_t slot) const {
+	return (slot < header()->highWater) && (record(slot)->state == LIVE);
+}
+
+uint64_t GameStore::getSessionId(uint32_t slot) const {
+	return liveRecord(slot)->sessionId;
+}
+
+// The slot goes on the free list, its session id field linking to the next free slot
+void GameStore::remove(uint32_t slot) {
+	Record* removed = liveRecord(slot);
+	markChanged(slot);
+	FileHeader* stored = header();
+	removed->state = FREE;
+	removed->sessionId = stored->freeHead;
+	stored->freeHead = slot;
+	stored->liveCount--;
+}
+
+// Durability point - changed records flushed first, then the header marked clean (see the header notes)
+//   throws runtime_error if a flush fails
+void GameStore::sync() {
+	FileHeader* stored = header();
+	if (stored->clean)
+		return;
+	if (dirtyLow <= dirtyHigh) {
+		file.flush(sizeof(FileHeader) + static_cast<size_t>(dirtyLow) * sizeof(Record),
+			static_cast<size_t>(dirtyHigh - dirtyLow + 1) * sizeof(Record));
+	}
+	stored->clean = 1;
+	file.flush(0, sizeof(FileHeader));
+	dirtyLow = NO_SLOT;
+	dirtyHigh = 0;
+}
+
+//                                     ***  GameStore helper functions ***
+
+GameStore::FileHeader* GameStore::header() const {
+	return reinterpret_cast<FileHeader*>(file.getData());
+}
+
+GameStore::Record* GameStore::record(uint32_t slot) const {
+	return reinterpret_cast<Record*>(file.getData() + sizeof(FileHeader)) + slot;
+}
+
+// the record of a live game, throws invalid_argument if the slot doesn't hold one
+GameStore::Record* GameStore::liveRecord(uint32_t slot) const {
+	if (!isLive(slot))
+		throw std::invalid_argument("No game in game store slot: " + std::to_string(slot) + "\n");
+	return record(slot);
+}
+
+void GameStore::write(Record* stored, const TicTacToeBoard& board) {
+	TicTacToeBoard::Snapshot snapshot = board.getSnapshot();
+	stored->xSquares = snapshot.xSquares;
+	stored->oSquares = snapshot.oSquares;
+	stored->player = snapshot.player;
+	stored->takenSquareCount = snapshot.takenSquareCount;
+}
+
+// before a record changes - the first change since the last sync puts "not clean" on disk, so a crash that
+//   keeps some of the changes is always recovered on the next open
+void GameStore::markChanged(uint32_t slot) {
+	FileHeader* stored = header();
+	if (stored->clean) {
+		stored->clean = 0;
+		file.flush(0, sizeof(FileHeader));
+	}
+	dirtyLow = std::min(dirtyLow, slot);
+	dirtyHigh = std::max(dirtyHigh, slot);
+}
+
+// rebuild high water, live count & free list from the records' states - free slots in ascending order
+void GameStore::recover() {
+	FileHeader* stored = header();
+	uint32_t highWater = 0;
+	for (uint32_t slot = 0; slot < capacity; slot++) {
+		if (record(slot)->state == LIVE)
+			highWater = slot + 1;
+	}
+	stored->highWater = highWater;
+	stored->liveCount = 0;
+	stored->freeHead = NO_SLOT;
+	for (uint32_t slot = highWater; slot-- > 0;) {
+		Record* scanned = record(slot);
+		if (scanned->state == LIVE)
+			stored->liveCount++;
+		else {
+			scanned->state = FREE;
+			scanned->sessionId = stored->freeHead;
+			stored->freeHead = slot;
+		}
+	}
+	file.flush(0, file.getSize());
+	stored->clean = 1;
+	file.flush(0, sizeof(FileHeader));
+	recovered = true;
+}
+
+// bytes for capacity records, throws invalid_argument (before the file is touched) for no records or NO_SLOT
+size_t GameStore::fileSize(uint32_t capacity) {
+	if ((capacity == 0) || (capacity == NO_SLOT))
+		throw std::invalid_argument("Invalid game store capacity: " + std::to_string(capacity) + "\n");
+	return sizeof(FileHeader) + static_cast<size_t>(capacity) * sizeof(Record);
+}
@@ -0,0 +1,100 @@
+#pragma once
+/*****************************************************************//**
+ * \file   GameStore.h
+ * \brief  persistent game store - GameStore (games in progress in a memory mapped file)
+ *     Scope - keeps the games a server is hosting in fixed size records of a MappedFile, so they survive a
+ *        restart: opening the file makes every stored game available again, nothing is parsed or rebuilt
+ *
+ * \date   updated: October 2026
+ *
+ * Implementation notes:
+ *     - layout: a 64 byte file header, then capacity records of 16 bytes - X squares, O squares (bit per
+ *          position, as TicTacToeBoard::Snapshot), side to move, takenSquareCount, state, session id
+ *     - file header: magic, record size, capacity, high water (records ever used), live count, free list head
+ *          (offset 32) & clean flag (offset 36), reserved bytes to 64
+ *     - add(), save(), load() & remove() are O(1): a game is its record, addressed by slot #; removed records
+ *          form a free list through their session id field & are reused before records past the high water
+ *     - durability points: sync() flushes the records changed since the last sync, then the header marked
+ *          clean - the first change after a sync marks the header not clean on disk before any record changes
+ *     - a file opened not clean (the system went down between syncs) is recovered from the records: free
+ *          list, live count & high water rebuilt from each record's state - records are 16 byte aligned, so a
+ *          record is never split across pages, it is written whole or not at all
+ *     - a file that isn't a game store (new, another format) is started empty, a smaller store is extended
+ *     - one thread (or callers serialise), the destructor syncs - native byte order, like CheckpointFile
+ *     - errors: store full or the file can't be mapped / flushed throws runtime_error, a slot that isn't a
+ *          live game throws invalid_argument
+ *
+ * GameStore(path, capacity)                 - opens or creates the store with room for capacity games
+ * uint32_t add(sessionId, board)            - stores a new game, returns its slot
+ * void save(slot, board)                    - replaces the game in the slot
+ * bool load(slot, board)                    - restores the slot's game into the board, false if the slot is free
+ * void remove(slot)                         - frees the slot for reuse
+ * void sync()                               - durability point, changes so far are on disk when it returns
+ **/
+
+#include <cstdint>
+#include <string>
+#include "MappedFile.h"
+#include "TicTacToeBoard.h"
+
+class GameStore
+{
+public:
+	static constexpr uint32_t FILE_MAGIC = 0x53475454;      // "TTGS"
+	static constexpr uint32_t NO_SLOT = 0xFFFFFFFF;
+
+	GameStore(const std::string& path, uint32_t capacity);
+	~GameStore();
+	GameStore(const GameStore&) = delete;                    // owns the mapping
+	GameStore& operator=(const GameStore&) = delete;
+
+	uint32_t getCapacity() const;
+	uint32_t getLiveCount() const;
+	uint32_t getHighWater() const;                           // slots below it may be live, none above
+	bool wasRecovered() const;                               // opened not clean, records scanned
+
+	uint32_t add(uint64_t sessionId, const TicTacToeBoard& board);
+	void save(uint32_t slot, const TicTacToeBoard& board);
+	bool load(uint32_t slot, TicTacToeBoard& board) const;
+	bool isLive(uint32_t slot) const;
+	uint64_t getSessionId(uint32_t slot) const;
+	void remove(uint32_t slot);
+	void sync();
+
+private:
+	enum State : uint8_t { FREE, LIVE };
+
+	struct FileHeader {
+		uint32_t magic;
+		uint32_t recordSize;
+		uint64_t capacity;
+		uint64_t highWater;
+		uint64_t liveCount;
+		uint32_t freeHead;
+		uint32_t clean;
+		char reserved[24];
+	};
+	struct Record {
+		uint16_t xSquares;
+		uint16_t oSquares;
+		uint8_t player;
+		uint8_t takenSquareCount;
+		uint8_t state;
+		uint8_t padding;
+		uint64_t sessionId;                   // next free slot while FREE
+	};
+
+	uint32_t capacity;
+	MappedFile file;
+	bool recovered = false;
+	uint32_t dirtyLow = NO_SLOT;          // records changed since the last sync, dirtyLow > dirtyHigh = none
+	uint32_t dirtyHigh = 0;
+
+	FileHeader* header() const;
+	Record* record(uint32_t slot) const;
+	Record* liveRecord(uint32_t slot) const;
+	void write(Record* stored, const TicTacToeBoard& board);
+	void markChanged(uint32_t slot);
+	void recover();
+	static size_t fileSize(uint32_t capacity);
+};
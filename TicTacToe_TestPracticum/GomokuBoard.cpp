@@ -0,0 +1,309 @@
+// GomokuBoard.cpp
+//   15x15 five in a row, bit rows per direction & shift-and-mask shape detection in windows around a cell
+//   <blank line>
+
+#include <stdexcept>
+#include "GomokuBoard.h"
+#include "BitHelpers.h"
+
+/*
+ * Instance variables (declared in header file)
+ *   lines[][][] - per player & direction, bit mask of the player's stones on each line
+ *   nearCount[] - per cell, # of stones within NEAR_DISTANCE (rows & columns), maintained by play() & undo()
+ *   occupied[] - per cell, Player + 1 of the stone on it, 0 if empty
+ *   player - player to move, toggled by play() & undo()
+ *   ply - # of cells played
+ *   scans - # of window scans, a counter only (mutable so the const queries can count)
+ */
+
+namespace {
+	// window of 9 cells centred on the cell, 16 bit lane per direction (bits 9 - 15 of each lane are always 0)
+	constexpr int WINDOW_HALF = GomokuBoard::WIN_LENGTH - 1;
+	constexpr uint32_t WINDOW_MASK = 0x1FF;
+	constexpr int LANE_BITS = 16;
+
+	// row & column steps of each direction, position along the line increases with the step
+	constexpr int ROW_STEP[GomokuBoard::DIRECTIONS] = { 0, 1, 1, -1 };
+	constexpr int COL_STEP[GomokuBoard::DIRECTIONS] = { 1, 0, 1, 1 };
+
+	static_assert(GomokuBoard::SIZE + WINDOW_HALF <= 32, "a line & its window margin must fit 32 bits");
+
+	// the same pattern in all 4 lanes
+	constexpr uint64_t lanes(uint64_t pattern) {
+		return pattern * 0x0001000100010001ull;
+	}
+
+	// line & position on it of a cell in each direction - rows by column, columns by row, diagonals by column
+	void lineOf(int cell, int direction, int& line, int& position) {
+		int row = cell / GomokuBoard::SIZE;
+		int col = cell % GomokuBoard::SIZE;
+		switch (direction) {
+		case 0: line = row; position = col; break;
+		case 1: line = col; position = row; break;
+		case 2: line = row - col + GomokuBoard::SIZE - 1; position = col; break;
+		default: line = row + col; position = col; break;
+		}
+	}
+
+	// positions on each line that are on the board
+	struct ValidTable {
+		uint32_t mask[GomokuBoard::DIRECTIONS][GomokuBoard::LINES];
+	};
+
+	constexpr ValidTable buildValid() {
+		ValidTable table{};
+		for (int row = 0; row < GomokuBoard::SIZE; row++) {
+			for (int col = 0; col < GomokuBoard::SIZE; col++) {
+				table.mask[0][row] |= 1u << col;
+				table.mask[1][col] |= 1u << row;
+				table.mask[2][row - col + GomokuBoard::SIZE - 1] |= 1u << col;
+				table.mask[3][row + col] |= 1u << col;
+			}
+		}
+		return table;
+	}
+
+	constexpr ValidTable VALID = buildValid();
+
+	// 5 cell windows (by start, bits 0 - 4 of each lane) with the player's stones everywhere except an empty gap
+	//   at offset gap - one more stone on the gap makes five
+	uint64_t fiveWithGap(uint64_t mine, uint64_t empty, int gap) {
+		uint64_t starts = empty >> gap;
+		for (int i = 0; i < GomokuBoard::WIN_LENGTH; i++) {
+			if (i != gap)
+				starts &= mine >> i;
+		}
+		return starts & lanes(0x1F);
+	}
+
+	// potential of a window by the player's stones in it (the cell always counts), 4 stones is a four
+	constexpr uint16_t WINDOW_WEIGHTS[GomokuBoard::WIN_LENGTH + 1] = { 0, 1, 4, 12, 30, 0 };
+
+	int laneCount(uint64_t bits) {
+		int count = 0;
+		for (int direction = 0; direction < GomokuBoard::DIRECTIONS; direction++)
+			count += ((bits >> (LANE_BITS * direction)) & 0xFFFF) != 0;
+		return count;
+	}
+}
+
+GomokuBoard::GomokuBoard() {
+}
+
+int GomokuBoard::cellIndex(int row, int col) {
+	if ((row < 0) || (row >= SIZE) || (col < 0) || (col >= SIZE))
+		throw std::invalid_argument("GomokuBoard row or column out of range\n");
+	return row * SIZE + col;
+}
+
+GomokuBoard::Player GomokuBoard::getPlayer() const {
+	return player;
+}
+
+int GomokuBoard::getPly() const {
+	return ply;
+}
+
+bool GomokuBoard::isSquareEmpty(int cell) const {
+	validateCell(cell);
+	return occupied[cell] == 0;
+}
+
+bool GomokuBoard::isFull() const {
+	return ply == CELLS;
+}
+
+// Current player takes the cell & the turn passes - false (board unchanged) if the cell is taken
+//   updates the 4 lines through the cell & the near counts around it, nothing else
+bool GomokuBoard::play(int cell) {
+	if (!isSquareEmpty(cell))
+		return false;
+	for (int direction = 0; direction < DIRECTIONS; direction++) {
+		int line, position;
+		lineOf(cell, direction, line, position);
+		lines[player][direction][line] |= 1u << position;
+	}
+	int row = cell / SIZE;
+	int col = cell % SIZE;
+	for (int r = row - NEAR_DISTANCE; r <= row + NEAR_DISTANCE; r++) {
+		for (int c = col - NEAR_DISTANCE; c <= col + NEAR_DISTANCE; c++) {
+			if ((r >= 0) && (r < SIZE) && (c >= 0) && (c < SIZE))
+				nearCount[r * SIZE + c]++;
+		}
+	}
+	occupied[cell] = static_cast<uint8_t>(player + 1);
+	player = (player == TicTacToeBoard::X) ? TicTacToeBoard::O : TicTacToeBoard::X;
+	ply++;
+	return true;
+}
+
+// Takes back the last move - the cell must be the one last played (the previous player's)
+void GomokuBoard::undo(int cell) {
+	validateCell(cell);
+	Player previous = (player == TicTacToeBoard::X) ? TicTacToeBoard::O : TicTacToeBoard::X;
+	if (occupied[cell] != previous + 1)
+		throw std::invalid_argument("GomokuBoard::undo - cell not played by the previous player\n");
+	for (int direction = 0; direction < DIRECTIONS; direction++) {
+		int line, position;
+		lineOf(cell, direction, line, position);
+		lines[previous][direction][line] &= ~(1u << position);
+	}
+	int row = cell / SIZE;
+	int col = cell % SIZE;
+	for (int r = row - NEAR_DISTANCE; r <= row + NEAR_DISTANCE; r++) {
+		for (int c = col - NEAR_DISTANCE; c <= col + NEAR_DISTANCE; c++) {
+			if ((r >= 0) && (r < SIZE) && (c >= 0) && (c < SIZE))
+				nearCount[r * SIZE + c]--;
+		}
+	}
+	occupied[cell] = 0;
+	player = previous;
+	ply--;
+}
+
+bool GomokuBoard::isWinningMove(int cell) const {
+	validateCell(cell);
+	if (occupied[cell] == 0)
+		return false;
+	return getShapes(cell, static_cast<Player>(occupied[cell] - 1)).fives > 0;
+}
+
+// Shapes through the cell in each direction, with the player's stone on the cell (played or not)
+//   every pattern below is evaluated for all 4 directions at once, bit s of a lane = pattern starting at
+//   window offset s (the cell is offset 4), start masks keep only the windows that contain the cell
+GomokuBoard::Shapes GomokuBoard::getShapes(int cell, Player player) const {
+	uint64_t mine, empty;
+	packWindows(cell, player, mine, empty);
+
+	uint64_t five = mine & (mine >> 1) & (mine >> 2) & (mine >> 3) & (mine >> 4) & lanes(0x1F);
+	uint64_t openFour = empty & (mine >> 1) & (mine >> 2) & (mine >> 3) & (mine >> 4) & (empty >> 5) & lanes(0x0F);
+	uint64_t four = 0;
+	for (int gap = 0; gap < WIN_LENGTH; gap++)
+		four |= fiveWithGap(mine, empty, gap);
+	// _XXX__ & the split forms: 6 cells, empty both ends, 3 stones & an empty cell between them
+	uint64_t openThree = 0;
+	for (int gap = 1; gap < WIN_LENGTH; gap++) {
+		uint64_t starts = empty & (empty >> 5) & (empty >> gap);
+		for (int i = 1; i < WIN_LENGTH; i++) {
+			if (i != gap)
+				starts &= mine >> i;
+		}
+		openThree |= starts;
+	}
+	openThree &= lanes(0x0F);
+	uint64_t open = mine | empty;
+	uint64_t freeWindows = open & (open >> 1) & (open >> 2) & (open >> 3) & (open >> 4) & lanes(0x1F);
+
+	Shapes shapes;
+	shapes.fives = static_cast<uint8_t>(laneCount(five));
+	shapes.fours = static_cast<uint8_t>(laneCount(four));
+	shapes.openFours = static_cast<uint8_t>(laneCount(openFour));
+	shapes.openThrees = static_cast<uint8_t>(laneCount(openThree));
+	for (int direction = 0; direction < DIRECTIONS; direction++) {
+		if ((openThree >> (LANE_BITS * direction)) & 0xFFFF)
+			shapes.threeDirections |= static_cast<uint8_t>(1u << direction);
+		uint32_t lane = static_cast<uint32_t>(freeWindows >> (LANE_BITS * direction)) & 0x1F;
+		uint32_t stones = static_cast<uint32_t>(mine >> (LANE_BITS * direction));
+		for (int start = 0; lane != 0; start++, lane >>= 1) {
+			if (lane & 1)
+				shapes.potential += WINDOW_WEIGHTS[bitCount((stones >> start) & 0x1F)];
+		}
+	}
+	return shapes;
+}
+
+// Empty cells that complete a five for the player in a window containing the cell - the replies to a four
+//   (one cell to block) or an open four / double four (two or more, can't all be blocked)
+int GomokuBoard::getFiveCells(int cell, Player player, int cells[MAX_FIVE_CELLS]) const {
+	uint64_t mine, empty;
+	packWindows(cell, player, mine, empty);
+	int row = cell / SIZE;
+	int col = cell % SIZE;
+	int count = 0;
+	for (int gap = 0; gap < WIN_LENGTH; gap++) {
+		uint64_t starts = fiveWithGap(mine, empty, gap);
+		for (int direction = 0; direction < DIRECTIONS; direction++) {
+			uint64_t lane = (starts >> (LANE_BITS * direction)) & 0xFFFF;
+			for (int start = 0; lane != 0; start++, lane >>= 1) {
+				if ((lane & 1) == 0)
+					continue;
+				int offset = start + gap - WINDOW_HALF;
+				int gapCell = (row + offset * ROW_STEP[direction]) * SIZE + col + offset * COL_STEP[direction];
+				bool known = false;
+				for (int i = 0; i < count; i++)
+					known = known || (cells[i] == gapCell);
+				if (!known)
+					cells[count++] = gapCell;
+			}
+		}
+	}
+	return count;
+}
+
+int GomokuBoard::getCandidates(int cells[CELLS]) const {
+	if (ply == 0) {
+		cells[0] = CELLS / 2;
+		return 1;
+	}
+	int count = 0;
+	for (int cell = 0; cell < CELLS; cell++) {
+		if ((occupied[cell] == 0) && (nearCount[cell] > 0))
+			cells[count++] = cell;
+	}
+	return count;
+}
+
+int GomokuBoard::getNearCount(int cell) const {
+	validateCell(cell);
+	return nearCount[cell];
+}
+
+int GomokuBoard::getLineCells(int cell, int direction, int cells[2 * (WIN_LENGTH - 1)]) const {
+	validateCell(cell);
+	int row = cell / SIZE;
+	int col = cell % SIZE;
+	int count = 0;
+	for (int offset = -WINDOW_HALF; offset <= WINDOW_HALF; offset++) {
+		int r = row + offset * ROW_STEP[direction];
+		int c = col + offset * COL_STEP[direction];
+		if ((offset != 0) && (r >= 0) && (r < SIZE) && (c >= 0) && (c < SIZE) && (occupied[r * SIZE + c] == 0))
+			cells[count++] = r * SIZE + c;
+	}
+	return count;
+}
+
+uint64_t GomokuBoard::getScanCount() const {
+	return scans;
+}
+
+//                                     ***  GomokuBoard helper functions ***
+
+// 9 cell windows centred on the cell, lane per direction: the player's stones (the cell included) & empty cells
+void GomokuBoard::packWindows(int cell, Player player, uint64_t& mine, uint64_t& empty) const {
+	validateCell(cell);
+	scans++;
+	Player opponent = (player == TicTacToeBoard::X) ? TicTacToeBoard::O : TicTacToeBoard::X;
+	mine = 0;
+	empty = 0;
+	for (int direction = 0; direction < DIRECTIONS; direction++) {
+		int line, position;
+		lineOf(cell, direction, line, position);
+		uint32_t stones = lines[player][direction][line] | (1u << position);
+		uint32_t open = VALID.mask[direction][line] & ~(stones | lines[opponent][direction][line]);
+		if (position >= WINDOW_HALF) {
+			stones >>= position - WINDOW_HALF;
+			open >>= position - WINDOW_HALF;
+		}
+		else {
+			stones <<= WINDOW_HALF - position;
+			open <<= WINDOW_HALF - position;
+		}
+		mine |= static_cast<uint64_t>(stones & WINDOW_MASK) << (LANE_BITS * direction);
+		empty |= static_cast<uint64_t>(open & WINDOW_MASK) << (LANE_BITS * direction);
+	}
+}
+
+void GomokuBoard::validateCell(int cell) {
+	if ((cell < 0) || (cell >= CELLS))
+		throw std::invalid_argument("GomokuBoard cell out of range\n");
+}
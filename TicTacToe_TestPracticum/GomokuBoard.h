@@ -0,0 +1,85 @@
+#pragma once
+/*****************************************************************//**
+ * \file   GomokuBoard.h
+ * \brief  large board five in a row - GomokuBoard (15x15, freestyle: five or more wins)
+ *     Scope - board state & threat detection around a move, used by GomokuSearch
+ *
+ * \date   updated: October 2026
+ *
+ * Implementation notes:
+ *     - bit rows: for each player, every row, column, diagonal & anti-diagonal is a 32 bit mask (bit = position
+ *          along the line), so a move updates 4 masks & never touches the rest of the board
+ *     - shapes are read from the 9 cells centred on a cell in each of the 4 directions: the 4 windows are packed
+ *          into one 64 bit word (16 bit lane per direction, own stones & empty cells in two words) & every
+ *          pattern is a few shifts & ANDs on all 4 lanes at once (SIMD within a register) - the cost is the same
+ *          on any board size, nothing outside the windows is read
+ *     - shapes (counted per direction): five, four (one more stone makes five, open fours included), open four
+ *          (_XXXX_, two ways to make five), open three (one more stone makes an open four), plus a potential
+ *          for the quieter shapes: every 5 cell window without opponent stones, weighted by the player's stones
+ *     - cells near stones (within 2) are counted incrementally, they are the candidate moves for the searches
+ *     - cells out of range throw an invalid argument exception, as in TicTacToeBoard & MnkBoard
+ *
+ * static int cellIndex(row, col)          - cell number, row * SIZE + column
+ * bool play(cell)                         - current player takes the cell & the turn passes, false if taken
+ * void undo(cell)                         - takes back the last move (must be the cell last played)
+ * Shapes getShapes(cell, player)          - shapes the player has through the cell, or would have by playing it
+ * int getFiveCells(cell, player, cells[]) - empty cells completing a five for the player along the lines through cell
+ * int getCandidates(cells[])              - empty cells within 2 of a stone (the centre on an empty board)
+ **/
+
+#include <cstdint>
+#include "TicTacToeBoard.h"
+
+class GomokuBoard
+{
+public:
+	typedef TicTacToeBoard::Player Player;
+
+	static constexpr int SIZE = 15;
+	static constexpr int CELLS = SIZE * SIZE;
+	static constexpr int WIN_LENGTH = 5;
+	static constexpr int DIRECTIONS = 4;                  // row, column, diagonal, anti-diagonal
+	static constexpr int LINES = 2 * SIZE - 1;            // most lines in one direction (the diagonals)
+	static constexpr int NEAR_DISTANCE = 2;               // candidate moves are this close to a stone
+	static constexpr int MAX_FIVE_CELLS = 2 * DIRECTIONS * WIN_LENGTH;
+
+	// # of directions through the cell with each shape
+	struct Shapes {
+		uint8_t fives = 0;
+		uint8_t fours = 0;            // includes open fours
+		uint8_t openFours = 0;
+		uint8_t openThrees = 0;
+		uint8_t threeDirections = 0;  // bit per direction with an open three
+		uint16_t potential = 0;       // 5 cell windows free of opponent stones, weighted by the player's stones
+	};
+
+	GomokuBoard();
+	static int cellIndex(int row, int col);
+
+	Player getPlayer() const;                             // player to move
+	int getPly() const;                                   // # of cells played
+	bool isSquareEmpty(int cell) const;
+	bool isFull() const;
+
+	bool play(int cell);
+	void undo(int cell);
+	bool isWinningMove(int cell) const;                   // five through a cell just played
+
+	Shapes getShapes(int cell, Player player) const;
+	int getFiveCells(int cell, Player player, int cells[MAX_FIVE_CELLS]) const;
+	int getCandidates(int cells[CELLS]) const;
+	int getNearCount(int cell) const;                     // stones within NEAR_DISTANCE of the cell
+	int getLineCells(int cell, int direction, int cells[2 * (WIN_LENGTH - 1)]) const;  // empty cells within 4 along a line
+	uint64_t getScanCount() const;                        // getShapes() & getFiveCells() calls, for throughput reports
+
+private:
+	uint32_t lines[2][DIRECTIONS][LINES] = {};            // [player][direction][line], bit per position on the line
+	uint8_t nearCount[CELLS] = {};
+	uint8_t occupied[CELLS] = {};                         // Player + 1, 0 = empty
+	Player player = TicTacToeBoard::INITIAL_PLAYER;
+	int ply = 0;
+	mutable uint64_t scans = 0;
+
+	void packWindows(int cell, Player player, uint64_t& mine, uint64_t& empty) const;
+	static void validateCell(int cell);
+};
@@ -0,0 +1,264 @@
+// GomokuSearch.cpp
+//   Threat space search for five in a row - VCF & VCT solvers, candidate scoring as the fallback
+//   <blank line>
+
+#include <algorithm>
+#include <stdexcept>
+#include "GomokuSearch.h"
+#include "BitHelpers.h"
+
+/*
+ * Instance variables (declared in header file)
+ *   threatSpace - true to use the VCF / VCT solvers, false to play by candidate scores only
+ *   deadline - stop condition of the current phase of the search
+ *   nodes - threat space positions searched so far
+ *   stopped - set once the deadline passes, the solvers unwind & report no win
+ */
+
+namespace {
+	constexpr int FIVE_SCORE = 100000;
+	constexpr int WINNING_FOUR_SCORE = 20000;    // open four or two fours, can't be blocked
+	constexpr int FOUR_SCORE = 1000;
+	constexpr int OPEN_THREE_SCORE = 400;
+
+	int shapeScore(const GomokuBoard::Shapes& shapes) {
+		int score = shapes.fives * FIVE_SCORE + shapes.fours * FOUR_SCORE + shapes.openThrees * OPEN_THREE_SCORE +
+			shapes.potential;
+		if ((shapes.openFours > 0) || (shapes.fours > 1))
+			score += WINNING_FOUR_SCORE;
+		return score;
+	}
+}
+
+GomokuSearch::GomokuSearch(bool threatSpace)
+	: threatSpace(threatSpace) {
+}
+
+// Picks the move for the player to move - see the order of play in the header notes
+GomokuSearch::Result GomokuSearch::search(const GomokuBoard& root, std::chrono::milliseconds budget) {
+	if (root.isFull())
+		throw std::invalid_argument("GomokuSearch::search called on a full board\n");
+
+	auto start = std::chrono::steady_clock::now();
+	deadline = start + budget / 2;
+	nodes = 0;
+	stopped = false;
+	GomokuBoard board = root;
+	GomokuBoard::Player player = board.getPlayer();
+	GomokuBoard::Player opponent = opponentOf(player);
+	int candidates[GomokuBoard::CELLS];
+	int count = board.getCandidates(candidates);
+
+	Result result;
+	for (int i = 0; (i < count) && (result.bestMove < 0); i++) {
+		if (board.getShapes(candidates[i], player).fives > 0) {
+			result.bestMove = candidates[i];
+			result.forcedWin = true;
+		}
+	}
+	for (int i = 0; (i < count) && (result.bestMove < 0); i++) {
+		if (board.getShapes(candidates[i], opponent).fives > 0)
+			result.bestMove = candidates[i];
+	}
+
+	if ((result.bestMove < 0) && threatSpace) {
+		int move;
+		if (vcf(board, VCF_DEPTH, -1, move)) {
+			result.bestMove = move;
+			result.forcedWin = true;
+		}
+		for (int depth = 1; (depth <= MAX_VCT_DEPTH) && (result.bestMove < 0) && !stopped; depth++) {
+			if (vct(board, depth, move)) {
+				result.bestMove = move;
+				result.forcedWin = true;
+				result.threatDepth = depth;
+			}
+		}
+	}
+
+	if (result.bestMove < 0) {
+		int scores[GomokuBoard::CELLS];
+		for (int i = 0; i < count; i++)
+			scores[candidates[i]] = scoreMove(board, candidates[i]);
+		std::stable_sort(candidates, candidates + count, [&scores](int a, int b) {
+			return scores[a] > scores[b];
+		});
+		result.bestMove = candidates[0];
+
+		// first of the best scoring moves that doesn't leave the opponent a VCF (or a short VCT)
+		deadline = start + budget;
+		stopped = false;
+		for (int i = 0; threatSpace && (i < std::min(count, DEFENCE_CANDIDATES)); i++) {
+			board.play(candidates[i]);
+			int replies[GomokuBoard::MAX_FIVE_CELLS];
+			int fours = board.getFiveCells(candidates[i], player, replies);
+			int move;
+			bool lost = (fours > 0) ? vcf(board, VCF_DEPTH, replies[0], move) : vct(board, DEFENCE_VCT_DEPTH, move);
+			board.undo(candidates[i]);
+			if (stopped)
+				break;
+			if (!lost) {
+				result.bestMove = candidates[i];
+				break;
+			}
+		}
+	}
+
+	result.nodes = nodes;
+	result.scans = board.getScanCount() - root.getScanCount();
+	result.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	return result;
+}
+
+// Forced win by continuous fours for the player to move, move = the first four (or the five)
+bool GomokuSearch::findVcf(const GomokuBoard& root, int maxDepth, int& move) {
+	GomokuBoard board = root;
+	deadline = std::chrono::steady_clock::time_point::max();
+	nodes = 0;
+	stopped = false;
+	return vcf(board, maxDepth, -1, move);
+}
+
+//                                     ***  GomokuSearch helper functions ***
+
+// VCF for the player to move - mustBlock is the cell completing a five for the defender (-1 if none), the
+//   attacker may only play there, & only if it makes a four
+bool GomokuSearch::vcf(GomokuBoard& board, int depth, int mustBlock, int& move) {
+	nodes++;
+	if ((nodes % NODES_PER_POLL == 0) && pollStop())
+		return false;
+
+	GomokuBoard::Player attacker = board.getPlayer();
+	GomokuBoard::Player defender = opponentOf(attacker);
+	int candidates[GomokuBoard::CELLS];
+	int count = board.getCandidates(candidates);
+	for (int i = 0; i < count; i++) {
+		if (board.getShapes(candidates[i], attacker).fives > 0) {
+			move = candidates[i];
+			return true;
+		}
+	}
+	if (depth == 0)
+		return false;
+
+	for (int i = 0; i < count; i++) {
+		int cell = candidates[i];
+		if (((mustBlock >= 0) && (cell != mustBlock)) || (board.getShapes(cell, attacker).fours == 0))
+			continue;
+		board.play(cell);
+		int replies[GomokuBoard::MAX_FIVE_CELLS];
+		int replyCount = board.getFiveCells(cell, attacker, replies);
+		bool win = replyCount >= 2;                   // open four or double four
+		if (replyCount == 1) {
+			board.play(replies[0]);
+			int counters[GomokuBoard::MAX_FIVE_CELLS];
+			int counterCount = board.getFiveCells(replies[0], defender, counters);
+			int next;
+			win = (counterCount < 2) && !board.isWinningMove(replies[0]) &&
+				vcf(board, depth - 1, (counterCount == 1) ? counters[0] : -1, next);
+			board.undo(replies[0]);
+		}
+		board.undo(cell);
+		if (win) {
+			move = cell;
+			return true;
+		}
+		if (stopped)
+			return false;
+	}
+	return false;
+}
+
+// VCT for the player to move (the defender has no five to make) - a VCF, or an open three that wins against
+//   every answer (see threatHolds)
+bool GomokuSearch::vct(GomokuBoard& board, int depth, int& move) {
+	if (vcf(board, VCF_DEPTH, -1, move))
+		return true;
+	if ((depth == 0) || stopped)
+		return false;
+
+	GomokuBoard::Player attacker = board.getPlayer();
+	int candidates[GomokuBoard::CELLS];
+	int count = board.getCandidates(candidates);
+	for (int i = 0; i < count; i++) {
+		int cell = candidates[i];
+		GomokuBoard::Shapes shapes = board.getShapes(cell, attacker);
+		if (shapes.openThrees == 0)
+			continue;
+		board.play(cell);
+		bool holds = threatHolds(board, cell, shapes.threeDirections, cell, depth);
+		board.undo(cell);
+		if (stopped)
+			return false;
+		if (holds) {
+			move = cell;
+			return true;
+		}
+	}
+	return false;
+}
+
+// Defender to move against the open three at threeCell (threeDirections) - true if the attacker wins against
+//   every answer: the empty cells along the three & every four the defender can make
+//   a defender's four is blocked (lastAttack) & the three is still there to answer, unless the block made a four
+bool GomokuSearch::threatHolds(GomokuBoard& board, int threeCell, uint8_t threeDirections, int lastAttack, int depth) {
+	GomokuBoard::Player defender = board.getPlayer();
+	GomokuBoard::Player attacker = opponentOf(defender);
+	int defences[GomokuBoard::CELLS];
+	int defenceCount = board.getFiveCells(lastAttack, attacker, defences);
+	if (defenceCount >= 2)
+		return true;
+	if (defenceCount == 0) {
+		int lineCells[2 * (GomokuBoard::WIN_LENGTH - 1)];
+		for (int direction = 0; direction < GomokuBoard::DIRECTIONS; direction++) {
+			if ((threeDirections & (1 << direction)) == 0)
+				continue;
+			int lineCount = board.getLineCells(threeCell, direction, lineCells);
+			for (int j = 0; j < lineCount; j++) {
+				if (std::find(defences, defences + defenceCount, lineCells[j]) == defences + defenceCount)
+					defences[defenceCount++] = lineCells[j];
+			}
+		}
+		int replies[GomokuBoard::CELLS];
+		int replyCount = board.getCandidates(replies);
+		for (int j = 0; j < replyCount; j++) {
+			if ((board.getShapes(replies[j], defender).fours > 0) &&
+				(std::find(defences, defences + defenceCount, replies[j]) == defences + defenceCount))
+				defences[defenceCount++] = replies[j];
+		}
+	}
+
+	bool holds = true;
+	for (int j = 0; (j < defenceCount) && holds && !stopped; j++) {
+		board.play(defences[j]);
+		int counters[GomokuBoard::MAX_FIVE_CELLS];
+		int counterCount = board.getFiveCells(defences[j], defender, counters);
+		int next;
+		if (counterCount >= 2)
+			holds = false;
+		else if (counterCount == 1) {
+			board.play(counters[0]);
+			holds = threatHolds(board, threeCell, threeDirections, counters[0], depth);
+			board.undo(counters[0]);
+		}
+		else
+			holds = vct(board, depth - 1, next);
+		board.undo(defences[j]);
+	}
+	return holds && !stopped;
+}
+
+// Candidate score: the shapes the move makes for the player to move, plus those it takes from the opponent
+//   (weighted a little lower), ties broken by the stones around the cell
+int GomokuSearch::scoreMove(const GomokuBoard& board, int cell) const {
+	int attack = shapeScore(board.getShapes(cell, board.getPlayer()));
+	int defence = shapeScore(board.getShapes(cell, opponentOf(board.getPlayer())));
+	return attack + defence * 4 / 5 + board.getNearCount(cell);
+}
+
+// true once the deadline has passed - sets stopped so the solvers unwind
+bool GomokuSearch::pollStop() {
+	if (std::chrono::steady_clock::now() >= deadline)
+		stopped = true;
+	return stopped;
+}
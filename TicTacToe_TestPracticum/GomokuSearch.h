@@ -0,0 +1,65 @@
+#pragma once
+/*****************************************************************//**
+ * \file   GomokuSearch.h
+ * \brief  gomoku engine - GomokuSearch (threat space search)
+ *     Scope - picks a move for the player to move on a GomokuBoard within a time budget, single thread
+ *
+ * \date   updated: October 2026
+ *
+ * Implementation notes:
+ *     - order of play: make five, block the opponent's five, win by continuous fours (VCF), win by fours & open
+ *          threes (VCT, deepened while time is left), otherwise the best scoring candidate that doesn't leave the
+ *          opponent a VCF or a VCT of DEFENCE_VCT_DEPTH
+ *     - threat space search only plays the attacker's threats & the defender's answers to them, so the tree stays
+ *          small on a large board: a four has one answer (the cell completing the five), an open three has the
+ *          empty cells along its line plus any four the defender can make - a double four / open four wins
+ *     - the defender's counter fours are followed: a four made while defending is blocked & the defender still has
+ *          to answer the three, unless the block made a four (then only that is answered)
+ *     - candidates are the empty cells within 2 of a stone, every shape is read with GomokuBoard::getShapes()
+ *          (a constant cost scan around the cell)
+ *     - VCF & VCT share the first half of the budget, the check of the chosen move against the opponent's threats the
+ *          rest - the deadline is polled every NODES_PER_POLL nodes, a search cut off by it finds no win
+ *
+ * Result search(board, budget)            - move to play & whether a forced win was found, throws invalid_argument
+ *                                           if the board is full
+ * bool findVcf(board, maxDepth, move)     - forced win by fours alone for the player to move
+ **/
+
+#include <chrono>
+#include <cstdint>
+#include "GomokuBoard.h"
+
+class GomokuSearch
+{
+public:
+	static constexpr int VCF_DEPTH = 12;              // attacker moves
+	static constexpr int MAX_VCT_DEPTH = 5;
+	static constexpr int DEFENCE_CANDIDATES = 8;      // best scoring moves checked against the opponent's threats
+	static constexpr int DEFENCE_VCT_DEPTH = 1;       // opponent VCT depth checked, 1 catches a double three
+	static constexpr int NODES_PER_POLL = 64;
+
+	struct Result {
+		int bestMove = -1;
+		bool forcedWin = false;       // VCF / VCT (or five) found for the player to move
+		int threatDepth = 0;          // VCT depth of the win found, 0 for VCF or no win
+		uint64_t nodes = 0;           // threat space positions searched
+		uint64_t scans = 0;           // shape scans
+		double milliseconds = 0;
+	};
+
+	explicit GomokuSearch(bool threatSpace = true);
+	Result search(const GomokuBoard& root, std::chrono::milliseconds budget);
+	bool findVcf(const GomokuBoard& root, int maxDepth, int& move);
+
+private:
+	bool threatSpace;                 // false: scoring only, used as a baseline opponent
+	std::chrono::steady_clock::time_point deadline;
+	uint64_t nodes = 0;
+	bool stopped = false;
+
+	bool vcf(GomokuBoard& board, int depth, int mustBlock, int& move);
+	bool vct(GomokuBoard& board, int depth, int& move);
+	bool threatHolds(GomokuBoard& board, int threeCell, uint8_t threeDirections, int lastAttack, int depth);
+	int scoreMove(const GomokuBoard& board, int cell) const;
+	bool pollStop();
+};
@@ -0,0 +1,170 @@
+// LineEvaluator.cpp
+//   Open line counts per player & length, vector kernel for the full count, incremental updates per move
+//   <blank line>
+
+#include <algorithm>
+#include <bitset>
+#include <stdexcept>
+#include <string>
+#include "LineEvaluator.h"
+
+// SSE2 is part of every x64 target (MSVC & gcc / clang), & 32 bit builds that ask for it
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define LINE_EVALUATOR_SSE2
+#include <emmintrin.h>
+#endif
+
+/*
+ * Instance variables (declared in header file)
+ *   rows, cols, k - geometry of the board the tables were built for, reset() rebuilds them for another one
+ *   lines - winning line masks, used to count a position's squares per line on reset()
+ *   throughStart, throughLines - lines through each square (flattened MnkBoard::getLinesThrough())
+ *   counts[] - X & O squares held in each line
+ *   weights[] - score of an open line of each length
+ *   score - sum of the weights of X's open lines less O's, kept current by play() / undo()
+ */
+
+// Constructor - no tables, reset() with a board before use
+LineEvaluator::LineEvaluator() {
+	std::fill(weights, weights + MAX_K + 1, 0);
+}
+
+LineEvaluator::LineEvaluator(const MnkBoard& board)
+	: LineEvaluator() {
+	reset(board);
+}
+
+// Counts for the board's position - squares per line from the bit boards, then the score from the kernel's histograms
+void LineEvaluator::reset(const MnkBoard& board) {
+	if ((board.getRows() != rows) || (board.getCols() != cols) || (board.getK() != k))
+		buildTables(board);
+
+	uint64_t squares[2] = { board.getSquares(TicTacToeBoard::X), board.getSquares(TicTacToeBoard::O) };
+	for (int player = TicTacToeBoard::X; player <= TicTacToeBoard::O; player++) {
+		for (size_t line = 0; line < lines.size(); line++)
+			counts[player][line] = static_cast<uint8_t>(std::bitset<64>(lines[line] & squares[player]).count());
+	}
+
+	int32_t openLines[2][MAX_K + 1] = {};
+	countOpenLines(counts[TicTacToeBoard::X].data(), counts[TicTacToeBoard::O].data(), getLineCount(), k,
+		openLines[TicTacToeBoard::X]);
+	countOpenLines(counts[TicTacToeBoard::O].data(), counts[TicTacToeBoard::X].data(), getLineCount(), k,
+		openLines[TicTacToeBoard::O]);
+	score = 0;
+	for (int length = 1; length <= k; length++)
+		score += weights[length] * (openLines[TicTacToeBoard::X][length] - openLines[TicTacToeBoard::O][length]);
+}
+
+// The player took the square - the lines through it move up one length, or close to the opponent
+void LineEvaluator::play(int position, Player player) {
+	update(position, player, 1);
+}
+
+// The player's square taken back - play() in reverse
+void LineEvaluator::undo(int position, Player player) {
+	update(position, player, -1);
+}
+
+// Score from the player's point of view, clamped to +-MAX_SCORE
+int LineEvaluator::evaluate(Player player) const {
+	int value = (player == TicTacToeBoard::X) ? score : -score;
+	return (value > MAX_SCORE) ? MAX_SCORE : (value < -MAX_SCORE) ? -MAX_SCORE : value;
+}
+
+// Counted when asked (the kernel over every line), only the score is kept current move by move
+int LineEvaluator::getOpenLines(Player player, int length) const {
+	if ((player != TicTacToeBoard::X) && (player != TicTacToeBoard::O))
+		throw std::invalid_argument("Open lines are counted for X or O only\n");
+	if ((length < 1) || (length > k))
+		throw std::invalid_argument("Open line length must be 1 - " + std::to_string(k) + ": " +
+			std::to_string(length) + "\n");
+	int32_t histogram[MAX_K + 1] = {};
+	countOpenLines(counts[player].data(), counts[1 - player].data(), getLineCount(), k, histogram);
+	return histogram[length];
+}
+
+int LineEvaluator::getLineCount() const {
+	return static_cast<int>(lines.size());
+}
+
+// Adds the lines open to "mine" to the histogram by length (1 - k) - LANES lines per step, see the header notes
+void LineEvaluator::countOpenLines(const uint8_t* mine, const uint8_t* theirs, int lines, int k, int32_t* histogram) {
+	int line = 0;
+#ifdef LINE_EVALUATOR_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	for (; line + LANES <= lines; line += LANES) {
+		__m128i own = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mine + line));
+		__m128i other = _mm_loadu_si128(reinterpret_cast<const __m128i*>(theirs + line));
+		__m128i open = _mm_and_si128(own, _mm_cmpeq_epi8(other, zero));      // own count, 0 if blocked
+		for (int length = 1; length <= k; length++) {
+			int matches = _mm_movemask_epi8(_mm_cmpeq_epi8(open, _mm_set1_epi8(static_cast<char>(length))));
+			histogram[length] += static_cast<int32_t>(std::bitset<LANES>(static_cast<unsigned>(matches)).count());
+		}
+	}
+#endif
+	countOpenLinesScalar(mine + line, theirs + line, lines - line, k, histogram);
+}
+
+// Plain loop version of countOpenLines(), also the reference the kernel is tested against
+void LineEvaluator::countOpenLinesScalar(const uint8_t* mine, const uint8_t* theirs, int lines, int k,
+	int32_t* histogram) {
+	for (int line = 0; line < lines; line++) {
+		if ((theirs[line] == 0) && (mine[line] > 0) && (mine[line] <= k))
+			histogram[mine[line]]++;
+	}
+}
+
+const char* LineEvaluator::getKernelName() {
+#ifdef LINE_EVALUATOR_SSE2
+	return "SSE2";
+#else
+	return "scalar";
+#endif
+}
+
+//                                     ***  LineEvaluator helper functions ***
+
+// tables for the board's geometry - line masks, lines through each square (flattened) & weights
+void LineEvaluator::buildTables(const MnkBoard& board) {
+	if (board.getK() > MAX_K)
+		throw std::invalid_argument("Line evaluation supports up to " + std::to_string(MAX_K) + " in a row: " +
+			std::to_string(board.getK()) + "\n");
+	rows = board.getRows();
+	cols = board.getCols();
+	k = board.getK();
+	lines = board.getLines();
+	throughStart.assign(1, 0);
+	throughLines.clear();
+	for (int position = 0; position < board.getSquareCount(); position++) {
+		for (int line : board.getLinesThrough(position))
+			throughLines.push_back(static_cast<uint16_t>(line));
+		throughStart.push_back(static_cast<int>(throughLines.size()));
+	}
+	counts[TicTacToeBoard::X].assign(lines.size(), 0);
+	counts[TicTacToeBoard::O].assign(lines.size(), 0);
+
+	int64_t weight = 1;
+	weights[0] = 0;
+	for (int length = 1; length <= MAX_K; length++) {
+		weights[length] = static_cast<int32_t>(std::min<int64_t>(weight, MAX_SCORE));
+		weight *= 4;
+	}
+}
+
+// play (step 1) or undo (step -1) - per line the count before the move decides, without branches: open to the
+//   player its weight goes up to the next length's, open to the opponent (player's count 0) it closes & their
+//   weight goes, otherwise nothing changes
+void LineEvaluator::update(int position, Player player, int step) {
+	uint8_t* mine = counts[player].data();
+	const uint8_t* theirs = counts[1 - player].data();
+	int taken = (step < 0) ? 1 : 0;
+	int delta = 0;
+	for (int i = throughStart[position]; i < throughStart[position + 1]; i++) {
+		int line = throughLines[i];
+		int m = mine[line] - taken;
+		int t = theirs[line];
+		delta += (t == 0) * (weights[m + 1] - weights[m]) + (m == 0) * weights[t];
+		mine[line] = static_cast<uint8_t>(m + 1 - taken);
+	}
+	score += step * ((player == TicTacToeBoard::X) ? delta : -delta);
+}
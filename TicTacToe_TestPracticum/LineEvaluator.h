@@ -0,0 +1,72 @@
+#pragma once
+/*****************************************************************//**
+ * \file   LineEvaluator.h
+ * \brief  static evaluation - LineEvaluator (open lines per player & length, MnkBoard)
+ *     Scope - scores a position for the search when the game can't be searched to the end (large boards): lines
+ *        still open to one player, weighted by how many of their squares the line holds
+ *
+ * \date   updated: October 2026
+ *
+ * Implementation notes:
+ *     - lines are MnkBoard's winning lines (getLines(), generated as winPatterns), a line holding squares of
+ *          only one player is open to that player, its length the # of squares held (1 - k)
+ *     - per line counts of X & O squares, one byte each, in two arrays (structure of arrays) so the full count
+ *          is a vector kernel: SSE2 compares 16 lines at a time (opponent count == 0, own count == length),
+ *          movemask & popcount per length - scalar loop for the rest & where SSE2 isn't available
+ *     - play() / undo() update only the lines through the square & only the score, without branches (random
+ *          positions would mispredict most of them) - evaluate() is O(1), the histograms per length are counted by
+ *          the kernel when asked for (reset(), getOpenLines())
+ *     - score = sum over lengths of weight(length) * (X's open lines - O's), weight 4^(length - 1) capped at
+ *          MAX_SCORE, from the point of view of the player asked for & clamped to +-MAX_SCORE - below any
+ *          SearchEngine win score, so a forced win always outranks an evaluation
+ *     - k greater than MAX_K throws an invalid argument exception
+ *
+ * LineEvaluator(board)                           - tables & counts for the board's geometry & position
+ * void reset(board)                              - counts for another position (tables rebuilt if the geometry differs)
+ * void play(position, player), undo(...)         - after MnkBoard::play() / before or after MnkBoard::undo()
+ * int evaluate(player)                           - score for the player, see notes
+ * int getOpenLines(player, length)               - # of lines open to the player holding length of its squares
+ * static void countOpenLines(mine, theirs, ...)  - the vector kernel, adds to a histogram per length
+ **/
+
+#include <cstdint>
+#include <vector>
+#include "MnkBoard.h"
+
+class LineEvaluator
+{
+public:
+	typedef TicTacToeBoard::Player Player;
+
+	static constexpr int MAX_K = 16;
+	static constexpr int MAX_SCORE = 500;
+	static constexpr int LANES = 16;                      // lines per SSE2 step
+
+	LineEvaluator();
+	explicit LineEvaluator(const MnkBoard& board);
+
+	void reset(const MnkBoard& board);
+	void play(int position, Player player);
+	void undo(int position, Player player);
+	int evaluate(Player player) const;
+	int getOpenLines(Player player, int length) const;
+	int getLineCount() const;
+
+	static void countOpenLines(const uint8_t* mine, const uint8_t* theirs, int lines, int k, int32_t* histogram);
+	static void countOpenLinesScalar(const uint8_t* mine, const uint8_t* theirs, int lines, int k, int32_t* histogram);
+	static const char* getKernelName();                   // "SSE2" or "scalar"
+
+private:
+	int rows = 0;                                         // geometry the tables were built for
+	int cols = 0;
+	int k = 0;
+	std::vector<uint64_t> lines;                          // masks, as MnkBoard::getLines()
+	std::vector<int> throughStart;                        // per square, first entry in throughLines (+1 entry)
+	std::vector<uint16_t> throughLines;                   // lines through each square, one after the other
+	std::vector<uint8_t> counts[2];                       // squares held per line, indexed by Player X / O
+	int32_t weights[MAX_K + 1];
+	int score = 0;                                        // X's point of view, not clamped
+
+	void buildTables(const MnkBoard& board);
+	void update(int position, Player player, int step);
+};
@@ -0,0 +1,219 @@
+// LocalSocket.cpp
+//   Unix domain stream socket, listen / accept / connect & whole buffer transfers
+//   <blank line>
+
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include "LocalSocket.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <winsock2.h>
+#include <afunix.h>
+#pragma comment(lib, "ws2_32.lib")
+#else
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#if !defined(_WIN32) && defined(MSG_NOSIGNAL)
+#define SEND_FLAGS MSG_NOSIGNAL             // a closed peer is a false return, not a signal
+#else
+#define SEND_FLAGS 0
+#endif
+#if !defined(_WIN32) && defined(SOCK_CLOEXEC)
+#define SOCKET_FLAGS SOCK_CLOEXEC           // not inherited by worker processes started later
+#else
+#define SOCKET_FLAGS 0
+#endif
+
+/*
+ * Instance variables (declared in header file)
+ *   handle - the socket, -1 (INVALID_SOCKET) once closed or moved from
+ *   boundPath - file system name of a listening socket, removed with it
+ */
+
+namespace {
+#ifdef _WIN32
+	typedef SOCKET NativeSocket;
+	typedef int TransferSize;
+	typedef WSAPOLLFD PollEntry;
+
+	int pollSockets(PollEntry* entries, size_t count, int milliseconds) {
+		return WSAPoll(entries, static_cast<ULONG>(count), milliseconds);
+	}
+
+	void closeSocket(NativeSocket socket) {
+		closesocket(socket);
+	}
+#else
+	typedef int NativeSocket;
+	typedef size_t TransferSize;
+	typedef pollfd PollEntry;
+
+	int pollSockets(PollEntry* entries, size_t count, int milliseconds) {
+		return poll(entries, static_cast<nfds_t>(count), milliseconds);
+	}
+
+	void closeSocket(NativeSocket socket) {
+		::close(socket);
+	}
+#endif
+
+	NativeSocket native(intptr_t handle) {
+		return static_cast<NativeSocket>(handle);
+	}
+}
+
+LocalSocket::LocalSocket() {
+}
+
+LocalSocket::LocalSocket(intptr_t handle)
+	: handle(handle) {
+}
+
+LocalSocket::~LocalSocket() {
+	close();
+}
+
+LocalSocket::LocalSocket(LocalSocket&& other)
+	: handle(other.handle), boundPath(std::move(other.boundPath)) {
+	other.handle = -1;
+	other.boundPath.clear();
+}
+
+LocalSocket& LocalSocket::operator=(LocalSocket&& other) {
+	if (this != &other) {
+		close();
+		handle = other.handle;
+		boundPath = std::move(other.boundPath);
+		other.handle = -1;
+		other.boundPath.clear();
+	}
+	return *this;
+}
+
+// Listening socket bound to the path (a stale socket file of that name is removed first)
+//   throws runtime_error if the socket can't be bound or listen
+LocalSocket LocalSocket::listen(const std::string& path) {
+	sockaddr_un address;
+	fillAddress(path, &address);
+	LocalSocket socket(createSocket());
+	std::remove(path.c_str());
+	if ((bind(native(socket.handle), reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) ||
+		(::listen(native(socket.handle), LISTEN_BACKLOG) != 0))
+		throw std::runtime_error("Unable to listen on local socket: " + path + "\n");
+	socket.boundPath = path;
+	return socket;
+}
+
+// Connection to the socket listening on the path - throws runtime_error if there isn't one
+LocalSocket LocalSocket::connect(const std::string& path) {
+	sockaddr_un address;
+	fillAddress(path, &address);
+	LocalSocket socket(createSocket());
+	if (::connect(native(socket.handle), reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+		throw std::runtime_error("Unable to connect to local socket: " + path + "\n");
+	return socket;
+}
+
+// Next waiting connection (blocks if there is none) - throws runtime_error if accept fails
+LocalSocket LocalSocket::accept() {
+	intptr_t connection = static_cast<intptr_t>(::accept(native(handle), nullptr, nullptr));
+	if (connection == -1)
+		throw std::runtime_error("Unable to accept local socket connection: " + boundPath + "\n");
+	return LocalSocket(connection);
+}
+
+bool LocalSocket::isOpen() const {
+	return handle != -1;
+}
+
+// Closes the socket, a listening socket's file is removed
+void LocalSocket::close() {
+	if (handle != -1)
+		closeSocket(native(handle));
+	handle = -1;
+	if (!boundPath.empty())
+		std::remove(boundPath.c_str());
+	boundPath.clear();
+}
+
+// Sends the whole buffer - false if the connection is gone
+bool LocalSocket::sendAll(const void* data, size_t bytes) {
+	const char* next = static_cast<const char*>(data);
+	while (bytes > 0) {
+		auto sent = send(native(handle), next, static_cast<TransferSize>(bytes), SEND_FLAGS);
+		if (sent <= 0)
+			return false;
+		next += sent;
+		bytes -= static_cast<size_t>(sent);
+	}
+	return true;
+}
+
+// Fills the whole buffer - false if the connection closed (or failed) before it was full
+bool LocalSocket::receiveAll(void* data, size_t bytes) {
+	char* next = static_cast<char*>(data);
+	while (bytes > 0) {
+		auto received = recv(native(handle), next, static_cast<TransferSize>(bytes), 0);
+		if (received <= 0)
+			return false;
+		next += received;
+		bytes -= static_cast<size_t>(received);
+	}
+	return true;
+}
+
+// Waits up to the time given for any of the sockets to be readable (data, a connection to accept, or the other end
+//   closed) - ready[i] is set for each one that is, returns how many (0 on timeout)
+int LocalSocket::waitReadable(const std::vector<const LocalSocket*>& sockets, int milliseconds, std::vector<char>& ready) {
+	std::vector<PollEntry> entries(sockets.size());
+	for (size_t i = 0; i < sockets.size(); i++) {
+		entries[i].fd = native(sockets[i]->handle);
+		entries[i].events = POLLIN;
+		entries[i].revents = 0;
+	}
+	int count = pollSockets(entries.data(), entries.size(), milliseconds);
+	if (count < 0)
+		throw std::runtime_error("Unable to wait on local sockets\n");
+	ready.assign(sockets.size(), 0);
+	for (size_t i = 0; i < sockets.size(); i++)
+		ready[i] = (entries[i].revents & (POLLIN | POLLHUP | POLLERR)) != 0;
+	return count;
+}
+
+//                                     ***  LocalSocket helper functions ***
+
+// new stream socket in the local (Unix) family - Winsock started on first use
+intptr_t LocalSocket::createSocket() {
+#ifdef _WIN32
+	static const bool started = [] {
+		WSADATA data;
+		return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+	}();
+	if (!started)
+		throw std::runtime_error("Unable to start Winsock\n");
+#endif
+	intptr_t created = static_cast<intptr_t>(socket(AF_UNIX, SOCK_STREAM | SOCKET_FLAGS, 0));
+	if (created == -1)
+		throw std::runtime_error("Unable to create local socket\n");
+	return created;
+}
+
+// socket address for the path - throws invalid_argument if the path doesn't fit
+void LocalSocket::fillAddress(const std::string& path, void* address) {
+	sockaddr_un* local = static_cast<sockaddr_un*>(address);
+	std::memset(local, 0, sizeof(*local));
+	local->sun_family = AF_UNIX;
+	if (path.empty() || (path.size() >= sizeof(local->sun_path)))
+		throw std::invalid_argument("Local socket path must be 1 - " + std::to_string(sizeof(local->sun_path) - 1) +
+			" characters: " + path + "\n");
+	std::memcpy(local->sun_path, path.c_str(), path.size() + 1);
+}
@@ -0,0 +1,64 @@
+#pragma once
+/*****************************************************************//**
+ * \file   LocalSocket.h
+ * \brief  local stream socket - LocalSocket
+ *     Scope - a Unix domain stream socket between processes on the same machine, the transport under
+ *        ShardCoordinator & ShardWorker (sharded simulation)
+ *
+ * \date   updated: October 2026
+ *
+ * Implementation notes:
+ *     - the socket is named by a path in the file system, listen() removes a stale file of that name first &
+ *          the listening socket removes it again when closed
+ *     - sendAll() / receiveAll() move the whole buffer (looping over partial transfers), receiveAll() returns
+ *          false if the other end closed the connection or it failed - a process that exits or is killed closes
+ *          its sockets, so that is how a lost peer shows up
+ *     - waitReadable() waits on several sockets at once (poll, or WSAPoll on Windows), a listening socket is
+ *          readable when a connection is waiting to be accepted
+ *     - POSIX sockets (send without SIGPIPE), or Winsock AF_UNIX on Windows (Windows 10 1803 on)
+ *     - errors (can't create, bind, listen or connect) throw runtime_error, a path too long for a socket
+ *          address (about 100 characters) throws invalid_argument
+ *
+ * static LocalSocket listen(path)               - listening socket bound to the path
+ * static LocalSocket connect(path)              - connection to a listening socket
+ * LocalSocket accept()                          - next waiting connection
+ * bool sendAll(data, bytes), receiveAll(...)    - the whole buffer, false once the connection is gone
+ * static int waitReadable(sockets, ms, ready)   - # of sockets with data (or a connection) waiting, 0 on timeout
+ **/
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class LocalSocket
+{
+public:
+	LocalSocket();
+	~LocalSocket();
+	LocalSocket(LocalSocket&& other);                          // owns the socket, moves only
+	LocalSocket& operator=(LocalSocket&& other);
+	LocalSocket(const LocalSocket&) = delete;
+	LocalSocket& operator=(const LocalSocket&) = delete;
+
+	static LocalSocket listen(const std::string& path);
+	static LocalSocket connect(const std::string& path);
+	LocalSocket accept();
+
+	bool isOpen() const;
+	void close();
+	bool sendAll(const void* data, size_t bytes);
+	bool receiveAll(void* data, size_t bytes);
+
+	static int waitReadable(const std::vector<const LocalSocket*>& sockets, int milliseconds, std::vector<char>& ready);
+
+private:
+	static constexpr int LISTEN_BACKLOG = 64;
+
+	intptr_t handle = -1;                                      // int on POSIX, SOCKET on Windows
+	std::string boundPath;                                     // listening socket: removed on close
+
+	explicit LocalSocket(intptr_t handle);
+	static intptr_t createSocket();
+	static void fillAddress(const std::string& path, void* address);
+};
@@ -0,0 +1,130 @@
+// MappedFile.cpp
+//   Fixed size file mapped into memory, flushed to disk on request
+//   <blank line>
+
+#include <algorithm>
+#include <stdexcept>
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*
+ * Instance variables (declared in header file)
+ *   path - file name as supplied
+ *   mapping, mappedSize - the whole file, mapped read / write & shared (writes go to the file)
+ *   fileHandle, mappingHandle (Windows) - kept open for FlushFileBuffers & closed with the mapping
+ */
+
+// Opens (or creates) the file, sizes & maps it - throws runtime_error on failure
+MappedFile::MappedFile(const std::string& path, Mode mode, size_t size)
+	: path(path) {
+	if (size == 0)
+		throw std::invalid_argument("Mapped file needs at least one byte: " + path + "\n");
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+		(mode == CREATE) ? CREATE_ALWAYS : OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		throw std::runtime_error("Unable to open mapped file: " + path + "\n");
+	LARGE_INTEGER existing;
+	if (!GetFileSizeEx(file, &existing)) {
+		CloseHandle(file);
+		throw std::runtime_error("Unable to size mapped file: " + path + "\n");
+	}
+	mappedSize = std::max(size, static_cast<size_t>(existing.QuadPart));
+	fileHandle = file;
+	mappingHandle = CreateFileMappingA(file, nullptr, PAGE_READWRITE, static_cast<DWORD>(mappedSize >> 32),
+		static_cast<DWORD>(mappedSize & 0xFFFFFFFF), nullptr);   // extends the file with zero bytes
+	if (mappingHandle == nullptr) {
+		unmap();
+		throw std::runtime_error("Unable to size mapped file: " + path + "\n");
+	}
+	mapping = static_cast<uint8_t*>(MapViewOfFile(mappingHandle, FILE_MAP_ALL_ACCESS, 0, 0, mappedSize));
+	if (mapping == nullptr) {
+		unmap();
+		throw std::runtime_error("Unable to map file: " + path + "\n");
+	}
+#else
+	int fd = open(path.c_str(), O_RDWR | O_CREAT | ((mode == CREATE) ? O_TRUNC : 0), 0644);
+	struct stat status;
+	if ((fd < 0) || (fstat(fd, &status) != 0)) {
+		if (fd >= 0)
+			close(fd);
+		throw std::runtime_error("Unable to open mapped file: " + path + "\n");
+	}
+	mappedSize = std::max(size, static_cast<size_t>(status.st_size));
+	if ((static_cast<size_t>(status.st_size) < mappedSize) && (ftruncate(fd, static_cast<off_t>(mappedSize)) != 0)) {
+		close(fd);
+		throw std::runtime_error("Unable to size mapped file: " + path + "\n");
+	}
+	void* mapped = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);                          // the mapping keeps the file open
+	if (mapped == MAP_FAILED)
+		throw std::runtime_error("Unable to map file: " + path + "\n");
+	mapping = static_cast<uint8_t*>(mapped);
+#endif
+}
+
+MappedFile::~MappedFile() {
+	unmap();
+}
+
+uint8_t* MappedFile::getData() const {
+	return mapping;
+}
+
+size_t MappedFile::getSize() const {
+	return mappedSize;
+}
+
+const std::string& MappedFile::getPath() const {
+	return path;
+}
+
+// Writes the range to disk & waits for it - throws runtime_error if the system reports a failure
+void MappedFile::flush(size_t offset, size_t length) {
+	if ((offset > mappedSize) || (length > mappedSize - offset))
+		throw std::invalid_argument("Flush range outside mapped file: " + path + "\n");
+	if (length == 0)
+		return;
+
+#ifdef _WIN32
+	bool flushed = FlushViewOfFile(mapping + offset, length) && FlushFileBuffers(static_cast<HANDLE>(fileHandle));
+#else
+	// msync wants a page aligned start
+	size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+	size_t start = offset - offset % page;
+	bool flushed = msync(mapping + start, offset + length - start, MS_SYNC) == 0;
+#endif
+	if (!flushed)
+		throw std::runtime_error("Unable to flush mapped file: " + path + "\n");
+}
+
+//                                     ***  MappedFile helper functions ***
+
+// release the mapping (& on Windows the mapping & file handles)
+void MappedFile::unmap() {
+#ifdef _WIN32
+	if (mapping != nullptr)
+		UnmapViewOfFile(mapping);
+	if (mappingHandle != nullptr)
+		CloseHandle(mappingHandle);
+	if (fileHandle != nullptr)
+		CloseHandle(fileHandle);
+	mappingHandle = nullptr;
+	fileHandle = nullptr;
+#else
+	if (mapping != nullptr)
+		munmap(mapping, mappedSize);
+#endif
+	mapping = nullptr;
+}
@@ -0,0 +1,53 @@
+#pragma once
+/*****************************************************************//**
+ * \file   MappedFile.h
+ * \brief  memory mapped file - MappedFile
+ *     Scope - a file of a fixed size mapped into memory, read & written in place, flushed to disk on request,
+ *        the storage under CheckpointFile (solver checkpoints)
+ *
+ * \date   updated: October 2026
+ *
+ * Implementation notes:
+ *     - OPEN_OR_CREATE keeps an existing file of at least the size asked for (its contents, & its size if
+ *          larger), a new or shorter file is created / extended with zero bytes, CREATE always starts zero filled
+ *     - flush(offset, length) returns once the range is on disk (msync MS_SYNC, or FlushViewOfFile then
+ *          FlushFileBuffers on Windows) - the range is widened to whole pages as the system calls require
+ *     - POSIX open / ftruncate / mmap, or CreateFile / CreateFileMapping / MapViewOfFile on Windows
+ *     - errors (can't open, size or map the file, flush failed) throw runtime_error, a range outside the file
+ *          throws invalid_argument
+ *
+ * MappedFile(path, mode, size)      - opens / creates & maps the file
+ * uint8_t* getData()                - first byte of the mapping, getSize() bytes
+ * void flush(offset, length)        - writes the range to disk, returns when done
+ **/
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class MappedFile
+{
+public:
+	enum Mode { CREATE, OPEN_OR_CREATE };
+
+	MappedFile(const std::string& path, Mode mode, size_t size);
+	~MappedFile();
+	MappedFile(const MappedFile&) = delete;                  // owns the mapping
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	uint8_t* getData() const;
+	size_t getSize() const;
+	const std::string& getPath() const;
+	void flush(size_t offset, size_t length);
+
+private:
+	std::string path;
+	size_t mappedSize = 0;
+	uint8_t* mapping = nullptr;
+#ifdef _WIN32
+	void* fileHandle = nullptr;
+	void* mappingHandle = nullptr;
+#endif
+
+	void unmap();
+};
@@ -0,0 +1,209 @@
+// MnkBoard.cpp
+//   Generalized m x n board with k in a row to win, bit board implementation
+//   <blank line>
+
+#include <stdexcept>
+#include <string>
+#include "MnkBoard.h"
+
+/*
+ * Instance variables (declared in header file)
+ *   geometry - rows, columns, k & the tables derived from them (winning lines, lines through each square)
+ *   squares[] - bit mask of squares played, one per player
+ *   player - player to move, toggled by play() & undo()
+ *   ply - # of squares played
+ *   positionIndex - base 3 number of the position, maintained incrementally by play() & undo()
+ */
+
+// Constructor - empty board, throws invalid_argument if the geometry doesn't fit the bit board
+MnkBoard::MnkBoard(int rows, int cols, int k)
+	: geometry(buildGeometry(rows, cols, k)) {
+}
+
+// Copy of a standard (3x3, three in a row) board, including the player to move
+MnkBoard MnkBoard::fromBoard(const TicTacToeBoard& board) {
+	MnkBoard copy(TicTacToeBoard::BOARD_NUM_ROWS, TicTacToeBoard::BOARD_NUM_COLS, 3);
+	TicTacToeBoard::Snapshot snapshot = board.getSnapshot();
+	for (int pos = 0; pos < copy.getSquareCount(); pos++) {
+		if (snapshot.xSquares & (1u << pos)) {
+			copy.squares[TicTacToeBoard::X] |= 1ull << pos;
+			copy.positionIndex += copy.getPowerOfThree(pos);
+		}
+		else if (snapshot.oSquares & (1u << pos)) {
+			copy.squares[TicTacToeBoard::O] |= 1ull << pos;
+			copy.positionIndex += 2 * copy.getPowerOfThree(pos);
+		}
+	}
+	copy.ply = snapshot.takenSquareCount;
+	copy.player = board.getPlayer();
+	return copy;
+}
+
+int MnkBoard::getRows() const {
+	return geometry->rows;
+}
+
+int MnkBoard::getCols() const {
+	return geometry->cols;
+}
+
+int MnkBoard::getK() const {
+	return geometry->k;
+}
+
+int MnkBoard::getSquareCount() const {
+	return geometry->rows * geometry->cols;
+}
+
+// position numbering is row 0 -> 0 .. cols-1, row 1 -> cols .. 2*cols-1, as in TicTacToeBoard
+int MnkBoard::rowColToPosition(int row, int col) const {
+	if ((row >= geometry->rows) || (col >= geometry->cols) || (row < 0) || (col < 0))
+		throw std::invalid_argument("Invalid row or column passed to MnkBoard.  row: " + std::to_string(row) +
+			"  column: " + std::to_string(col) + "\n");
+	return row * geometry->cols + col;
+}
+
+uint64_t MnkBoard::getSquares(Player player) const {
+	return squares[player];
+}
+
+uint64_t MnkBoard::getAllSquares() const {
+	int count = getSquareCount();
+	return (count == MAX_SQUARES) ? ~0ull : ((1ull << count) - 1);
+}
+
+uint64_t MnkBoard::getEmptySquares() const {
+	return getAllSquares() & ~(squares[TicTacToeBoard::X] | squares[TicTacToeBoard::O]);
+}
+
+MnkBoard::Player MnkBoard::getPlayer() const {
+	return player;
+}
+
+int MnkBoard::getPly() const {
+	return ply;
+}
+
+uint64_t MnkBoard::getPositionIndex() const {
+	return positionIndex;
+}
+
+bool MnkBoard::isSquareEmpty(int position) const {
+	validatePosition(position);
+	return ((squares[TicTacToeBoard::X] | squares[TicTacToeBoard::O]) & (1ull << position)) == 0;
+}
+
+// Current player takes the square & the turn passes to the other player
+//   returns false (board unchanged) if the square is already taken, as writeSquare() does
+bool MnkBoard::play(int position) {
+	if (!isSquareEmpty(position))
+		return false;
+	squares[player] |= 1ull << position;
+	positionIndex += (player == TicTacToeBoard::X ? 1 : 2) * getPowerOfThree(position);
+	ply++;
+	player = (player == TicTacToeBoard::X) ? TicTacToeBoard::O : TicTacToeBoard::X;
+	return true;
+}
+
+// Take back the move on the square - the previous player gets the turn back
+void MnkBoard::undo(int position) {
+	validatePosition(position);
+	player = (player == TicTacToeBoard::X) ? TicTacToeBoard::O : TicTacToeBoard::X;
+	squares[player] &= ~(1ull << position);
+	positionIndex -= (player == TicTacToeBoard::X ? 1 : 2) * getPowerOfThree(position);
+	ply--;
+}
+
+// Return true if any winning line is fully occupied by the player
+bool MnkBoard::isWinner(Player player) const {
+	uint64_t played = squares[player];
+	for (uint64_t line : geometry->lines) {
+		if ((played & line) == line)
+			return true;
+	}
+	return false;
+}
+
+// Return true if the player on the square has a winning line through it
+//   only the lines through the square are checked - use right after play() to test the move just made
+bool MnkBoard::isWinningMove(int position) const {
+	validatePosition(position);
+	uint64_t bit = 1ull << position;
+	uint64_t played = (squares[TicTacToeBoard::X] & bit) ? squares[TicTacToeBoard::X] : squares[TicTacToeBoard::O];
+	for (int line : geometry->linesThrough[position]) {
+		uint64_t mask = geometry->lines[line];
+		if ((played & mask) == mask)
+			return true;
+	}
+	return false;
+}
+
+bool MnkBoard::isFull() const {
+	return ply >= getSquareCount();
+}
+
+const std::vector<uint64_t>& MnkBoard::getLines() const {
+	return geometry->lines;
+}
+
+const std::vector<int>& MnkBoard::getLinesThrough(int position) const {
+	validatePosition(position);
+	return geometry->linesThrough[position];
+}
+
+uint64_t MnkBoard::getPowerOfThree(int position) const {
+	return (position < MAX_INDEXED_SQUARES) ? geometry->powersOfThree[position] : 0;
+}
+
+//                                     ***  MnkBoard helper functions ***
+
+// throws invalid_argument if the position isn't on the board
+void MnkBoard::validatePosition(int position) const {
+	if ((position < 0) || (position >= getSquareCount()))
+		throw std::invalid_argument("Invalid position passed to MnkBoard: " + std::to_string(position) + "\n");
+}
+
+// Builds the winning lines - every run of k squares in a row, column, diagonal or anti-diagonal
+//   for 3x3/k=3 these are the 8 winPatterns used by TicTacToeBoard
+std::shared_ptr<const MnkBoard::Geometry> MnkBoard::buildGeometry(int rows, int cols, int k) {
+	if ((rows < 1) || (cols < 1) || (rows * cols > MAX_SQUARES) || (k < 1) || ((k > rows) && (k > cols)))
+		throw std::invalid_argument("Invalid MnkBoard geometry.  rows: " + std::to_string(rows) +
+			"  columns: " + std::to_string(cols) + "  k: " + std::to_string(k) + "\n");
+
+	std::shared_ptr<Geometry> built = std::make_shared<Geometry>();
+	built->rows = rows;
+	built->cols = cols;
+	built->k = k;
+	built->linesThrough.resize(rows * cols);
+
+	// directions: row, column, diagonal, anti-diagonal (row step, column step)
+	const int directions[4][2] = { { 0, 1 }, { 1, 0 }, { 1, 1 }, { 1, -1 } };
+	for (int d = 0; d < 4; d++) {
+		if ((k == 1) && (d > 0))            // single squares - one "line" each, not one per direction
+			break;
+		int rowStep = directions[d][0];
+		int colStep = directions[d][1];
+		for (int r = 0; r < rows; r++) {
+			for (int c = 0; c < cols; c++) {
+				int endRow = r + (k - 1) * rowStep;
+				int endCol = c + (k - 1) * colStep;
+				if ((endRow >= rows) || (endCol < 0) || (endCol >= cols))
+					continue;
+				uint64_t line = 0;
+				for (int i = 0; i < k; i++) {
+					int pos = (r + i * rowStep) * cols + c + i * colStep;
+					line |= 1ull << pos;
+					built->linesThrough[pos].push_back(static_cast<int>(built->lines.size()));
+				}
+				built->lines.push_back(line);
+			}
+		}
+	}
+
+	uint64_t power = 1;
+	for (int pos = 0; pos < rows * cols && pos < MAX_INDEXED_SQUARES; pos++) {
+		built->powersOfThree.push_back(power);
+		power *= 3;
+	}
+	return built;
+}
@@ -0,0 +1,86 @@
+#pragma once
+/*****************************************************************//**
+ * \file   MnkBoard.h
+ * \brief  generalized board class - MnkBoard (m rows, n columns, k in a row to win)
+ *     Scope - board state & win detection for tic-tac-toe variants (3x3/k=3 is the standard game),
+ *        used by the analysis tools & engines, the interactive game still uses TicTacToeBoard
+ *
+ * \date   updated: October 2026
+ *
+ * Implementation notes:
+ *     - bit board: one 64 bit mask per player, bit (row * cols + column) = position, so at most 64 squares
+ *     - winning lines are generated from the geometry the same way as winPatterns (rows, columns, diagonals),
+ *          each line is a bit mask, plus a square -> lines table so a move only checks the lines through it
+ *     - geometry (lines, tables) is shared between copies of a board, copying a board doesn't copy the tables
+ *     - play()/undo() keep the position index (base 3 number, 1 = X, 2 = O per square) up to date,
+ *          used to number positions (e.g. visited sets), only valid for boards up to MAX_INDEXED_SQUARES
+ *     - positions out of range throw an invalid argument exception, as in TicTacToeBoard
+ *
+ * MnkBoard(rows, cols, k)                 - empty board, X to play (TicTacToeBoard::INITIAL_PLAYER)
+ * static MnkBoard fromBoard(board)        - 3x3/k=3 copy of a TicTacToeBoard
+ * bool play(position)                     - current player takes the square & the turn passes, false if taken
+ * void undo(position)                     - takes back the last move (must be the square last played)
+ * bool isWinner(player)                   - checks all winning lines
+ * bool isWinningMove(position)            - checks only the lines through a square just played
+ **/
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "TicTacToeBoard.h"
+
+class MnkBoard
+{
+public:
+	typedef TicTacToeBoard::Player Player;
+
+	static constexpr int MAX_SQUARES = 64;
+	static constexpr int MAX_INDEXED_SQUARES = 40;       // 3^40 fits in 64 bits
+
+	MnkBoard(int rows, int cols, int k);
+	static MnkBoard fromBoard(const TicTacToeBoard& board);
+
+	int getRows() const;
+	int getCols() const;
+	int getK() const;
+	int getSquareCount() const;
+	int rowColToPosition(int row, int col) const;
+
+	uint64_t getSquares(Player player) const;             // squares occupied by the player
+	uint64_t getEmptySquares() const;
+	uint64_t getAllSquares() const;                       // mask of every square on the board
+	Player getPlayer() const;                             // player to move
+	int getPly() const;                                   // # of squares played
+	uint64_t getPositionIndex() const;                    // base 3 position number, see notes
+	bool isSquareEmpty(int position) const;
+
+	bool play(int position);
+	void undo(int position);
+
+	bool isWinner(Player player) const;
+	bool isWinningMove(int position) const;
+	bool isFull() const;
+
+	const std::vector<uint64_t>& getLines() const;        // every winning line, as a mask
+	const std::vector<int>& getLinesThrough(int position) const;   // indexes into getLines()
+	uint64_t getPowerOfThree(int position) const;         // weight of the square in the position index
+
+private:
+	struct Geometry {
+		int rows;
+		int cols;
+		int k;
+		std::vector<uint64_t> lines;
+		std::vector<std::vector<int>> linesThrough;       // per square, lines containing it
+		std::vector<uint64_t> powersOfThree;
+	};
+
+	std::shared_ptr<const Geometry> geometry;
+	uint64_t squares[2] = { 0, 0 };                       // indexed by Player X / O
+	Player player = TicTacToeBoard::INITIAL_PLAYER;
+	int ply = 0;
+	uint64_t positionIndex = 0;
+
+	void validatePosition(int position) const;
+	static std::shared_ptr<const Geometry> buildGeometry(int rows, int cols, int k);
+};
@@ -0,0 +1,247 @@
+// MoveCache.cpp
+//   Sharded, size bounded cache of search results keyed on the canonical (symmetry reduced) position
+//   <blank line>
+
+#include <fstream>
+#include <stdexcept>
+#include "MoveCache.h"
+#include "BitHelpers.h"
+
+/*
+ * Instance variables (declared in header file)
+ *   capacity - total slots, capacity per shard * SHARDS
+ *   shards - SHARDS independent caches, each with its mutex, slots, CLOCK hand & hash index
+ *   hits, misses, inserts, evictions - counters, relaxed atomics (statistics only)
+ */
+
+namespace {
+	// entry as written to a cache file, see the header notes
+	struct FileEntry {
+		uint64_t squares[2];
+		int8_t rows, cols, k, bestMove, exact, padding;
+		int16_t score;
+		int32_t depth;
+		int32_t reserved;
+	};
+
+	uint64_t hashSquares(const uint64_t squares[2], int rows, int cols, int k) {
+		uint64_t geometry = static_cast<uint64_t>(rows) | (static_cast<uint64_t>(cols) << 8) |
+			(static_cast<uint64_t>(k) << 16);
+		return mix(squares[TicTacToeBoard::X] ^ mix(squares[TicTacToeBoard::O] ^ mix(geometry)));
+	}
+}
+
+// Constructor - capacity is rounded up to a multiple of SHARDS, all slots are allocated here
+//   throws invalid_argument if capacity is 0
+MoveCache::MoveCache(size_t capacity)
+	: hits(0), misses(0), inserts(0), evictions(0) {
+	if (capacity == 0)
+		throw std::invalid_argument("Move cache capacity must be at least 1\n");
+	size_t perShard = (capacity + SHARDS - 1) / SHARDS;
+	this->capacity = perShard * SHARDS;
+	shards.reset(new Shard[SHARDS]);
+	for (int shard = 0; shard < SHARDS; shard++) {
+		shards[shard].slots.resize(perShard);
+		shards[shard].index.reserve(perShard);
+	}
+}
+
+size_t MoveCache::getCapacity() const {
+	return capacity;
+}
+
+// Cached result of the position or one of its symmetries - the best move is mapped onto this board,
+//   nodes is 0 (no search)
+bool MoveCache::lookup(const MnkBoard& board, SearchEngine::Result& result) {
+	int symmetry;
+	Key key = canonicalKey(board, symmetry);
+	Shard& shard = shardFor(key.hash);
+	{
+		std::lock_guard<std::mutex> guard(shard.lock);
+		auto found = shard.index.find(key.hash);
+		if ((found != shard.index.end()) && sameKey(shard.slots[found->second].key, key)) {
+			Slot& slot = shard.slots[found->second];
+			slot.referenced = true;
+			result = SearchEngine::Result();
+			result.score = slot.score;
+			result.depth = slot.depth;
+			result.exact = slot.exact;
+			for (int position = 0; position < board.getSquareCount(); position++) {
+				if (mapSquare(position, symmetry, key.rows, key.cols) == slot.bestMove)
+					result.bestMove = position;
+			}
+			hits.fetch_add(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+	misses.fetch_add(1, std::memory_order_relaxed);
+	return false;
+}
+
+// Caches the result for the position & its symmetries, unless a better result is cached (see notes)
+void MoveCache::store(const MnkBoard& board, const SearchEngine::Result& result) {
+	if (result.bestMove < 0)
+		return;
+	int symmetry;
+	Key key = canonicalKey(board, symmetry);
+	storeCanonical(key, mapSquare(result.bestMove, symmetry, key.rows, key.cols), result);
+}
+
+MoveCache::Stats MoveCache::getStats() const {
+	Stats stats;
+	stats.hits = hits.load(std::memory_order_relaxed);
+	stats.misses = misses.load(std::memory_order_relaxed);
+	stats.inserts = inserts.load(std::memory_order_relaxed);
+	stats.evictions = evictions.load(std::memory_order_relaxed);
+	for (int shard = 0; shard < SHARDS; shard++) {
+		std::lock_guard<std::mutex> guard(shards[shard].lock);
+		stats.entries += shards[shard].used;
+	}
+	return stats;
+}
+
+// Writes every entry to the file (replacing it), returns the # written - throws runtime_error on failure
+size_t MoveCache::save(const std::string& path) const {
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file)
+		throw std::runtime_error("Unable to create move cache file: " + path + "\n");
+
+	std::vector<FileEntry> entries;
+	for (int shard = 0; shard < SHARDS; shard++) {
+		std::lock_guard<std::mutex> guard(shards[shard].lock);
+		for (size_t i = 0; i < shards[shard].used; i++) {
+			const Slot& slot = shards[shard].slots[i];
+			FileEntry entry = { { slot.key.squares[0], slot.key.squares[1] }, slot.key.rows, slot.key.cols,
+				slot.key.k, slot.bestMove, static_cast<int8_t>(slot.exact ? 1 : 0), 0, slot.score, slot.depth, 0 };
+			entries.push_back(entry);
+		}
+	}
+	const uint32_t header[2] = { FILE_MAGIC, FILE_VERSION };
+	const uint64_t count = entries.size();
+	file.write(reinterpret_cast<const char*>(header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+	file.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(FileEntry));
+	if (!file)
+		throw std::runtime_error("Unable to write move cache file: " + path + "\n");
+	return entries.size();
+}
+
+// Adds the entries of a file written by save(), returns the # read - a missing file is not an error (0),
+//   a file in another format or cut short throws runtime_error
+size_t MoveCache::load(const std::string& path) {
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+		return 0;
+
+	uint32_t header[2] = { 0, 0 };
+	uint64_t count = 0;
+	file.read(reinterpret_cast<char*>(header), sizeof(header));
+	file.read(reinterpret_cast<char*>(&count), sizeof(count));
+	if (!file || (header[0] != FILE_MAGIC) || (header[1] != FILE_VERSION))
+		throw std::runtime_error("Not a move cache file: " + path + "\n");
+
+	for (uint64_t i = 0; i < count; i++) {
+		FileEntry entry;
+		file.read(reinterpret_cast<char*>(&entry), sizeof(entry));
+		int squareCount = entry.rows * entry.cols;
+		if (!file || (entry.rows < 1) || (entry.cols < 1) || (squareCount > MnkBoard::MAX_SQUARES) ||
+			(entry.bestMove < 0) || (entry.bestMove >= squareCount))
+			throw std::runtime_error("Corrupt move cache file: " + path + "\n");
+
+		Key key = { { entry.squares[0], entry.squares[1] }, entry.rows, entry.cols, entry.k, 0 };
+		key.hash = hashSquares(key.squares, key.rows, key.cols, key.k);
+		SearchEngine::Result result;
+		result.score = entry.score;
+		result.depth = entry.depth;
+		result.exact = entry.exact != 0;
+		storeCanonical(key, entry.bestMove, result);
+	}
+	return static_cast<size_t>(count);
+}
+
+//                                     ***  MoveCache helper functions ***
+
+MoveCache::Shard& MoveCache::shardFor(uint64_t hash) const {
+	return shards[(hash >> 32) % SHARDS];
+}
+
+// Store with the move already in the canonical symmetry's squares - replaces a worse result of the position,
+//   otherwise takes a free slot or the CLOCK victim
+void MoveCache::storeCanonical(const Key& key, int bestMove, const SearchEngine::Result& result) {
+	Shard& shard = shardFor(key.hash);
+	std::lock_guard<std::mutex> guard(shard.lock);
+	size_t index;
+	auto found = shard.index.find(key.hash);
+	if (found != shard.index.end()) {
+		index = found->second;
+		Slot& cached = shard.slots[index];
+		if (sameKey(cached.key, key) &&
+			(cached.exact || (!result.exact && (cached.depth > result.depth))))
+			return;                                  // cached result is at least as good
+	}
+	else if (shard.used < shard.slots.size()) {
+		index = shard.used++;
+		shard.index[key.hash] = index;
+	}
+	else {
+		while (shard.slots[shard.hand].referenced) {
+			shard.slots[shard.hand].referenced = false;
+			shard.hand = (shard.hand + 1) % shard.slots.size();
+		}
+		index = shard.hand;
+		shard.hand = (shard.hand + 1) % shard.slots.size();
+		shard.index.erase(shard.slots[index].key.hash);
+		shard.index[key.hash] = index;
+		evictions.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	Slot& slot = shard.slots[index];
+	slot.key = key;
+	slot.bestMove = static_cast<int8_t>(bestMove);
+	slot.exact = result.exact;
+	slot.score = static_cast<int16_t>(result.score);
+	slot.depth = result.depth;
+	slot.referenced = false;                         // set by the first hit
+	inserts.fetch_add(1, std::memory_order_relaxed);
+}
+
+// The board's bit boards in the symmetry with the smallest hash (ties to the first), & that symmetry
+MoveCache::Key MoveCache::canonicalKey(const MnkBoard& board, int& symmetry) {
+	Key key;
+	key.rows = static_cast<int8_t>(board.getRows());
+	key.cols = static_cast<int8_t>(board.getCols());
+	key.k = static_cast<int8_t>(board.getK());
+	key.hash = ~0ull;
+	int symmetries = (key.rows == key.cols) ? 8 : 4;
+	for (int candidate = 0; candidate < symmetries; candidate++) {
+		uint64_t mapped[2] = { 0, 0 };
+		for (int player = TicTacToeBoard::X; player <= TicTacToeBoard::O; player++) {
+			uint64_t squares = board.getSquares(static_cast<TicTacToeBoard::Player>(player));
+			for (; squares != 0; squares &= squares - 1)
+				mapped[player] |= 1ull << mapSquare(lowestBit(squares), candidate, key.rows, key.cols);
+		}
+		uint64_t hash = hashSquares(mapped, key.rows, key.cols, key.k);
+		if ((candidate == 0) || (hash < key.hash)) {
+			key.squares[0] = mapped[0];
+			key.squares[1] = mapped[1];
+			key.hash = hash;
+			symmetry = candidate;
+		}
+	}
+	return key;
+}
+
+// Square the position moves to in the symmetry: bit 0 flips the rows, bit 1 the columns, bit 2 transposes
+//   (square boards only)
+int MoveCache::mapSquare(int position, int symmetry, int rows, int cols) {
+	int row = position / cols;
+	int col = position % cols;
+	int mappedRow = (symmetry & 1) ? rows - 1 - row : row;
+	int mappedCol = (symmetry & 2) ? cols - 1 - col : col;
+	return (symmetry & 4) ? mappedCol * cols + mappedRow : mappedRow * cols + mappedCol;
+}
+
+bool MoveCache::sameKey(const Key& a, const Key& b) {
+	return (a.squares[0] == b.squares[0]) && (a.squares[1] == b.squares[1]) && (a.rows == b.rows) &&
+		(a.cols == b.cols) && (a.k == b.k);
+}
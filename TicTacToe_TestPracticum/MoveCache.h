@@ -0,0 +1,109 @@
+#pragma once
+/*****************************************************************//**
+ * \file   MoveCache.h
+ * \brief  solved position cache - MoveCache (sharded, size bounded, thread-safe)
+ *     Scope - search results (best move, score, depth, exact) of positions already searched, in front of the
+ *        engine (AsyncMoveSearch) so repeated positions - openings above all - are answered without a search
+ *
+ * \date   updated: October 2026
+ *
+ * Implementation notes:
+ *     - canonical key: a position & its rotations / reflections (8 on a square board, 4 on a rectangle) are
+ *          one entry - the entry holds the bit boards of the symmetry with the smallest hash & the best move
+ *          in that symmetry's squares, a lookup maps the move back onto the board asked about
+ *     - the board size & k are part of the key, one cache serves every m,n,k variant
+ *     - the full canonical bit boards are compared on lookup, a hash collision is a miss, never a wrong move
+ *     - sharded: SHARDS independent parts picked by the hash, each with its own mutex, so threads looking up
+ *          different positions rarely wait on each other
+ *     - size bounded: capacity is split between the shards, slots allocated once by the constructor, CLOCK
+ *          eviction per shard (a hit sets the slot's reference bit, the hand clears bits until it finds a
+ *          slot not referenced since its last pass)
+ *     - a result replaces the cached one for the same position only if it is at least as good: exact, or not
+ *          exact & searched at least as deep
+ *     - hit / miss / insert (results stored, replacements too) / eviction counters are relaxed atomics
+ *     - warm loading: save() writes every entry to a binary file, load() adds the entries of a file (e.g. one
+ *          saved by an earlier run) - a missing file loads nothing, a file in another format throws runtime_error
+ *
+ * File format (native byte order): "TTMC", uint32 version, uint64 entry count, then per entry uint64 x squares,
+ *     o squares, int8 rows, cols, k, best move, exact (0 / 1), padding, int16 score, int32 depth, reserved
+ *
+ * MoveCache(capacity)                - capacity entries (rounded up to a multiple of SHARDS), invalid_argument if 0
+ * bool lookup(board, result)         - true & the cached result (best move on this board) if the position is cached
+ * void store(board, result)          - caches a search result of the board
+ * Stats getStats()                   - hits, misses, inserts, evictions, entries
+ * size_t save(path), load(path)      - entries written / read, throw runtime_error if the file can't be used
+ **/
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "MnkBoard.h"
+#include "SearchEngine.h"
+
+class MoveCache
+{
+public:
+	static constexpr int SHARDS = 16;
+	static constexpr size_t DEFAULT_CAPACITY = 1 << 16;
+	static constexpr uint32_t FILE_MAGIC = 0x434D5454;      // "TTMC"
+	static constexpr uint32_t FILE_VERSION = 1;
+
+	struct Stats {
+		uint64_t hits = 0;
+		uint64_t misses = 0;
+		uint64_t inserts = 0;
+		uint64_t evictions = 0;
+		size_t entries = 0;
+	};
+
+	MoveCache(size_t capacity = DEFAULT_CAPACITY);
+	MoveCache(const MoveCache&) = delete;
+	MoveCache& operator=(const MoveCache&) = delete;
+
+	size_t getCapacity() const;
+	bool lookup(const MnkBoard& board, SearchEngine::Result& result);
+	void store(const MnkBoard& board, const SearchEngine::Result& result);
+	Stats getStats() const;
+	size_t save(const std::string& path) const;
+	size_t load(const std::string& path);
+
+private:
+	// position in its canonical symmetry - what the cache is keyed on
+	struct Key {
+		uint64_t squares[2];              // X, O bit boards
+		int8_t rows, cols, k;
+		uint64_t hash;
+	};
+	struct Slot {
+		Key key;
+		int8_t bestMove;                  // in the canonical symmetry's squares
+		bool exact;
+		int16_t score;
+		int32_t depth;
+		bool referenced;                  // CLOCK reference bit
+	};
+	struct Shard {
+		std::mutex lock;
+		std::vector<Slot> slots;          // the first `used` are in use
+		size_t used = 0;
+		size_t hand = 0;                  // CLOCK hand
+		std::unordered_map<uint64_t, size_t> index;      // hash -> slot
+	};
+
+	size_t capacity;
+	std::unique_ptr<Shard[]> shards;
+	std::atomic<uint64_t> hits;
+	std::atomic<uint64_t> misses;
+	std::atomic<uint64_t> inserts;
+	std::atomic<uint64_t> evictions;
+
+	Shard& shardFor(uint64_t hash) const;
+	void storeCanonical(const Key& key, int bestMove, const SearchEngine::Result& result);
+	static Key canonicalKey(const MnkBoard& board, int& symmetry);
+	static int mapSquare(int position, int symmetry, int rows, int cols);
+	static bool sameKey(const Key& a, const Key& b);
+};
@@ -0,0 +1,228 @@
+// OpeningStats.cpp
+//   Results per move prefix in a compact trie, per thread shards combined by a parallel reduction
+//   <blank line>
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include "OpeningStats.h"
+
+/*
+ * Instance variables (declared in header files)
+ *   OpeningTrie
+ *     maxDepth - longest prefix counted, moves after it only count towards the shorter prefixes
+ *     nodes - the trie, root at index 0, children linked through firstChild / nextSibling in cell order
+ *   OpeningStats
+ *     shards - one trie per ingesting thread, shard 0 holds everything after merge()
+ */
+
+uint64_t OpeningTrie::Counts::getGames() const {
+	return xWins + oWins + draws;
+}
+
+double OpeningTrie::Counts::getRate(uint64_t count) const {
+	uint64_t games = getGames();
+	return (games > 0) ? static_cast<double>(count) / games : 0.0;
+}
+
+// Constructor - just the root, throws invalid_argument if maxDepth isn't 0 - MAX_DEPTH
+OpeningTrie::OpeningTrie(int maxDepth)
+	: maxDepth(maxDepth), nodes(1) {
+	if ((maxDepth < 0) || (maxDepth > MAX_DEPTH))
+		throw std::invalid_argument("Opening trie depth must be 0 - " + std::to_string(MAX_DEPTH) + ": " +
+			std::to_string(maxDepth) + "\n");
+}
+
+int OpeningTrie::getMaxDepth() const {
+	return maxDepth;
+}
+
+size_t OpeningTrie::getNodeCount() const {
+	return nodes.size();
+}
+
+size_t OpeningTrie::getMemoryBytes() const {
+	return nodes.capacity() * sizeof(Node);
+}
+
+// Counts the result for the empty prefix & each prefix of the game up to maxDepth moves
+void OpeningTrie::addGame(const int* cells, int count, TicTacToeBoard::GameStatus result) {
+	validateCells(cells, count);
+	if (result == TicTacToeBoard::IN_PROGRESS)
+		throw std::invalid_argument("Game in progress can't be added to the opening statistics\n");
+	uint32_t node = 0;
+	addResult(nodes[node].counts, result);
+	for (int move = 0; (move < count) && (move < maxDepth); move++) {
+		node = findOrAddChild(node, cells[move]);
+		addResult(nodes[node].counts, result);
+	}
+}
+
+// Results of the games that started with the cells - zero counts if none did (or the prefix is too long)
+OpeningTrie::Counts OpeningTrie::query(const int* cells, int count) const {
+	validateCells(cells, count);
+	uint32_t node = findPrefix(cells, count);
+	return ((count > 0) && (node == NO_NODE)) ? Counts() : nodes[node].counts;
+}
+
+// Results after each move played from the prefix, in cell order
+std::vector<OpeningTrie::Continuation> OpeningTrie::continuations(const int* cells, int count) const {
+	validateCells(cells, count);
+	std::vector<Continuation> result;
+	uint32_t node = findPrefix(cells, count);
+	if ((count > 0) && (node == NO_NODE))
+		return result;
+	for (uint32_t child = nodes[node].firstChild; child != NO_NODE; child = nodes[child].nextSibling)
+		result.push_back({ nodes[child].cell, nodes[child].counts });
+	return result;
+}
+
+// Adds the other trie's counts, prefixes longer than this trie's maxDepth are left out
+void OpeningTrie::merge(const OpeningTrie& other) {
+	mergeNode(0, other, 0, 0);
+}
+
+// Back to just an empty root, memory released
+void OpeningTrie::clear() {
+	std::vector<Node>(1).swap(nodes);
+}
+
+//                                     ***  OpeningTrie helper functions ***
+
+uint32_t OpeningTrie::findChild(uint32_t node, int cell) const {
+	for (uint32_t child = nodes[node].firstChild; (child != NO_NODE) && (nodes[child].cell <= cell);
+		child = nodes[child].nextSibling) {
+		if (nodes[child].cell == cell)
+			return child;
+	}
+	return NO_NODE;
+}
+
+// child for the cell, added in cell order if it isn't there - nodes may move, so indexes only
+uint32_t OpeningTrie::findOrAddChild(uint32_t node, int cell) {
+	uint32_t previous = NO_NODE;
+	uint32_t child = nodes[node].firstChild;
+	for (; (child != NO_NODE) && (nodes[child].cell < cell); child = nodes[child].nextSibling)
+		previous = child;
+	if ((child != NO_NODE) && (nodes[child].cell == cell))
+		return child;
+
+	uint32_t added = static_cast<uint32_t>(nodes.size());
+	nodes.emplace_back();
+	nodes[added].cell = static_cast<uint8_t>(cell);
+	nodes[added].nextSibling = child;
+	if (previous == NO_NODE)
+		nodes[node].firstChild = added;
+	else
+		nodes[previous].nextSibling = added;
+	return added;
+}
+
+// node of the prefix, NO_NODE if it was never played - the root (also index 0) for an empty prefix
+uint32_t OpeningTrie::findPrefix(const int* cells, int count) const {
+	uint32_t node = 0;
+	for (int move = 0; move < count; move++) {
+		node = findChild(node, cells[move]);
+		if (node == NO_NODE)
+			break;
+	}
+	return node;
+}
+
+// adds the other trie's node (at depth moves) to the node, then the children - new prefixes are added
+void OpeningTrie::mergeNode(uint32_t node, const OpeningTrie& other, uint32_t otherNode, int depth) {
+	Counts& counts = nodes[node].counts;
+	counts.xWins += other.nodes[otherNode].counts.xWins;
+	counts.oWins += other.nodes[otherNode].counts.oWins;
+	counts.draws += other.nodes[otherNode].counts.draws;
+	if (depth >= maxDepth)
+		return;
+	for (uint32_t child = other.nodes[otherNode].firstChild; child != NO_NODE; child = other.nodes[child].nextSibling)
+		mergeNode(findOrAddChild(node, other.nodes[child].cell), other, child, depth + 1);
+}
+
+void OpeningTrie::addResult(Counts& counts, TicTacToeBoard::GameStatus result) {
+	if (result == TicTacToeBoard::X_WINS)
+		counts.xWins++;
+	else if (result == TicTacToeBoard::O_WINS)
+		counts.oWins++;
+	else
+		counts.draws++;
+}
+
+// cells must be on the board & not repeated
+void OpeningTrie::validateCells(const int* cells, int count) {
+	if ((count < 0) || (count > CELLS))
+		throw std::invalid_argument("Invalid # of moves for the opening statistics: " + std::to_string(count) + "\n");
+	uint16_t seen = 0;
+	for (int move = 0; move < count; move++) {
+		if ((cells[move] < 0) || (cells[move] >= CELLS) || (seen & (1u << cells[move])))
+			throw std::invalid_argument("Invalid cell in the opening statistics: " + std::to_string(cells[move]) +
+				"\n");
+		seen |= static_cast<uint16_t>(1u << cells[move]);
+	}
+}
+
+// Constructor - shards empty, throws invalid_argument if shards < 1 (or maxDepth is out of range)
+OpeningStats::OpeningStats(int shards, int maxDepth) {
+	if (shards < 1)
+		throw std::invalid_argument("Opening statistics need at least one shard\n");
+	this->shards.assign(shards, OpeningTrie(maxDepth));
+}
+
+int OpeningStats::getShardCount() const {
+	return static_cast<int>(shards.size());
+}
+
+// The shard for one thread - only that thread may write to it until merge()
+OpeningTrie& OpeningStats::getShard(int index) {
+	if ((index < 0) || (index >= getShardCount()))
+		throw std::invalid_argument("Invalid opening statistics shard: " + std::to_string(index) + "\n");
+	return shards[index];
+}
+
+// Pairwise reduction - each round merges shard i + step into shard i on its own thread (disjoint pairs,
+//   nothing shared), the merged shard is cleared - after log2(shards) rounds shard 0 holds everything
+const OpeningTrie& OpeningStats::merge() {
+	for (size_t step = 1; step < shards.size(); step *= 2) {
+		std::vector<std::thread> mergers;
+		for (size_t i = 0; i + step < shards.size(); i += 2 * step) {
+			mergers.emplace_back([this, i, step] {
+				shards[i].merge(shards[i + step]);
+				shards[i + step].clear();
+			});
+		}
+		for (std::thread& merger : mergers)
+			merger.join();
+	}
+	return shards[0];
+}
+
+// Games from a log (format in the header notes) into the trie, returns the # of games
+//   throws invalid_argument with the line # for a line that isn't a game
+size_t OpeningStats::ingestLog(std::istream& log, OpeningTrie& trie) {
+	std::string line;
+	size_t games = 0;
+	int cells[OpeningTrie::CELLS];
+	for (size_t lineNumber = 1; std::getline(log, line); lineNumber++) {
+		if (!line.empty() && (line.back() == '\r'))
+			line.pop_back();
+		if (line.empty() || (line[0] == '#'))
+			continue;
+
+		size_t space = line.find(' ');
+		bool valid = (space != std::string::npos) && (space <= OpeningTrie::CELLS) && (line.size() == space + 2);
+		for (size_t i = 0; valid && (i < space); i++) {
+			valid = (line[i] >= '0') && (line[i] < '0' + OpeningTrie::CELLS);
+			cells[i] = line[i] - '0';
+		}
+		char outcome = valid ? line[space + 1] : '?';
+		TicTacToeBoard::GameStatus result = (outcome == 'X') ? TicTacToeBoard::X_WINS :
+			(outcome == 'O') ? TicTacToeBoard::O_WINS : (outcome == 'D') ? TicTacToeBoard::DRAW : TicTacToeBoard::IN_PROGRESS;
+		if (result == TicTacToeBoard::IN_PROGRESS)
+			throw std::invalid_argument("Bad game record on line " + std::to_string(lineNumber) + ": " + line + "\n");
+		trie.addGame(cells, static_cast<int>(space), result);
+		games++;
+	}
+	return games;
+}
@@ -0,0 +1,103 @@
+#pragma once
+/*****************************************************************//**
+ * \file   OpeningStats.h
+ * \brief  opening statistics - OpeningTrie (per move prefix results), OpeningStats (sharded aggregation)
+ *     Scope - streams completed games (engine self-play, game logs) into X win / O win / draw counts for every
+ *        move prefix seen, & answers queries such as the results after an opening or the best reply to it
+ *
+ * \date   updated: October 2026
+ *
+ * Implementation notes:
+ *     - a game is its squares in the order played, cell = row * BOARD_NUM_COLS + column (as TicTacToeBoard's
+ *          rowColToPosition()), & its result - nothing else of a game is kept, memory is one node per distinct
+ *          prefix (up to maxDepth moves), whatever the # of games
+ *     - trie nodes in one vector (32 bit indexes, no per node allocation): counts, first child & next sibling,
+ *          siblings kept in cell order - a node is 40 bytes, children of a node are found in at most CELLS steps
+ *     - OpeningStats: one OpeningTrie shard per ingesting thread, each written by its thread only (no locks or
+ *          atomics while ingesting) - merge() combines the shards in a parallel pairwise reduction, every merge
+ *          step owns the two shards it combines, so no shard is shared between threads, then shard 0 holds all
+ *     - game log format: one game per line, the cells as digits then a space & the result X, O or D
+ *          (e.g. "40215 X"), blank lines & lines starting with # are skipped
+ *     - an invalid cell, repeated cell, game still in progress or bad log line throws an invalid argument exception
+ *
+ * OpeningTrie(maxDepth)                     - prefixes of up to maxDepth moves are counted
+ * void addGame(cells, count, result)        - counts the game's result for each of its prefixes
+ * Counts query(cells, count)                - results of the games starting with the cells (zero if none)
+ * std::vector<Continuation> continuations() - results after each next move seen, in cell order
+ * void merge(other)                         - adds the other trie's counts
+ * OpeningStats(shards, maxDepth)            - a shard per ingesting thread
+ * OpeningTrie& getShard(i), merge()         - shard for thread i, all shards combined (returns shard 0)
+ * static size_t ingestLog(stream, trie)     - games read from a log
+ **/
+
+#include <cstdint>
+#include <istream>
+#include <vector>
+#include "TicTacToeBoard.h"
+
+class OpeningTrie
+{
+public:
+	static constexpr int CELLS = TicTacToeBoard::BOARD_NUM_ROWS * TicTacToeBoard::BOARD_NUM_COLS;
+	static constexpr int MAX_DEPTH = CELLS;
+
+	struct Counts {
+		uint64_t xWins = 0;
+		uint64_t oWins = 0;
+		uint64_t draws = 0;
+
+		uint64_t getGames() const;
+		double getRate(uint64_t count) const;     // count / games, 0 if no games
+	};
+
+	struct Continuation {
+		int cell;
+		Counts counts;
+	};
+
+	OpeningTrie(int maxDepth = MAX_DEPTH);
+
+	int getMaxDepth() const;
+	size_t getNodeCount() const;
+	size_t getMemoryBytes() const;
+	void addGame(const int* cells, int count, TicTacToeBoard::GameStatus result);
+	Counts query(const int* cells, int count) const;
+	std::vector<Continuation> continuations(const int* cells, int count) const;
+	void merge(const OpeningTrie& other);
+	void clear();
+
+private:
+	static constexpr uint32_t NO_NODE = 0;        // node 0 is the root, never anyone's child or sibling
+
+	struct Node {
+		Counts counts;
+		uint32_t firstChild = NO_NODE;
+		uint32_t nextSibling = NO_NODE;
+		uint8_t cell = 0;
+	};
+
+	int maxDepth;
+	std::vector<Node> nodes;                      // root first
+
+	uint32_t findChild(uint32_t node, int cell) const;
+	uint32_t findOrAddChild(uint32_t node, int cell);
+	uint32_t findPrefix(const int* cells, int count) const;
+	void mergeNode(uint32_t node, const OpeningTrie& other, uint32_t otherNode, int depth);
+	static void addResult(Counts& counts, TicTacToeBoard::GameStatus result);
+	static void validateCells(const int* cells, int count);
+};
+
+class OpeningStats
+{
+public:
+	OpeningStats(int shards, int maxDepth = OpeningTrie::MAX_DEPTH);
+
+	int getShardCount() const;
+	OpeningTrie& getShard(int index);
+	const OpeningTrie& merge();
+
+	static size_t ingestLog(std::istream& log, OpeningTrie& trie);
+
+private:
+	std::vector<OpeningTrie> shards;
+};
@@ -0,0 +1,219 @@
+// ParallelSearch.cpp
+//   Lazy SMP search over an MnkBoard - independent iterative deepening threads sharing a TranspositionTable
+//   <blank line>
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <thread>
+#include "ParallelSearch.h"
+#include "BitHelpers.h"
+
+/*
+ * Instance variables (declared in header file)
+ *   threadCount - # of search threads, thread 0 runs on the calling thread
+ *   table - results shared by all threads, kept between searches (older generations replaced first)
+ *   deadline - stop condition of the current search
+ *   stop - set by the first thread to see the deadline or to finish the search, every thread unwinds
+ */
+
+namespace {
+	typedef TranspositionTable::Entry Entry;
+}
+
+ParallelSearch::ParallelSearch(int threads, size_t tableSlots)
+	: threadCount(threads), table(tableSlots), stop(false) {
+	if (threads < 1)
+		throw std::invalid_argument("ParallelSearch needs at least one thread\n");
+}
+
+// Search the position with every thread until the deadline, the depth limit or the end of the tree
+//   returns the best move of the deepest completed iteration (the first legal move if none completed)
+ParallelSearch::Result ParallelSearch::search(const MnkBoard& root, std::chrono::milliseconds budget, int maxDepth) {
+	uint64_t empty = root.getEmptySquares();
+	if ((empty == 0) || root.isWinner(TicTacToeBoard::X) || root.isWinner(TicTacToeBoard::O))
+		throw std::invalid_argument("ParallelSearch::search called on a finished game\n");
+
+	auto start = std::chrono::steady_clock::now();
+	deadline = start + budget;
+	stop = false;
+	table.newSearch();
+
+	std::vector<int> order = centreFirst(root);
+	std::vector<Worker> workers(threadCount);
+	for (int id = 0; id < threadCount; id++) {
+		workers[id].id = id;
+		workers[id].moveOrder = order;
+		std::rotate(workers[id].moveOrder.begin(), workers[id].moveOrder.begin() + id % order.size(),
+			workers[id].moveOrder.end());
+	}
+
+	std::vector<std::thread> helpers;
+	for (int id = 1; id < threadCount; id++)
+		helpers.emplace_back(&ParallelSearch::runWorker, this, std::ref(workers[id]), std::cref(root), maxDepth);
+	runWorker(workers[0], root, maxDepth);
+	for (std::thread& helper : helpers)
+		helper.join();
+
+	Result result = workers[0].result;
+	for (const Worker& worker : workers) {
+		if ((worker.result.depth > result.depth) || (worker.result.exact && !result.exact))
+			result = worker.result;
+	}
+	result.nodes = 0;
+	for (const Worker& worker : workers)
+		result.nodes += worker.nodes;
+	result.threads = threadCount;
+	result.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	return result;
+}
+
+//                                     ***  ParallelSearch helper functions ***
+
+// One thread's iterative deepening - as SearchEngine::search, the table move is searched first at the root
+void ParallelSearch::runWorker(Worker& worker, const MnkBoard& root, int maxDepth) {
+	MnkBoard board = root;
+	uint64_t empty = root.getEmptySquares();
+	uint64_t key = hashPosition(root);
+	for (int pos : worker.moveOrder) {
+		if (empty & (1ull << pos)) {
+			worker.result.bestMove = pos;
+			break;
+		}
+	}
+
+	int remaining = root.getSquareCount() - root.getPly();
+	int firstDepth = std::min(1 + worker.id % 2, remaining);
+	for (int depth = firstDepth; depth <= std::min(maxDepth, remaining); depth++) {
+		worker.horizonReached = false;
+		int alpha = -WIN_SCORE - 1;
+		int bestMove = -1;
+
+		Entry entry;
+		int firstMove = (table.probe(key, entry) && (entry.move >= 0)) ? entry.move : worker.result.bestMove;
+		std::vector<int> rootMoves(1, firstMove);
+		for (int pos : worker.moveOrder) {
+			if ((pos != firstMove) && (empty & (1ull << pos)))
+				rootMoves.push_back(pos);
+		}
+		for (int pos : rootMoves) {
+			board.play(pos);
+			int score = board.isWinningMove(pos) ? WIN_SCORE - board.getPly() :
+				-negamax(worker, board, depth - 1, -WIN_SCORE - 1, -alpha);
+			board.undo(pos);
+			if (stop.load(std::memory_order_relaxed))
+				break;
+			if (score > alpha) {
+				alpha = score;
+				bestMove = pos;
+			}
+		}
+		if (stop.load(std::memory_order_relaxed))
+			break;
+
+		worker.result.bestMove = bestMove;
+		worker.result.score = alpha;
+		worker.result.depth = depth;
+		Entry rootEntry;
+		rootEntry.score = alpha;
+		rootEntry.depth = depth;
+		rootEntry.bound = TranspositionTable::EXACT;
+		rootEntry.move = bestMove;
+		table.store(key, rootEntry);
+		if (!worker.horizonReached || (alpha != 0)) {
+			// whole tree searched, or a forced win / loss found - the depth limit only ever scores 0
+			worker.result.exact = true;
+			break;
+		}
+	}
+	// done (or out of depth) - the other threads can't do better than a finished search
+	stop = true;
+}
+
+// Negamax with alpha-beta pruning & the shared table, score from the point of view of the player to move
+//   the move that led here wasn't a win (checked by the caller), so only a full board ends the game
+int ParallelSearch::negamax(Worker& worker, MnkBoard& board, int depth, int alpha, int beta) {
+	worker.nodes++;
+	if ((worker.nodes % NODES_PER_POLL == 0) && pollStop())
+		return 0;
+	if (board.isFull())
+		return 0;
+	if (depth == 0) {
+		worker.horizonReached = true;
+		return 0;
+	}
+
+	uint64_t empty = board.getEmptySquares();
+	uint64_t key = hashPosition(board);
+	Entry entry;
+	int tableMove = TranspositionTable::NO_MOVE;
+	if (table.probe(key, entry)) {
+		tableMove = entry.move;
+		if ((entry.depth >= depth) && ((entry.bound == TranspositionTable::EXACT) ||
+			((entry.bound == TranspositionTable::LOWER) && (entry.score >= beta)) ||
+			((entry.bound == TranspositionTable::UPPER) && (entry.score <= alpha)))) {
+			if (entry.depth < bitCount(empty))
+				worker.horizonReached = true;
+			return entry.score;
+		}
+	}
+
+	int originalAlpha = alpha;
+	int best = -WIN_SCORE - 1;
+	int bestMove = TranspositionTable::NO_MOVE;
+	for (int i = -1; i < static_cast<int>(worker.moveOrder.size()); i++) {
+		int pos = (i < 0) ? tableMove : worker.moveOrder[i];
+		if ((pos < 0) || ((empty & (1ull << pos)) == 0) || ((i >= 0) && (pos == tableMove)))
+			continue;
+		board.play(pos);
+		int score = board.isWinningMove(pos) ? WIN_SCORE - board.getPly() :
+			-negamax(worker, board, depth - 1, -beta, -alpha);
+		board.undo(pos);
+		if (stop.load(std::memory_order_relaxed))
+			return 0;
+		if (score > best) {
+			best = score;
+			bestMove = pos;
+			alpha = std::max(alpha, score);
+			if (alpha >= beta)
+				break;
+		}
+	}
+
+	Entry result;
+	result.score = best;
+	result.depth = depth;
+	result.bound = (best <= originalAlpha) ? TranspositionTable::UPPER :
+		(best >= beta) ? TranspositionTable::LOWER : TranspositionTable::EXACT;
+	result.move = bestMove;
+	table.store(key, result);
+	return best;
+}
+
+// true once the deadline has passed or another thread has stopped the search - sets stop for every thread
+bool ParallelSearch::pollStop() {
+	if (std::chrono::steady_clock::now() >= deadline)
+		stop = true;
+	return stop.load(std::memory_order_relaxed);
+}
+
+// Squares sorted by distance from the centre of the board, as SearchEngine
+std::vector<int> ParallelSearch::centreFirst(const MnkBoard& board) {
+	std::vector<int> order;
+	for (int pos = 0; pos < board.getSquareCount(); pos++)
+		order.push_back(pos);
+	int rows = board.getRows();
+	int cols = board.getCols();
+	std::stable_sort(order.begin(), order.end(), [rows, cols](int a, int b) {
+		// distances doubled so the centre of an even sized board is a whole number
+		int distanceA = std::abs(2 * (a / cols) - (rows - 1)) + std::abs(2 * (a % cols) - (cols - 1));
+		int distanceB = std::abs(2 * (b / cols) - (rows - 1)) + std::abs(2 * (b % cols) - (cols - 1));
+		return distanceA < distanceB;
+	});
+	return order;
+}
+
+// Position key - the two bit boards (the player to move follows from them)
+uint64_t ParallelSearch::hashPosition(const MnkBoard& board) {
+	return mix(board.getSquares(TicTacToeBoard::X) ^ mix(board.getSquares(TicTacToeBoard::O)));
+}
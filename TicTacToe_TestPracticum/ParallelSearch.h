@@ -0,0 +1,73 @@
+#pragma once
+/*****************************************************************//**
+ * \file   ParallelSearch.h
+ * \brief  multi-threaded move search - ParallelSearch (Lazy SMP)
+ *     Scope - finds the best move for the player to move on an MnkBoard with several threads, for the harder
+ *        k in a row variants (analysis runs), same scores & result as SearchEngine
+ *
+ * \date   updated: October 2026
+ *
+ * Implementation notes:
+ *     - Lazy SMP: every thread runs its own iterative deepening alpha-beta from the root, nothing is split or
+ *          synchronized except the shared TranspositionTable - threads find each other's results there & skip
+ *          those subtrees, so the extra threads speed up the main one instead of repeating its work
+ *     - helper threads are spread out: odd ones start one ply deeper, & each rotates the move order (after the
+ *          table move) by its thread number, so they reach different parts of the tree first
+ *     - key = hash of the two bit boards (the board geometry is fixed for a search); the ply is part of the
+ *          position, so win / loss scores are stored as they are
+ *     - a table hit searched short of the end of the game counts as a horizon (the result is not exact)
+ *     - stop: the deadline, the depth limit or a thread finishing the whole tree (exact) stops every thread,
+ *          the result is the deepest completed iteration of any thread (thread 0 on a tie)
+ *
+ * Result search(board, budget, maxDepth) - best move & score, throws invalid_argument if no move is possible
+ **/
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include "MnkBoard.h"
+#include "TranspositionTable.h"
+
+class ParallelSearch
+{
+public:
+	static constexpr int WIN_SCORE = 1000;                      // as SearchEngine
+	static constexpr int NODES_PER_POLL = 1024;
+	static constexpr int UNLIMITED_DEPTH = 64;
+	static constexpr size_t DEFAULT_TABLE_SLOTS = 1 << 22;      // 64 MB
+
+	struct Result {
+		int bestMove = -1;
+		int score = 0;
+		int depth = 0;                // deepest completed iteration
+		uint64_t nodes = 0;           // all threads
+		bool exact = false;
+		int threads = 0;
+		double milliseconds = 0;
+	};
+
+	explicit ParallelSearch(int threads, size_t tableSlots = DEFAULT_TABLE_SLOTS);
+	Result search(const MnkBoard& root, std::chrono::milliseconds budget, int maxDepth = UNLIMITED_DEPTH);
+
+private:
+	// per thread state, each thread only touches its own
+	struct Worker {
+		int id = 0;
+		std::vector<int> moveOrder;
+		uint64_t nodes = 0;
+		bool horizonReached = false;
+		Result result;
+	};
+
+	int threadCount;
+	TranspositionTable table;
+	std::chrono::steady_clock::time_point deadline;
+	std::atomic<bool> stop;
+
+	void runWorker(Worker& worker, const MnkBoard& root, int maxDepth);
+	int negamax(Worker& worker, MnkBoard& board, int depth, int alpha, int beta);
+	bool pollStop();
+	static std::vector<int> centreFirst(const MnkBoard& board);
+	static uint64_t hashPosition(const MnkBoard& board);
+};
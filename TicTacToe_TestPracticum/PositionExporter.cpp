@@ -0,0 +1,358 @@
+// PositionExporter.cpp
+//   Streams labelled positions to a columnar binary file, worker threads build blocks, one thread writes them
+//   <blank line>
+
+#include <algorithm>
+#include <bitset>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include "PositionExporter.h"
+
+/*
+ * Instance variables (declared in header file)
+ *   rows, cols, k - board geometry
+ *   numThreads - worker threads building blocks (plus the calling thread, which writes them)
+ *   squareWidth - bytes per square mask column, 1 for up to 8 squares, 2 otherwise
+ *   powersOfThree - weight of each square in the position number
+ *   table - solve table, one byte per position number, see notes in the header
+ *   nextWorkItem - next position range / game / solve item to hand to a worker
+ *   fullBlocks, freeBlocks - blocks waiting to be written & blocks ready for reuse, guarded by queueLock
+ *   blockReady, spaceReady - signal the writer (block queued, worker finished) & the workers (block written)
+ *   workersRunning - workers still producing, the writer stops once this is 0 & the queue is empty
+ */
+
+namespace {
+	// value in width bytes, least significant first - the file is little endian on any host
+	void putLittleEndian(unsigned char* out, uint64_t value, int width) {
+		for (int b = 0; b < width; b++)
+			out[b] = static_cast<unsigned char>(value >> (8 * b));
+	}
+
+	// column names & whether the column is signed, in file order (widths depend on the board, see columnWidth())
+	const char* const COLUMN_NAMES[PositionExporter::COLUMN_COUNT] =
+		{ "x_squares", "o_squares", "value", "optimal_moves", "ply", "side_to_move" };
+	const bool COLUMN_SIGNED[PositionExporter::COLUMN_COUNT] = { false, false, true, false, false, false };
+	constexpr int X_COLUMN = 0;
+	constexpr int O_COLUMN = 1;
+	constexpr int VALUE_COLUMN = 2;
+	constexpr int OPTIMAL_COLUMN = 3;
+	constexpr int PLY_COLUMN = 4;
+	constexpr int SIDE_COLUMN = 5;
+	constexpr int COLUMN_NAME_CHARS = 16;
+	constexpr uint64_t RANGE_SIZE = 1 << 16;      // position numbers per exhaustive work item
+}
+
+// Constructor - geometry is validated by MnkBoard, the solve table limits the board to MAX_SQUARES
+PositionExporter::PositionExporter(int rows, int cols, int k, int numThreads)
+	: rows(rows), cols(cols), k(k), numThreads(numThreads < 1 ? 1 : numThreads), nextWorkItem(0) {
+	MnkBoard validate(rows, cols, k);      // throws invalid_argument for a bad geometry
+	if (validate.getSquareCount() > MAX_SQUARES)
+		throw std::invalid_argument("Position export is limited to " + std::to_string(MAX_SQUARES) +
+			" squares, board has " + std::to_string(validate.getSquareCount()) + "\n");
+	squareWidth = (validate.getSquareCount() <= 8) ? 1 : 2;
+	for (int pos = 0; pos < validate.getSquareCount(); pos++)
+		powersOfThree.push_back(validate.getPowerOfThree(pos));
+}
+
+// Every reachable position once - the workers take ranges of position numbers, unreachable ones are skipped
+PositionExporter::Result PositionExporter::exportAll(const std::string& path) {
+	Result result;
+	solveTable(result);
+	uint64_t positionCount = powersOfThree.back() * 3;
+	uint64_t rangeCount = (positionCount + RANGE_SIZE - 1) / RANGE_SIZE;
+
+	nextWorkItem.store(0);
+	runExport(path, [this, positionCount, rangeCount](std::unique_ptr<Block>& block, uint64_t& rowCount) {
+		for (uint64_t range = nextWorkItem.fetch_add(1); range < rangeCount; range = nextWorkItem.fetch_add(1)) {
+			uint64_t first = range * RANGE_SIZE;
+			exportRange(first, std::min(first + RANGE_SIZE, positionCount), block, rowCount);
+		}
+	}, result);
+	return result;
+}
+
+// Every position of games played with uniformly random moves, from the empty board to the end of the game
+//   each worker has its own generator (seed + worker #), so the rows depend on the thread count
+PositionExporter::Result PositionExporter::exportSelfPlay(const std::string& path, uint64_t games, unsigned seed) {
+	Result result;
+	solveTable(result);
+
+	nextWorkItem.store(0);
+	std::atomic<unsigned> nextSeed(seed);
+	runExport(path, [this, games, &nextSeed](std::unique_ptr<Block>& block, uint64_t& rowCount) {
+		std::mt19937 random(nextSeed.fetch_add(1));
+		while (nextWorkItem.fetch_add(1) < games)
+			playRandomGame(random, block, rowCount);
+	}, result);
+	return result;
+}
+
+//                                     ***  Exporter helper functions ***
+
+// Solve every reachable position - the positions after two moves are solved by the workers, then the
+//   top of the tree on this thread (its children are already in the table)
+void PositionExporter::solveTable(Result& result) {
+	auto start = std::chrono::steady_clock::now();
+	uint64_t positionCount = powersOfThree.back() * 3;
+	table.reset(new std::atomic<uint8_t>[static_cast<size_t>(positionCount)]);
+	for (uint64_t p = 0; p < positionCount; p++)
+		table[p].store(0, std::memory_order_relaxed);
+
+	// work items - first & second move, the first move must not end the game
+	MnkBoard root(rows, cols, k);
+	std::vector<std::pair<int, int>> workItems;
+	for (int first = 0; first < root.getSquareCount(); first++) {
+		root.play(first);
+		if (!root.isWinningMove(first) && !root.isFull()) {
+			for (int second = 0; second < root.getSquareCount(); second++) {
+				if (second != first)
+					workItems.push_back(std::make_pair(first, second));
+			}
+		}
+		root.undo(first);
+	}
+
+	nextWorkItem.store(0);
+	std::vector<std::thread> workers;
+	for (int t = 0; t < numThreads; t++) {
+		workers.emplace_back([this, &workItems]() {
+			MnkBoard board(rows, cols, k);
+			for (uint64_t item = nextWorkItem.fetch_add(1); item < workItems.size(); item = nextWorkItem.fetch_add(1)) {
+				board.play(workItems[item].first);
+				board.play(workItems[item].second);
+				solve(board, workItems[item].second);
+				board.undo(workItems[item].second);
+				board.undo(workItems[item].first);
+			}
+		});
+	}
+	for (std::thread& worker : workers)
+		worker.join();
+	solve(root, -1);
+
+	result.solveMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Memoized minimax without pruning (every child is solved, the optimal move mask needs them all)
+//   returns the value for the side to move, lastMove is the square just played (-1 for the empty board)
+int PositionExporter::solve(MnkBoard& board, int lastMove) {
+	std::atomic<uint8_t>& entry = table[static_cast<size_t>(board.getPositionIndex())];
+	uint8_t known = entry.load(std::memory_order_relaxed);
+	if (known != 0)
+		return (known & 3) - 2;
+
+	int value = -1;
+	bool terminal = true;
+	if ((lastMove >= 0) && board.isWinningMove(lastMove))
+		value = -1;                          // the player who just moved has won
+	else if (board.isFull())
+		value = 0;
+	else {
+		terminal = false;
+		for (int pos = 0; pos < board.getSquareCount(); pos++) {
+			if (board.play(pos)) {
+				value = std::max(value, -solve(board, pos));
+				board.undo(pos);
+			}
+		}
+	}
+	entry.store(static_cast<uint8_t>((value + 2) | (terminal ? TERMINAL : 0)), std::memory_order_relaxed);
+	return value;
+}
+
+// Starts the workers (producer called once on each), writes their blocks on this thread as they arrive
+//   throws runtime_error if the file can't be opened or written
+template <typename Producer>
+void PositionExporter::runExport(const std::string& path, Producer producer, Result& result) {
+	auto start = std::chrono::steady_clock::now();
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file)
+		throw std::runtime_error("Unable to create export file " + path + "\n");
+	writeFileHeader(file, result.bytes);
+
+	workersRunning = numThreads;
+	std::vector<uint64_t> rowCounts(numThreads, 0);
+	std::vector<std::thread> workers;
+	for (int t = 0; t < numThreads; t++) {
+		workers.emplace_back([this, &producer, &rowCounts, t]() {
+			std::unique_ptr<Block> block = newBlock();
+			producer(block, rowCounts[t]);
+			if (block->rowCount > 0)
+				pushBlock(block);
+			{
+				std::lock_guard<std::mutex> guard(queueLock);
+				workersRunning--;
+			}
+			blockReady.notify_one();
+		});
+	}
+
+	// writer - the queue is bounded, so the workers wait for the disk rather than filling memory
+	while (true) {
+		std::unique_lock<std::mutex> guard(queueLock);
+		blockReady.wait(guard, [this] { return !fullBlocks.empty() || (workersRunning == 0); });
+		if (fullBlocks.empty())
+			break;
+		std::unique_ptr<Block> block = std::move(fullBlocks.front());
+		fullBlocks.pop_front();
+		guard.unlock();
+
+		writeBlock(file, *block, result.bytes);
+		result.blocks++;
+		block->rowCount = 0;
+		guard.lock();
+		freeBlocks.push_back(std::move(block));
+		guard.unlock();
+		spaceReady.notify_one();
+	}
+	for (int t = 0; t < numThreads; t++) {
+		workers[t].join();
+		result.rows += rowCounts[t];
+	}
+
+	unsigned char end[4] = { 0, 0, 0, 0 };
+	file.write(reinterpret_cast<const char*>(end), sizeof(end));
+	result.bytes += sizeof(end);
+	file.close();
+	if (!file)
+		throw std::runtime_error("Error writing export file " + path + "\n");
+	result.exportMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// A row for each reachable position number in [first, last) - the squares are the base 3 digits
+void PositionExporter::exportRange(uint64_t first, uint64_t last, std::unique_ptr<Block>& block, uint64_t& rowCount) {
+	for (uint64_t positionIndex = first; positionIndex < last; positionIndex++) {
+		if (table[static_cast<size_t>(positionIndex)].load(std::memory_order_relaxed) == 0)
+			continue;
+		uint64_t xSquares = 0;
+		uint64_t oSquares = 0;
+		uint64_t digits = positionIndex;
+		for (size_t pos = 0; pos < powersOfThree.size(); pos++, digits /= 3) {
+			if (digits % 3 == 1)
+				xSquares |= 1ull << pos;
+			else if (digits % 3 == 2)
+				oSquares |= 1ull << pos;
+		}
+		appendRow(block, xSquares, oSquares, positionIndex, rowCount);
+	}
+}
+
+// One random game, a row for every position from the empty board to the end of the game
+void PositionExporter::playRandomGame(std::mt19937& random, std::unique_ptr<Block>& block, uint64_t& rowCount) {
+	MnkBoard board(rows, cols, k);
+	appendRow(block, 0, 0, 0, rowCount);
+	while (true) {
+		uint64_t empty = board.getEmptySquares();
+		int choice = static_cast<int>(random() % std::bitset<64>(empty).count());
+		int pos = 0;
+		for (; ; pos++) {
+			if ((empty & (1ull << pos)) && (choice-- == 0))
+				break;
+		}
+		board.play(pos);
+		appendRow(block, board.getSquares(TicTacToeBoard::X), board.getSquares(TicTacToeBoard::O),
+			board.getPositionIndex(), rowCount);
+		if (board.isWinningMove(pos) || board.isFull())
+			return;
+	}
+}
+
+// Labels the position from the solve table & adds it to the block, the block is queued once full
+//   optimal moves - every move whose child has the negated value of the position (none if the game is over)
+void PositionExporter::appendRow(std::unique_ptr<Block>& block, uint64_t xSquares, uint64_t oSquares,
+	uint64_t positionIndex, uint64_t& rowCount) {
+	uint8_t entry = table[static_cast<size_t>(positionIndex)].load(std::memory_order_relaxed);
+	int value = (entry & 3) - 2;
+	int ply = static_cast<int>(std::bitset<64>(xSquares | oSquares).count());
+	bool xToMove = (std::bitset<64>(xSquares).count() == std::bitset<64>(oSquares).count());
+
+	uint64_t optimalMoves = 0;
+	if ((entry & TERMINAL) == 0) {
+		uint64_t taken = xSquares | oSquares;
+		for (size_t pos = 0; pos < powersOfThree.size(); pos++) {
+			if (taken & (1ull << pos))
+				continue;
+			uint64_t child = positionIndex + (xToMove ? 1 : 2) * powersOfThree[pos];
+			if ((table[static_cast<size_t>(child)].load(std::memory_order_relaxed) & 3) - 2 == -value)
+				optimalMoves |= 1ull << pos;
+		}
+	}
+
+	uint32_t row = block->rowCount;
+	putLittleEndian(&block->columns[X_COLUMN][row * squareWidth], xSquares, squareWidth);
+	putLittleEndian(&block->columns[O_COLUMN][row * squareWidth], oSquares, squareWidth);
+	block->columns[VALUE_COLUMN][row] = static_cast<unsigned char>(static_cast<int8_t>(value));
+	putLittleEndian(&block->columns[OPTIMAL_COLUMN][row * squareWidth], optimalMoves, squareWidth);
+	block->columns[PLY_COLUMN][row] = static_cast<unsigned char>(ply);
+	block->columns[SIDE_COLUMN][row] = xToMove ? 0 : 1;
+	rowCount++;
+	if (++block->rowCount == BLOCK_ROWS)
+		pushBlock(block);
+}
+
+// Queue the full block for the writer (waits while the queue is full) & replace it with an empty one
+void PositionExporter::pushBlock(std::unique_ptr<Block>& block) {
+	{
+		std::unique_lock<std::mutex> guard(queueLock);
+		spaceReady.wait(guard, [this] {
+			return fullBlocks.size() < static_cast<size_t>(numThreads * QUEUE_BLOCKS_PER_THREAD); });
+		fullBlocks.push_back(std::move(block));
+	}
+	blockReady.notify_one();
+	block = newBlock();
+}
+
+// Empty block - a written one if there is one, otherwise a new one sized for BLOCK_ROWS
+std::unique_ptr<PositionExporter::Block> PositionExporter::newBlock() {
+	{
+		std::lock_guard<std::mutex> guard(queueLock);
+		if (!freeBlocks.empty()) {
+			std::unique_ptr<Block> reused = std::move(freeBlocks.back());
+			freeBlocks.pop_back();
+			return reused;
+		}
+	}
+	std::unique_ptr<Block> block(new Block());
+	for (int column = 0; column < COLUMN_COUNT; column++)
+		block->columns[column].resize(static_cast<size_t>(BLOCK_ROWS) * columnWidth(column));
+	return block;
+}
+
+// "TTTC", version, geometry & the column directory
+void PositionExporter::writeFileHeader(std::ofstream& file, uint64_t& bytes) const {
+	std::vector<unsigned char> header(10 + COLUMN_COUNT * (COLUMN_NAME_CHARS + 2), 0);
+	std::memcpy(&header[0], "TTTC", 4);
+	putLittleEndian(&header[4], FORMAT_VERSION, 2);
+	header[6] = static_cast<unsigned char>(rows);
+	header[7] = static_cast<unsigned char>(cols);
+	header[8] = static_cast<unsigned char>(k);
+	header[9] = static_cast<unsigned char>(COLUMN_COUNT);
+	for (int column = 0; column < COLUMN_COUNT; column++) {
+		unsigned char* entry = &header[10 + column * (COLUMN_NAME_CHARS + 2)];
+		std::strncpy(reinterpret_cast<char*>(entry), COLUMN_NAMES[column], COLUMN_NAME_CHARS - 1);
+		entry[COLUMN_NAME_CHARS] = static_cast<unsigned char>(columnWidth(column));
+		entry[COLUMN_NAME_CHARS + 1] = COLUMN_SIGNED[column] ? 1 : 0;
+	}
+	file.write(reinterpret_cast<const char*>(header.data()), header.size());
+	bytes += header.size();
+}
+
+// Row count, then each column's values for the rows in the block - one write per column
+void PositionExporter::writeBlock(std::ofstream& file, const Block& block, uint64_t& bytes) const {
+	unsigned char rowCount[4];
+	putLittleEndian(rowCount, block.rowCount, 4);
+	file.write(reinterpret_cast<const char*>(rowCount), sizeof(rowCount));
+	bytes += sizeof(rowCount);
+	for (int column = 0; column < COLUMN_COUNT; column++) {
+		size_t size = static_cast<size_t>(block.rowCount) * columnWidth(column);
+		file.write(reinterpret_cast<const char*>(block.columns[column].data()), size);
+		bytes += size;
+	}
+}
+
+// square masks depend on the board size, the labels are one byte
+int PositionExporter::columnWidth(int column) const {
+	return ((column == X_COLUMN) || (column == O_COLUMN) || (column == OPTIMAL_COLUMN)) ? squareWidth : 1;
+}
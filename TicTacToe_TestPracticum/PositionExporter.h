@@ -0,0 +1,107 @@
+#pragma once
+/*****************************************************************//**
+ * \file   PositionExporter.h
+ * \brief  training data exporter - PositionExporter
+ *     Scope - writes labelled positions (every reachable position, or positions from random self-play games)
+ *        to a columnar binary file, for training move prediction models
+ *
+ * \date   updated: October 2026
+ *
+ * Implementation notes:
+ *     - labels come from a solve table: game value of every reachable position, one byte per base 3 position
+ *          number (3^16 = 43 MB for 4x4), so boards are limited to MAX_SQUARES - the table is filled by
+ *          memoized minimax without pruning, threads share it (byte stores, a position solved twice gets the
+ *          same value), the positions after two moves are handed out by an atomic counter
+ *     - a table entry of 0 means unreachable, otherwise (value + 2) | TERMINAL, value +1/0/-1 for the side to move
+ *     - rows are built by the worker threads in blocks of BLOCK_ROWS & passed to a writer thread through a
+ *          bounded queue (QUEUE_BLOCKS_PER_THREAD per worker), so memory use doesn't grow with the dataset
+ *     - exhaustive export: the workers take ranges of position numbers & write a row for each reachable one,
+ *          the optimal move mask is read from the children's table entries, no board is played
+ *     - blocks are written in the order they are finished (not sorted) - each block is self contained
+ *
+ * File format (integers little endian, whatever the host):
+ *     header      "TTTC", uint16 version, uint8 rows, cols, k, column count
+ *     columns     per column: char name[16] (zero padded), uint8 width in bytes, uint8 signed (1) / unsigned (0)
+ *     blocks      uint32 row count, then each column's values for the block, back to back (column major)
+ *     end         uint32 row count 0
+ *   columns: x_squares, o_squares, value, optimal_moves, ply, side_to_move (0 = X, 1 = O)
+ *       square masks (x, o, optimal moves) are 2 bytes wide for up to 16 squares (1 byte for up to 8)
+ *
+ * PositionExporter(rows, cols, k, threads)         - throws invalid_argument if the board is larger than MAX_SQUARES
+ * Result exportAll(path)                           - every reachable position, exactly once
+ * Result exportSelfPlay(path, games, seed)         - every position of random games, repeats included
+ *   both throw runtime_error if the file can't be written
+ **/
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+#include "MnkBoard.h"
+
+class PositionExporter
+{
+public:
+	static constexpr int MAX_SQUARES = 16;
+	static constexpr uint32_t BLOCK_ROWS = 65536;
+	static constexpr int QUEUE_BLOCKS_PER_THREAD = 2;
+	static constexpr int COLUMN_COUNT = 6;
+	static constexpr uint16_t FORMAT_VERSION = 1;
+
+	struct Result {
+		uint64_t rows = 0;
+		uint64_t blocks = 0;
+		uint64_t bytes = 0;                  // file size
+		double solveMilliseconds = 0;
+		double exportMilliseconds = 0;       // rows built & written, after the solve
+	};
+
+	PositionExporter(int rows, int cols, int k, int numThreads);
+	Result exportAll(const std::string& path);
+	Result exportSelfPlay(const std::string& path, uint64_t games, unsigned seed);
+
+private:
+	static constexpr uint8_t TERMINAL = 4;
+
+	struct Block {
+		uint32_t rowCount = 0;
+		std::vector<unsigned char> columns[COLUMN_COUNT];
+	};
+
+	int rows;
+	int cols;
+	int k;
+	int numThreads;
+	int squareWidth;                         // bytes per square mask column
+	std::vector<uint64_t> powersOfThree;
+	std::unique_ptr<std::atomic<uint8_t>[]> table;
+	std::atomic<uint64_t> nextWorkItem;
+
+	// bounded block queue between the workers & the writer
+	std::deque<std::unique_ptr<Block>> fullBlocks;
+	std::vector<std::unique_ptr<Block>> freeBlocks;      // written blocks, reused by the workers
+	std::mutex queueLock;
+	std::condition_variable blockReady;      // writer waits for a block (or all workers done)
+	std::condition_variable spaceReady;      // workers wait for space in the queue
+	int workersRunning = 0;
+
+	void solveTable(Result& result);
+	int solve(MnkBoard& board, int lastMove);
+	template <typename Producer> void runExport(const std::string& path, Producer producer, Result& result);
+
+	void exportRange(uint64_t first, uint64_t last, std::unique_ptr<Block>& block, uint64_t& rowCount);
+	void playRandomGame(std::mt19937& random, std::unique_ptr<Block>& block, uint64_t& rowCount);
+	void appendRow(std::unique_ptr<Block>& block, uint64_t xSquares, uint64_t oSquares, uint64_t positionIndex,
+		uint64_t& rowCount);
+	void pushBlock(std::unique_ptr<Block>& block);
+	std::unique_ptr<Block> newBlock();
+	void writeFileHeader(std::ofstream& file, uint64_t& bytes) const;
+	void writeBlock(std::ofstream& file, const Block& block, uint64_t& bytes) const;
+	int columnWidth(int column) const;
+};
@@ -0,0 +1,192 @@
+// QubicBoard.cpp
+//   4x4x4 tic-tac-toe, bit board with compile time winning lines & incremental line counts
+//   <blank line>
+
+#include <stdexcept>
+#include "QubicBoard.h"
+
+/*
+ * Instance variables (declared in header file)
+ *   squares[] - bit mask of cells played, one per player
+ *   lineCounts[][] - per player, # of its cells on each winning line, maintained by play() & undo()
+ *   threatLines[] - per player, # of lines it could complete with one more cell, maintained by play() & undo()
+ *   player - player to move, toggled by play() & undo()
+ *   ply - # of cells played
+ */
+
+namespace {
+	// winning lines & the lines through each cell, built by a constexpr function so the table is in the binary,
+	//   nothing runs at start up
+	struct LineTable {
+		uint64_t lines[QubicBoard::LINE_COUNT];
+		uint8_t through[QubicBoard::CELLS][QubicBoard::MAX_LINES_PER_CELL];
+		uint8_t throughCount[QubicBoard::CELLS];
+		int lineCount;
+	};
+
+	constexpr bool onBoard(int coordinate) {
+		return (coordinate >= 0) && (coordinate < QubicBoard::SIZE);
+	}
+
+	// every run of 4 cells along one of the 13 directions (a direction & its reverse give the same lines,
+	//   so only directions whose first non zero step is positive are used)
+	constexpr LineTable buildLines() {
+		LineTable table{};
+		for (int dLevel = -1; dLevel <= 1; dLevel++) {
+			for (int dRow = -1; dRow <= 1; dRow++) {
+				for (int dCol = -1; dCol <= 1; dCol++) {
+					int first = (dLevel != 0) ? dLevel : (dRow != 0) ? dRow : dCol;
+					if (first <= 0)
+						continue;
+					for (int start = 0; start < QubicBoard::CELLS; start++) {
+						int level = start / 16;
+						int row = (start / 4) % 4;
+						int col = start % 4;
+						int last = QubicBoard::SIZE - 1;
+						if (!onBoard(level + last * dLevel) || !onBoard(row + last * dRow) || !onBoard(col + last * dCol))
+							continue;
+						uint64_t line = 0;
+						for (int i = 0; i < QubicBoard::SIZE; i++) {
+							int cell = (level + i * dLevel) * 16 + (row + i * dRow) * 4 + (col + i * dCol);
+							line |= 1ull << cell;
+							table.through[cell][table.throughCount[cell]++] = static_cast<uint8_t>(table.lineCount);
+						}
+						table.lines[table.lineCount++] = line;
+					}
+				}
+			}
+		}
+		return table;
+	}
+
+	constexpr LineTable LINES = buildLines();
+	static_assert(LINES.lineCount == QubicBoard::LINE_COUNT, "a 4x4x4 board has 76 winning lines");
+}
+
+QubicBoard::QubicBoard() {
+}
+
+// cell numbering is level 0 -> 0 .. 15 (row by row, as TicTacToeBoard), level 1 -> 16 .. 31, ...
+int QubicBoard::cellIndex(int level, int row, int col) {
+	if ((level < 0) || (level >= SIZE) || (row < 0) || (row >= SIZE) || (col < 0) || (col >= SIZE))
+		throw std::invalid_argument("QubicBoard level, row or column out of range\n");
+	return level * SIZE * SIZE + row * SIZE + col;
+}
+
+uint64_t QubicBoard::getSquares(Player player) const {
+	return squares[player];
+}
+
+uint64_t QubicBoard::getEmptySquares() const {
+	return ~(squares[TicTacToeBoard::X] | squares[TicTacToeBoard::O]);
+}
+
+QubicBoard::Player QubicBoard::getPlayer() const {
+	return player;
+}
+
+int QubicBoard::getPly() const {
+	return ply;
+}
+
+bool QubicBoard::isSquareEmpty(int cell) const {
+	validateCell(cell);
+	return (getEmptySquares() & (1ull << cell)) != 0;
+}
+
+// Current player takes the cell & the turn passes - false (board unchanged) if the cell is taken
+bool QubicBoard::play(int cell) {
+	if (!isSquareEmpty(cell))
+		return false;
+	Player opponent = (player == TicTacToeBoard::X) ? TicTacToeBoard::O : TicTacToeBoard::X;
+	squares[player] |= 1ull << cell;
+	for (int i = 0; i < LINES.throughCount[cell]; i++) {
+		int line = LINES.through[cell][i];
+		int count = ++lineCounts[player][line];
+		if ((lineCounts[opponent][line] == SIZE - 1) && (count == 1))
+			threatLines[opponent]--;                     // blocked
+		else if ((lineCounts[opponent][line] == 0) && (count >= SIZE - 1))
+			threatLines[player] += (count == SIZE - 1) ? 1 : -1;     // new threat, or completed
+	}
+	player = opponent;
+	ply++;
+	return true;
+}
+
+// Takes back the last move - the cell must be the one last played (the previous player's)
+void QubicBoard::undo(int cell) {
+	validateCell(cell);
+	Player previous = (player == TicTacToeBoard::X) ? TicTacToeBoard::O : TicTacToeBoard::X;
+	if ((squares[previous] & (1ull << cell)) == 0)
+		throw std::invalid_argument("QubicBoard::undo - cell not played by the previous player\n");
+	squares[previous] &= ~(1ull << cell);
+	for (int i = 0; i < LINES.throughCount[cell]; i++) {
+		int line = LINES.through[cell][i];
+		int count = lineCounts[previous][line]--;
+		if ((lineCounts[player][line] == SIZE - 1) && (count == 1))
+			threatLines[player]++;
+		else if ((lineCounts[player][line] == 0) && (count >= SIZE - 1))
+			threatLines[previous] += (count == SIZE - 1) ? -1 : 1;
+	}
+	player = previous;
+	ply--;
+}
+
+bool QubicBoard::isWinner(Player player) const {
+	for (int line = 0; line < LINE_COUNT; line++) {
+		if (lineCounts[player][line] == SIZE)
+			return true;
+	}
+	return false;
+}
+
+// true if the player on the cell has completed a line through it - use right after play()
+bool QubicBoard::isWinningMove(int cell) const {
+	validateCell(cell);
+	Player owner = (squares[TicTacToeBoard::X] & (1ull << cell)) ? TicTacToeBoard::X : TicTacToeBoard::O;
+	for (int i = 0; i < LINES.throughCount[cell]; i++) {
+		if (lineCounts[owner][LINES.through[cell][i]] == SIZE)
+			return true;
+	}
+	return false;
+}
+
+bool QubicBoard::isFull() const {
+	return ply == CELLS;
+}
+
+// A line with 3 of the player's cells & none of the opponent's has one empty cell, which wins
+uint64_t QubicBoard::getThreats(Player player) const {
+	if (threatLines[player] == 0)
+		return 0;
+	Player opponent = (player == TicTacToeBoard::X) ? TicTacToeBoard::O : TicTacToeBoard::X;
+	uint64_t threats = 0;
+	for (int line = 0; line < LINE_COUNT; line++) {
+		if ((lineCounts[player][line] == SIZE - 1) && (lineCounts[opponent][line] == 0))
+			threats |= LINES.lines[line];
+	}
+	return threats & ~squares[player];
+}
+
+const uint8_t* QubicBoard::getLineCounts(Player player) const {
+	return lineCounts[player];
+}
+
+uint64_t QubicBoard::getLine(int line) {
+	if ((line < 0) || (line >= LINE_COUNT))
+		throw std::invalid_argument("QubicBoard line out of range\n");
+	return LINES.lines[line];
+}
+
+int QubicBoard::getLinesThrough(int cell, const uint8_t*& lines) {
+	validateCell(cell);
+	lines = LINES.through[cell];
+	return LINES.throughCount[cell];
+}
+
+//                                     ***  QubicBoard helper functions ***
+
+void QubicBoard::validateCell(int cell) {
+	if ((cell < 0) || (cell >= CELLS))
+		throw std::invalid_argument("QubicBoard cell out of range\n");
+}
@@ -0,0 +1,70 @@
+#pragma once
+/*****************************************************************//**
+ * \file   QubicBoard.h
+ * \brief  3D tic-tac-toe board - QubicBoard (4x4x4, four in a row)
+ *     Scope - board state & win detection for Qubic, used by QubicSearch
+ *
+ * \date   updated: October 2026
+ *
+ * Implementation notes:
+ *     - bit board: the 64 cells fit one 64 bit mask per player, cell = level * 16 + row * 4 + column
+ *     - the 76 winning lines (16 per direction along the axes x 3, 2 diagonals per plane x 12 planes,
+ *          4 space diagonals) are generated at compile time, as is the cell -> lines table (4 or 7 lines per cell),
+ *          the same way winPatterns is a constexpr table for the 3x3 board
+ *     - play()/undo() keep a count of each player's cells on every line through the cell played, so a win check
+ *          only reads the lines through the move & the threats (lines with 3 of a player's cells & no opponent)
+ *          are found without counting bits - the # of threat lines per player is kept too, so the common case,
+ *          no threats, costs one comparison
+ *     - cells out of range throw an invalid argument exception, as in TicTacToeBoard & MnkBoard
+ *
+ * static int cellIndex(level, row, col)   - cell number of a level / row / column
+ * bool play(cell)                         - current player takes the cell & the turn passes, false if taken
+ * void undo(cell)                         - takes back the last move (must be the cell last played)
+ * bool isWinner(player)                   - checks all winning lines
+ * bool isWinningMove(cell)                - checks only the lines through a cell just played
+ * uint64_t getThreats(player)             - empty cells that would complete a line for the player
+ **/
+
+#include <cstdint>
+#include "TicTacToeBoard.h"
+
+class QubicBoard
+{
+public:
+	typedef TicTacToeBoard::Player Player;
+
+	static constexpr int SIZE = 4;                        // cells per edge & in a winning line
+	static constexpr int CELLS = SIZE * SIZE * SIZE;
+	static constexpr int LINE_COUNT = 76;
+	static constexpr int MAX_LINES_PER_CELL = 7;          // corners & the 8 centre cells
+
+	QubicBoard();
+	static int cellIndex(int level, int row, int col);
+
+	uint64_t getSquares(Player player) const;             // cells occupied by the player
+	uint64_t getEmptySquares() const;
+	Player getPlayer() const;                             // player to move
+	int getPly() const;                                   // # of cells played
+	bool isSquareEmpty(int cell) const;
+
+	bool play(int cell);
+	void undo(int cell);
+
+	bool isWinner(Player player) const;
+	bool isWinningMove(int cell) const;
+	bool isFull() const;
+	uint64_t getThreats(Player player) const;
+	const uint8_t* getLineCounts(Player player) const;    // [line], cells of the player on each line
+
+	static uint64_t getLine(int line);                    // winning line as a mask
+	static int getLinesThrough(int cell, const uint8_t*& lines);   // # of lines through the cell, lines = their indexes
+
+private:
+	uint64_t squares[2] = { 0, 0 };                       // indexed by Player X / O
+	uint8_t lineCounts[2][LINE_COUNT] = {};               // [player][line], cells of the player on the line
+	int threatLines[2] = { 0, 0 };                        // [player], lines with 3 of the player's cells & no opponent
+	Player player = TicTacToeBoard::INITIAL_PLAYER;
+	int ply = 0;
+
+	static void validateCell(int cell);
+};
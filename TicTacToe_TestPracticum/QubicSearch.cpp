@@ -0,0 +1,306 @@
+// QubicSearch.cpp
+//   Threat aware iterative deepening alpha-beta for Qubic, with a transposition table & history heuristic
+//   <blank line>
+
+#include <algorithm>
+#include <stdexcept>
+#include "QubicSearch.h"
+#include "BitHelpers.h"
+
+/*
+ * Instance variables (declared in header file)
+ *   table - transposition table, allocated once, kept between searches (entries are checked by key)
+ *   history - per cell, credit for cutoffs caused by playing it, halved at the start of each search
+ *   deadline - stop condition of the current search
+ *   nodes - positions searched so far
+ *   stopped - set once the deadline passes, the iteration in progress is thrown away
+ */
+
+namespace {
+	constexpr int INFINITE_SCORE = QubicSearch::WIN_SCORE + 1;
+	constexpr int LINE_WEIGHTS[QubicBoard::SIZE] = { 0, 1, 4, 32 };       // evaluation, by cells on an open line
+	constexpr int ATTACK_WEIGHTS[QubicBoard::SIZE] = { 1, 3, 12, 0 };     // ordering, extending an open line
+	constexpr int DEFENCE_WEIGHTS[QubicBoard::SIZE] = { 0, 2, 10, 0 };    // ordering, blocking an opponent's line
+	constexpr uint32_t MAX_HISTORY = 4095;
+}
+
+// Constructor - allocates the transposition table (at least one entry)
+QubicSearch::QubicSearch(size_t tableEntries)
+	: table(tableEntries == 0 ? 1 : tableEntries, Entry{ 0, 0, -1, NONE, -1 }) {
+	for (uint32_t& credit : history)
+		credit = 0;
+}
+
+// Search the position until the budget, the depth limit or a forced win / loss is found
+//   returns the best move of the deepest completed iteration (a legal move even if none completed)
+QubicSearch::Result QubicSearch::search(const QubicBoard& root, std::chrono::milliseconds budget, int maxDepth) {
+	if (root.isFull() || root.isWinner(TicTacToeBoard::X) || root.isWinner(TicTacToeBoard::O))
+		throw std::invalid_argument("QubicSearch::search called on a finished game\n");
+
+	auto start = std::chrono::steady_clock::now();
+	deadline = start + budget;
+	auto lastIteration = start + budget / 2;
+	nodes = 0;
+	stopped = false;
+	for (uint32_t& credit : history)
+		credit /= 2;
+
+	Result result;
+	QubicBoard::Player player = root.getPlayer();
+	uint64_t wins = root.getThreats(player);
+	uint64_t forced = root.getThreats(opponentOf(player));
+	if (wins != 0) {
+		result.bestMove = firstCell(wins);
+		result.score = WIN_SCORE - (root.getPly() + 1);
+		result.exact = true;
+	}
+	else if (forced != 0) {
+		// only one move doesn't lose at once (or none, with two threats)
+		result.bestMove = firstCell(forced);
+		if ((forced & (forced - 1)) != 0) {
+			result.score = -(WIN_SCORE - (root.getPly() + 2));
+			result.exact = true;
+		}
+	}
+	else {
+		QubicBoard board = root;
+		int8_t moves[QubicBoard::CELLS];
+		int count = orderMoves(board, -1, moves);
+		result.bestMove = moves[0];
+		int remaining = QubicBoard::CELLS - root.getPly();
+		for (int depth = 1; depth <= std::min(maxDepth, remaining); depth++) {
+			count = orderMoves(board, result.bestMove, moves);
+			int alpha = -INFINITE_SCORE;
+			int bestMove = -1;
+			for (int i = 0; i < count; i++) {
+				board.play(moves[i]);
+				int score = -negamax(board, depth - 1, -INFINITE_SCORE, -alpha);
+				board.undo(moves[i]);
+				if (stopped)
+					break;
+				if (score > alpha) {
+					alpha = score;
+					bestMove = moves[i];
+				}
+			}
+			if (stopped)
+				break;
+
+			result.bestMove = bestMove;
+			result.score = alpha;
+			result.depth = depth;
+			if ((alpha >= WIN_SCORE - QubicBoard::CELLS) || (alpha <= -(WIN_SCORE - QubicBoard::CELLS))) {
+				result.exact = true;
+				break;
+			}
+			if (std::chrono::steady_clock::now() >= lastIteration)
+				break;
+		}
+	}
+	result.nodes = nodes;
+	result.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	return result;
+}
+
+//                                     ***  QubicSearch helper functions ***
+
+// Negamax with alpha-beta pruning & threat resolution, score from the point of view of the player to move
+//   the move that led here can't have won: the parent had no line to complete (checked before moving)
+int QubicSearch::negamax(QubicBoard& board, int depth, int alpha, int beta) {
+	nodes++;
+	if ((nodes % NODES_PER_POLL == 0) && pollStop())
+		return 0;
+
+	QubicBoard::Player player = board.getPlayer();
+	if (board.getThreats(player) != 0)
+		return WIN_SCORE - (board.getPly() + 1);
+	if (board.isFull())
+		return 0;
+	uint64_t forced = board.getThreats(opponentOf(player));
+	if (forced != 0) {
+		if ((forced & (forced - 1)) != 0)
+			return -(WIN_SCORE - (board.getPly() + 2));
+		// a single block is the only move, searched at the same depth so forcing sequences are read out
+		int cell = firstCell(forced);
+		board.play(cell);
+		int score = -negamax(board, depth, -beta, -alpha);
+		board.undo(cell);
+		return score;
+	}
+	if (depth == 0)
+		return evaluate(board);
+
+	uint64_t key = hashPosition(board);
+	Entry& entry = table[key % table.size()];
+	int tableMove = -1;
+	if (entry.key == key) {
+		tableMove = entry.move;
+		if (entry.depth >= depth) {
+			if ((entry.bound == EXACT) || ((entry.bound == LOWER) && (entry.score >= beta)) ||
+				((entry.bound == UPPER) && (entry.score <= alpha)))
+				return entry.score;
+		}
+	}
+
+	int originalAlpha = alpha;
+	int bestMove = -1;
+	int best = (depth == 1) ? searchFrontier(board, alpha, beta, bestMove) : -INFINITE_SCORE;
+	if (depth > 1) {
+		int8_t moves[QubicBoard::CELLS];
+		int count = orderMoves(board, tableMove, moves);
+		for (int i = 0; i < count; i++) {
+			board.play(moves[i]);
+			int score = -negamax(board, depth - 1, -beta, -alpha);
+			board.undo(moves[i]);
+			if (stopped)
+				return 0;
+			if (score > best) {
+				best = score;
+				bestMove = moves[i];
+				if (score > alpha) {
+					alpha = score;
+					if (alpha >= beta) {
+						history[moves[i]] += static_cast<uint32_t>(depth * depth);
+						break;
+					}
+				}
+			}
+		}
+	}
+	if (stopped)
+		return 0;
+
+	entry.key = key;
+	entry.score = static_cast<int16_t>(best);
+	entry.depth = static_cast<int8_t>(depth);
+	entry.bound = (best <= originalAlpha) ? UPPER : (best >= beta) ? LOWER : EXACT;
+	entry.move = static_cast<int8_t>(bestMove);
+	return best;
+}
+
+// Depth 1 - a child that is only evaluated scores the evaluation of this position plus the change to the lines
+//   through the move, so it is scored without being played - only moves that make a threat (the reply is forced,
+//   the sequence is read out) are played & searched
+int QubicSearch::searchFrontier(QubicBoard& board, int alpha, int beta, int& bestMove) {
+	QubicBoard::Player player = board.getPlayer();
+	const uint8_t* mine = board.getLineCounts(player);
+	const uint8_t* theirs = board.getLineCounts(opponentOf(player));
+	int base = evaluate(board);
+	bool lastCell = (board.getPly() + 1 == QubicBoard::CELLS);
+	uint64_t empty = board.getEmptySquares();
+	int best = -INFINITE_SCORE;
+	for (int cell = 0; cell < QubicBoard::CELLS; cell++) {
+		if ((empty & (1ull << cell)) == 0)
+			continue;
+		const uint8_t* lines;
+		int lineCount = QubicBoard::getLinesThrough(cell, lines);
+		int change = 0;
+		bool threat = false;
+		for (int i = 0; i < lineCount; i++) {
+			int line = lines[i];
+			if (theirs[line] == 0) {
+				change += LINE_WEIGHTS[mine[line] + 1] - LINE_WEIGHTS[mine[line]];
+				threat = threat || (mine[line] == QubicBoard::SIZE - 2);
+			}
+			else if (mine[line] == 0)
+				change += LINE_WEIGHTS[theirs[line]];     // the line is no longer open for the opponent
+		}
+
+		int score;
+		if (threat) {
+			board.play(cell);
+			score = -negamax(board, 0, -beta, -alpha);
+			board.undo(cell);
+			if (stopped)
+				return 0;
+		}
+		else {
+			nodes++;
+			score = lastCell ? 0 : base + change;
+		}
+		if (score > best) {
+			best = score;
+			bestMove = cell;
+			if (score > alpha) {
+				alpha = score;
+				if (alpha >= beta)
+					break;
+			}
+		}
+	}
+	return best;
+}
+
+// Open lines for the player to move minus open lines for the opponent, weighted by the cells on them
+int QubicSearch::evaluate(const QubicBoard& board) const {
+	QubicBoard::Player player = board.getPlayer();
+	const uint8_t* mine = board.getLineCounts(player);
+	const uint8_t* theirs = board.getLineCounts(opponentOf(player));
+	int score = 0;
+	for (int line = 0; line < QubicBoard::LINE_COUNT; line++) {
+		if (theirs[line] == 0)
+			score += LINE_WEIGHTS[mine[line]];
+		else if (mine[line] == 0)
+			score -= LINE_WEIGHTS[theirs[line]];
+	}
+	return score;
+}
+
+// Writes the empty cells to moves[], best first: firstMove (if legal), then by the lines through the cell
+//   that the move extends or blocks, ties broken by history - returns the # of moves
+int QubicSearch::orderMoves(const QubicBoard& board, int firstMove, int8_t moves[QubicBoard::CELLS]) const {
+	QubicBoard::Player player = board.getPlayer();
+	const uint8_t* mine = board.getLineCounts(player);
+	const uint8_t* theirs = board.getLineCounts(opponentOf(player));
+	uint64_t empty = board.getEmptySquares();
+	uint32_t keys[QubicBoard::CELLS];
+	int count = 0;
+	for (int cell = 0; cell < QubicBoard::CELLS; cell++) {
+		if ((empty & (1ull << cell)) == 0)
+			continue;
+		uint32_t key = 0;
+		if (cell == firstMove)
+			key = ~0u;
+		else {
+			const uint8_t* lines;
+			int lineCount = QubicBoard::getLinesThrough(cell, lines);
+			for (int i = 0; i < lineCount; i++) {
+				if (theirs[lines[i]] == 0)
+					key += ATTACK_WEIGHTS[mine[lines[i]]];
+				else if (mine[lines[i]] == 0)
+					key += DEFENCE_WEIGHTS[theirs[lines[i]]];
+			}
+			key = key * (MAX_HISTORY + 1) + ((history[cell] < MAX_HISTORY) ? history[cell] : MAX_HISTORY);
+		}
+
+		// insertion sort, highest key first
+		int i = count++;
+		while ((i > 0) && (keys[i - 1] < key)) {
+			keys[i] = keys[i - 1];
+			moves[i] = moves[i - 1];
+			i--;
+		}
+		keys[i] = key;
+		moves[i] = static_cast<int8_t>(cell);
+	}
+	return count;
+}
+
+// true once the deadline has passed - sets stopped so the search unwinds
+bool QubicSearch::pollStop() {
+	if (std::chrono::steady_clock::now() >= deadline)
+		stopped = true;
+	return stopped;
+}
+
+uint64_t QubicSearch::hashPosition(const QubicBoard& board) {
+	return mix(board.getSquares(TicTacToeBoard::X) ^ mix(board.getSquares(TicTacToeBoard::O)));
+}
+
+// lowest numbered cell in the mask, which must not be empty
+int QubicSearch::firstCell(uint64_t cells) {
+	int cell = 0;
+	while ((cells & (1ull << cell)) == 0)
+		cell++;
+	return cell;
+}
@@ -0,0 +1,75 @@
+#pragma once
+/*****************************************************************//**
+ * \file   QubicSearch.h
+ * \brief  Qubic engine - QubicSearch (threat aware alpha-beta)
+ *     Scope - finds the best move for the player to move on a QubicBoard within a time budget, single thread
+ *
+ * \date   updated: October 2026
+ *
+ * Implementation notes:
+ *     - iterative deepening negamax with alpha-beta, scores from the point of view of the player to move:
+ *          WIN_SCORE - ply for a win, the negative for a loss, otherwise a static evaluation of the open lines
+ *     - threats are resolved before anything else at every node: a line the player to move can complete wins,
+ *          two opponent threats lose (only one can be blocked), a single opponent threat leaves one legal move,
+ *          which is played without using up depth - forcing sequences are followed to the end
+ *     - evaluation: each line held by only one player scores 1 / 4 / 32 for 1 / 2 / 3 cells, for or against -
+ *          one ply from the horizon the children are scored from the lines through each move, not played
+ *     - move ordering: transposition table move, then cells by the open lines through them & the history heuristic
+ *     - transposition table: fixed size (allocated once), always replace, keyed by a hash of the two bit boards -
+ *          the ply is part of the position, so win / loss scores can be stored as they are
+ *     - a new iteration is only started in the first half of the budget (the next one takes several times longer),
+ *          the deadline is polled every NODES_PER_POLL nodes & an interrupted iteration is discarded
+ *
+ * Result search(board, budget, maxDepth)  - best move & score, throws invalid_argument if the game is over
+ **/
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include "QubicBoard.h"
+
+class QubicSearch
+{
+public:
+	static constexpr int WIN_SCORE = 10000;
+	static constexpr int NODES_PER_POLL = 1024;
+	static constexpr int MAX_DEPTH = QubicBoard::CELLS;
+	static constexpr size_t DEFAULT_TABLE_ENTRIES = 1 << 20;     // 16 MB
+
+	struct Result {
+		int bestMove = -1;            // cell
+		int score = 0;                // see notes, from the point of view of the player to move
+		int depth = 0;                // deepest completed iteration
+		uint64_t nodes = 0;           // positions searched, all iterations
+		bool exact = false;           // true if the result is a forced win or loss
+		double milliseconds = 0;
+	};
+
+	explicit QubicSearch(size_t tableEntries = DEFAULT_TABLE_ENTRIES);
+	Result search(const QubicBoard& root, std::chrono::milliseconds budget, int maxDepth = MAX_DEPTH);
+
+private:
+	enum Bound : uint8_t { NONE, EXACT, LOWER, UPPER };
+
+	struct Entry {
+		uint64_t key;
+		int16_t score;
+		int8_t depth;
+		Bound bound;
+		int8_t move;
+	};
+
+	std::vector<Entry> table;
+	uint32_t history[QubicBoard::CELLS];
+	std::chrono::steady_clock::time_point deadline;
+	uint64_t nodes = 0;
+	bool stopped = false;
+
+	int negamax(QubicBoard& board, int depth, int alpha, int beta);
+	int searchFrontier(QubicBoard& board, int alpha, int beta, int& bestMove);
+	int evaluate(const QubicBoard& board) const;
+	int orderMoves(const QubicBoard& board, int firstMove, int8_t moves[QubicBoard::CELLS]) const;
+	bool pollStop();
+	static uint64_t hashPosition(const QubicBoard& board);
+	static int firstCell(uint64_t cells);
+};
@@ -0,0 +1,225 @@
+#pragma once
+/*****************************************************************//**
+ * \file   RuleVariantBoard.h
+ * \brief  rule variant board template - RuleVariantBoard<Outcome, Symbols, Start>
+ *     Scope - 3x3 board for tic-tac-toe rule variants (misère, wild, other starting players & positions), the rules
+ *        are template parameters (policies) so each variant is its own class with the rule checks inlined,
+ *        no virtual calls or rule flags tested per move - several variants can be used side by side
+ *
+ * \date   updated: October 2026
+ *
+ * Implementation notes:
+ *     - policies (all static constexpr functions, resolved at compile time):
+ *          Outcome - who wins when a player completes a line: StandardOutcome (the player), MisereOutcome (the opponent)
+ *          Symbols - which symbols a player may place: OwnSymbol (X places X ...), WildSymbol (either, each move)
+ *          Start   - StartPosition<first player, X squares, O squares>, squares as bit masks (bit = position)
+ *     - players & symbols both use TicTacToeBoard::Player, in the wild game X & O name the players (first / second
+ *          by default) & a line is three of the same symbol, whoever placed them - the player completing it is scored
+ *     - bit board per symbol, same positions (row * 3 + column) & winning patterns as TicTacToeBoard, the game status
+ *          is updated by play(): win / loss, draw (board full) or forced draw (every line holds both symbols)
+ *     - the line masks & the lines through each position are built from TicTacToeBoard::winPatterns by a constexpr
+ *          function (as QubicBoard's lines), a start position holding a line doesn't compile
+ *     - all in this header - templates are instantiated in the code using them
+ *     - a position out of range or a symbol the rules don't allow throws an invalid argument exception, a move on a
+ *          taken square or after the game is over returns false (as TicTacToeBoard::writeSquare)
+ *
+ * bool play(position)             - the player to move places their own symbol, the turn passes
+ * bool play(position, symbol)     - places the symbol (must be allowed by the Symbols policy), the turn passes
+ * bool isSymbolAllowed(symbol)    - the Symbols policy for the player to move
+ * GameStatus getGameStatus()      - X_WINS / O_WINS name the winning player, DRAW, FORCED_DRAW or IN_PROGRESS
+ * void reset()                    - back to the Start policy's position
+ **/
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include "TicTacToeBoard.h"
+
+// who wins when the player to move completes a line
+struct StandardOutcome {
+	static constexpr TicTacToeBoard::Player winner(TicTacToeBoard::Player mover) {
+		return mover;
+	}
+};
+
+struct MisereOutcome {
+	static constexpr TicTacToeBoard::Player winner(TicTacToeBoard::Player mover) {
+		return (mover == TicTacToeBoard::X) ? TicTacToeBoard::O : TicTacToeBoard::X;
+	}
+};
+
+// which symbols the player to move may place
+struct OwnSymbol {
+	static constexpr bool allows(TicTacToeBoard::Player mover, TicTacToeBoard::Player symbol) {
+		return symbol == mover;
+	}
+};
+
+struct WildSymbol {
+	static constexpr bool allows(TicTacToeBoard::Player, TicTacToeBoard::Player symbol) {
+		return (symbol == TicTacToeBoard::X) || (symbol == TicTacToeBoard::O);
+	}
+};
+
+// winning lines as bit masks (TicTacToeBoard::winPatterns order) & bit per line through each position,
+//   built at compile time so the tables can't drift from TicTacToeBoard's patterns
+struct RuleVariantLines {
+	uint16_t lines[TicTacToeBoard::winPatterns.size()];
+	uint8_t through[TicTacToeBoard::BOARD_NUM_ROWS * TicTacToeBoard::BOARD_NUM_COLS];
+};
+
+constexpr RuleVariantLines buildRuleVariantLines() {
+	RuleVariantLines table{};
+	for (size_t line = 0; line < TicTacToeBoard::winPatterns.size(); line++) {
+		for (size_t i = 0; i < TicTacToeBoard::winPatterns[line].size(); i++) {
+			int position = TicTacToeBoard::winPatterns[line][i];
+			table.lines[line] |= static_cast<uint16_t>(1u << position);
+			table.through[position] |= static_cast<uint8_t>(1u << line);
+		}
+	}
+	return table;
+}
+
+constexpr bool holdsRuleVariantLine(uint16_t squares) {
+	for (uint16_t line : buildRuleVariantLines().lines) {
+		if ((squares & line) == line)
+			return true;
+	}
+	return false;
+}
+
+// starting player & stones already on the board (bit per position, must not overlap or hold a line)
+template <TicTacToeBoard::Player FIRST = TicTacToeBoard::INITIAL_PLAYER, uint16_t X_SQUARES = 0, uint16_t O_SQUARES = 0>
+struct StartPosition {
+	static_assert((FIRST == TicTacToeBoard::X) || (FIRST == TicTacToeBoard::O), "first player must be X or O");
+	static_assert((X_SQUARES & O_SQUARES) == 0, "start squares overlap");
+	static_assert(((X_SQUARES | O_SQUARES) >> 9) == 0, "start squares off the board");
+	static_assert(!holdsRuleVariantLine(X_SQUARES) && !holdsRuleVariantLine(O_SQUARES), "start squares hold a line");
+
+	static constexpr TicTacToeBoard::Player first() {
+		return FIRST;
+	}
+	static constexpr uint16_t squares(TicTacToeBoard::Player symbol) {
+		return (symbol == TicTacToeBoard::X) ? X_SQUARES : O_SQUARES;
+	}
+};
+
+template <class Outcome = StandardOutcome, class Symbols = OwnSymbol, class Start = StartPosition<>>
+class RuleVariantBoard
+{
+public:
+	typedef TicTacToeBoard::Player Player;
+	typedef TicTacToeBoard::GameStatus GameStatus;
+
+	static constexpr int SQUARES = TicTacToeBoard::BOARD_NUM_ROWS * TicTacToeBoard::BOARD_NUM_COLS;
+	static constexpr int LINE_COUNT = static_cast<int>(TicTacToeBoard::winPatterns.size());
+
+	RuleVariantBoard() {
+		reset();
+	}
+
+	// Start policy's position - the status is worked out once here, play() keeps it up to date
+	void reset() {
+		player = Start::first();
+		ply = 0;
+		status = TicTacToeBoard::IN_PROGRESS;
+		for (int symbol = TicTacToeBoard::X; symbol <= TicTacToeBoard::O; symbol++) {
+			squares[symbol] = Start::squares(static_cast<Player>(symbol));
+			symbolLines[symbol] = 0;
+			for (int position = 0; position < SQUARES; position++) {
+				if (squares[symbol] & (1u << position)) {
+					symbolLines[symbol] |= LINES.through[position];
+					ply++;
+				}
+			}
+		}
+		if (ply == SQUARES)
+			status = TicTacToeBoard::DRAW;
+		else if ((symbolLines[TicTacToeBoard::X] & symbolLines[TicTacToeBoard::O]) == ALL_LINES)
+			status = TicTacToeBoard::FORCED_DRAW;
+	}
+
+	Player getPlayer() const {
+		return player;
+	}
+
+	int getPly() const {
+		return ply;
+	}
+
+	uint16_t getSquares(Player symbol) const {
+		return squares[symbol];
+	}
+
+	GameStatus getGameStatus() const {
+		return status;
+	}
+
+	bool isSquareEmpty(int position) const {
+		validatePosition(position);
+		return ((squares[TicTacToeBoard::X] | squares[TicTacToeBoard::O]) & (1u << position)) == 0;
+	}
+
+	bool isSymbolAllowed(Player symbol) const {
+		return Symbols::allows(player, symbol);
+	}
+
+	bool play(int position) {
+		return play(position, player);
+	}
+
+	bool play(int position, Player symbol) {
+		if (!isSymbolAllowed(symbol))
+			throw std::invalid_argument("Symbol not allowed by the rules: " + std::to_string(symbol) + "\n");
+		if (!isSquareEmpty(position) || (status != TicTacToeBoard::IN_PROGRESS))
+			return false;
+
+		squares[symbol] |= static_cast<uint16_t>(1u << position);
+		symbolLines[symbol] |= LINES.through[position];
+		ply++;
+		if (completesLine(position, symbol))
+			status = (Outcome::winner(player) == TicTacToeBoard::X) ? TicTacToeBoard::X_WINS : TicTacToeBoard::O_WINS;
+		else if (ply == SQUARES)
+			status = TicTacToeBoard::DRAW;
+		else if ((symbolLines[TicTacToeBoard::X] & symbolLines[TicTacToeBoard::O]) == ALL_LINES)
+			status = TicTacToeBoard::FORCED_DRAW;
+		player = (player == TicTacToeBoard::X) ? TicTacToeBoard::O : TicTacToeBoard::X;
+		return true;
+	}
+
+private:
+	static constexpr uint8_t ALL_LINES = static_cast<uint8_t>((1u << LINE_COUNT) - 1);
+	static constexpr RuleVariantLines LINES = buildRuleVariantLines();
+
+	uint16_t squares[2];                          // bit per position, by symbol
+	uint8_t symbolLines[2];                       // lines holding the symbol - in both = can't be completed
+	Player player;
+	int ply;
+	GameStatus status;
+
+	// the symbol just placed at position completes one of the lines through it
+	bool completesLine(int position, Player symbol) const {
+		for (int line = 0; line < LINE_COUNT; line++) {
+			if ((LINES.through[position] & (1u << line)) && ((squares[symbol] & LINES.lines[line]) == LINES.lines[line]))
+				return true;
+		}
+		return false;
+	}
+
+	static void validatePosition(int position) {
+		if ((position < 0) || (position >= SQUARES))
+			throw std::invalid_argument("Invalid position passed to RuleVariantBoard: " + std::to_string(position) +
+				"\n");
+	}
+};
+
+// C++14 - constexpr static members used at run time need a definition
+template <class Outcome, class Symbols, class Start>
+constexpr RuleVariantLines RuleVariantBoard<Outcome, Symbols, Start>::LINES;
+
+// the variants hosted side by side
+typedef RuleVariantBoard<> StandardBoard;
+typedef RuleVariantBoard<MisereOutcome> MisereBoard;
+typedef RuleVariantBoard<StandardOutcome, WildSymbol> WildBoard;
+typedef RuleVariantBoard<StandardOutcome, OwnSymbol, StartPosition<TicTacToeBoard::O>> OStartsBoard;
+typedef RuleVariantBoard<StandardOutcome, OwnSymbol, StartPosition<TicTacToeBoard::O, 0x010>> CentreTakenBoard;
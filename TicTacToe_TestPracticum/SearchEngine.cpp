@@ -0,0 +1,157 @@
+// SearchEngine.cpp
+//   Iterative deepening alpha-beta search over an MnkBoard, bounded by a deadline & a cancel flag
+//   <blank line>
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include "SearchEngine.h"
+
+/*
+ * Instance variables (declared in header file)
+ *   evaluation, evaluator - score at the depth limit, the evaluator reset to the root & moved with the board
+ *   moveOrder - squares of the board being searched, centre first
+ *   deadline, cancel - stop conditions of the current search
+ *   nodes - positions searched so far
+ *   stopped - set once the deadline passes or cancel is seen, the iteration in progress is thrown away
+ *   horizonReached - set if the current iteration stopped a line of play at the depth limit (ie not exact)
+ */
+
+SearchEngine::SearchEngine(Evaluation evaluation)
+	: evaluation(evaluation) {
+	static_assert(LineEvaluator::MAX_SCORE < WIN_SCORE - MnkBoard::MAX_SQUARES, "evaluation must stay below a win");
+}
+
+// Search the position until the deadline, the cancel flag, the depth limit or the end of the tree
+//   returns the best move of the deepest completed iteration (the first legal move if none completed)
+SearchEngine::Result SearchEngine::search(const MnkBoard& root, std::chrono::steady_clock::time_point deadline,
+	const std::atomic<bool>& cancel, int maxDepth) {
+	uint64_t empty = root.getEmptySquares();
+	if ((empty == 0) || root.isWinner(TicTacToeBoard::X) || root.isWinner(TicTacToeBoard::O))
+		throw std::invalid_argument("SearchEngine::search called on a finished game\n");
+
+	this->deadline = deadline;
+	this->cancel = &cancel;
+	nodes = 0;
+	stopped = false;
+	orderMoves(root);
+	if (evaluation == OPEN_LINES)
+		evaluator.reset(root);
+
+	MnkBoard board = root;
+	Result result;
+	for (int pos : moveOrder) {
+		if (empty & (1ull << pos)) {
+			result.bestMove = pos;
+			break;
+		}
+	}
+
+	int remaining = root.getSquareCount() - root.getPly();
+	for (int depth = 1; depth <= std::min(maxDepth, remaining); depth++) {
+		horizonReached = false;
+		int alpha = -WIN_SCORE - 1;
+		int bestMove = -1;
+
+		// previous iteration's best move first, then the centre out
+		std::vector<int> rootMoves(1, result.bestMove);
+		for (int pos : moveOrder) {
+			if ((pos != result.bestMove) && (empty & (1ull << pos)))
+				rootMoves.push_back(pos);
+		}
+		for (int pos : rootMoves) {
+			play(board, pos);
+			int score = board.isWinningMove(pos) ? WIN_SCORE - board.getPly() :
+				-negamax(board, depth - 1, -WIN_SCORE - 1, -alpha);
+			undo(board, pos);
+			if (stopped)
+				break;
+			if (score > alpha) {
+				alpha = score;
+				bestMove = pos;
+			}
+		}
+		if (stopped)
+			break;
+
+		result.bestMove = bestMove;
+		result.score = alpha;
+		result.depth = depth;
+		if (!horizonReached || (std::abs(alpha) >= WIN_SCORE - MnkBoard::MAX_SQUARES)) {
+			// whole tree searched, or a forced win / loss found - the depth limit never scores that high
+			result.exact = true;
+			break;
+		}
+	}
+	result.nodes = nodes;
+	return result;
+}
+
+//                                     ***  SearchEngine helper functions ***
+
+// Negamax with alpha-beta pruning, score from the point of view of the player to move
+//   the move that led here wasn't a win (checked by the caller), so only a full board ends the game
+int SearchEngine::negamax(MnkBoard& board, int depth, int alpha, int beta) {
+	nodes++;
+	if ((nodes % NODES_PER_POLL == 0) && pollStop())
+		return 0;
+	if (board.isFull())
+		return 0;
+	if (depth == 0) {
+		horizonReached = true;
+		return (evaluation == OPEN_LINES) ? evaluator.evaluate(board.getPlayer()) : 0;
+	}
+
+	uint64_t empty = board.getEmptySquares();
+	for (int pos : moveOrder) {
+		if ((empty & (1ull << pos)) == 0)
+			continue;
+		play(board, pos);
+		int score = board.isWinningMove(pos) ? WIN_SCORE - board.getPly() : -negamax(board, depth - 1, -beta, -alpha);
+		undo(board, pos);
+		if (stopped)
+			return 0;
+		if (score > alpha) {
+			alpha = score;
+			if (alpha >= beta)
+				break;
+		}
+	}
+	return alpha;
+}
+
+// move on the board (& the evaluator, if used) - the player to move takes the square
+void SearchEngine::play(MnkBoard& board, int position) {
+	if (evaluation == OPEN_LINES)
+		evaluator.play(position, board.getPlayer());
+	board.play(position);
+}
+
+// takes the move back - once undone, the player who took the square is to move again
+void SearchEngine::undo(MnkBoard& board, int position) {
+	board.undo(position);
+	if (evaluation == OPEN_LINES)
+		evaluator.undo(position, board.getPlayer());
+}
+
+// true once the deadline has passed or the search has been cancelled - sets stopped so the search unwinds
+bool SearchEngine::pollStop() {
+	if (cancel->load(std::memory_order_relaxed) || (std::chrono::steady_clock::now() >= deadline))
+		stopped = true;
+	return stopped;
+}
+
+// Squares sorted by distance from the centre of the board, the centre squares take part in the most lines
+void SearchEngine::orderMoves(const MnkBoard& board) {
+	moveOrder.clear();
+	for (int pos = 0; pos < board.getSquareCount(); pos++)
+		moveOrder.push_back(pos);
+	int rows = board.getRows();
+	int cols = board.getCols();
+	std::stable_sort(moveOrder.begin(), moveOrder.end(), [rows, cols](int a, int b) {
+		// distances doubled so the centre of an even sized board is a whole number
+		int distanceA = std::abs(2 * (a / cols) - (rows - 1)) + std::abs(2 * (a % cols) - (cols - 1));
+		int distanceB = std::abs(2 * (b / cols) - (rows - 1)) + std::abs(2 * (b % cols) - (cols - 1));
+		return distanceA < distanceB;
+	});
+}
@@ -0,0 +1,67 @@
+#pragma once
+/*****************************************************************//**
+ * \file   SearchEngine.h
+ * \brief  move search - SearchEngine
+ *     Scope - finds the best move for the player to move on an MnkBoard, iterative deepening alpha-beta (negamax)
+ *
+ * \date   updated: October 2026
+ *
+ * Implementation notes:
+ *     - scores are from the point of view of the player to move: WIN_SCORE - ply for a win (faster wins score
+ *          higher), -(WIN_SCORE - ply) for a loss, 0 for a draw or an unresolved position at the depth limit -
+ *          with OPEN_LINES evaluation the depth limit scores LineEvaluator::evaluate() instead (within
+ *          +-LineEvaluator::MAX_SCORE, so wins & losses still stand out), kept up to date move by move
+ *     - iterative deepening: depth 1, 2, ... until the tree is searched to the end, the depth limit is reached,
+ *          the deadline passes or the search is cancelled - the result is the best move of the deepest
+ *          completed iteration, so there is always a move once depth 1 completes (or the first legal move)
+ *     - the best move of the previous iteration is searched first, then squares ordered from the centre out
+ *     - the deadline & cancel flag are polled every NODES_PER_POLL nodes, an interrupted iteration is discarded
+ *
+ * SearchEngine(evaluation)                         - NO_EVALUATION (default, as before) or OPEN_LINES
+ * Result search(board, deadline, cancel, maxDepth) - best move & score, throws invalid_argument if no move is possible
+ **/
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include "LineEvaluator.h"
+#include "MnkBoard.h"
+
+class SearchEngine
+{
+public:
+	static constexpr int WIN_SCORE = 1000;
+	static constexpr int NODES_PER_POLL = 1024;
+	static constexpr int UNLIMITED_DEPTH = 64;
+
+	enum Evaluation { NO_EVALUATION, OPEN_LINES };     // score at the depth limit, 0 or the open lines
+
+	struct Result {
+		int bestMove = -1;            // position on the board
+		int score = 0;                // see notes, from the point of view of the player to move
+		int depth = 0;                // deepest completed iteration
+		uint64_t nodes = 0;           // positions searched, all iterations
+		bool exact = false;           // true if the tree was searched to the end (score is the game value)
+	};
+
+	SearchEngine(Evaluation evaluation = NO_EVALUATION);
+	Result search(const MnkBoard& root, std::chrono::steady_clock::time_point deadline,
+		const std::atomic<bool>& cancel, int maxDepth = UNLIMITED_DEPTH);
+
+private:
+	Evaluation evaluation;
+	LineEvaluator evaluator;                      // OPEN_LINES: follows the board through the search
+	std::vector<int> moveOrder;                   // squares, centre first
+	std::chrono::steady_clock::time_point deadline;
+	const std::atomic<bool>* cancel = nullptr;
+	uint64_t nodes = 0;
+	bool stopped = false;                         // deadline or cancel seen, unwind & discard the iteration
+	bool horizonReached = false;                  // an iteration cut off a line of play at the depth limit
+
+	int negamax(MnkBoard& board, int depth, int alpha, int beta);
+	void play(MnkBoard& board, int position);
+	void undo(MnkBoard& board, int position);
+	bool pollStop();
+	void orderMoves(const MnkBoard& board);
+};
@@ -0,0 +1,176 @@
+// SessionLog.cpp
+//   Record an interactive session (inputs & console frames) & replay it, checking & timing every frame
+//   <blank line>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include "SessionLog.h"
+
+/*
+ * Instance variables (declared in header file)
+ *   mode - RECORD or REPLAY
+ *   recording - RECORD: the log file, events written as they happen
+ *   events, nextEvent - REPLAY: the recorded events & the next one to use
+ *   frame - output since the last input, the frame being built
+ *   start - RECORD: time 0 for the event timestamps
+ *   frameStart - REPLAY: when the input before the current frame was handed out
+ *   frameTimes - REPLAY: replay time of each frame checked, for the percentiles
+ *   report - REPLAY: counts so far
+ *   ended - endSession() called, the last frame is done
+ */
+
+// Constructor - RECORD creates the file & writes the header, REPLAY reads every event (before the clock starts)
+//   throws runtime_error if the file can't be opened, invalid_argument if it isn't a session log
+SessionLog::SessionLog(const std::string& path, Mode mode)
+	: mode(mode) {
+	if (mode == RECORD) {
+		recording.open(path, std::ios::binary | std::ios::trunc);
+		if (!recording)
+			throw std::runtime_error("Unable to create session log: " + path + "\n");
+		recording << FILE_HEADER << '\n';
+		recording.flush();
+	}
+	else {
+		std::ifstream log(path, std::ios::binary);
+		if (!log)
+			throw std::runtime_error("Unable to open session log: " + path + "\n");
+		std::string header;
+		if (!std::getline(log, header) || (header != FILE_HEADER))
+			throw std::invalid_argument("Not a session log: " + path + "\n");
+		Event event;
+		while (readEvent(log, event))
+			events.push_back(event);
+		frameTimes.reserve(events.size());
+	}
+	frame.reserve(4096);
+	start = std::chrono::steady_clock::now();
+	frameStart = start;
+}
+
+SessionLog::Mode SessionLog::getMode() const {
+	return mode;
+}
+
+// Output of the frame being built - the UI & renderer append everything they write
+std::string& SessionLog::getFrame() {
+	return frame;
+}
+
+// RECORD: the frame the user answered, then what they typed (as typed, before any lower casing)
+void SessionLog::recordInput(const std::string& input) {
+	writeRecorded(OUTPUT_EVENT, frame);
+	frame.clear();
+	writeRecorded(INPUT_EVENT, input);
+}
+
+// REPLAY: checks & times the frame, then the next recorded input - false once the recording has no more
+//   input (or doesn't expect one here), the caller ends the game as if the user quit
+bool SessionLog::replayInput(std::string& input) {
+	checkFrame();
+	if ((nextEvent >= events.size()) || (events[nextEvent].type != INPUT_EVENT))
+		return false;
+	input = events[nextEvent++].text;
+	report.inputs++;
+	frameStart = std::chrono::steady_clock::now();
+	return true;
+}
+
+// The last frame (e.g. the exit message) - written or checked once, further calls do nothing
+void SessionLog::endSession() {
+	if (ended)
+		return;
+	ended = true;
+	if (mode == RECORD) {
+		writeRecorded(OUTPUT_EVENT, frame);
+		frame.clear();
+	}
+	else
+		checkFrame();
+}
+
+// REPLAY: frames checked so far & their times, unused events counted from where the replay is
+SessionLog::Report SessionLog::getReport() const {
+	Report result = report;
+	result.unusedEvents = static_cast<int>(events.size() - nextEvent);
+	if (!events.empty())
+		result.recordedSeconds = events.back().microseconds / 1e6;
+	if (!frameTimes.empty()) {
+		std::vector<double> sorted(frameTimes);
+		std::sort(sorted.begin(), sorted.end());
+		double total = 0;
+		for (double time : sorted)
+			total += time;
+		result.totalMs = total / 1000;
+		result.meanUs = total / sorted.size();
+		result.p50Us = sorted[sorted.size() / 2];
+		result.p99Us = sorted[(sorted.size() * 99) / 100];
+		result.maxUs = sorted.back();
+	}
+	return result;
+}
+
+// One event in the file format (header notes) - the text is written as is, whatever bytes it holds
+void SessionLog::writeEvent(std::ostream& out, const Event& event) {
+	out << event.type << ' ' << event.microseconds << ' ' << event.text.size() << '\n';
+	out.write(event.text.data(), static_cast<std::streamsize>(event.text.size()));
+	out << '\n';
+}
+
+// The next event, false at the end of the file - throws invalid_argument for a damaged or cut short event
+bool SessionLog::readEvent(std::istream& in, Event& event) {
+	std::string line;
+	if (!std::getline(in, line))
+		return false;
+	// "<type> <microseconds> <bytes>" - digits only, nothing after the size
+	char* sizeStart = nullptr;
+	char* sizeEnd = nullptr;
+	long long microseconds = (line.size() > 2) ? strtoll(line.c_str() + 2, &sizeStart, 10) : -1;
+	unsigned long long size = (microseconds >= 0) ? strtoull(sizeStart, &sizeEnd, 10) : 0;
+	if ((line.size() < 5) || ((line[0] != INPUT_EVENT) && (line[0] != OUTPUT_EVENT)) || (line[1] != ' ') ||
+		!isdigit(static_cast<unsigned char>(line[2])) || (*sizeStart != ' ') ||
+		!isdigit(static_cast<unsigned char>(sizeStart[1])) || (*sizeEnd != '\0'))
+		throw std::invalid_argument("Bad session log event: " + line + "\n");
+
+	event.type = line[0];
+	event.microseconds = microseconds;
+	event.text.resize(static_cast<size_t>(size));
+	if (size > 0)
+		in.read(&event.text[0], static_cast<std::streamsize>(size));
+	if (!in || (in.get() != '\n'))
+		throw std::invalid_argument("Session log event cut short: " + line + "\n");
+	return true;
+}
+
+//                                     ***  SessionLog helper functions ***
+
+int64_t SessionLog::elapsedMicroseconds() const {
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// flushed so a session that ends without endSession() (e.g. killed) is recorded up to its last input
+void SessionLog::writeRecorded(char type, const std::string& text) {
+	writeEvent(recording, { type, elapsedMicroseconds(), text });
+	recording.flush();
+	if (!recording)
+		throw std::runtime_error("Unable to write session log\n");
+}
+
+// replay: the frame just completed against the next recorded frame, timed from the input that caused it
+void SessionLog::checkFrame() {
+	frameTimes.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - frameStart).count());
+	bool matches = (nextEvent < events.size()) && (events[nextEvent].type == OUTPUT_EVENT) &&
+		(events[nextEvent].text == frame);
+	if ((nextEvent < events.size()) && (events[nextEvent].type == OUTPUT_EVENT))
+		nextEvent++;
+	if (!matches) {
+		if (report.firstMismatch < 0)
+			report.firstMismatch = report.frames;
+		report.mismatches++;
+	}
+	report.frames++;
+	frame.clear();
+}
@@ -0,0 +1,94 @@
+#pragma once
+/*****************************************************************//**
+ * \file   SessionLog.h
+ * \brief  console session record & replay - SessionLog
+ *     Scope - records an interactive game (every line typed, with its time, & every frame written to the console)
+ *        & replays it through the same game loop at full speed, checking each frame against the recording & timing
+ *        it - an end to end benchmark of input parsing, writeSquare(), the win check & rendering
+ *
+ * \date   updated: October 2026
+ *
+ * Implementation notes:
+ *     - a frame is everything written to the console between two inputs, the prompt included - frame i is the
+ *          response to input i (frame 0 is the start up screen), the last frame is written when the session ends
+ *     - file: header line "TTSESSION 1", then events - a line "I|O <microseconds> <bytes>", the bytes (escape
+ *          sequences, tabs & newlines as written) & a newline - microseconds since recording started
+ *     - recording writes each event as it happens (flushed), a session cut short still replays up to that point
+ *     - replay loads the whole file first, then a frame's time runs from handing out the input before it to the
+ *          frame being complete (the next prompt), nothing is written to the console while replaying
+ *     - frames only repeat if the renderer doesn't follow the terminal size (TerminalRenderer::setOutput()) - a
+ *          resize would otherwise force a full redraw that the replay doesn't see
+ *     - can't open / write the file throws runtime_error, a file that isn't a session log throws invalid_argument
+ *
+ * SessionLog(path, mode)                - RECORD creates the file, REPLAY loads it
+ * std::string& getFrame()               - output of the current frame, appended to by the UI & the renderer
+ * void recordInput(input)               - RECORD: ends the frame (written to the file), then writes the input
+ * bool replayInput(input)               - REPLAY: ends & checks the frame, the next recorded input (false if none)
+ * void endSession()                     - the last frame written / checked
+ * Report getReport()                    - REPLAY: frames, mismatches & time per frame
+ **/
+
+#include <cstdint>
+#include <chrono>
+#include <fstream>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+class SessionLog
+{
+public:
+	enum Mode { RECORD, REPLAY };
+
+	struct Event {
+		char type;                            // INPUT_EVENT or OUTPUT_EVENT
+		int64_t microseconds;                 // since recording started
+		std::string text;
+	};
+
+	struct Report {
+		int frames = 0;                       // replayed & checked
+		int inputs = 0;
+		int mismatches = 0;                   // frames that differ from the recording
+		int firstMismatch = -1;               // frame #, -1 if all match
+		int unusedEvents = 0;                 // recorded events not reached by the replay
+		double recordedSeconds = 0;           // length of the recorded session
+		double totalMs = 0;                   // replay time of all frames
+		double meanUs = 0;                    // per frame
+		double p50Us = 0;
+		double p99Us = 0;
+		double maxUs = 0;
+	};
+
+	static constexpr char INPUT_EVENT = 'I';
+	static constexpr char OUTPUT_EVENT = 'O';
+	static constexpr const char* FILE_HEADER = "TTSESSION 1";
+
+	SessionLog(const std::string& path, Mode mode);
+	Mode getMode() const;
+
+	std::string& getFrame();
+	void recordInput(const std::string& input);
+	bool replayInput(std::string& input);
+	void endSession();
+	Report getReport() const;
+
+	static void writeEvent(std::ostream& out, const Event& event);
+	static bool readEvent(std::istream& in, Event& event);
+
+private:
+	Mode mode;
+	std::ofstream recording;
+	std::vector<Event> events;                // REPLAY: the whole recording
+	size_t nextEvent = 0;
+	std::string frame;
+	std::chrono::steady_clock::time_point start;
+	std::chrono::steady_clock::time_point frameStart;
+	std::vector<double> frameTimes;           // microseconds, in frame order
+	Report report;
+	bool ended = false;
+
+	int64_t elapsedMicroseconds() const;
+	void writeRecorded(char type, const std::string& text);
+	void checkFrame();
+};
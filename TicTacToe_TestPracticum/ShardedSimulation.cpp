@@ -0,0 +1,328 @@
+// ShardedSimulation.cpp
+//   Random games spread over worker processes - coordinator, worker, partial totals & process launch
+//   <blank line>
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include "ShardedSimulation.h"
+#include "BitHelpers.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <climits>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+extern char** environ;
+#endif
+
+/*
+ * Instance variables (declared in header file)
+ *   ShardCoordinator
+ *     listener - the socket workers connect to, listening from construction so workers can start first
+ *     seed, units, unitGames - the run: unit u plays unitGames games from the seed derived from seed & u
+ *     workerTimeout - how long to wait with no worker connected before giving up
+ *     pending - units to hand out, lost workers' units go back to the front
+ *     report - counts so far, the totals merged as results come in
+ *   ShardWorker
+ *     socket - connection to the coordinator
+ *   WorkerProcess
+ *     process - pid, or process HANDLE on Windows, -1 once waited for
+ *     exitCode - set by wait()
+ */
+
+namespace {
+	constexpr uint32_t MESSAGE_MAGIC = 0x48535454;     // "TTSH"
+	enum MessageType : uint32_t { WORK = 1, RESULT = 2, DONE = 3 };
+
+	// message header, see the header notes - RESULT is followed by the unit's ShardTotals
+	struct Message {
+		uint32_t magic;
+		uint32_t type;
+		uint32_t unit;
+		uint32_t games;
+		uint64_t seed;
+	};
+
+	bool sendMessage(LocalSocket& socket, MessageType type, uint32_t unit, uint32_t games, uint64_t seed) {
+		Message message = { MESSAGE_MAGIC, type, unit, games, seed };
+		return socket.sendAll(&message, sizeof(message));
+	}
+}
+
+//                                     ***  ShardTotals ***
+
+void ShardTotals::merge(const ShardTotals& other) {
+	games += other.games;
+	for (int result = 0; result < RESULTS; result++) {
+		results[result] += other.results[result];
+		for (int cell = 0; cell < CELLS; cell++)
+			firstMoves[cell][result] += other.firstMoves[cell][result];
+	}
+	for (int length = 0; length <= CELLS; length++)
+		lengths[length] += other.lengths[length];
+}
+
+bool ShardTotals::operator==(const ShardTotals& other) const {
+	return (games == other.games) && std::equal(results, results + RESULTS, other.results) &&
+		std::equal(&firstMoves[0][0], &firstMoves[0][0] + CELLS * RESULTS, &other.firstMoves[0][0]) &&
+		std::equal(lengths, lengths + CELLS + 1, other.lengths);
+}
+
+// Games that ended with the result - throws invalid_argument for IN_PROGRESS
+uint64_t ShardTotals::getResult(TicTacToeBoard::GameStatus result) const {
+	if ((result < TicTacToeBoard::X_WINS) || (result > TicTacToeBoard::FORCED_DRAW))
+		throw std::invalid_argument("Shard totals count finished games only\n");
+	return results[result - 1];
+}
+
+// The unit's games - X opens each game, then random empty squares until it's won or drawn
+ShardTotals ShardTotals::simulate(uint64_t seed, uint32_t games) {
+	ShardTotals totals;
+	TicTacToeBoard board;
+	std::mt19937_64 generator(seed);
+	int emptySquares[CELLS];
+	for (uint32_t game = 0; game < games; game++) {
+		board.resetBoard();
+		if (board.getPlayer() != TicTacToeBoard::INITIAL_PLAYER)
+			board.nextPlayer();
+		int firstMove = -1;
+		int moves = 0;
+		TicTacToeBoard::GameStatus status = TicTacToeBoard::IN_PROGRESS;
+		while (status == TicTacToeBoard::IN_PROGRESS) {
+			int numEmpty = 0;
+			for (int square = 0; square < CELLS; square++)
+				if (board.isSquareEmpty(square / TicTacToeBoard::BOARD_NUM_COLS, square % TicTacToeBoard::BOARD_NUM_COLS))
+					emptySquares[numEmpty++] = square;
+			int square = emptySquares[generator() % numEmpty];
+			board.writeSquare(square / TicTacToeBoard::BOARD_NUM_COLS, square % TicTacToeBoard::BOARD_NUM_COLS,
+				board.getPlayer());
+			if (moves++ == 0)
+				firstMove = square;
+			status = board.getGameStatus();
+			board.nextPlayer();
+		}
+		totals.games++;
+		totals.results[status - 1]++;
+		totals.firstMoves[firstMove][status - 1]++;
+		totals.lengths[moves]++;
+	}
+	return totals;
+}
+
+//                                     ***  ShardCoordinator ***
+
+// Constructor - listens on the path straight away, workers may connect before run()
+//   throws invalid_argument for no units or no games, runtime_error if the socket can't listen
+ShardCoordinator::ShardCoordinator(const std::string& path, uint64_t seed, uint32_t units, uint32_t unitGames,
+	std::chrono::milliseconds workerTimeout)
+	: seed(seed), units(units), unitGames(unitGames), workerTimeout(workerTimeout) {
+	if ((units == 0) || (unitGames == 0))
+		throw std::invalid_argument("Sharded simulation needs at least one unit of at least one game\n");
+	listener = LocalSocket::listen(path);
+}
+
+// Hands out every unit & merges the results, accepting workers as they connect & requeueing the units of any
+//   that are lost - throws runtime_error if there is no worker for workerTimeout
+ShardCoordinator::Report ShardCoordinator::run() {
+	report = Report();
+	report.units = units;
+	pending.clear();
+	for (uint32_t unit = 0; unit < units; unit++)
+		pending.push_back(unit);
+	std::vector<char> done(units, 0);
+	uint32_t completed = 0;
+	std::vector<Worker> workers;
+	std::vector<const LocalSocket*> sockets;
+	std::vector<char> ready;
+	auto start = std::chrono::steady_clock::now();
+	auto lastWorker = start;
+
+	while (completed < units) {
+		sockets.assign(1, &listener);
+		for (const Worker& worker : workers)
+			sockets.push_back(&worker.socket);
+		LocalSocket::waitReadable(sockets, POLL_MILLISECONDS, ready);
+
+		for (size_t i = 0; i < workers.size(); i++) {
+			if (ready[i + 1] && !receiveResult(workers[i], done, completed))
+				lose(workers[i]);
+		}
+		workers.erase(std::remove_if(workers.begin(), workers.end(),
+			[](const Worker& worker) { return !worker.socket.isOpen(); }), workers.end());
+		if (ready[0]) {
+			if (report.workers == 0)
+				start = std::chrono::steady_clock::now();
+			workers.push_back(Worker{ listener.accept(), std::deque<uint32_t>() });
+			report.workers++;
+		}
+
+		// lost units may be back in the queue, so every worker is topped up
+		for (Worker& worker : workers)
+			feed(worker);
+		workers.erase(std::remove_if(workers.begin(), workers.end(),
+			[](const Worker& worker) { return !worker.socket.isOpen(); }), workers.end());
+
+		auto now = std::chrono::steady_clock::now();
+		if (!workers.empty())
+			lastWorker = now;
+		else if ((completed < units) && (now - lastWorker > workerTimeout))
+			throw std::runtime_error("No shard worker connected for " + std::to_string(workerTimeout.count()) +
+				" ms, " + std::to_string(units - completed) + " units left\n");
+	}
+	report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	for (Worker& worker : workers)
+		sendMessage(worker.socket, DONE, 0, 0, 0);
+	return report;
+}
+
+//                                     ***  ShardCoordinator helper functions ***
+
+// up to PIPELINE units outstanding - a failed send loses the worker
+void ShardCoordinator::feed(Worker& worker) {
+	while (worker.socket.isOpen() && (worker.outstanding.size() < static_cast<size_t>(PIPELINE)) && !pending.empty()) {
+		uint32_t unit = pending.front();
+		pending.pop_front();
+		worker.outstanding.push_back(unit);
+		if (!sendMessage(worker.socket, WORK, unit, unitGames, mix(seed + unit)))
+			lose(worker);
+	}
+}
+
+// the worker's connection is gone - its outstanding units are handed out again, first
+void ShardCoordinator::lose(Worker& worker) {
+	for (auto unit = worker.outstanding.rbegin(); unit != worker.outstanding.rend(); ++unit)
+		pending.push_front(*unit);
+	report.reassigned += static_cast<int>(worker.outstanding.size());
+	report.workersLost++;
+	worker.outstanding.clear();
+	worker.socket.close();
+}
+
+// a result from the worker, merged once per unit - false if the connection closed or sent something unexpected
+bool ShardCoordinator::receiveResult(Worker& worker, std::vector<char>& done, uint32_t& completed) {
+	Message message;
+	ShardTotals totals;
+	if (!worker.socket.receiveAll(&message, sizeof(message)) || (message.magic != MESSAGE_MAGIC) ||
+		(message.type != RESULT) || !worker.socket.receiveAll(&totals, sizeof(totals)))
+		return false;
+	auto unit = std::find(worker.outstanding.begin(), worker.outstanding.end(), message.unit);
+	if ((unit == worker.outstanding.end()) || (totals.games != unitGames))
+		return false;
+	worker.outstanding.erase(unit);
+	if (!done[message.unit]) {
+		done[message.unit] = 1;
+		report.totals.merge(totals);
+		completed++;
+	}
+	return true;
+}
+
+//                                     ***  ShardWorker ***
+
+// Constructor - connects to the coordinator, throws runtime_error if it isn't listening
+ShardWorker::ShardWorker(const std::string& path)
+	: socket(LocalSocket::connect(path)) {
+}
+
+// Plays the units handed out until DONE (or the coordinator goes away), returns the # played
+//   failAfter >= 0: after that many units the next one is abandoned & the connection closed, as a crash would
+//   throws runtime_error if the coordinator sends something that isn't a message
+int ShardWorker::run(int failAfter) {
+	int played = 0;
+	Message message;
+	while (socket.receiveAll(&message, sizeof(message))) {
+		if (message.magic != MESSAGE_MAGIC)
+			throw std::runtime_error("Shard worker received a bad message\n");
+		if (message.type == DONE)
+			break;
+		if (message.type != WORK)
+			continue;
+		if ((failAfter >= 0) && (played == failAfter)) {
+			socket.close();
+			break;
+		}
+		ShardTotals totals = ShardTotals::simulate(message.seed, message.games);
+		if (!sendMessage(socket, RESULT, message.unit, message.games, message.seed) ||
+			!socket.sendAll(&totals, sizeof(totals)))
+			break;
+		played++;
+	}
+	return played;
+}
+
+//                                     ***  WorkerProcess ***
+
+// Starts the program with the arguments (the program path isn't repeated in them) - throws runtime_error if it
+//   can't be started
+WorkerProcess::WorkerProcess(const std::string& program, const std::vector<std::string>& arguments) {
+#ifdef _WIN32
+	// command line: each argument quoted (arguments here hold no quotes)
+	std::string commandLine = "\"" + program + "\"";
+	for (const std::string& argument : arguments)
+		commandLine += " \"" + argument + "\"";
+	STARTUPINFOA startup = {};
+	startup.cb = sizeof(startup);
+	PROCESS_INFORMATION info = {};
+	if (!CreateProcessA(program.c_str(), &commandLine[0], nullptr, nullptr, FALSE, 0, nullptr, nullptr, &startup,
+		&info))
+		throw std::runtime_error("Unable to start worker process: " + program + "\n");
+	CloseHandle(info.hThread);
+	process = reinterpret_cast<intptr_t>(info.hProcess);
+#else
+	std::vector<char*> argv;
+	argv.push_back(const_cast<char*>(program.c_str()));
+	for (const std::string& argument : arguments)
+		argv.push_back(const_cast<char*>(argument.c_str()));
+	argv.push_back(nullptr);
+	pid_t pid;
+	if (posix_spawn(&pid, program.c_str(), nullptr, nullptr, argv.data(), environ) != 0)
+		throw std::runtime_error("Unable to start worker process: " + program + "\n");
+	process = pid;
+#endif
+}
+
+WorkerProcess::~WorkerProcess() {
+	wait();
+}
+
+// Waits for the process to exit - its exit code, -1 if it was killed (or already waited for & failed)
+int WorkerProcess::wait() {
+	if (process == -1)
+		return exitCode;
+#ifdef _WIN32
+	HANDLE handle = reinterpret_cast<HANDLE>(process);
+	DWORD code = 0;
+	if ((WaitForSingleObject(handle, INFINITE) == WAIT_OBJECT_0) && GetExitCodeProcess(handle, &code))
+		exitCode = static_cast<int>(code);
+	CloseHandle(handle);
+#else
+	int status = 0;
+	if ((waitpid(static_cast<pid_t>(process), &status, 0) == process) && WIFEXITED(status))
+		exitCode = WEXITSTATUS(status);
+#endif
+	process = -1;
+	return exitCode;
+}
+
+// Path of the running executable, so workers run the same build - argv[0] if the system can't say
+std::string WorkerProcess::currentProgram(const char* argv0) {
+#ifdef _WIN32
+	char path[MAX_PATH];
+	DWORD length = GetModuleFileNameA(nullptr, path, MAX_PATH);
+	if ((length > 0) && (length < MAX_PATH))
+		return std::string(path, length);
+#else
+	char path[PATH_MAX];
+	ssize_t length = readlink("/proc/self/exe", path, sizeof(path) - 1);
+	if (length > 0)
+		return std::string(path, static_cast<size_t>(length));
+#endif
+	return argv0;
+}
@@ -0,0 +1,128 @@
+#pragma once
+/*****************************************************************//**
+ * \file   ShardedSimulation.h
+ * \brief  multi-process random game simulation - ShardTotals (partial results), ShardCoordinator, ShardWorker,
+ *        WorkerProcess
+ *     Scope - spreads random TicTacToeBoard games over worker processes: a coordinator hands out units of work
+ *        (a seed & a # of games) over a local socket, workers play them & send back the unit's totals, the
+ *        coordinator merges them & hands the units of a lost worker to the others - local processes stand in
+ *        for the nodes of a cluster
+ *
+ * \date   updated: October 2026
+ *
+ * Implementation notes:
+ *     - a unit's games depend only on its seed (derived from the run's seed & the unit #), so the merged totals
+ *          are the same whichever worker plays which unit, & however many workers there are
+ *     - ShardTotals is a fixed size block of counts (408 bytes): results, results by X's first square & game
+ *          lengths - merging is adding, a unit's games are summed by the worker & only its totals travel
+ *     - messages: a fixed header (magic "TTSH", type, unit, games, seed), WORK coordinator -> worker, RESULT
+ *          worker -> coordinator followed by the unit's ShardTotals, DONE when every unit is in - native byte
+ *          order, both ends run on the same machine
+ *     - each worker has up to PIPELINE units outstanding, so it starts the next as soon as it sends a result
+ *     - a worker whose connection closes (exited, killed or crashed) is lost, its outstanding units go back to
+ *          the front of the queue for the other workers - results are counted once per unit
+ *     - the coordinator waits in one thread on all its sockets at once (LocalSocket::waitReadable()), if no
+ *          worker is connected for the worker timeout it gives up (runtime_error) - a worker that hangs without
+ *          closing its connection isn't detected
+ *     - WorkerProcess: posix_spawn / waitpid, or CreateProcess / WaitForSingleObject on Windows
+ *     - socket & process errors throw runtime_error, a unit or game count of 0 throws invalid_argument
+ *
+ * ShardTotals simulate(seed, games)             - the games of one unit, played in this process
+ * ShardCoordinator(path, seed, units, games)    - listens on the path, units of games each
+ * Report run()                                  - hands out every unit & merges the results, returns the totals
+ * ShardWorker(path)                             - connects to the coordinator
+ * int run(failAfter)                            - plays units until DONE, # played (failAfter >= 0: abandons the
+ *                                                    next unit after that many, as if the process died)
+ * WorkerProcess(program, arguments), wait()     - another process running the program, its exit code
+ **/
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+#include "LocalSocket.h"
+#include "TicTacToeBoard.h"
+
+struct ShardTotals {
+	static constexpr int CELLS = TicTacToeBoard::BOARD_NUM_ROWS * TicTacToeBoard::BOARD_NUM_COLS;
+	static constexpr int RESULTS = TicTacToeBoard::FORCED_DRAW;      // X_WINS - FORCED_DRAW, indexed status - 1
+
+	uint64_t games = 0;
+	uint64_t results[RESULTS] = {};
+	uint64_t firstMoves[CELLS][RESULTS] = {};                        // by X's first square
+	uint64_t lengths[CELLS + 1] = {};                                // by # of moves played
+
+	void merge(const ShardTotals& other);
+	bool operator==(const ShardTotals& other) const;
+	uint64_t getResult(TicTacToeBoard::GameStatus result) const;
+
+	static ShardTotals simulate(uint64_t seed, uint32_t games);
+};
+
+class ShardCoordinator
+{
+public:
+	static constexpr int PIPELINE = 2;                               // units outstanding per worker
+
+	struct Report {
+		ShardTotals totals;
+		uint32_t units = 0;
+		int workers = 0;                                             // connected during the run
+		int workersLost = 0;                                         // connection closed before DONE
+		int reassigned = 0;                                          // units handed out again
+		double seconds = 0;                                          // first worker connected to last result in
+	};
+
+	ShardCoordinator(const std::string& path, uint64_t seed, uint32_t units, uint32_t unitGames,
+		std::chrono::milliseconds workerTimeout = std::chrono::seconds(10));
+
+	Report run();
+
+private:
+	static constexpr int POLL_MILLISECONDS = 100;
+
+	struct Worker {
+		LocalSocket socket;
+		std::deque<uint32_t> outstanding;                            // units sent, results not yet in
+	};
+
+	LocalSocket listener;
+	uint64_t seed;
+	uint32_t units;
+	uint32_t unitGames;
+	std::chrono::milliseconds workerTimeout;
+	std::deque<uint32_t> pending;                                    // units not handed out
+	Report report;
+
+	void feed(Worker& worker);
+	void lose(Worker& worker);
+	bool receiveResult(Worker& worker, std::vector<char>& done, uint32_t& completed);
+};
+
+class ShardWorker
+{
+public:
+	explicit ShardWorker(const std::string& path);
+	int run(int failAfter = -1);
+
+private:
+	LocalSocket socket;
+};
+
+class WorkerProcess
+{
+public:
+	WorkerProcess(const std::string& program, const std::vector<std::string>& arguments);
+	~WorkerProcess();                                                // waits if wait() wasn't called
+	WorkerProcess(const WorkerProcess&) = delete;                    // owns the process
+	WorkerProcess& operator=(const WorkerProcess&) = delete;
+
+	int wait();                                                      // exit code, -1 if it didn't exit normally
+
+	static std::string currentProgram(const char* argv0);            // path of this executable
+
+private:
+	intptr_t process = -1;                                           // pid, or HANDLE on Windows
+	int exitCode = -1;
+};
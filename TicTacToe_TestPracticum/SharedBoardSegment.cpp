@@ -0,0 +1,203 @@
+// SharedBoardSegment.cpp
+//   Publishes board snapshots to other processes through shared memory, seqlock per game
+//   <blank line>
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include "SharedBoardSegment.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*
+ * Instance variables (declared in header file)
+ *   name - segment name as supplied, the platform prefix ("/" or "Local\") is added when mapping
+ *   mode - CREATE (publisher, removes the name on destruction) or ATTACH (viewer)
+ *   mapping, mappedSize - the mapped segment, header followed by numGames slots
+ *
+ * Notes
+ *   The atomics must be lock free to be shared between processes, checked at compile time below
+ *   Slot fields are individually atomic (relaxed), so a reader racing the writer is well defined,
+ *     the sequence check tells it whether the copy is consistent
+ */
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_SHORT_LOCK_FREE == 2 && ATOMIC_CHAR_LOCK_FREE == 2,
+	"shared memory slots require lock free atomics");
+
+// Create (publisher) or attach to (viewer) the named segment
+//   throws runtime_error if the segment can't be created / opened or doesn't hold board slots
+SharedBoardSegment::SharedBoardSegment(const std::string& name, Mode mode, int numGames)
+	: name(name), mode(mode) {
+	static_assert(sizeof(Slot) == 64, "slot should fill one cache line");
+	if (mode == CREATE && numGames <= 0)
+		throw std::invalid_argument("Shared board segment needs at least one game\n");
+
+#ifdef _WIN32
+	std::string mappingName = "Local\\" + name;
+	if (mode == CREATE) {
+		mappedSize = segmentSize(numGames);
+		mappingHandle = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+			0, static_cast<DWORD>(mappedSize), mappingName.c_str());
+		if (mappingHandle != nullptr && GetLastError() == ERROR_ALREADY_EXISTS) {   // opened another publisher's
+			CloseHandle(mappingHandle);
+			mappingHandle = nullptr;
+			throw std::runtime_error("Shared memory segment already in use: " + name + " (another publisher)\n");
+		}
+	}
+	else
+		mappingHandle = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, mappingName.c_str());
+	if (mappingHandle == nullptr)
+		throw std::runtime_error("Unable to open shared memory segment: " + name + "\n");
+	mapping = MapViewOfFile(mappingHandle, FILE_MAP_ALL_ACCESS, 0, 0, mappedSize);   // 0 = whole mapping
+	if (mapping == nullptr) {
+		CloseHandle(mappingHandle);
+		throw std::runtime_error("Unable to map shared memory segment: " + name + "\n");
+	}
+	if (mode == ATTACH) {
+		MEMORY_BASIC_INFORMATION info;
+		VirtualQuery(mapping, &info, sizeof(info));
+		mappedSize = info.RegionSize;
+	}
+#else
+	std::string mappingName = "/" + name;
+	int fd;
+	if (mode == CREATE) {
+		mappedSize = segmentSize(numGames);
+		fd = shm_open(mappingName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);    // never truncate a mapped segment
+		if (fd < 0 && errno == EEXIST)
+			throw std::runtime_error("Shared memory segment already in use: " + name +
+				" (another publisher, or a stale one left by a publisher that crashed)\n");
+		if (fd >= 0 && ftruncate(fd, static_cast<off_t>(mappedSize)) != 0) {
+			shm_unlink(mappingName.c_str());
+			close(fd);
+			fd = -1;
+		}
+	}
+	else {
+		fd = shm_open(mappingName.c_str(), O_RDWR, 0);
+		struct stat status;
+		if (fd >= 0 && fstat(fd, &status) == 0)
+			mappedSize = static_cast<size_t>(status.st_size);
+		if (fd >= 0 && mappedSize < sizeof(Header)) {     // fstat failed or too small to be a segment
+			close(fd);
+			fd = -1;
+		}
+	}
+	if (fd < 0 || mappedSize < sizeof(Header))
+		throw std::runtime_error("Unable to open shared memory segment: " + name + "\n");
+	mapping = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);                          // the mapping keeps the segment alive
+	if (mapping == MAP_FAILED && mode == CREATE)
+		shm_unlink(mappingName.c_str());    // destructor doesn't run, remove the name created above
+	if (mapping == MAP_FAILED)
+		throw std::runtime_error("Unable to map shared memory segment: " + name + "\n");
+#endif
+
+	header = static_cast<Header*>(mapping);
+	slots = reinterpret_cast<Slot*>(header + 1);
+	if (mode == CREATE) {               // new segment is zero filled - slots start as empty boards, sequence 0
+		header->numGames = static_cast<uint32_t>(numGames);
+		std::atomic_thread_fence(std::memory_order_release);
+		header->magic = SEGMENT_MAGIC;
+	}
+	else if (header->magic != SEGMENT_MAGIC || segmentSize(header->numGames) > mappedSize) {
+		unmap();                        // destructor doesn't run if the constructor throws
+		throw std::runtime_error("Shared memory segment doesn't contain board slots: " + name + "\n");
+	}
+}
+
+// Unmap - the publisher also removes the name, viewers already attached keep their mapping
+SharedBoardSegment::~SharedBoardSegment() {
+	unmap();
+#ifndef _WIN32
+	if (mode == CREATE)
+		shm_unlink(("/" + name).c_str());
+#endif
+}
+
+int SharedBoardSegment::getGameCount() const {
+	return static_cast<int>(header->numGames);
+}
+
+// Seqlock write - sequence odd, fields, sequence even
+//   the release fence keeps the field stores after the odd sequence, the release store keeps them before the even one
+void SharedBoardSegment::publish(int game, const TicTacToeBoard& board, unsigned gameNumber) {
+	validateGame(game);
+	Slot& slot = slots[game];
+	TicTacToeBoard::Snapshot snapshot = board.getSnapshot();
+
+	uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+	slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot.gameNumber.store(gameNumber, std::memory_order_relaxed);
+	slot.xSquares.store(snapshot.xSquares, std::memory_order_relaxed);
+	slot.oSquares.store(snapshot.oSquares, std::memory_order_relaxed);
+	slot.player.store(snapshot.player, std::memory_order_relaxed);
+	slot.takenSquareCount.store(snapshot.takenSquareCount, std::memory_order_relaxed);
+	slot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+// Seqlock read - copy the fields between two reads of the sequence, retry if a write was in progress
+//   returns false (snapshot unchanged) if the retry limit is reached, e.g. the publisher died mid-write
+bool SharedBoardSegment::read(int game, TicTacToeBoard::Snapshot& snapshot, unsigned& gameNumber) const {
+	validateGame(game);
+	const Slot& slot = slots[game];
+
+	for (int attempt = 0; attempt < MAX_READ_RETRIES; attempt++) {
+		uint32_t before = slot.sequence.load(std::memory_order_acquire);
+		if (before & 1) {                     // write in progress
+			std::this_thread::yield();
+			continue;
+		}
+		TicTacToeBoard::Snapshot copy;
+		unsigned number = slot.gameNumber.load(std::memory_order_relaxed);
+		copy.xSquares = slot.xSquares.load(std::memory_order_relaxed);
+		copy.oSquares = slot.oSquares.load(std::memory_order_relaxed);
+		copy.player = slot.player.load(std::memory_order_relaxed);
+		copy.takenSquareCount = slot.takenSquareCount.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (slot.sequence.load(std::memory_order_relaxed) == before) {
+			snapshot = copy;
+			gameNumber = number;
+			return true;
+		}
+	}
+	return false;
+}
+
+//                                     ***  Segment helper functions ***
+
+// throws invalid_argument if the game # doesn't have a slot
+void SharedBoardSegment::validateGame(int game) const {
+	if (game < 0 || game >= getGameCount())
+		throw std::invalid_argument("Invalid game passed to shared board segment: " + std::to_string(game) + "\n");
+}
+
+// release the mapping (& on Windows the mapping handle, the name goes with the last handle)
+void SharedBoardSegment::unmap() {
+#ifdef _WIN32
+	if (mapping != nullptr)
+		UnmapViewOfFile(mapping);
+	if (mappingHandle != nullptr)
+		CloseHandle(mappingHandle);
+	mappingHandle = nullptr;
+#else
+	if (mapping != nullptr)
+		munmap(mapping, mappedSize);
+#endif
+	mapping = nullptr;
+}
+
+size_t SharedBoardSegment::segmentSize(int numGames) {
+	return sizeof(Header) + static_cast<size_t>(numGames) * sizeof(Slot);
+}
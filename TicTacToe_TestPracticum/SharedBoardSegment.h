@@ -0,0 +1,79 @@
+#pragma once
+/*****************************************************************//**
+ * \file   SharedBoardSegment.h
+ * \brief  shared memory board publication - SharedBoardSegment
+ *     Scope - a running game (or many) publishes board snapshots into a named shared memory segment,
+ *        separate viewer / analytics processes attach to the segment & read consistent snapshots
+ *
+ * \date   updated: October 2026
+ *
+ * Implementation notes:
+ *     - one slot per game, each guarded by a seqlock (sequence counter, odd while a write is in progress)
+ *          the writer never waits - it bumps the sequence, stores the fields & bumps the sequence again
+ *          readers retry if the sequence was odd or changed while they copied the fields
+ *          no system calls on either side once the segment is mapped
+ *     - only one thread may publish to a given slot (the thread playing that game)
+ *     - POSIX shared memory (shm_open, name "/<name>") or a named file mapping on Windows ("Local\<name>")
+ *     - the creating process removes the name on destruction, attached readers keep their mapping
+ *     - CREATE fails (runtime_error) if the name is already in use, it never resizes a segment viewers have mapped
+ *     - errors (e.g. segment doesn't exist, wrong layout) throw runtime_error, game # out of range throws invalid_argument
+ *
+ * SharedBoardSegment(name, CREATE, numGames)   - creates the segment (publisher)
+ * SharedBoardSegment(name, ATTACH)             - maps an existing segment (viewer)
+ * void publish(game, board, gameNumber)        - seqlock write of the board snapshot
+ * bool read(game, snapshot, gameNumber)        - consistent copy, false if the writer kept it busy past the retry limit
+ **/
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include "TicTacToeBoard.h"
+
+class SharedBoardSegment
+{
+public:
+	enum Mode { CREATE, ATTACH };
+
+	SharedBoardSegment(const std::string& name, Mode mode, int numGames = 0);
+	~SharedBoardSegment();
+	SharedBoardSegment(const SharedBoardSegment&) = delete;              // owns the mapping
+	SharedBoardSegment& operator=(const SharedBoardSegment&) = delete;
+
+	int getGameCount() const;
+	void publish(int game, const TicTacToeBoard& board, unsigned gameNumber);
+	bool read(int game, TicTacToeBoard::Snapshot& snapshot, unsigned& gameNumber) const;
+
+private:
+	static constexpr uint32_t SEGMENT_MAGIC = 0x31545454;    // "TTT1"
+	static constexpr int MAX_READ_RETRIES = 1000;
+
+	// layout shared between processes - lock free atomics only, each slot in its own cache line
+	struct Header {
+		uint32_t magic;
+		uint32_t numGames;
+		char padding[56];
+	};
+	struct Slot {
+		std::atomic<uint32_t> sequence;       // odd while the writer is updating the slot
+		std::atomic<uint32_t> gameNumber;
+		std::atomic<uint16_t> xSquares;
+		std::atomic<uint16_t> oSquares;
+		std::atomic<uint8_t> player;
+		std::atomic<uint8_t> takenSquareCount;
+		char padding[50];
+	};
+
+	std::string name;
+	Mode mode;
+	size_t mappedSize = 0;
+	void* mapping = nullptr;
+	Header* header = nullptr;
+	Slot* slots = nullptr;
+#ifdef _WIN32
+	void* mappingHandle = nullptr;
+#endif
+
+	void validateGame(int game) const;
+	void unmap();
+	static size_t segmentSize(int numGames);
+};
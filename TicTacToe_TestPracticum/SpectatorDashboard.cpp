@@ -0,0 +1,247 @@
+// SpectatorDashboard.cpp
+//   Renders a grid of live games from snapshots published by the threads playing them
+//   <blank line>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include "SpectatorDashboard.h"
+#include "TerminalRenderer.h"     // terminal size & cursor positioning
+
+#ifdef _MSC_VER
+#include <malloc.h>               // _aligned_malloc
+#endif
+
+/*
+ * Instance variables (declared in header file)
+ *   slots - one per game, latest packed snapshot, written by game threads & read by the UI thread
+ *     each slot is a cache line, allocated aligned (allocateSlots()) so no two games share a line
+ *   gamesStarted - sum of the game #s published, kept in full (the packed game # wraps at 65536)
+ *   frontFrame - characters currently on screen (row major, frameRows x frameCols), empty forces a full redraw
+ *   backFrame - frame being composed from the snapshots, swapped with frontFrame once written
+ *   output - escape sequences & changed characters for the frame, written to the console in one call
+ *   frameCount - # frames rendered, shown in the header line
+ *
+ * Packed snapshot layout (64 bits)
+ *   bits  0-15  X squares          bits 16-31  O squares
+ *   bits 32-39  player to move     bits 40-47  # squares played
+ *   bits 48-63  game # (wraps), incremented by the game thread each time the board is reset
+ */
+
+namespace {
+	constexpr int DEFAULT_TERMINAL_COLS = 80;     // used if the output is not a terminal
+	constexpr int MERGE_GAP = 4;                  // unchanged characters rewritten rather than a new cursor move
+}
+
+// Constructor - all slots start as an empty board, game 0
+SpectatorDashboard::SpectatorDashboard(int numGames)
+	: numGames(numGames), slots(allocateSlots(numGames)) {
+	for (int g = 0; g < numGames; g++) {
+		slots[g].packed.store(0, std::memory_order_relaxed);
+		slots[g].lastGameNumber = 0;
+	}
+}
+
+int SpectatorDashboard::getGameCount() const {
+	return numGames;
+}
+
+// Publish the current state of a game - one atomic store, never blocks the game thread
+//   release ordering isn't needed, the snapshot travels in the word itself
+void SpectatorDashboard::publish(int game, const TicTacToeBoard& board, unsigned gameNumber) {
+	publish(game, board.getSnapshot(), gameNumber);
+}
+
+// Snapshot version, e.g. for games read from another process
+//   a new game # adds how far it moved to the running total (one publisher per slot, so no race on lastGameNumber)
+void SpectatorDashboard::publish(int game, const TicTacToeBoard::Snapshot& snapshot, unsigned gameNumber) {
+	Slot& slot = slots[game];
+	if (gameNumber != slot.lastGameNumber) {
+		gamesStarted.fetch_add(gameNumber - slot.lastGameNumber, std::memory_order_relaxed);
+		slot.lastGameNumber = gameNumber;
+	}
+	slot.packed.store(packSnapshot(snapshot, gameNumber), std::memory_order_relaxed);
+}
+
+// Latest snapshot of a game, consistent by construction (single word)
+TicTacToeBoard::Snapshot SpectatorDashboard::readSnapshot(int game, unsigned& gameNumber) const {
+	uint64_t packed = slots[game].packed.load(std::memory_order_relaxed);
+	TicTacToeBoard::Snapshot snapshot;
+	snapshot.xSquares = static_cast<uint16_t>(packed);
+	snapshot.oSquares = static_cast<uint16_t>(packed >> 16);
+	snapshot.player = static_cast<uint8_t>(packed >> 32);
+	snapshot.takenSquareCount = static_cast<uint8_t>(packed >> 40);
+	gameNumber = static_cast<unsigned>(packed >> 48);
+	return snapshot;
+}
+
+// Sum of the game #s published to every slot - the games started, not limited to the 16 bits in a slot
+uint64_t SpectatorDashboard::getGamesStarted() const {
+	return gamesStarted.load(std::memory_order_relaxed);
+}
+
+// Forces the next frame to clear the screen & redraw everything
+void SpectatorDashboard::invalidate() {
+	frontFrame.clear();
+}
+
+// Compose one frame from the latest snapshots & write the characters that changed since the last frame
+int SpectatorDashboard::renderFrame(std::ostream& out) {
+	int terminalRows = 0;
+	int terminalCols = 0;
+	if (!TerminalRenderer::querySize(terminalRows, terminalCols) || terminalCols <= 0)
+		terminalCols = DEFAULT_TERMINAL_COLS;
+
+	int tilesPerRow = std::max(1, (terminalCols + TILE_GAP_COLS) / (TILE_WIDTH + TILE_GAP_COLS));
+	int tileRows = (numGames + tilesPerRow - 1) / tilesPerRow;
+	int rows = HEADER_ROWS + tileRows * (TILE_HEIGHT + TILE_GAP_ROWS);
+	if (rows != frameRows || terminalCols != frameCols)
+		resizeFrames(rows, terminalCols);      // terminal resized -> full redraw
+
+	// compose the back frame
+	backFrame.assign(static_cast<size_t>(frameRows) * frameCols, ' ');
+	for (int g = 0; g < numGames; g++) {     // each slot loaded once per frame
+		unsigned gameNumber = 0;
+		TicTacToeBoard::Snapshot snapshot = readSnapshot(g, gameNumber);
+		composeTile(snapshot, gameNumber, HEADER_ROWS + (g / tilesPerRow) * (TILE_HEIGHT + TILE_GAP_ROWS),
+			(g % tilesPerRow) * (TILE_WIDTH + TILE_GAP_COLS));
+	}
+	char header[96];
+	snprintf(header, sizeof(header), "Spectating %d games   games started: %llu   frame: %u",
+		numGames, static_cast<unsigned long long>(getGamesStarted()), frameCount);
+	putText(0, 0, header);
+
+	// write it - everything if there is no front frame, otherwise runs of changed characters
+	output.clear();
+	if (frontFrame.size() != backFrame.size()) {
+		output += "\x1b[H\x1b[2J";
+		for (int r = 0; r < frameRows; r++) {
+			TerminalRenderer::appendMoveTo(output, r + 1, 1);
+			output.append(backFrame, static_cast<size_t>(r) * frameCols, frameCols);
+		}
+	}
+	else {
+		for (int r = 0; r < frameRows; r++) {
+			size_t rowStart = static_cast<size_t>(r) * frameCols;
+			int c = 0;
+			while (c < frameCols) {
+				if (backFrame[rowStart + c] == frontFrame[rowStart + c]) {
+					c++;
+					continue;
+				}
+				// extend the run over nearby changes, a few unchanged characters are cheaper than a cursor move
+				int end = c + 1;
+				int gap = 0;
+				for (int k = end; k < frameCols && gap <= MERGE_GAP; k++) {
+					if (backFrame[rowStart + k] != frontFrame[rowStart + k]) {
+						end = k + 1;
+						gap = 0;
+					}
+					else
+						gap++;
+				}
+				TerminalRenderer::appendMoveTo(output, r + 1, c + 1);
+				output.append(backFrame, rowStart + c, end - c);
+				c = end;
+			}
+		}
+	}
+	TerminalRenderer::appendMoveTo(output, frameRows + 1, 1);    // park cursor under the dashboard
+
+	out.write(output.data(), output.size());
+	out.flush();
+	frontFrame.swap(backFrame);
+	frameCount++;
+	return static_cast<int>(output.size());
+}
+
+//                                     ***  Dashboard helper functions ***
+
+// Slots for count games on cache line boundaries - new doesn't over-align before C++17
+SpectatorDashboard::Slot* SpectatorDashboard::allocateSlots(int count) {
+	size_t bytes = sizeof(Slot) * static_cast<size_t>(std::max(count, 1));
+#ifdef _MSC_VER
+	void* memory = _aligned_malloc(bytes, alignof(Slot));
+#else
+	void* memory = nullptr;
+	if (posix_memalign(&memory, alignof(Slot), bytes) != 0)
+		memory = nullptr;
+#endif
+	if (memory == nullptr)
+		throw std::bad_alloc();
+	Slot* slots = static_cast<Slot*>(memory);
+	for (int g = 0; g < count; g++)
+		new (&slots[g]) Slot();
+	return slots;
+}
+
+// Slots are trivially destructible (an atomic word), only the memory is released
+void SpectatorDashboard::SlotDeleter::operator()(Slot* slots) const {
+#ifdef _MSC_VER
+	_aligned_free(slots);
+#else
+	free(slots);
+#endif
+}
+
+// Pack snapshot & game # into one word, see layout at the top of the file
+uint64_t SpectatorDashboard::packSnapshot(const TicTacToeBoard::Snapshot& snapshot, unsigned gameNumber) {
+	return static_cast<uint64_t>(snapshot.xSquares) |
+		(static_cast<uint64_t>(snapshot.oSquares) << 16) |
+		(static_cast<uint64_t>(snapshot.player) << 32) |
+		(static_cast<uint64_t>(snapshot.takenSquareCount) << 40) |
+		(static_cast<uint64_t>(gameNumber & 0xFFFF) << 48);
+}
+
+// Draw one game - title (game # & result or player to move), then the cells in the writeTicTacToeBoard() layout
+//   from the snapshot renderFrame() loaded, so the tile shows one publication
+void SpectatorDashboard::composeTile(const TicTacToeBoard::Snapshot& snapshot, unsigned gameNumber, int top, int left) {
+	const char* state;
+	if (TicTacToeBoard::containsWinningPattern(snapshot.xSquares))
+		state = "X won";
+	else if (TicTacToeBoard::containsWinningPattern(snapshot.oSquares))
+		state = "O won";
+	else if (snapshot.takenSquareCount >= TicTacToeBoard::BOARD_NUM_ROWS * TicTacToeBoard::BOARD_NUM_COLS)
+		state = "draw";
+	else
+		state = (snapshot.player == TicTacToeBoard::X) ? "X" : "O";
+	char title[TILE_WIDTH + 1];
+	snprintf(title, sizeof(title), "#%-4u %s", gameNumber % 10000, state);
+	putText(top, left, title);
+
+	char line[TILE_WIDTH + 1];
+	for (int r = 0; r < TicTacToeBoard::BOARD_NUM_ROWS; r++) {
+		int pos = 0;
+		for (int c = 0; c < TicTacToeBoard::BOARD_NUM_COLS; c++) {
+			uint16_t bit = static_cast<uint16_t>(1u << (r * TicTacToeBoard::BOARD_NUM_COLS + c));
+			line[pos++] = ' ';
+			line[pos++] = (snapshot.xSquares & bit) ? 'X' : ((snapshot.oSquares & bit) ? 'O' : ' ');
+			if (c < TicTacToeBoard::BOARD_NUM_COLS - 1) {
+				line[pos++] = ' ';
+				line[pos++] = '|';
+			}
+		}
+		line[pos] = '\0';
+		putText(top + 1 + 2 * r, left, line);
+		if (r < TicTacToeBoard::BOARD_NUM_ROWS - 1) {     // row divider
+			std::fill(line, line + TILE_WIDTH, '-');
+			line[TILE_WIDTH] = '\0';
+			putText(top + 2 + 2 * r, left, line);
+		}
+	}
+}
+
+// Copy text into the back frame, clipped at the right edge
+void SpectatorDashboard::putText(int row, int col, const char* text) {
+	size_t rowStart = static_cast<size_t>(row) * frameCols;
+	for (int c = col; *text != '\0' && c < frameCols; c++, text++)
+		backFrame[rowStart + c] = *text;
+}
+
+// New frame size, the front frame is dropped so the next frame is a full redraw
+void SpectatorDashboard::resizeFrames(int rows, int cols) {
+	frameRows = rows;
+	frameCols = cols;
+	frontFrame.clear();
+}
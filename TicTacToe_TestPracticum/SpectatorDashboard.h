@@ -0,0 +1,83 @@
+#pragma once
+/*****************************************************************//**
+ * \file   SpectatorDashboard.h
+ * \brief  multi-board spectator view - SpectatorDashboard
+ *     Scope - shows a grid of live games (e.g. simulations), each tile uses the writeTicTacToeBoard() cell layout
+ *        game threads publish board snapshots, the UI thread renders frames at its own (throttled) rate
+ *
+ * \date   updated: October 2026
+ *
+ * Implementation notes:
+ *     - each game has a slot holding its latest snapshot packed into one 64 bit atomic word
+ *          publish() is a single store, readSnapshot() a single load - game threads never wait on the renderer
+ *     - the packed word keeps the low 16 bits of the game # (tile titles), the header's games started is a
+ *          running total - publish() adds how far the slot's game # moved, one relaxed add per new game
+ *          slots are aligned to (& fill) a cache line, so games published from different threads don't share
+ *          a line - C++14 new doesn't honour over-alignment, so the slots are allocated with aligned malloc
+ *     - frames are double-buffered: the back frame is composed from the snapshots, diffed against the
+ *          front frame (what is on screen) & only changed characters are written, then the frames are swapped
+ *     - a full redraw happens on the first frame, after invalidate() & when the terminal is resized
+ *
+ * void publish(game, board, gameNumber)         - called by the thread playing the game, after each move
+ * Snapshot readSnapshot(game, gameNumber)       - latest snapshot & # of the game in the slot (low 16 bits)
+ * uint64_t getGamesStarted()                    - sum of the game #s published, doesn't wrap
+ * int renderFrame(out)                          - compose & write one frame, returns # bytes written
+ **/
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include "TicTacToeBoard.h"
+
+class SpectatorDashboard
+{
+public:
+	// tile layout, in characters - title line above the board, cells as drawn by writeTicTacToeBoard()
+	static constexpr int TILE_WIDTH = 4 * TicTacToeBoard::BOARD_NUM_COLS - 1;     // " X | O | X"
+	static constexpr int TILE_HEIGHT = 2 * TicTacToeBoard::BOARD_NUM_ROWS;        // title + rows & dividers
+	static constexpr int TILE_GAP_COLS = 3;
+	static constexpr int TILE_GAP_ROWS = 1;
+	static constexpr int HEADER_ROWS = 2;                                          // summary line + blank
+
+	explicit SpectatorDashboard(int numGames);
+	int getGameCount() const;
+
+	void publish(int game, const TicTacToeBoard& board, unsigned gameNumber);
+	void publish(int game, const TicTacToeBoard::Snapshot& snapshot, unsigned gameNumber);
+	TicTacToeBoard::Snapshot readSnapshot(int game, unsigned& gameNumber) const;
+	uint64_t getGamesStarted() const;
+
+	int renderFrame(std::ostream& out);
+	void invalidate();
+
+private:
+	static constexpr size_t CACHE_LINE = 64;
+
+	struct alignas(CACHE_LINE) Slot {
+		std::atomic<uint64_t> packed;     // snapshot & game # - see packSnapshot()
+		unsigned lastGameNumber;          // full game # last published, only used by the publishing thread
+	};
+	static_assert(sizeof(Slot) == CACHE_LINE, "slot should fill one cache line");
+	struct SlotDeleter {                  // frees slots from allocateSlots()
+		void operator()(Slot* slots) const;
+	};
+
+	int numGames;
+	std::unique_ptr<Slot[], SlotDeleter> slots;
+	std::atomic<uint64_t> gamesStarted{ 0 };    // running total of the game #s published
+	std::string frontFrame;               // characters on screen, frameRows x frameCols
+	std::string backFrame;                // frame being composed
+	std::string output;                   // escape sequences & text written for the frame
+	int frameRows = 0;
+	int frameCols = 0;
+	unsigned frameCount = 0;
+
+	static Slot* allocateSlots(int count);    // cache line aligned, throws bad_alloc
+	static uint64_t packSnapshot(const TicTacToeBoard::Snapshot& snapshot, unsigned gameNumber);
+	void composeTile(const TicTacToeBoard::Snapshot& snapshot, unsigned gameNumber, int top, int left);
+	void putText(int row, int col, const char* text);
+	void resizeFrames(int rows, int cols);
+};
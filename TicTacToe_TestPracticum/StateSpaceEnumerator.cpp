@@ -0,0 +1,250 @@
+// StateSpaceEnumerator.cpp
+//   Visits every reachable position once, cross-checking all win check implementations at each one
+//   <blank line>
+
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include "StateSpaceEnumerator.h"
+
+/*
+ * Instance variables (declared in header file)
+ *   rows, cols, k - board geometry
+ *   numThreads - worker threads used by run()
+ *   winChecks - extra implementations added by addWinCheck(), compared at every position
+ *   visited - bit per base 3 position number, set by the first thread to reach the position
+ *   nextWorkItem - next position after two moves to hand to a worker thread
+ */
+
+// Constructor - geometry is validated by MnkBoard, the visited set limits the board to MAX_SQUARES
+StateSpaceEnumerator::StateSpaceEnumerator(int rows, int cols, int k, int numThreads)
+	: rows(rows), cols(cols), k(k), numThreads(numThreads < 1 ? 1 : numThreads), nextWorkItem(0) {
+	MnkBoard validate(rows, cols, k);      // throws invalid_argument for a bad geometry
+	if (validate.getSquareCount() > MAX_SQUARES)
+		throw std::invalid_argument("State space enumeration is limited to " + std::to_string(MAX_SQUARES) +
+			" squares, board has " + std::to_string(validate.getSquareCount()) + "\n");
+}
+
+// Extra implementation to compare against the line masks at every position
+void StateSpaceEnumerator::addWinCheck(const char* name, WinCheck check) {
+	NamedCheck named = { name, check };
+	winChecks.push_back(named);
+}
+
+// Enumerate every reachable position & cross-check the win checks
+//   the first two moves are expanded on this thread, the positions after them are shared between the workers
+StateSpaceEnumerator::Result StateSpaceEnumerator::run() {
+	auto start = std::chrono::steady_clock::now();
+
+	uint64_t positionCount = 1;
+	int squareCount = rows * cols;
+	for (int pos = 0; pos < squareCount; pos++)
+		positionCount *= 3;
+	size_t words = static_cast<size_t>((positionCount + 63) / 64);
+	visited.reset(new std::atomic<uint64_t>[words]);
+	for (size_t w = 0; w < words; w++)
+		visited[w].store(0, std::memory_order_relaxed);
+
+	Result total;
+	MnkBoard root(rows, cols, k);
+	TicTacToeBoard legacyRoot;
+	const TicTacToeBoard* legacy = useLegacyBoard() ? &legacyRoot : nullptr;
+
+	// empty board & the positions after one move, the positions after two moves become the work items
+	std::vector<std::vector<int>> workItems;
+	markVisited(root.getPositionIndex());
+	if (!checkPosition(root, legacy, -1, total)) {
+		for (int first = 0; first < squareCount; first++) {
+			root.play(first);
+			TicTacToeBoard legacyFirst = legacyRoot;
+			if (legacy != nullptr)
+				legacyFirst.writeSquare(first / cols, first % cols, TicTacToeBoard::INITIAL_PLAYER);
+			if (markVisited(root.getPositionIndex()) &&
+				!checkPosition(root, legacy != nullptr ? &legacyFirst : nullptr, first, total)) {
+				for (int second = 0; second < squareCount; second++) {
+					if (root.play(second)) {
+						if (markVisited(root.getPositionIndex()))
+							workItems.push_back(std::vector<int>{ first, second });
+						root.undo(second);
+					}
+				}
+			}
+			root.undo(first);
+		}
+	}
+
+	// workers - each keeps its own counts, added up once they finish
+	nextWorkItem.store(0);
+	std::vector<Result> counts(numThreads);
+	std::vector<std::thread> workers;
+	for (int t = 0; t < numThreads; t++)
+		workers.emplace_back(&StateSpaceEnumerator::runWorker, this, std::cref(workItems), std::ref(counts[t]));
+	for (int t = 0; t < numThreads; t++) {
+		workers[t].join();
+		total.positions += counts[t].positions;
+		total.xWins += counts[t].xWins;
+		total.oWins += counts[t].oWins;
+		total.draws += counts[t].draws;
+		total.checks += counts[t].checks;
+		total.mismatches += counts[t].mismatches;
+		if (total.firstMismatch.empty())
+			total.firstMismatch = counts[t].firstMismatch;
+	}
+
+	total.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	visited.reset();
+	return total;
+}
+
+//                                     ***  Enumerator helper functions ***
+
+// Worker thread - takes positions after two moves until there are none left & explores everything below them
+void StateSpaceEnumerator::runWorker(const std::vector<std::vector<int>>& workItems, Result& counts) {
+	for (size_t item = nextWorkItem.fetch_add(1); item < workItems.size(); item = nextWorkItem.fetch_add(1)) {
+		MnkBoard board(rows, cols, k);
+		TicTacToeBoard legacyBoard;
+		const TicTacToeBoard* legacy = useLegacyBoard() ? &legacyBoard : nullptr;
+		for (int move : workItems[item]) {
+			if (legacy != nullptr)
+				legacyBoard.writeSquare(move / cols, move % cols, board.getPlayer());
+			board.play(move);
+		}
+		if (!checkPosition(board, legacy, workItems[item].back(), counts))
+			explore(board, legacy, counts);
+	}
+}
+
+// Depth first expansion - every child not yet visited by any thread is checked & (if not terminal) expanded
+//   TicTacToeBoard has no undo, so the legacy board is copied for each child
+void StateSpaceEnumerator::explore(MnkBoard& board, const TicTacToeBoard* legacy, Result& counts) {
+	TicTacToeBoard::Player mover = board.getPlayer();
+	for (int pos = 0; pos < board.getSquareCount(); pos++) {
+		if (!board.play(pos))
+			continue;
+		if (markVisited(board.getPositionIndex())) {
+			if (legacy != nullptr) {
+				TicTacToeBoard child = *legacy;
+				child.writeSquare(pos / cols, pos % cols, mover);
+				if (!checkPosition(board, &child, pos, counts))
+					explore(board, &child, counts);
+			}
+			else if (!checkPosition(board, nullptr, pos, counts))
+				explore(board, nullptr, counts);
+		}
+		board.undo(pos);
+	}
+}
+
+// Compare every implementation against the line masks (MnkBoard::isWinner) & count the position
+//   returns true if the position is terminal (someone has won or the board is full)
+bool StateSpaceEnumerator::checkPosition(const MnkBoard& board, const TicTacToeBoard* legacy, int lastMove,
+	Result& counts) {
+	const TicTacToeBoard::Player players[2] = { TicTacToeBoard::X, TicTacToeBoard::O };
+	bool winner[2];
+
+	for (int p = 0; p < 2; p++) {
+		TicTacToeBoard::Player player = players[p];
+		bool expected = board.isWinner(player);
+		winner[p] = expected;
+
+		counts.checks++;
+		if (scanCells(board, player) != expected)
+			recordMismatch(board, "cell scan", player, counts);
+
+		if (legacy != nullptr) {
+			TicTacToeBoard::Snapshot snapshot = legacy->getSnapshot();
+			counts.checks += 3;
+			if (legacy->isWinner(player) != expected)
+				recordMismatch(board, "TicTacToeBoard::isWinner", player, counts);
+			if (legacy->matchesWinningPattern(player) != expected)
+				recordMismatch(board, "TicTacToeBoard::matchesWinningPattern", player, counts);
+			if (TicTacToeBoard::containsWinningPattern(player == TicTacToeBoard::X ? snapshot.xSquares : snapshot.oSquares)
+				!= expected)
+				recordMismatch(board, "TicTacToeBoard::containsWinningPattern", player, counts);
+		}
+
+		for (const NamedCheck& named : winChecks) {
+			counts.checks++;
+			if (named.check(board, player) != expected)
+				recordMismatch(board, named.name, player, counts);
+		}
+	}
+
+	// the parent wasn't terminal, so only the player who just moved can have won - through the square played
+	if (lastMove >= 0) {
+		int mover = (board.getPlayer() == TicTacToeBoard::X) ? 1 : 0;
+		counts.checks++;
+		if (board.isWinningMove(lastMove) != winner[mover])
+			recordMismatch(board, "MnkBoard::isWinningMove", players[mover], counts);
+	}
+
+	counts.positions++;
+	if (winner[0])
+		counts.xWins++;
+	else if (winner[1])
+		counts.oWins++;
+	else if (board.isFull())
+		counts.draws++;
+	return winner[0] || winner[1] || board.isFull();
+}
+
+// Records the disagreement - count always, description only for the thread's first one (counts are per thread)
+void StateSpaceEnumerator::recordMismatch(const MnkBoard& board, const char* name, TicTacToeBoard::Player player,
+	Result& counts) {
+	counts.mismatches++;
+	if (!counts.firstMismatch.empty())
+		return;
+	std::string description = std::string(name) + " disagrees for player " + (player == TicTacToeBoard::X ? "X" : "O") +
+		" in position:\n";
+	for (int r = 0; r < board.getRows(); r++) {
+		description += "  ";
+		for (int c = 0; c < board.getCols(); c++) {
+			uint64_t bit = 1ull << board.rowColToPosition(r, c);
+			description += (board.getSquares(TicTacToeBoard::X) & bit) ? 'X' :
+				((board.getSquares(TicTacToeBoard::O) & bit) ? 'O' : '.');
+		}
+		description += "\n";
+	}
+	counts.firstMismatch = description;
+}
+
+// Sets the position's bit, returns true if this call set it (ie first visit)
+bool StateSpaceEnumerator::markVisited(uint64_t positionIndex) {
+	uint64_t bit = 1ull << (positionIndex & 63);
+	return (visited[positionIndex >> 6].fetch_or(bit, std::memory_order_relaxed) & bit) == 0;
+}
+
+// TicTacToeBoard is only played alongside the MnkBoard for the standard geometry
+bool StateSpaceEnumerator::useLegacyBoard() const {
+	return (rows == TicTacToeBoard::BOARD_NUM_ROWS) && (cols == TicTacToeBoard::BOARD_NUM_COLS) && (k == 3);
+}
+
+// Reference implementation without the line tables - k squares in a row from every square, in all 4 directions
+bool StateSpaceEnumerator::scanCells(const MnkBoard& board, TicTacToeBoard::Player player) {
+	const int directions[4][2] = { { 0, 1 }, { 1, 0 }, { 1, 1 }, { 1, -1 } };
+	uint64_t played = board.getSquares(player);
+	int rows = board.getRows();
+	int cols = board.getCols();
+	int k = board.getK();
+	for (int r = 0; r < rows; r++) {
+		for (int c = 0; c < cols; c++) {
+			if ((played & (1ull << (r * cols + c))) == 0)
+				continue;
+			for (const auto& direction : directions) {
+				int run = 0;
+				int row = r;
+				int col = c;
+				while ((run < k) && (row >= 0) && (row < rows) && (col >= 0) && (col < cols) &&
+					(played & (1ull << (row * cols + col)))) {
+					run++;
+					row += direction[0];
+					col += direction[1];
+				}
+				if (run == k)
+					return true;
+			}
+		}
+	}
+	return false;
+}
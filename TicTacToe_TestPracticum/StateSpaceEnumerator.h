@@ -0,0 +1,77 @@
+#pragma once
+/*****************************************************************//**
+ * \file   StateSpaceEnumerator.h
+ * \brief  exhaustive verification tool - StateSpaceEnumerator
+ *     Scope - plays every legal move sequence, visits each reachable position once & cross-checks
+ *        every win check implementation against the others at every position
+ *
+ * \date   updated: October 2026
+ *
+ * Implementation notes:
+ *     - 3x3 / k=3: moves are played through TicTacToeBoard::writeSquare() alongside an MnkBoard, compared are
+ *          TicTacToeBoard::isWinner(), matchesWinningPattern(), containsWinningPattern() & the MnkBoard checks
+ *     - other geometries (up to MAX_SQUARES, e.g. 4x4): MnkBoard only - line masks, lines through the last move
+ *          & a cell by cell scan that doesn't use the line tables
+ *     - extra implementations (e.g. an optimized engine) can be added with addWinCheck()
+ *     - positions are deduplicated with a visited set, one bit per base 3 position number, set with an atomic
+ *          fetch_or so threads never lock - the thread that sets the bit expands the position
+ *     - a position where someone has won, or the board is full, is terminal (not expanded), as in main()
+ *     - the work is split on the positions after two moves, handed out to the threads by an atomic counter
+ *
+ * StateSpaceEnumerator(rows, cols, k, threads)   - throws invalid_argument if the board is larger than MAX_SQUARES
+ * void addWinCheck(name, check)                  - extra implementation to compare at every position
+ * Result run()                                   - enumerate & cross-check, returns counts & the first mismatch
+ **/
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "MnkBoard.h"
+#include "TicTacToeBoard.h"
+
+class StateSpaceEnumerator
+{
+public:
+	typedef bool (*WinCheck)(const MnkBoard& board, TicTacToeBoard::Player player);
+
+	static constexpr int MAX_SQUARES = 16;      // visited set is 3^16 bits = 5.4 MB
+
+	struct Result {
+		uint64_t positions = 0;           // distinct reachable positions, including the empty board
+		uint64_t xWins = 0;               // terminal positions by outcome
+		uint64_t oWins = 0;
+		uint64_t draws = 0;
+		uint64_t checks = 0;              // win check comparisons made
+		uint64_t mismatches = 0;          // comparisons where an implementation disagreed with the line masks
+		std::string firstMismatch;        // description of the first disagreement found
+		double milliseconds = 0;
+	};
+
+	StateSpaceEnumerator(int rows, int cols, int k, int numThreads);
+	void addWinCheck(const char* name, WinCheck check);
+	Result run();
+
+private:
+	struct NamedCheck {
+		const char* name;
+		WinCheck check;
+	};
+
+	int rows;
+	int cols;
+	int k;
+	int numThreads;
+	std::vector<NamedCheck> winChecks;
+	std::unique_ptr<std::atomic<uint64_t>[]> visited;    // bit per position index
+	std::atomic<size_t> nextWorkItem;
+
+	bool markVisited(uint64_t positionIndex);
+	bool checkPosition(const MnkBoard& board, const TicTacToeBoard* legacy, int lastMove, Result& counts);
+	void explore(MnkBoard& board, const TicTacToeBoard* legacy, Result& counts);
+	void recordMismatch(const MnkBoard& board, const char* name, TicTacToeBoard::Player player, Result& counts);
+	void runWorker(const std::vector<std::vector<int>>& workItems, Result& counts);
+	bool useLegacyBoard() const;
+	static bool scanCells(const MnkBoard& board, TicTacToeBoard::Player player);
+};
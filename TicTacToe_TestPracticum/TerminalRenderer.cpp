@@ -0,0 +1,220 @@
+// TerminalRenderer.cpp
+//   Incremental board renderer - repaints only what changed since the last frame using ANSI escape sequences
+//   <blank line>
+
+#include <iostream>
+#include <cstdio>
+#include "TerminalRenderer.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+/*
+ * Instance variables (declared in header file)
+ *   lastCells[][] - character drawn in each square in the last frame, compared against the board to find changes
+ *   lastStatus - status text on screen, only repainted when it changes
+ *   frame - escape sequences & text for the frame being built, written to the console in a single call
+ *   frameValid - cleared by invalidate() (e.g. screen cleared by the caller), forces a full redraw
+ *   boardHeld - set by holdBoard(), the squares on screen are kept until a board with a move is drawn
+ *   terminalRows, terminalCols - size of the terminal at the last full redraw, a change forces a full redraw
+ *   console, capture - where frames are written (console stream) & copied (capture string), see setOutput()
+ */
+
+namespace {
+	// ANSI / VT100 sequences
+	constexpr const char* CLEAR_SCREEN = "\x1b[H\x1b[2J";   // home cursor, erase whole screen
+	constexpr const char* ERASE_BELOW = "\x1b[J";            // erase from cursor to end of screen
+}
+
+// Constructor - on Windows, enable virtual terminal processing so the console understands ANSI sequences
+TerminalRenderer::TerminalRenderer()
+	: console(&std::cout) {
+#ifdef _WIN32
+	HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+	DWORD mode = 0;
+	if (console != INVALID_HANDLE_VALUE && GetConsoleMode(console, &mode))
+		SetConsoleMode(console, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+#endif
+	frame.reserve(1024);
+	invalidate();
+}
+
+// Forces the next renderBoard() to clear the screen & redraw everything
+void TerminalRenderer::invalidate() {
+	frameValid = false;
+	for (int r = 0; r < TicTacToeBoard::BOARD_NUM_ROWS; r++)
+		for (int c = 0; c < TicTacToeBoard::BOARD_NUM_COLS; c++)
+			lastCells[r][c] = ' ';
+}
+
+// Keeps the board on screen (e.g. a finished game) while the boards drawn are empty - the next game's first move
+//   repaints it, so the final position stays up while the players read the result
+void TerminalRenderer::holdBoard() {
+	boardHeld = true;
+}
+
+// Where frames go - the console stream & / or a capture string, either nullptr to leave it out
+//   while capturing, frames don't follow the terminal size (see the header notes)
+void TerminalRenderer::setOutput(std::ostream* console, std::string* capture) {
+	this->console = console;
+	this->capture = capture;
+}
+
+// Draws the board - full redraw if required, otherwise only squares whose contents changed
+//   leaves the cursor at the start of the prompt line (after the status) with the rest of the screen erased
+//   while the board is held, an empty board leaves the squares on screen as they are
+int TerminalRenderer::renderBoard(const TicTacToeBoard& board) {
+	frame.clear();
+	for (int r = 0; boardHeld && (r < TicTacToeBoard::BOARD_NUM_ROWS); r++)    // a move releases the hold
+		for (int c = 0; c < TicTacToeBoard::BOARD_NUM_COLS; c++)
+			if (!board.isSquareEmpty(r, c))
+				boardHeld = false;
+
+	if (((capture == nullptr) && terminalResized()) || !frameValid) {
+		frame += CLEAR_SCREEN;
+		frame += '\n';                      // row 1 left blank, as in the original layout
+		if (!boardHeld)
+			for (int r = 0; r < TicTacToeBoard::BOARD_NUM_ROWS; r++)
+				for (int c = 0; c < TicTacToeBoard::BOARD_NUM_COLS; c++)
+					lastCells[r][c] = board.getSquareContents(r, c);
+		appendCellsText(frame, lastCells);
+		appendStatus();
+		frameValid = true;
+	}
+	else if (!boardHeld) {
+		for (int r = 0; r < TicTacToeBoard::BOARD_NUM_ROWS; r++) {
+			for (int c = 0; c < TicTacToeBoard::BOARD_NUM_COLS; c++) {
+				char contents = board.getSquareContents(r, c);
+				if (contents != lastCells[r][c]) {
+					appendMoveTo(frame, cellRow(r), cellCol(c));
+					frame += contents;
+					lastCells[r][c] = contents;
+				}
+			}
+		}
+	}
+
+	// park the cursor for the prompt & erase the previous prompt & user input
+	appendMoveTo(frame, promptRow(), 1);
+	frame += ERASE_BELOW;
+	return flushFrame();
+}
+
+// Replaces the status text shown under the board, nothing is written if the status is unchanged
+int TerminalRenderer::renderStatus(const char* status) {
+	if (frameValid && lastStatus == status)
+		return 0;
+
+	lastStatus = status;
+	if (!frameValid)           // status is drawn as part of the full redraw
+		return 0;
+
+	frame.clear();
+	appendStatus();
+	return flushFrame();
+}
+
+// Board text in the original writeTicTacToeBoard() layout - tabs, " X |" cells & "---" row dividers
+void TerminalRenderer::appendBoardText(std::string& out, const TicTacToeBoard& board) {
+	char cells[TicTacToeBoard::BOARD_NUM_ROWS][TicTacToeBoard::BOARD_NUM_COLS];
+	for (int r = 0; r < TicTacToeBoard::BOARD_NUM_ROWS; r++)
+		for (int c = 0; c < TicTacToeBoard::BOARD_NUM_COLS; c++)
+			cells[r][c] = board.getSquareContents(r, c);
+	appendCellsText(out, cells);
+}
+
+//                                     ***  Renderer helper functions ***
+
+// Board text for the square contents given, see appendBoardText()
+void TerminalRenderer::appendCellsText(std::string& out,
+	const char (&cells)[TicTacToeBoard::BOARD_NUM_ROWS][TicTacToeBoard::BOARD_NUM_COLS]) {
+	for (int r = 0; r < TicTacToeBoard::BOARD_NUM_ROWS; r++) {
+		out += "\t\t\t\t";
+		for (int c = 0; c < TicTacToeBoard::BOARD_NUM_COLS; c++) {
+			out += ' ';
+			out += cells[r][c];
+			if (c < TicTacToeBoard::BOARD_NUM_COLS - 1)
+				out += " |";
+		}
+		if (r < TicTacToeBoard::BOARD_NUM_ROWS - 1) {  // draw the row dividers
+			out += "\n\t\t\t\t";
+			for (int itr = 0; itr < TicTacToeBoard::BOARD_NUM_COLS; itr++)
+				out += "---";
+			out += "---\n";
+		}
+		else
+			out += "\n\n";
+	}
+}
+
+// Returns true if the terminal size changed since the last full frame
+//   if the size can't be determined (e.g. output redirected), it is treated as unchanged
+bool TerminalRenderer::terminalResized() {
+	int rows = 0;
+	int cols = 0;
+	querySize(rows, cols);
+	if (rows == terminalRows && cols == terminalCols)
+		return false;
+	terminalRows = rows;
+	terminalCols = cols;
+	return true;
+}
+
+// Query the terminal size (visible window), returns false if there is no terminal
+bool TerminalRenderer::querySize(int& rows, int& cols) {
+#ifdef _WIN32
+	CONSOLE_SCREEN_BUFFER_INFO info;
+	if (GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &info)) {
+		rows = info.srWindow.Bottom - info.srWindow.Top + 1;
+		cols = info.srWindow.Right - info.srWindow.Left + 1;
+		return true;
+	}
+#else
+	struct winsize size;
+	if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0) {
+		rows = size.ws_row;
+		cols = size.ws_col;
+		return true;
+	}
+#endif
+	return false;
+}
+
+// Append the cursor position sequence ESC[row;colH
+void TerminalRenderer::appendMoveTo(std::string& out, int row, int col) {
+	char sequence[24];
+	int length = snprintf(sequence, sizeof(sequence), "\x1b[%d;%dH", row, col);
+	out.append(sequence, length);
+}
+
+// Append the status text, erasing the old status & anything below it first
+void TerminalRenderer::appendStatus() {
+	appendMoveTo(frame, statusRow(), 1);
+	frame += ERASE_BELOW;
+	frame += lastStatus;
+}
+
+// The prompt goes on the line after the status text, one line down for each newline in the status
+int TerminalRenderer::promptRow() const {
+	int row = statusRow();
+	for (char ch : lastStatus)
+		if (ch == '\n')
+			row++;
+	return row;
+}
+
+int TerminalRenderer::flushFrame() {
+	if (console != nullptr) {
+		console->write(frame.data(), frame.size());
+		console->flush();
+	}
+	if (capture != nullptr)
+		capture->append(frame);
+	return static_cast<int>(frame.size());
+}
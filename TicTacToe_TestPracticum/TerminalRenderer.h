@@ -0,0 +1,79 @@
+#pragma once
+/*****************************************************************//**
+ * \file   TerminalRenderer.h
+ * \brief  incremental console renderer - TerminalRenderer
+ *     Scope - draws the board & a status area using ANSI escape sequences (cursor positioning, erase)
+ *        keeps the last drawn frame, so only changed squares & the status area are repainted
+ *
+ * \date   updated: October 2026
+ *
+ * Implementation notes:
+ *     - replaces system("cls") + full redraw, which is Windows only & spawns a process on every clear
+ *     - screen layout is fixed, matching the original writeTicTacToeBoard() output:
+ *          row 1                     blank
+ *          rows 2, 4, 6 ...          board rows, cells at column CELL_FIRST_COL + CELL_WIDTH * col
+ *          rows 3, 5 ...             row dividers
+ *          statusRow()               status text (may span several lines), prompt follows the status
+ *     - a full redraw happens on the first frame, after invalidate() & whenever the terminal is resized
+ *     - holdBoard() keeps a finished game on screen after the board is reset: empty boards don't repaint the
+ *          squares (a full redraw draws the held ones), the first board with a move releases the hold
+ *     - on Windows, virtual terminal processing is enabled in the constructor so the same sequences work
+ *     - frames go to std::cout unless setOutput() says otherwise - a capture string gets a copy of every frame
+ *          (session record & replay, see SessionLog) & turns off following the terminal size, so the frames
+ *          written depend only on the calls made
+ *
+ * int renderBoard(board)        - repaints changed squares, leaves cursor on the prompt line, returns # bytes written
+ * int renderStatus(status)      - replaces the status area, returns # bytes written
+ * void invalidate()             - forces a full redraw on the next renderBoard()
+ * void holdBoard()              - squares on screen stay until a board with a move is drawn
+ * void setOutput(console, capture) - where frames go, console & / or capture string (nullptr = not there)
+ **/
+
+#include <iosfwd>
+#include <string>
+#include "TicTacToeBoard.h"
+
+class TerminalRenderer
+{
+public:
+	// screen coordinates are 1-based, as used by the ANSI cursor position sequence ESC[row;colH
+	static constexpr int BOARD_FIRST_ROW = 2;      // first board row, row 1 is left blank
+	static constexpr int CELL_FIRST_COL = 34;      // 4 tabs (col 33) + leading space
+	static constexpr int CELL_WIDTH = 4;           // " X |" per cell
+
+	TerminalRenderer();
+	int renderBoard(const TicTacToeBoard& board);
+	int renderStatus(const char* status);
+	void invalidate();
+	void holdBoard();
+	void setOutput(std::ostream* console, std::string* capture);
+
+	static int cellRow(int row) { return BOARD_FIRST_ROW + 2 * row; }
+	static int cellCol(int col) { return CELL_FIRST_COL + CELL_WIDTH * col; }
+	static int statusRow() { return BOARD_FIRST_ROW + 2 * TicTacToeBoard::BOARD_NUM_ROWS; }
+
+	// appends the board text in the original writeTicTacToeBoard() layout, shared with full redraws
+	static void appendBoardText(std::string& out, const TicTacToeBoard& board);
+	// terminal size in rows & columns, false if unknown (e.g. output redirected to a file)
+	static bool querySize(int& rows, int& cols);
+	// appends the cursor position sequence ESC[row;colH
+	static void appendMoveTo(std::string& out, int row, int col);
+
+private:
+	char lastCells[TicTacToeBoard::BOARD_NUM_ROWS][TicTacToeBoard::BOARD_NUM_COLS];   // last frame drawn
+	std::string lastStatus;           // status text currently on screen
+	std::string frame;                // output buffer, reused between frames to avoid reallocating
+	bool frameValid = false;          // false -> next renderBoard() does a full redraw
+	bool boardHeld = false;           // true -> squares on screen kept while the board drawn is empty
+	int terminalRows = 0;             // terminal size when the last full frame was drawn
+	int terminalCols = 0;
+	std::ostream* console;            // frames written here (std::cout unless setOutput()), nullptr = nowhere
+	std::string* capture = nullptr;   // frames appended here too, the terminal size isn't followed
+
+	bool terminalResized();           // queries terminal size, true if changed since last full frame
+	static void appendCellsText(std::string& out,
+		const char (&cells)[TicTacToeBoard::BOARD_NUM_ROWS][TicTacToeBoard::BOARD_NUM_COLS]);
+	void appendStatus();
+	int promptRow() const;            // line following the status text
+	int flushFrame();                 // writes frame to console & returns # bytes written
+};
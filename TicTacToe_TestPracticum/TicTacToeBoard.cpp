@@ -2,6 +2,7 @@
 #include <iostream>
 #include <stdlib.h>
 #include <string>
+#include <cstdio>     // error message formatting
 #include <array>    // set refactor
 #include <algorithm>  // set refactor
 
@@ -13,6 +14,7 @@
  * Instance variables (declared in header file)
  *   board[][] - two dimensional array indexed by row (0-2) & column (0-2), cleared when starting a new game
  *   takenSquareCount - integer tracking # of moves in the game, reset at instance creation & on starting a new game
+ *   xLines, oLines - bit per winning pattern (winPatterns order) holding at least one X / O, both set = dead line
  *   player - character indicating the player making the current move
  *     notes - default player defined in board class header file,
  *     current player is tracked and can be retrived by the board class, but is updated from outside the class via nextPlayer()
@@ -31,14 +33,16 @@ TicTacToeBoard::TicTacToeBoard() {
 // Reset board and variable tracking # of spaces played in current game
 void TicTacToeBoard::resetBoard() {
 	takenSquareCount = 0;
+	xLines = 0;
+	oLines = 0;
 	for (int r = 0; r < BOARD_NUM_ROWS; r++) {
 		for (int c = 0; c < BOARD_NUM_COLS; c++) {
 			board[r][c] = EMPTY;
 		}
 	}
 	// clear the set of player moves (used in the pattern implementation of isWinner()
-	xMoves.clear();
-	oMoves.clear();
+	xMoves = 0;
+	oMoves = 0;
 }
 
 // If specified space is empty - return true
@@ -63,9 +67,14 @@ bool TicTacToeBoard::writeSquare(int row, int col, Player currentPlayer) {
 		takenSquareCount++;
 		// used for set based refactoring of win condition
 		if (currentPlayer == X)
-			xMoves.insert(rowColToPosition(row, col));
+			xMoves |= static_cast<uint16_t>(1u << rowColToPosition(row, col));
 		else
-			oMoves.insert(rowColToPosition(row, col));
+			oMoves |= static_cast<uint16_t>(1u << rowColToPosition(row, col));
+		// lines blocked for the other player, for the forced draw check
+		if (currentPlayer == X)
+			xLines |= linesThrough(rowColToPosition(row, col));
+		else if (currentPlayer == O)
+			oLines |= linesThrough(rowColToPosition(row, col));
 		return true;
 	}
 	else { // the space was already occupied, return false
@@ -158,22 +167,19 @@ bool TicTacToeBoard::isWinner(Player playerToCheck) const {
 //    given a set of winning patterns (winPatterns)
 //    check if any of the winning patterns is a sub-set of the specified player's moves
 // for example - X has moved {(0,0), (1,0), (1,1), (2,0)}  winning pattern (0,0), (1,0), (2,0) is a subset, X wins
-//   To add a new winning pattern - update the array size (e.g. 8->9) & add the pattern to the set below ,{{x,y,z}}
+//   winPatterns is initialized in the header (RuleVariantBoard builds its line tables from it at compile time)
 
-static constexpr  std::array<std::array<int, 3>, 8> winPatterns{ {
-	{{0,1,2}}, {{3, 4, 5}}, {{6,7,8}},    // rows
-	{{0,3,6}}, {{1, 4, 7}}, {{2,5,8}},    // columns
-	{{0,4,8}}, {{2,4,6}}                 // diagonals
-} };
+// C++14 - constexpr static member used at run time needs a definition
+constexpr std::array<std::array<int, 3>, 8> TicTacToeBoard::winPatterns;
 
 bool TicTacToeBoard::matchesWinningPattern(Player p) const {
-	const std::set<int>& moves = (p == X) ? xMoves : oMoves;   // select players individual moves
+	uint16_t moves = (p == X) ? xMoves : oMoves;   // select players individual moves
 
 	for (const auto& pattern : winPatterns) {
 		bool allFound = true;
 		// check all 3 positions for each pattern
 		for (int pos : pattern) {
-			if (moves.count(pos) == 0) {
+			if ((moves & (1u << pos)) == 0) {
 				allFound = false; // a position inside the pattern was not found in the player's moves
 				break;   // check the next pattern
 			}
@@ -184,6 +190,85 @@ bool TicTacToeBoard::matchesWinningPattern(Player p) const {
 	return false;   // no winner yet
 }
 
+// bit per winning pattern (winPatterns order) that includes the position, for the dead line tracking
+uint8_t TicTacToeBoard::linesThrough(int position) {
+	uint8_t lines = 0;
+	for (size_t i = 0; i < winPatterns.size(); i++) {
+		if (std::find(winPatterns[i].begin(), winPatterns[i].end(), position) != winPatterns[i].end())
+			lines |= static_cast<uint8_t>(1u << i);
+	}
+	return lines;
+}
+
+// bit mask version of the pattern check, squares has bit (position) set for each square played
+//   used for snapshots, where only the bit masks are available
+bool TicTacToeBoard::containsWinningPattern(uint16_t squares) {
+	for (const auto& pattern : winPatterns) {
+		uint16_t patternSquares = 0;
+		for (int pos : pattern)
+			patternSquares |= static_cast<uint16_t>(1u << pos);
+		if ((squares & patternSquares) == patternSquares)
+			return true;
+	}
+	return false;
+}
+
+// Game over? - a win, a full board, or a forced draw: every winning pattern holds an X & an O, so the remaining
+//   moves can't change the result (a pattern with both players in it is never completed)
+TicTacToeBoard::GameStatus TicTacToeBoard::getGameStatus() const {
+	if (isWinner(X))
+		return X_WINS;
+	if (isWinner(O))
+		return O_WINS;
+	if (takenSquareCount >= BOARD_NUM_ROWS * BOARD_NUM_COLS)
+		return DRAW;
+	if ((xLines & oLines) == (1u << winPatterns.size()) - 1)
+		return FORCED_DRAW;
+	return IN_PROGRESS;
+}
+
+// Returns a compact copy of the board, built from board[][] (the legacy storage)
+TicTacToeBoard::Snapshot TicTacToeBoard::getSnapshot() const {
+	Snapshot snapshot = {};
+	for (int r = 0; r < BOARD_NUM_ROWS; r++) {
+		for (int c = 0; c < BOARD_NUM_COLS; c++) {
+			uint16_t bit = static_cast<uint16_t>(1u << (r * BOARD_NUM_COLS + c));
+			if (board[r][c] == X)
+				snapshot.xSquares |= bit;
+			else if (board[r][c] == O)
+				snapshot.oSquares |= bit;
+		}
+	}
+	snapshot.player = static_cast<uint8_t>(player);
+	snapshot.takenSquareCount = static_cast<uint8_t>(takenSquareCount);
+	return snapshot;
+}
+
+// Replaces the game with the snapshot's - squares written through writeSquare() so the move sets & lines match
+//   throws invalid_argument if the snapshot isn't a board (checked before anything changes)
+void TicTacToeBoard::restoreSnapshot(const Snapshot& snapshot) {
+	const unsigned allSquares = (1u << (BOARD_NUM_ROWS * BOARD_NUM_COLS)) - 1;
+	int squares = 0;
+	for (unsigned bits = snapshot.xSquares | snapshot.oSquares; bits != 0; bits &= bits - 1)
+		squares++;
+	if (((snapshot.xSquares | snapshot.oSquares) & ~allSquares) || (snapshot.xSquares & snapshot.oSquares) ||
+		((snapshot.player != X) && (snapshot.player != O)) || (snapshot.takenSquareCount != squares)) {
+		char errorMessage[128];
+		snprintf(errorMessage, sizeof(errorMessage), "Invalid board snapshot: X 0x%03x  O 0x%03x  player %d  squares %d\n",
+			snapshot.xSquares, snapshot.oSquares, snapshot.player, snapshot.takenSquareCount);
+		throw std::invalid_argument(errorMessage);
+	}
+
+	resetBoard();
+	for (int position = 0; position < BOARD_NUM_ROWS * BOARD_NUM_COLS; position++) {
+		if (snapshot.xSquares & (1u << position))
+			writeSquare(position / BOARD_NUM_COLS, position % BOARD_NUM_COLS, X);
+		else if (snapshot.oSquares & (1u << position))
+			writeSquare(position / BOARD_NUM_COLS, position % BOARD_NUM_COLS, O);
+	}
+	player = static_cast<Player>(snapshot.player);
+}
+
 // pattern matching helper function to compute position from row & column
 // for a 3x3 board - position numbering is row 0 -> 0, 1, 2 .... row 2 -> 6, 7, 8
 int TicTacToeBoard::rowColToPosition(int row, int column) {
@@ -212,7 +297,10 @@ char TicTacToeBoard::playerMap(Player playerEnum) const {
 void TicTacToeBoard::validateRowsAndColumns(int row, int column) const {
 	if ((row >= BOARD_NUM_ROWS) || (column >= BOARD_NUM_COLS) ||
 		(row < 0) || (column < 0)) {
-		std::string errorMessage = "Exception thrown: invalid row or column.  row: " + std::to_string(row) + "  column: " + std::to_string(column) + "\n";
+		// message built in a local buffer - the exception object is the only allocation on the error path
+		char errorMessage[96];
+		snprintf(errorMessage, sizeof(errorMessage), "Exception thrown: invalid row or column.  row: %d  column: %d\n",
+			row, column);
 		throw std::invalid_argument(errorMessage);
 	}
 }
\ No newline at end of file
@@ -27,22 +27,55 @@
  *                                                 returns Player (ie enum) of the new player (e.g. if O playing, returns X)
  * bool isWinner(Player playerToCheck)         - true if the specified player has won, false otherwise
  * bool isDraw()                               - true if no-one has won & no open squares, false otherwise (e.g. consider - no spaces empty)
+ * GameStatus getGameStatus()                  - in progress, X or O has won, a draw (board full) or a forced draw -
+ *                                                 every winning line holds both an X & an O, so no-one can win, reported
+ *                                                 as soon as the last open line is blocked (lines tracked by writeSquare())
+ *
+ * Snapshot getSnapshot()                      - compact copy of the board (bit per square for each player), e.g. for spectators
+ * void restoreSnapshot(snapshot)             - the board & player as in the snapshot (e.g. a stored game), throws invalid
+ *                                                 argument for squares off the board or held by both, an unknown player or a
+ *                                                 takenSquareCount that isn't the # of squares held
+ * static winPatterns                         - the 8 winning patterns (rows, columns, diagonals) as positions 0-8,
+ *                                                 constexpr so other boards can build their line tables from it at compile time
+ * static bool containsWinningPattern(squares) - true if the squares (bit per position 0-8) include a winning pattern
+ * bool matchesWinningPattern(Player p)        - set based version of isWinner(), see pattern matching notes below
+ *
+ * No heap allocation after construction - the per move methods (writeSquare(), isWinner(), isDraw(), resetBoard() ...)
+ *   are checked by AllocationTests, only the exception thrown for an invalid row or column allocates
  **/
 
-#include <set>          // for pattern matching design
-#include <array>        //   ditto - pattern matching
+#include <array>        // for pattern matching design
+#include <cstdint>      // fixed width types for the snapshot & the move sets
 
 class TicTacToeBoard
 {
 
 public:
 	enum Player { X, O, EMPTY };    // define player enums, map to display character, ToDo: use "class" for type safety
+	enum GameStatus { IN_PROGRESS, X_WINS, O_WINS, DRAW, FORCED_DRAW };
 
 	// define some constants for public consumption, note initial player defined here in the Board class
 	static constexpr int BOARD_NUM_ROWS = 3;
 	static constexpr int BOARD_NUM_COLS = 3;
 	static constexpr Player INITIAL_PLAYER = Player::X;
 
+	// winning patterns as positions (row * BOARD_NUM_COLS + column), see pattern matching notes below
+	//   To add a new winning pattern - update the array size (e.g. 8->9) & add the pattern to the set ,{{x,y,z}}
+	static constexpr std::array<std::array<int, 3>, 8> winPatterns{ {
+		{{0,1,2}}, {{3, 4, 5}}, {{6,7,8}},    // rows
+		{{0,3,6}}, {{1, 4, 7}}, {{2,5,8}},    // columns
+		{{0,4,8}}, {{2,4,6}}                 // diagonals
+	} };
+
+	// compact copy of the board - bit (row * BOARD_NUM_COLS + column) is set if the player occupies the square
+	//   small enough to be published to other threads in a single 64 bit word
+	struct Snapshot {
+		uint16_t xSquares;          // squares played by X
+		uint16_t oSquares;          // squares played by O
+		uint8_t player;             // Player enum whose turn it is
+		uint8_t takenSquareCount;   // # of squares played in the current game
+	};
+
 
 	TicTacToeBoard();
 	void resetBoard();										// resets the squares to EMPTY and the # of turns played in the current game
@@ -55,13 +88,21 @@ public:
 	Player nextPlayer();					              // swap player for next move, returns new player
 	bool isDraw() const;								// check if a draw
 	bool isWinner(Player playerToCheck) const;           // check if specified player has won
+	GameStatus getGameStatus() const;                    // win, draw (full board), forced draw (no line left to win)
 
+	Snapshot getSnapshot() const;                         // compact copy of squares, player & # of squares played
+	void restoreSnapshot(const Snapshot& snapshot);       // replaces the board & player with the snapshot's
+	static bool containsWinningPattern(uint16_t squares); // check a set of squares (bit per position) for a win
+	bool matchesWinningPattern(Player p) const;           // pattern matching version of isWinner(), public so the
+	                                                      //   two implementations can be cross-checked (StateSpaceEnumerator)
 
 
 private:  // reserve memory for board & current player
 	Player board[BOARD_NUM_ROWS][BOARD_NUM_COLS];      // board storage, indexed by row [0-2] and column [0-2]
 	Player player = INITIAL_PLAYER;                    // tracks the current player, ie next symbol placed
 	int takenSquareCount = 0;                        // # of spaces played in current game, reset for new games
+	uint8_t xLines = 0;                              // bit per winning pattern holding an X, updated by writeSquare()
+	uint8_t oLines = 0;                              //   ditto O - a pattern in both can't be won by either player
 
 	  // map player enum to player character - used as a helper function
 	char playerMap(Player playerEnum) const;		// ToDo - create mapping list rather than switch statement
@@ -74,12 +115,14 @@ private:  // reserve memory for board & current player
 		//   writeSquare() fills in legacy board[][], as well as tracking X & Os positions played
 		//   matchesWinningPattern() checks if any of the winning patterns (e.g. 0,4,8 - forward diagonal) is a subset of the player's moves
 		//     isWinner() via comment removal can be set to use the new approach
+		//   the sets are bit masks (bit = position) rather than std::set, so a move never allocates
 		//
 		// Important!  an inline declaration would require C++ v17 or newer, default in MS VS 2022 is v14
-		//   To mitigate: the initialization is in the cpp file -> no inline declaration required, and can run in v14
-	std::set<int> xMoves;		// track X moves by position 0-8 for set based evaluation
-	std::set<int> oMoves;       // track O moves by position 0-8 for same
+		//   To mitigate: winPatterns (public, above) is initialized here & defined (no initializer) in the cpp file
+		//   -> no inline declaration required, and can run in v14
+	uint16_t xMoves = 0;		// track X moves by position 0-8 (bit per position) for set based evaluation
+	uint16_t oMoves = 0;        // track O moves by position 0-8 for same
 
-	bool matchesWinningPattern(Player p) const;     // refactor isWinner() to pattern matching approach
 	int rowColToPosition(int row, int column);      // helper function to map row & column to a position
+	static uint8_t linesThrough(int position);      // bit per winning pattern containing the position
 };
\ No newline at end of file
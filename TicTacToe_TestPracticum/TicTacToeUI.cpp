@@ -7,6 +7,12 @@
 #include <iostream>
 #include <stdlib.h>
 #include <algorithm>
+#ifdef _WIN32
+#include <conio.h>
+#else
+#include <poll.h>
+#include <unistd.h>
+#endif
 #include "TicTacToeUI.h"
 #include "TicTacToeBoard.h"  // required for displaying board which is maintained by the board class
 
@@ -17,12 +23,22 @@
  *
  * Methods:
  *      getUserInput() writes prompt to console, blocks on user input (terminated by new line), returns input
+ *      pollUserInput() returns a line only if one has been typed, otherwise returns straight away
+ *        the line is also kept for getUserInput() (input typed ahead isn't lost)
  *      writeOutput()  writes output to console & returns 0 indicating no error,
  *        in future write errors may contain an error code
- *      writeTicTacToeBoard(board) displays current board to console
+ *      writeStatus()  replaces the status text shown under the board
+ *      writeTicTacToeBoard(board) displays current board to console, repainting only what changed
+ *      holdBoard()    keeps the board on screen (e.g. game over) until the next game's first move is drawn
+ *      writeSpectatorDashboard(dashboard) displays a frame of many live games, repainting only what changed
+ *      recordSession(), replaySession(), endSession() record the session to a file / replay it (SessionLog)
  *
  * Instance Variables:
- *   None
+ *   renderer - TerminalRenderer, tracks the last frame drawn (ANSI escape sequences, no system("cls"))
+ *   session - SessionLog while recording or replaying: all output is also appended to its frame, & while
+ *     replaying the input comes from it & nothing is written to the console
+ *   typedAhead - lines pollUserInput() read, getUserInput() returns them (oldest first) before reading more
+ *   partialLine - Windows only, keys pollUserInput() read (echoed) before Enter, getUserInput() completes the line
  */
 
 
@@ -36,21 +52,89 @@ TicTacToeUI::TicTacToeUI() {
 //   prompts user with string included in call
 //   waits for user input, echoes the input & returns it to caller
 //   note: does not trim leading white space
+//   a line already read by pollUserInput() is returned (& echoed) without waiting
 //
-string TicTacToeUI::getUserInput(const char* prompt) const {
+string TicTacToeUI::getUserInput(const char* prompt) {
     string userInput;
 
     writeOutput(prompt);
-    getline(cin, userInput);
+    if (!typedAhead.empty()) {
+        userInput = typedAhead.front();
+        typedAhead.pop_front();
+        writeOutput(userInput.c_str());
+        writeOutput("\n");
+        return userInput;
+    }
+    if (session && (session->getMode() == SessionLog::REPLAY)) {
+        if (!session->replayInput(userInput))    // recording used up - quit, as the recorded player did
+            userInput = "q";
+    }
+    else if (session) {
+        if (!getline(cin, userInput))            // end of input ends a recording rather than looping on it
+            userInput = "q";
+        session->recordInput(userInput);
+    }
+    else {
+        getline(cin, userInput);
+        userInput = partialLine + userInput;     // keys typed while polling (Windows) start the line
+        partialLine.clear();
+    }
         // convert to lower case, requires algorithm library
     transform(userInput.begin(), userInput.end(), userInput.begin(), ::tolower);
     return userInput;
 }
 
+// pollUserInput() - non blocking version of getUserInput(), no prompt
+//   returns false straight away if no whole line has been typed, otherwise reads the line (lower case) & returns true
+//   the line is also queued for getUserInput(), so a move typed ahead is played once it is that player's turn
+//   lets the caller keep redrawing while waiting (e.g. for an engine move)
+//   Windows: keys are read (& echoed) one at a time, so waiting for Enter never blocks the caller
+//
+bool TicTacToeUI::pollUserInput(string& userInput) {
+    if (session)                                 // sessions record getUserInput() only
+        return false;
+#ifdef _WIN32
+    bool lineTyped = false;
+    while (!lineTyped && _kbhit()) {
+        int key = _getch();
+        if ((key == 0) || (key == 0xE0))         // function / arrow key, second code follows
+            _getch();
+        else if (key == '\r')
+            lineTyped = true;
+        else if (key == '\b') {
+            if (!partialLine.empty()) {
+                partialLine.pop_back();
+                _cputs("\b \b");
+            }
+        }
+        else {
+            partialLine += static_cast<char>(key);
+            _putch(key);
+        }
+    }
+    if (!lineTyped)
+        return false;
+    userInput = partialLine;
+    partialLine.clear();
+#else
+    struct pollfd input = { STDIN_FILENO, POLLIN, 0 };
+    if (poll(&input, 1, 0) <= 0)
+        return false;
+    if (!getline(cin, userInput))
+        return false;
+#endif
+    transform(userInput.begin(), userInput.end(), userInput.begin(), ::tolower);
+    typedAhead.push_back(userInput);
+    return true;
+}
+
 // writeOutput() - writes parameter to output
 //   
 int TicTacToeUI::writeOutput(const char* output) const {
-    cout << output;
+    if (!session || (session->getMode() == SessionLog::RECORD))
+        cout << output;
+    if (session)
+        session->getFrame() += output;
     return 0;
 }
 
@@ -58,10 +142,22 @@ int TicTacToeUI::writeOutput(const char* output) const {
 // overload of writeOutput() giving option to clear screen
 // writeOutput() - writes parameter to output
 //   
-int TicTacToeUI::writeOutput(const char* output, bool clearScreenPrior) const {
-    if (clearScreenPrior)
-        system("cls");
-    cout << output;
+//   clearing the screen no longer spawns system("cls") (Windows only) - the renderer is invalidated instead,
+//   the next writeTicTacToeBoard() redraws the screen & the output is shown as the status under the board
+int TicTacToeUI::writeOutput(const char* output, bool clearScreenPrior) {
+    if (clearScreenPrior) {
+        renderer.invalidate();
+        renderer.renderStatus(output);
+    }
+    else
+        writeOutput(output);
+    return 0;
+}
+
+// writeStatus() - replaces the status text under the board (e.g. last move, errors, game over)
+//   only written to the console if the status changed
+int TicTacToeUI::writeStatus(const char* status) {
+    renderer.renderStatus(status);
     return 0;
 }
 
@@ -88,28 +184,58 @@ int TicTacToeUI::writeOutput(const char* output, int arg1, int arg2) const {
 }
 
 // Draws board based on data from board class
-// ToDo - find alternative to hard coding last row & column to avoid drawing delimiter - e.g. |
+//   the renderer repaints only squares changed since the last call (full redraw on first call or resize)
+//   & leaves the cursor on the prompt line, under the status
 //
-int TicTacToeUI::writeTicTacToeBoard(TicTacToeBoard board) const {
-    // loop thru all rows and all columns, retrieving contents from board class & displaying
-    cout << "\n";
-    for (int r = 0; r < TicTacToeBoard::BOARD_NUM_ROWS; r++) {
-        cout << "\t\t\t\t";
-        for (int c = 0; c < TicTacToeBoard::BOARD_NUM_COLS; c++) {
-            cout << " " << board.getSquareContents(r,c);
-            if (c < TicTacToeBoard::BOARD_NUM_COLS - 1)
-                cout << " |";
-        }
-        if (r < TicTacToeBoard::BOARD_NUM_ROWS - 1) {  // draw the row dividers
-            cout << "\n\t\t\t\t";
-            for (int itr = 0; itr < TicTacToeBoard::BOARD_NUM_COLS; itr++) {
-                cout << "---";  // print three - for every column, so we aren't hardcoding the columns
-            }
-            cout << "---\n";
-        }
+int TicTacToeUI::writeTicTacToeBoard(const TicTacToeBoard& board) {
+    renderer.renderBoard(board);
+    return 0;
+}
 
-        else
-            cout << "\n\n";
-    }
+// Keeps the board on screen after a game ends - the board is reset straight away, but the final position
+//   stays up with the result until the next game's first move
+//
+void TicTacToeUI::holdBoard() {
+    renderer.holdBoard();
+}
+
+// Draws one frame of the spectator dashboard - the latest snapshot of every game being watched
+//   called at a fixed rate by the UI thread, independent of the threads playing the games
+//
+int TicTacToeUI::writeSpectatorDashboard(SpectatorDashboard& dashboard) {
+    dashboard.renderFrame(cout);
     return 0;
 }
+
+// recordSession() - from here on every input & every frame written is recorded to the file (SessionLog)
+//   the renderer's frames are captured too & no longer follow the terminal size, so a replay repeats them
+//   throws runtime_error if the file can't be created
+//
+void TicTacToeUI::recordSession(const char* path) {
+    session.reset(new SessionLog(path, SessionLog::RECORD));
+    renderer.setOutput(&cout, &session->getFrame());
+}
+
+// replaySession() - input comes from the recording & each frame is checked against the recorded one
+//   nothing is written to the console until endSession()
+//   throws runtime_error if the file can't be read, invalid_argument if it isn't a session log
+//
+void TicTacToeUI::replaySession(const char* path) {
+    session.reset(new SessionLog(path, SessionLog::REPLAY));
+    renderer.setOutput(nullptr, &session->getFrame());
+}
+
+// endSession() - records / checks the last frame & goes back to the plain console
+//   returns the replay report (empty when recording or if there was no session)
+//
+SessionLog::Report TicTacToeUI::endSession() {
+    SessionLog::Report report;
+    if (!session)
+        return report;
+    session->endSession();
+    if (session->getMode() == SessionLog::REPLAY)
+        report = session->getReport();
+    renderer.setOutput(&cout, nullptr);
+    session.reset();
+    return report;
+}
@@ -1,20 +1,55 @@
 #pragma once
 
+#include <deque>
+#include <memory>
 #include <string>
+#include <stdio.h>
 #include "TicTacToeBoard.h"
+#include "TerminalRenderer.h"
+#include "SpectatorDashboard.h"
+#include "SessionLog.h"
+
+// sprintf_s & sscanf_s are MSVC (secure CRT) only, map to the standard versions elsewhere (e.g. Linux builds)
+//   sscanf_s takes a buffer size after each %c, %s or %[ destination - the wrappers drop it, sscanf has no size
+#ifndef _MSC_VER
+#define sprintf_s snprintf
+
+// one character (or string) destination, followed by its buffer size
+inline int sscanf_s(const char* buffer, const char* format, char* destination, unsigned size) {
+	(void)size;
+	return sscanf(buffer, format, destination);
+}
+
+// numeric destinations only (e.g. %u %u), no buffer sizes
+template <typename... Destinations>
+inline int sscanf_s(const char* buffer, const char* format, Destinations*... destinations) {
+	return sscanf(buffer, format, destinations...);
+}
+#endif
 
 using namespace std;  // fair programming practice, as could create scope issues, but don't feel like qualifying all reads & writes
 
 /*
  * Header file for Fall 2023 Tic Tac Toe program UI
  *    getUserInput() prompts user with specified string and returns user input
+ *    pollUserInput() returns user input if a line has been typed, without blocking (false if nothing typed)
+ *        the line is kept for the next getUserInput(), so a move typed ahead (e.g. while the engine thinks) isn't lost
  *    writeOutput() writes output to console and returns success (0) - 4 versions, all use character arrays
  *        1) one parameter - character array to write -> output it
  *        2) char array incl sprintf formatting (e.g. %c) + char arg -> uses sprintf to add arg to string -> outputs
  *        3) char array + two format items (e.g. %d ... %d) -> sprintf to add args -> outputs
- *        4) char array + option to clear screen -> if true, clears screen & outputs
+ *        4) char array + option to clear screen -> if true, clears screen & shows output as the status
+ *    writeStatus() replaces the status text shown under the board
  * 
  *    writeTicTacToeBoard(board) displays the board based on the contents maintained in the board class
+ *        only squares changed since the last call are redrawn (see TerminalRenderer)
+ *    holdBoard() keeps the board on screen until the next game's first move (the final position of a game)
+ *    writeSpectatorDashboard(dashboard) displays one frame of a grid of live games (see SpectatorDashboard)
+ *
+ *    recordSession(path) records the inputs & every frame written until endSession() (see SessionLog)
+ *    replaySession(path) inputs come from the recording & frames are checked against it, nothing is shown,
+ *        once the recorded inputs are used up getUserInput() returns "q"
+ *    endSession() finishes the recording or replay, returns the replay report (frames, mismatches, timing)
  */
 
 class TicTacToeUI
@@ -24,9 +59,23 @@ public:
 	int writeOutput(const char* output) const;
 	int writeOutput(const char* output, char arg) const;
 	int writeOutput(const char* output, int arg1, int arg2) const;
-	int writeOutput(const char* output, bool clearScreenPriorToWrite) const;
-	string getUserInput(const char* prompt) const;
+	int writeOutput(const char* output, bool clearScreenPriorToWrite);
+	int writeStatus(const char* status);
+	string getUserInput(const char* prompt);
+	bool pollUserInput(string& userInput);
+
+	int writeTicTacToeBoard(const TicTacToeBoard& board);
+	void holdBoard();
+	int writeSpectatorDashboard(SpectatorDashboard& dashboard);
+
+	void recordSession(const char* path);
+	void replaySession(const char* path);
+	SessionLog::Report endSession();
 
-	int writeTicTacToeBoard(TicTacToeBoard board) const;
+private:
+	TerminalRenderer renderer;    // keeps the last frame drawn, so only changes are repainted
+	std::unique_ptr<SessionLog> session;    // recording or replaying, nullptr for a plain console session
+	std::deque<string> typedAhead;          // lines read by pollUserInput(), returned by getUserInput() first
+	string partialLine;                     // Windows: keys read by pollUserInput() before Enter was pressed
 };
 
@@ -2,15 +2,69 @@
 //
 
 #include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include <fstream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
 #include "TicTacToeUI.h"
 #include "TicTacToeBoard.h"
+#include "SpectatorDashboard.h"
+#include "SharedBoardSegment.h"
+#include "StateSpaceEnumerator.h"
+#include "AsyncMoveSearch.h"
+#include "PositionExporter.h"
+#include "UltimateMcts.h"
+#include "QubicSearch.h"
+#include "GomokuSearch.h"
+#include "ParallelSearch.h"
+#include "DfpnSolver.h"
+#include "RuleVariantBoard.h"
+#include "MoveCache.h"
+#include "Tournament.h"
+#include "OpeningStats.h"
+#include "GameStore.h"
+#include "LineEvaluator.h"
+#include "ShardedSimulation.h"
 
 #define MAX_CHARS 128     // max size of the user output buffer
 
 namespace {  //  Anonymous namespace - ensures the helper functions & the output strings are only accessible in this file
     // helper functions
-    void someoneWins(TicTacToeUI console, TicTacToeBoard& board);
-    void itsaDraw(TicTacToeUI console, TicTacToeBoard& board);
+    int playGame(TicTacToeUI& console, TicTacToeBoard& board, SharedBoardSegment* publisher, AsyncMoveSearch* engine,
+        int engineBudget);
+    int reportReplay(TicTacToeUI& console, const char* path);
+    void someoneWins(TicTacToeUI& console, TicTacToeBoard& board);
+    void itsaDraw(TicTacToeUI& console, TicTacToeBoard& board);
+    bool waitForEngineMove(TicTacToeUI& console, AsyncMoveSearch& engine, const TicTacToeBoard& board,
+        int budgetMilliseconds, unsigned int& row, unsigned int& col);
+
+    // command line modes - no arguments runs the interactive game
+    int runCommandLineMode(TicTacToeUI& console, int argc, char* argv[]);
+    int runSpectatorMode(TicTacToeUI& console, int argc, char* argv[]);
+    int runAttachMode(TicTacToeUI& console, int argc, char* argv[]);
+    int runEnumerateMode(TicTacToeUI& console, int argc, char* argv[]);
+    int runExportMode(TicTacToeUI& console, int argc, char* argv[]);
+    int runUltimateMode(TicTacToeUI& console, int argc, char* argv[]);
+    int runQubicMode(TicTacToeUI& console, int argc, char* argv[]);
+    int runGomokuMode(TicTacToeUI& console, int argc, char* argv[]);
+    int runParallelMode(TicTacToeUI& console, int argc, char* argv[]);
+    int runSolveMode(TicTacToeUI& console, int argc, char* argv[]);
+    int runVariantsMode(TicTacToeUI& console, int argc, char* argv[]);
+    int runCacheMode(TicTacToeUI& console, int argc, char* argv[]);
+    int runTournamentMode(TicTacToeUI& console, int argc, char* argv[]);
+    int runOpeningsMode(TicTacToeUI& console, int argc, char* argv[]);
+    int runStoreMode(TicTacToeUI& console, int argc, char* argv[]);
+    int runEvaluateMode(TicTacToeUI& console, int argc, char* argv[]);
+    int runShardMode(TicTacToeUI& console, int argc, char* argv[]);
+    int runShardWorkerMode(TicTacToeUI& console, int argc, char* argv[]);
+    int intArgument(int argc, char* argv[], int index, int defaultValue);
 
     constexpr const char* GAME_VERSION = "Version: 2025 v1.1\n";
 
@@ -19,129 +73,1369 @@ namespace {  //  Anonymous namespace - ensures the helper functions & the output
     constexpr const char* INTRO_MESSAGE = "Welcome to Tic Tac Toe, class of Fall 2025!\n";
     constexpr const char* ENTER_MOVE = "Player %c to play, please enter two digits, row[0 - 2] & column[0 - 2] or q to exit: ";
     constexpr const char* SHOW_MOVE = "You entered ... Row: %u\tColumn: %u\n";
+    constexpr const char* ENGINE_THINKING = "Player %c (engine) thinking ... %d ms, q to exit\n";
+    constexpr const char* SHOW_ENGINE_MOVE = "Engine played ... Row: %u\tColumn: %u\n";
+
+    // engine opponent - plays O, while it thinks the status is redrawn & the console checked for 'q' every poll
+    constexpr TicTacToeBoard::Player ENGINE_PLAYER = TicTacToeBoard::O;
+    constexpr int ENGINE_BUDGET_MS = 500;
+    constexpr int ENGINE_POLL_MS = 50;
 
     // Game over messages
     constexpr const char* PLAYER_WIN = "\tGame over - Player %c has won!\n   Resetting board, q to exit\n";
     constexpr const char* PLAYER_DRAW = "\tGame over - It's a DRAW!\n   Resetting board, q to exit\n";
+    constexpr const char* PLAYER_FORCED_DRAW = "\tGame over - no line left to win, It's a DRAW!\n   Resetting board, q to exit\n";
 
     // Error messages
     constexpr const char* INVALID_COMMAND = "\t\t\tInvalid entry - please try again\n";
     constexpr const char* SQUARE_NOT_EMPTY = "\t\t\tInvalid move!Square already taken - player %c to try again\n";
     constexpr const char* EXIT_MESSAGE = "\tThank you for playing\n";
 
-    // hack - empty message to clear screen (ToDo - get rid of this)
-    constexpr const char* CLEAR_SCREEN = "";
+    // Command line messages
+    constexpr const char* USAGE_MESSAGE =
+        "Usage: TicTacToe_TestPracticum [mode]\n"
+        "   (no mode)                              interactive game\n"
+        "   --publish <segment>                    interactive game, board published to shared memory\n"
+        "   --vs-engine [milliseconds]             interactive game against the engine (plays O), time per move\n"
+        "   --record <file>                        interactive game, inputs & screen output recorded to the file\n"
+        "   --replay <file>                        recorded game replayed at full speed, output checked & timed\n"
+        "   --spectate [games] [seconds] [fps] [segment]\n"
+        "                                          watch random games played on all cores, fps 0 = no rendering\n"
+        "                                          games are also published to the shared memory segment if named\n"
+        "   --attach <segment> [seconds] [fps]     watch games published to shared memory by another process\n"
+        "   --enumerate [rows] [cols] [k] [threads]\n"
+        "                                          visit every reachable position, cross-checking the win checks\n"
+        "   --export <file> [rows] [cols] [k] [threads] [games]\n"
+        "                                          labelled positions for training, columnar binary file\n"
+        "                                          every reachable position, or those of [games] random games\n"
+        "   --ultimate [games] [milliseconds]      Ultimate Tic Tac Toe, search engine against random moves\n"
+        "   --qubic [games] [milliseconds]         4x4x4 Tic Tac Toe, engine against the same engine limited to 1 ms\n"
+        "   --gomoku [games] [milliseconds]        15x15 five in a row, threat space search against move scoring only\n"
+        "   --parallel [rows] [cols] [k] [milliseconds] [threads]\n"
+        "                                          search the empty board with 1, 2, 4 ... threads, node rate scaling\n"
+        "   --solve [rows] [cols] [k] [seconds] [entries] [checkpoint]\n"
+        "                                          prove the value of the empty board (proof-number search)\n"
+        "                                          saved to the checkpoint file every minute, resumed from it on restart\n"
+        "   --variants [games]                     random games of each rule variant (misere, wild, other starts)\n"
+        "   --cache [rows] [cols] [k] [milliseconds] [file]\n"
+        "                                          opening moves twice through the engine's move cache, latency\n"
+        "   --tournament [games] [threads] [round-robin | gauntlet | sprt] [player ...]\n"
+        "                                          players: random, perfect, mcts:<playouts>, script:<squares>\n"
+        "   --openings [games] [threads] [depth] [log ...]\n"
+        "                                          results per opening, random games or game logs (a thread each)\n"
+        "   --store <file> [games] [moves]        games in progress kept in a memory mapped file, a random move\n"
+        "                                          in each of [moves] stored games, run again to reopen them\n"
+        "   --evaluate [rows] [cols] [k] [milliseconds]\n"
+        "                                          open line evaluation: incremental against recount, search with it\n"
+        "   --shard [workers] [games] [failing] [socket]\n"
+        "                                          random games in worker processes over a local socket, 1, 2, 4 ...\n"
+        "                                          workers, then [failing] of them dropping out & their work reassigned\n"
+        "   --shard-worker <socket> [fail after]   worker process, started by --shard\n";
+    constexpr const char* SEGMENT_ERROR = "Shared memory error: ";
+    constexpr const char* REPLAY_SUMMARY = "replayed %s: %d frames, %d inputs in %.2f ms (recorded session %.1f s)\n";
+    constexpr const char* REPLAY_FRAMES = "   per frame: mean %.1f us, p50 %.1f us, p99 %.1f us, max %.1f us\n";
+    constexpr const char* REPLAY_MATCH = "   every frame matches the recording\n";
+    constexpr const char* REPLAY_DIFFERS =
+        "   %d of %d frames differ from the recording (first: frame %d), %d recorded events not replayed\n";
+    constexpr const char* ENUMERATE_SUMMARY =
+        "%dx%d board, %d in a row, %d threads\n"
+        "   positions: %llu   X wins: %llu   O wins: %llu   draws: %llu\n"
+        "   win checks compared: %llu   mismatches: %llu   time: %.2f ms\n";
+    constexpr const char* EXPORT_SUMMARY =
+        "%dx%d board, %d in a row, %d threads\n"
+        "   rows: %llu   blocks: %llu   bytes: %llu\n"
+        "   solve: %.2f ms   export: %.2f ms (%.1f MB/s)\n";
+    constexpr const char* ULTIMATE_GAME = "Game %d: engine plays %c, %s after %d moves, %.0f playouts/s\n";
+    constexpr const char* ULTIMATE_SUMMARY = "Engine won %d, lost %d, drew %d of %d games\n";
+    constexpr const char* QUBIC_GAME =
+        "Game %d: engine plays %c, %s after %d moves, average depth %.1f, %.0f nodes/s, slowest move %.1f ms\n";
+    constexpr const char* GOMOKU_GAME =
+        "Game %d: engine plays %c, %s after %d moves, %d forced wins, %.1f M scans/s, slowest %.0f ms\n";
+    constexpr const char* PARALLEL_HEADER = "%dx%d board, %d in a row, %d ms per search\n";
+    constexpr const char* PARALLEL_RUN =
+        "%2d threads: move %d, score %d, depth %d%s, %llu nodes, %.2f M nodes/s, %.2fx 1 thread\n";
+    constexpr const char* SOLVE_RESULT = "%dx%d board, %d in a row: %s";
+    constexpr const char* SOLVE_MOVE = ", winning first move row %d column %d";
+    constexpr const char* SOLVE_SUMMARY =
+        "\n   nodes: %llu   table: %llu of %llu entries, %d collections   time: %.2f s\n";
+    constexpr const char* SOLVE_CHECKPOINTS = "   %s, %d checkpoints written\n";
+    constexpr int SOLVE_CHECKPOINT_SECONDS = 60;
+    constexpr const char* VARIANT_RESULT =
+        "%-12s X won %5.1f%%, O won %5.1f%%, drawn %5.1f%% (%4.1f%% forced), %4.1f moves, %.2f M games/s\n";
+    constexpr const char* CACHE_HEADER = "%dx%d board, %d in a row, %d opening positions, %d ms per search\n";
+    constexpr const char* CACHE_ROUND = "%s: p50 %.3f ms, p99 %.3f ms, max %.3f ms, %llu hits, %llu misses\n";
+    constexpr const char* CACHE_FILE = "   %s %s: %llu entries\n";
+    constexpr int CACHE_PLIES = 2;
+    constexpr const char* TOURNAMENT_HEADER = "%d players, %s, %d games per pairing, %d threads\n";
+    constexpr const char* TOURNAMENT_PAIRING = "%-16s vs %-16s +%d =%d -%d  Elo %+7.1f [%+7.1f, %+7.1f]";
+    constexpr const char* TOURNAMENT_SPRT = "  LLR %+.2f %s";
+    constexpr const char* TOURNAMENT_PLAYER = "%-16s +%d =%d -%d  Elo %+7.1f [%+7.1f, %+7.1f] against the field\n";
+    constexpr const char* TOURNAMENT_SUMMARY = "%d games in %.2f s, %.0f games/s\n";
+    constexpr double TOURNAMENT_ELO0 = 0.0;        // SPRT hypotheses & error rates
+    constexpr double TOURNAMENT_ELO1 = 20.0;
+    constexpr double TOURNAMENT_ALPHA = 0.05;
+    constexpr double TOURNAMENT_BETA = 0.05;
+    constexpr const char* OPENINGS_HEADER = "%llu games from %s, %d threads, prefixes up to %d moves\n";
+    constexpr const char* OPENINGS_MOVE = "   %s row %d column %d: %9llu games, X %5.1f%%, O %5.1f%%, drawn %5.1f%%\n";
+    constexpr const char* OPENINGS_SUMMARY =
+        "%llu prefixes (%.1f MB), ingest %.0f k games/s, merge %.2f ms\n";
+    constexpr const char* STORE_OPENED = "%s: %u games in progress (room for %u), opened in %.2f ms%s\n";
+    constexpr const char* STORE_LOADED = "   every game loaded in %.1f ms (%.0f ns a game)\n";
+    constexpr const char* STORE_PLAYED =
+        "   %d moves saved, %d finished games replaced, %.0f k updates/s, %d syncs (last %.1f ms)\n";
+    constexpr int STORE_SYNC_MOVES = 100000;        // a durability point every so many moves
+    constexpr const char* EVALUATE_HEADER = "%dx%d board, %d in a row: %d lines, %s kernel\n";
+    constexpr const char* EVALUATE_UPDATE =
+        "   incremental: %.1f ns a move (play or undo & evaluate), full recount: %.1f ns (%.0fx), checksum %lld\n";
+    constexpr const char* EVALUATE_SEARCH =
+        "   %-13s depth %d%s, %llu nodes, %.0f k nodes/s, move row %d column %d, score %d\n";
+    constexpr int EVALUATE_ROUNDS = 20000;          // random games played & taken back for the timing
+    constexpr const char* SHARD_HEADER = "%llu random games in %u units, %d workers at most, socket %s\n";
+    constexpr const char* SHARD_RUN =
+        "%2d workers: %.2f s, %.2f M games/s, %.2fx 1 worker, %d lost, %d units reassigned, totals %s\n";
+    constexpr const char* SHARD_TOTALS =
+        "   X won %.2f%%, O won %.2f%%, drawn %.2f%% (%.2f%% forced), %.2f moves a game\n";
+    constexpr const char* SHARD_DEFAULT_SOCKET = "tictactoe-shard.sock";
+    constexpr uint32_t SHARD_UNIT_GAMES = 100000;   // games per unit of work
+    constexpr uint64_t SHARD_SEED = 1;
+    constexpr const char* SPECTATE_SUMMARY = "\n%d games finished in %d seconds\n";
 } // end anonymous namespace to restrict visibility to this file
 
 
 
-int main()
+int main(int argc, char* argv[])
 {
     TicTacToeUI console;    // UI encapsulation - rather than directly writing to console
     TicTacToeBoard board;
 
-    char userString[MAX_CHARS];
-
-    // local variables
-    int num_args;   // # of arguments returned from scanner
-    char command = '?';   // if command is entered, currently only quit supported ('q')
-    unsigned int row;        // row entered by user
-    unsigned int col;        // column entered by user
-
-
-    console.writeOutput(INTRO_MESSAGE);
-    console.writeOutput(GAME_VERSION);
-
-    // ToDo - game play instuctions
-    //
-    // Game loop
-    //     input options - row/column to play, or exit (can quit at any time)
-    //     parse input
-    //        command - currently only 'q' for quit or
-    //        row & column - two digits, 0-2 (note - board has constants for these values - ToDo)
-    //     after parsing input
-    //        update the board with the players move (assuming valid move)
-    //        check for win or draw
-    do {
-        // first section of code is parsing user input, validating & processing the quit command
-        console.writeTicTacToeBoard(board); 
-        sprintf_s(userString, MAX_CHARS, ENTER_MOVE, board.getPlayerName());
-        string userInput = console.getUserInput(userString);
-
-        // parse input string for single character
-        num_args = sscanf_s(userInput.c_str(), "%c", &command, 1);
-
-        if (num_args == 0) {  // no character entered, digits seem to work okay here
-            console.writeOutput(INVALID_COMMAND, true);
-            continue;
-        }
-
-        // user wants to exit?
-        if ((num_args == 1) && (command == 'q')) {
-            console.writeOutput(EXIT_MESSAGE);
-            exit(0);
-        }
-
-        // Wasn't a command - check if row & column entered
-        //   must be two unsigned integers between 0 & 2 (ToDo BAD - use board class constants)
-        num_args = sscanf_s(userInput.c_str(), "%u %u", &row, &col);
-        if ((num_args != 2) || 
-              (row > TicTacToeBoard::BOARD_NUM_ROWS) || 
-              (col > TicTacToeBoard::BOARD_NUM_COLS)) {
-            console.writeOutput(INVALID_COMMAND, true);
-            continue;
-        }
-        console.writeOutput(CLEAR_SCREEN, true);
-        console.writeOutput(SHOW_MOVE, row, col);
-
-
-        // core game logic below
-        //  if valid move (ie square is empty)
-        //    log the move &
-        //    check if game is over (win or draw)
-        //       congratulate the player & start again
-        //  else - user selected a square already taken
-        //     politely ask them to try again
-
-        if (board.isSquareEmpty(row, col)) {
-            board.writeSquare(row, col, board.getPlayer());
-
-            if (board.isWinner(board.getPlayer())) {  // a win?
-                someoneWins(console, board);
-                board.nextPlayer();                // player who lost gets to go first
-            }
-            else if (board.isDraw()) {  // a draw?
-                itsaDraw(console, board);
-                board.nextPlayer();                // player who made the last move, gets to go second
-            }
-            else {                                  // game goes on
-                board.nextPlayer();
-            }  
+    // optional shared memory publication of the game, for viewers in other processes
+    std::unique_ptr<SharedBoardSegment> publisher;
+
+    // optional engine opponent, searches on its own thread so the console stays responsive
+    std::unique_ptr<AsyncMoveSearch> engine;
+    int engineBudget = ENGINE_BUDGET_MS;
+
+    if ((argc == 3) && (strcmp(argv[1], "--publish") == 0)) {
+        try {
+            publisher.reset(new SharedBoardSegment(argv[2], SharedBoardSegment::CREATE, 1));
         }
-        else {        // square already taken
-            console.writeOutput(SQUARE_NOT_EMPTY, board.getPlayerName());
+        catch (const std::exception& ex) {
+            console.writeOutput(SEGMENT_ERROR);
+            console.writeOutput(ex.what());
+            return 1;
         }
-    } while (true);
+    }
+    else if ((argc >= 2) && (argc <= 3) && (strcmp(argv[1], "--vs-engine") == 0)) {
+        engineBudget = intArgument(argc, argv, 2, ENGINE_BUDGET_MS);
+        engine.reset(new AsyncMoveSearch(std::make_shared<MoveCache>()));
+    }
+    else if ((argc == 3) && ((strcmp(argv[1], "--record") == 0) || (strcmp(argv[1], "--replay") == 0))) {
+        try {
+            if (strcmp(argv[1], "--record") == 0)
+                console.recordSession(argv[2]);
+            else
+                console.replaySession(argv[2]);
+        }
+        catch (const std::exception& ex) {
+            console.writeOutput(ex.what());
+            return 1;
+        }
+    }
+    else if (argc > 1)      // command line mode (e.g. spectating simulations) rather than a game
+        return runCommandLineMode(console, argc, argv);
+
+    int result = playGame(console, board, publisher.get(), engine.get(), engineBudget);
+    if ((argc == 3) && (strcmp(argv[1], "--replay") == 0))
+        return reportReplay(console, argv[2]);
+    console.endSession();
+    return result;
 
 }
 
 namespace {   // anonymous namespace to match definitions at top of the file
+    // The interactive game - console input (or a replayed session), moves checked & played, wins & draws
+    //   announced, the next game started by the player who didn't make the last move - returns 0 when the player quits
+    //   publisher (board published to shared memory) & engine (plays ENGINE_PLAYER) are optional (nullptr)
+    int playGame(TicTacToeUI& console, TicTacToeBoard& board, SharedBoardSegment* publisher, AsyncMoveSearch* engine,
+        int engineBudget) {
+        char userString[MAX_CHARS];
+        unsigned gameNumber = 0;   // games finished, published with the board
+
+        // local variables
+        int num_args;   // # of arguments returned from scanner
+        char command = '?';   // if command is entered, currently only quit supported ('q')
+        unsigned int row;        // row entered by user
+        unsigned int col;        // column entered by user
+
+
+        // intro is the first status shown under the board
+        sprintf_s(userString, MAX_CHARS, "%s%s", INTRO_MESSAGE, GAME_VERSION);
+        console.writeStatus(userString);
+
+        // ToDo - game play instuctions
+        //
+        // Game loop
+        //     input options - row/column to play, or exit (can quit at any time)
+        //     parse input
+        //        command - currently only 'q' for quit or
+        //        row & column - two digits, 0-2 (note - board has constants for these values - ToDo)
+        //     after parsing input
+        //        update the board with the players move (assuming valid move)
+        //        check for win or draw
+        do {
+            // first section of code is parsing user input, validating & processing the quit command
+            console.writeTicTacToeBoard(board); 
+            if (publisher)
+                publisher->publish(0, board, gameNumber);
+            if (engine && (board.getPlayer() == ENGINE_PLAYER)) {
+                // engine's turn - the console keeps redrawing & accepting 'q' while the engine thinks
+                if (!waitForEngineMove(console, *engine, board, engineBudget, row, col)) {
+                    console.writeOutput(EXIT_MESSAGE);
+                    return 0;
+                }
+                sprintf_s(userString, MAX_CHARS, SHOW_ENGINE_MOVE, row, col);
+                console.writeStatus(userString);
+            }
+            else {
+                sprintf_s(userString, MAX_CHARS, ENTER_MOVE, board.getPlayerName());
+                string userInput = console.getUserInput(userString);
+
+                // parse input string for single character
+                num_args = sscanf_s(userInput.c_str(), "%c", &command, 1);
+
+                if (num_args == 0) {  // no character entered, digits seem to work okay here
+                    console.writeStatus(INVALID_COMMAND);
+                    continue;
+                }
+
+                // user wants to exit?
+                if ((num_args == 1) && (command == 'q')) {
+                    console.writeOutput(EXIT_MESSAGE);
+                    return 0;
+                }
+
+                // Wasn't a command - check if row & column entered
+                //   must be two unsigned integers between 0 & 2 (ToDo BAD - use board class constants)
+                num_args = sscanf_s(userInput.c_str(), "%u %u", &row, &col);
+                if ((num_args != 2) || 
+                      (row > TicTacToeBoard::BOARD_NUM_ROWS) || 
+                      (col > TicTacToeBoard::BOARD_NUM_COLS)) {
+                    console.writeStatus(INVALID_COMMAND);
+                    continue;
+                }
+                sprintf_s(userString, MAX_CHARS, SHOW_MOVE, row, col);
+                console.writeStatus(userString);
+            }
+
+
+            // core game logic below
+            //  if valid move (ie square is empty)
+            //    log the move &
+            //    check if game is over (win or draw)
+            //       congratulate the player & start again
+            //  else - user selected a square already taken
+            //     politely ask them to try again
+
+            if (board.isSquareEmpty(row, col)) {
+                board.writeSquare(row, col, board.getPlayer());
+                if (publisher)                         // viewers see the final position before the reset
+                    publisher->publish(0, board, gameNumber);
+
+                TicTacToeBoard::GameStatus status = board.getGameStatus();
+                if (status != TicTacToeBoard::IN_PROGRESS)
+                    gameNumber++;
+
+                if ((status == TicTacToeBoard::X_WINS) || (status == TicTacToeBoard::O_WINS)) {  // a win?
+                    someoneWins(console, board);
+                    board.nextPlayer();                // player who lost gets to go first
+                }
+                else if (status != TicTacToeBoard::IN_PROGRESS) {  // a draw? (board full, or no line left to win)
+                    itsaDraw(console, board);
+                    board.nextPlayer();                // player who made the last move, gets to go second
+                }
+                else {                                  // game goes on
+                    board.nextPlayer();
+                }  
+            }
+            else {        // square already taken
+                sprintf_s(userString, MAX_CHARS, SQUARE_NOT_EMPTY, board.getPlayerName());
+                console.writeStatus(userString);
+            }
+        } while (true);
+
+    }
+
+    // Replay report - frames checked, time per frame through the game loop & renderer, returns 1 if the replay
+    //   didn't match the recording (a frame differs or recorded events were left over)
+    int reportReplay(TicTacToeUI& console, const char* path) {
+        SessionLog::Report report = console.endSession();
+        char line[MAX_CHARS];
+        sprintf_s(line, MAX_CHARS, REPLAY_SUMMARY, path, report.frames, report.inputs, report.totalMs,
+            report.recordedSeconds);
+        console.writeOutput(line);
+        sprintf_s(line, MAX_CHARS, REPLAY_FRAMES, report.meanUs, report.p50Us, report.p99Us, report.maxUs);
+        console.writeOutput(line);
+        if ((report.mismatches == 0) && (report.unusedEvents == 0)) {
+            console.writeOutput(REPLAY_MATCH);
+            return 0;
+        }
+        sprintf_s(line, MAX_CHARS, REPLAY_DIFFERS, report.mismatches, report.frames, report.firstMismatch,
+            report.unusedEvents);
+        console.writeOutput(line);
+        return 1;
+    }
+
     // Helper function - the current player has won - take the necessary steps
     //   note - need to pass by reference, otherwise it makes a copy of the board object
-    //     could do the same for console, but not needed, should be stateless
-    void someoneWins(TicTacToeUI console, TicTacToeBoard& board) {
+    //     console also by reference, it tracks the last frame drawn
+    void someoneWins(TicTacToeUI& console, TicTacToeBoard& board) {
+        char userString[MAX_CHARS];
+
         console.writeTicTacToeBoard(board);
-        console.writeOutput(PLAYER_WIN, board.getPlayerName());
+        sprintf_s(userString, MAX_CHARS, PLAYER_WIN, board.getPlayerName());
+        console.writeStatus(userString);
+        console.holdBoard();                  // final position stays up until the next game's first move
         board.resetBoard();
     }
 
     // helper function - it's a draw - reset & prepare for a new game
     //   note - need to pass by reference, otherwise it makes a copy of the board object
-    void itsaDraw(TicTacToeUI console, TicTacToeBoard& board) {
+    //   a forced draw (every line blocked) ends the game before the board is full
+    void itsaDraw(TicTacToeUI& console, TicTacToeBoard& board) {
         console.writeTicTacToeBoard(board);
-        console.writeOutput(PLAYER_DRAW);
+        console.writeStatus((board.getGameStatus() == TicTacToeBoard::FORCED_DRAW) ? PLAYER_FORCED_DRAW : PLAYER_DRAW);
+        console.holdBoard();
         board.resetBoard();
     }
+
+    // Helper function - engine's turn, the search runs on the engine's worker thread
+    //   this thread polls the result, redrawing the status & checking for 'q' between polls
+    //   any other line typed meanwhile stays queued in the console, it answers the player's next prompt
+    //   returns false (search cancelled) if the player quit while the engine was thinking
+    bool waitForEngineMove(TicTacToeUI& console, AsyncMoveSearch& engine, const TicTacToeBoard& board,
+        int budgetMilliseconds, unsigned int& row, unsigned int& col) {
+        char userString[MAX_CHARS];
+        auto start = std::chrono::steady_clock::now();
+        std::future<SearchEngine::Result> move =
+            engine.requestMove(MnkBoard::fromBoard(board), std::chrono::milliseconds(budgetMilliseconds));
+
+        while (move.wait_for(std::chrono::milliseconds(ENGINE_POLL_MS)) != std::future_status::ready) {
+            int elapsed = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start).count());
+            sprintf_s(userString, MAX_CHARS, ENGINE_THINKING, board.getPlayerName(), elapsed);
+            console.writeStatus(userString);
+
+            string userInput;
+            if (console.pollUserInput(userInput) && !userInput.empty() && (userInput[0] == 'q')) {
+                engine.cancel();
+                move.wait();                       // cancelled search returns within one poll of the engine
+                return false;
+            }
+        }
+
+        SearchEngine::Result result = move.get();
+        row = result.bestMove / TicTacToeBoard::BOARD_NUM_COLS;
+        col = result.bestMove % TicTacToeBoard::BOARD_NUM_COLS;
+        return true;
+    }
+
+    //                                     Command line modes
+
+    // Dispatch on the first argument, shows usage if the mode is unknown
+    int runCommandLineMode(TicTacToeUI& console, int argc, char* argv[]) {
+        if (strcmp(argv[1], "--spectate") == 0)
+            return runSpectatorMode(console, argc, argv);
+        if ((strcmp(argv[1], "--attach") == 0) && (argc > 2))
+            return runAttachMode(console, argc, argv);
+        if (strcmp(argv[1], "--enumerate") == 0)
+            return runEnumerateMode(console, argc, argv);
+        if ((strcmp(argv[1], "--export") == 0) && (argc > 2))
+            return runExportMode(console, argc, argv);
+        if (strcmp(argv[1], "--ultimate") == 0)
+            return runUltimateMode(console, argc, argv);
+        if (strcmp(argv[1], "--qubic") == 0)
+            return runQubicMode(console, argc, argv);
+        if (strcmp(argv[1], "--gomoku") == 0)
+            return runGomokuMode(console, argc, argv);
+        if (strcmp(argv[1], "--parallel") == 0)
+            return runParallelMode(console, argc, argv);
+        if (strcmp(argv[1], "--solve") == 0)
+            return runSolveMode(console, argc, argv);
+        if (strcmp(argv[1], "--variants") == 0)
+            return runVariantsMode(console, argc, argv);
+        if (strcmp(argv[1], "--cache") == 0)
+            return runCacheMode(console, argc, argv);
+        if (strcmp(argv[1], "--tournament") == 0)
+            return runTournamentMode(console, argc, argv);
+        if (strcmp(argv[1], "--openings") == 0)
+            return runOpeningsMode(console, argc, argv);
+        if ((strcmp(argv[1], "--store") == 0) && (argc > 2))
+            return runStoreMode(console, argc, argv);
+        if (strcmp(argv[1], "--evaluate") == 0)
+            return runEvaluateMode(console, argc, argv);
+        if (strcmp(argv[1], "--shard") == 0)
+            return runShardMode(console, argc, argv);
+        if ((strcmp(argv[1], "--shard-worker") == 0) && (argc > 2))
+            return runShardWorkerMode(console, argc, argv);
+
+        console.writeOutput(USAGE_MESSAGE);
+        return 1;
+    }
+
+    // Returns argv[index] as an integer, or the default if not supplied
+    int intArgument(int argc, char* argv[], int index, int defaultValue) {
+        return (index < argc) ? atoi(argv[index]) : defaultValue;
+    }
+
+    // Plays random games on the boards first, first + stride, ... until told to stop
+    //   publishes every move to the dashboard - a single atomic store, the renderer never slows the games down
+    //   & to the shared memory segment if there is one (seqlock write, no system calls)
+    void playRandomGames(SpectatorDashboard& dashboard, SharedBoardSegment* segment, int first, int stride,
+                         const std::atomic<bool>& stop, unsigned long& gamesFinished) {
+        std::vector<TicTacToeBoard> boards;
+        std::vector<unsigned> gameNumbers;
+        for (int g = first; g < dashboard.getGameCount(); g += stride) {
+            boards.emplace_back();
+            gameNumbers.push_back(0);
+        }
+        std::mt19937 rng(static_cast<unsigned>(first) * 7919u + 1u);
+        int emptySquares[TicTacToeBoard::BOARD_NUM_ROWS * TicTacToeBoard::BOARD_NUM_COLS];
+
+        while (!stop.load(std::memory_order_relaxed)) {
+            for (size_t i = 0; i < boards.size(); i++) {
+                TicTacToeBoard& board = boards[i];
+                int numEmpty = 0;
+                for (int r = 0; r < TicTacToeBoard::BOARD_NUM_ROWS; r++)
+                    for (int c = 0; c < TicTacToeBoard::BOARD_NUM_COLS; c++)
+                        if (board.isSquareEmpty(r, c))
+                            emptySquares[numEmpty++] = r * TicTacToeBoard::BOARD_NUM_COLS + c;
+                int square = emptySquares[rng() % numEmpty];
+                board.writeSquare(square / TicTacToeBoard::BOARD_NUM_COLS, square % TicTacToeBoard::BOARD_NUM_COLS,
+                                  board.getPlayer());
+                dashboard.publish(first + static_cast<int>(i) * stride, board, gameNumbers[i]);
+                if (segment != nullptr)
+                    segment->publish(first + static_cast<int>(i) * stride, board, gameNumbers[i]);
+
+                if (board.getGameStatus() != TicTacToeBoard::IN_PROGRESS) {   // same flow as main(), next game
+                    board.resetBoard();
+                    gameNumbers[i]++;
+                    gamesFinished++;
+                }
+                board.nextPlayer();
+            }
+        }
+    }
+
+    // --spectate [games] [seconds] [fps] [segment]
+    //   games are played on one thread per core, the dashboard is rendered on this thread at a fixed frame rate
+    int runSpectatorMode(TicTacToeUI& console, int argc, char* argv[]) {
+        int numGames = std::max(1, intArgument(argc, argv, 2, 24));
+        int seconds = std::max(1, intArgument(argc, argv, 3, 10));
+        int framesPerSecond = std::max(0, intArgument(argc, argv, 4, 10));
+
+        std::unique_ptr<SharedBoardSegment> segment;
+        if (argc > 5) {
+            try {
+                segment.reset(new SharedBoardSegment(argv[5], SharedBoardSegment::CREATE, numGames));
+            }
+            catch (const std::exception& ex) {
+                console.writeOutput(SEGMENT_ERROR);
+                console.writeOutput(ex.what());
+                return 1;
+            }
+        }
+
+        SpectatorDashboard dashboard(numGames);
+        std::atomic<bool> stop(false);
+        int numThreads = std::max(1, std::min(numGames, static_cast<int>(std::thread::hardware_concurrency())));
+        std::vector<unsigned long> gamesFinished(numThreads, 0);
+        std::vector<std::thread> players;
+        for (int t = 0; t < numThreads; t++)
+            players.emplace_back(playRandomGames, std::ref(dashboard), segment.get(), t, numThreads,
+                                 std::cref(stop), std::ref(gamesFinished[t]));
+
+        auto endTime = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
+        if (framesPerSecond > 0) {
+            auto frameInterval = std::chrono::microseconds(1000000 / framesPerSecond);
+            auto nextFrame = std::chrono::steady_clock::now();
+            while (nextFrame < endTime) {
+                console.writeSpectatorDashboard(dashboard);
+                nextFrame += frameInterval;
+                std::this_thread::sleep_until(nextFrame);
+            }
+        }
+        else
+            std::this_thread::sleep_until(endTime);
+
+        stop.store(true);
+        unsigned long total = 0;
+        for (int t = 0; t < numThreads; t++) {
+            players[t].join();
+            total += gamesFinished[t];
+        }
+        console.writeOutput(SPECTATE_SUMMARY, static_cast<int>(total), seconds);
+        return 0;
+    }
+
+    // --attach <segment> [seconds] [fps]
+    //   viewer for games published by another process - copies the seqlocked snapshots into the dashboard
+    int runAttachMode(TicTacToeUI& console, int argc, char* argv[]) {
+        int seconds = std::max(1, intArgument(argc, argv, 3, 10));
+        int framesPerSecond = std::max(1, intArgument(argc, argv, 4, 10));
+
+        try {
+            SharedBoardSegment segment(argv[2], SharedBoardSegment::ATTACH);
+            SpectatorDashboard dashboard(segment.getGameCount());
+            auto endTime = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
+            auto frameInterval = std::chrono::microseconds(1000000 / framesPerSecond);
+            auto nextFrame = std::chrono::steady_clock::now();
+            while (nextFrame < endTime) {
+                for (int g = 0; g < segment.getGameCount(); g++) {
+                    TicTacToeBoard::Snapshot snapshot;
+                    unsigned gameNumber;
+                    if (segment.read(g, snapshot, gameNumber))
+                        dashboard.publish(g, snapshot, gameNumber);
+                }
+                console.writeSpectatorDashboard(dashboard);
+                nextFrame += frameInterval;
+                std::this_thread::sleep_until(nextFrame);
+            }
+        }
+        catch (const std::exception& ex) {
+            console.writeOutput(SEGMENT_ERROR);
+            console.writeOutput(ex.what());
+            return 1;
+        }
+        return 0;
+    }
+
+    // --enumerate [rows] [cols] [k] [threads]
+    //   exhaustive check of the win detection, returns 1 if any implementation disagreed
+    int runEnumerateMode(TicTacToeUI& console, int argc, char* argv[]) {
+        int rows = intArgument(argc, argv, 2, TicTacToeBoard::BOARD_NUM_ROWS);
+        int cols = intArgument(argc, argv, 3, TicTacToeBoard::BOARD_NUM_COLS);
+        int k = intArgument(argc, argv, 4, 3);
+        int numThreads = intArgument(argc, argv, 5, std::max(1, static_cast<int>(std::thread::hardware_concurrency())));
+        char summary[512];
+
+        try {
+            StateSpaceEnumerator enumerator(rows, cols, k, numThreads);
+            StateSpaceEnumerator::Result result = enumerator.run();
+            sprintf_s(summary, sizeof(summary), ENUMERATE_SUMMARY, rows, cols, k, numThreads,
+                static_cast<unsigned long long>(result.positions), static_cast<unsigned long long>(result.xWins),
+                static_cast<unsigned long long>(result.oWins), static_cast<unsigned long long>(result.draws),
+                static_cast<unsigned long long>(result.checks), static_cast<unsigned long long>(result.mismatches),
+                result.milliseconds);
+            console.writeOutput(summary);
+            console.writeOutput(result.firstMismatch.c_str());
+            return (result.mismatches == 0) ? 0 : 1;
+        }
+        catch (const std::invalid_argument& ex) {
+            console.writeOutput(ex.what());
+            return 1;
+        }
+    }
+
+    // Writes labelled positions for training - all reachable positions, or the positions of random games
+    //   file format described in PositionExporter.h
+    int runExportMode(TicTacToeUI& console, int argc, char* argv[]) {
+        int rows = intArgument(argc, argv, 3, TicTacToeBoard::BOARD_NUM_ROWS);
+        int cols = intArgument(argc, argv, 4, TicTacToeBoard::BOARD_NUM_COLS);
+        int k = intArgument(argc, argv, 5, 3);
+        int numThreads = intArgument(argc, argv, 6, std::max(1, static_cast<int>(std::thread::hardware_concurrency())));
+        int games = intArgument(argc, argv, 7, 0);
+        char summary[512];
+
+        try {
+            PositionExporter exporter(rows, cols, k, numThreads);
+            PositionExporter::Result result = (games > 0) ?
+                exporter.exportSelfPlay(argv[2], static_cast<uint64_t>(games), std::random_device()()) :
+                exporter.exportAll(argv[2]);
+            double megabytesPerSecond = (result.exportMilliseconds > 0) ?
+                result.bytes / 1000.0 / result.exportMilliseconds : 0;
+            sprintf_s(summary, sizeof(summary), EXPORT_SUMMARY, rows, cols, k, numThreads,
+                static_cast<unsigned long long>(result.rows), static_cast<unsigned long long>(result.blocks),
+                static_cast<unsigned long long>(result.bytes), result.solveMilliseconds, result.exportMilliseconds,
+                megabytesPerSecond);
+            console.writeOutput(summary);
+            return 0;
+        }
+        catch (const std::exception& ex) {
+            console.writeOutput(ex.what());
+            return 1;
+        }
+    }
+
+    // Ultimate Tic Tac Toe - the search engine against a random mover, the engine alternates X & O
+    //   reports each game's result & the engine's playout rate (the cost that matters in this variant)
+    int runUltimateMode(TicTacToeUI& console, int argc, char* argv[]) {
+        int games = intArgument(argc, argv, 2, 4);
+        int budget = intArgument(argc, argv, 3, 100);
+        const char* outcomes[] = { "unfinished", "X won", "O won", "drawn" };
+        char line[MAX_CHARS];
+        int wins = 0;
+        int losses = 0;
+        UltimateMcts engine;
+        std::mt19937 rng(std::random_device{}());
+        uint8_t moves[UltimateBoard::MAX_MOVES];
+
+        for (int game = 0; game < games; game++) {
+            UltimateBoard board;
+            TicTacToeBoard::Player enginePlayer = (game % 2 == 0) ? TicTacToeBoard::X : TicTacToeBoard::O;
+            uint64_t playouts = 0;
+            double milliseconds = 0;
+            while (board.getResult() == UltimateBoard::IN_PROGRESS) {
+                if (board.getPlayer() == enginePlayer) {
+                    UltimateMcts::Result result = engine.search(board, std::chrono::milliseconds(budget));
+                    playouts += result.iterations;
+                    milliseconds += result.milliseconds;
+                    board.play(result.bestMove);
+                }
+                else {
+                    int count = board.getLegalMoves(moves);
+                    board.play(moves[rng() % count]);
+                }
+            }
+            UltimateBoard::Result outcome = board.getResult();
+            if (outcome != UltimateBoard::DRAW) {
+                if ((outcome == UltimateBoard::X_WINS) == (enginePlayer == TicTacToeBoard::X))
+                    wins++;
+                else
+                    losses++;
+            }
+            sprintf_s(line, MAX_CHARS, ULTIMATE_GAME, game + 1, enginePlayer == TicTacToeBoard::X ? 'X' : 'O',
+                outcomes[outcome], board.getMoveCount(), (milliseconds > 0) ? playouts * 1000.0 / milliseconds : 0.0);
+            console.writeOutput(line);
+        }
+        sprintf_s(line, MAX_CHARS, ULTIMATE_SUMMARY, wins, losses, games - wins - losses, games);
+        console.writeOutput(line);
+        return 0;
+    }
+
+    // Qubic (4x4x4) - the engine with the full time per move against the same engine with 1 ms, alternating X & O
+    //   reports each game's result, the depth the full engine reached & its slowest move (should stay in budget)
+    int runQubicMode(TicTacToeUI& console, int argc, char* argv[]) {
+        int games = intArgument(argc, argv, 2, 4);
+        int budget = intArgument(argc, argv, 3, 100);
+        char line[MAX_CHARS];
+        int wins = 0;
+        int losses = 0;
+        QubicSearch engine;
+        QubicSearch opponent;
+
+        for (int game = 0; game < games; game++) {
+            QubicBoard board;
+            TicTacToeBoard::Player enginePlayer = (game % 2 == 0) ? TicTacToeBoard::X : TicTacToeBoard::O;
+            const char* outcome = "drawn";
+            int engineMoves = 0;
+            int depths = 0;
+            uint64_t nodes = 0;
+            double milliseconds = 0;
+            double slowest = 0;
+            while (!board.isFull()) {
+                int move;
+                if (board.getPlayer() == enginePlayer) {
+                    QubicSearch::Result result = engine.search(board, std::chrono::milliseconds(budget));
+                    engineMoves++;
+                    depths += result.depth;
+                    nodes += result.nodes;
+                    milliseconds += result.milliseconds;
+                    slowest = std::max(slowest, result.milliseconds);
+                    move = result.bestMove;
+                }
+                else
+                    move = opponent.search(board, std::chrono::milliseconds(1)).bestMove;
+                board.play(move);
+                if (board.isWinningMove(move)) {
+                    bool engineWon = (board.getPlayer() != enginePlayer);
+                    outcome = engineWon ? "engine won" : "engine lost";
+                    (engineWon ? wins : losses)++;
+                    break;
+                }
+            }
+            sprintf_s(line, MAX_CHARS, QUBIC_GAME, game + 1, enginePlayer == TicTacToeBoard::X ? 'X' : 'O', outcome,
+                board.getPly(), (engineMoves > 0) ? static_cast<double>(depths) / engineMoves : 0.0,
+                (milliseconds > 0) ? nodes * 1000.0 / milliseconds : 0.0, slowest);
+            console.writeOutput(line);
+        }
+        sprintf_s(line, MAX_CHARS, ULTIMATE_SUMMARY, wins, losses, games - wins - losses, games);
+        console.writeOutput(line);
+        return 0;
+    }
+
+    // Gomoku (15x15) - the threat space search engine against the same engine scoring moves only, alternating X & O
+    //   reports each game's result, the forced wins the solver found & the shape scan rate
+    int runGomokuMode(TicTacToeUI& console, int argc, char* argv[]) {
+        int games = intArgument(argc, argv, 2, 4);
+        int budget = intArgument(argc, argv, 3, 100);
+        char line[MAX_CHARS];
+        int wins = 0;
+        int losses = 0;
+        GomokuSearch engine;
+        GomokuSearch opponent(false);
+
+        for (int game = 0; game < games; game++) {
+            GomokuBoard board;
+            TicTacToeBoard::Player enginePlayer = (game % 2 == 0) ? TicTacToeBoard::X : TicTacToeBoard::O;
+            const char* outcome = "drawn";
+            int forcedWins = 0;
+            uint64_t scans = 0;
+            double milliseconds = 0;
+            double slowest = 0;
+            while (!board.isFull()) {
+                bool engineMove = (board.getPlayer() == enginePlayer);
+                GomokuSearch::Result result = (engineMove ? engine : opponent).search(board,
+                    std::chrono::milliseconds(budget));
+                if (engineMove) {
+                    forcedWins += result.forcedWin;
+                    scans += result.scans;
+                    milliseconds += result.milliseconds;
+                    slowest = std::max(slowest, result.milliseconds);
+                }
+                board.play(result.bestMove);
+                if (board.isWinningMove(result.bestMove)) {
+                    outcome = engineMove ? "engine won" : "engine lost";
+                    (engineMove ? wins : losses)++;
+                    break;
+                }
+            }
+            sprintf_s(line, MAX_CHARS, GOMOKU_GAME, game + 1, enginePlayer == TicTacToeBoard::X ? 'X' : 'O', outcome,
+                board.getPly(), forcedWins, (milliseconds > 0) ? scans / milliseconds / 1000.0 : 0.0, slowest);
+            console.writeOutput(line);
+        }
+        sprintf_s(line, MAX_CHARS, ULTIMATE_SUMMARY, wins, losses, games - wins - losses, games);
+        console.writeOutput(line);
+        return 0;
+    }
+
+    // Lazy SMP search of the empty board with 1, 2, 4 ... up to [threads] threads (default all cores), same time each
+    //   reports the depth & node rate of each run, & the node rate against the single thread run
+    int runParallelMode(TicTacToeUI& console, int argc, char* argv[]) {
+        int rows = intArgument(argc, argv, 2, 5);
+        int cols = intArgument(argc, argv, 3, 5);
+        int k = intArgument(argc, argv, 4, 4);
+        int budget = intArgument(argc, argv, 5, 1000);
+        int maxThreads = intArgument(argc, argv, 6, std::max(1, static_cast<int>(std::thread::hardware_concurrency())));
+        char line[MAX_CHARS];
+
+        try {
+            MnkBoard board(rows, cols, k);
+            sprintf_s(line, MAX_CHARS, PARALLEL_HEADER, rows, cols, k, budget);
+            console.writeOutput(line);
+            double baseRate = 0;
+            for (int threads = 1; threads <= std::max(1, maxThreads);
+                threads = ((threads < maxThreads) && (threads * 2 > maxThreads)) ? maxThreads : threads * 2) {
+                ParallelSearch search(threads);
+                ParallelSearch::Result result = search.search(board, std::chrono::milliseconds(budget));
+                double rate = (result.milliseconds > 0) ? result.nodes / result.milliseconds / 1000.0 : 0.0;
+                if (threads == 1)
+                    baseRate = rate;
+                sprintf_s(line, MAX_CHARS, PARALLEL_RUN, threads, result.bestMove, result.score, result.depth,
+                    result.exact ? " (exact)" : "", static_cast<unsigned long long>(result.nodes), rate,
+                    (baseRate > 0) ? rate / baseRate : 0.0);
+                console.writeOutput(line);
+            }
+        }
+        catch (const std::invalid_argument& ex) {
+            console.writeOutput(ex.what());
+            return 1;
+        }
+        return 0;
+    }
+
+    // Proof-number search of the empty board - first player win, draw or loss, unknown if out of time or memory
+    //   with a checkpoint file the solve is saved every SOLVE_CHECKPOINT_SECONDS & picks up where a killed run stopped
+    int runSolveMode(TicTacToeUI& console, int argc, char* argv[]) {
+        int rows = intArgument(argc, argv, 2, 4);
+        int cols = intArgument(argc, argv, 3, 4);
+        int k = intArgument(argc, argv, 4, 3);
+        int seconds = intArgument(argc, argv, 5, 60);
+        int entries = intArgument(argc, argv, 6, static_cast<int>(DfpnSolver::DEFAULT_MAX_ENTRIES));
+        const char* values[] = { "unknown (out of time)", "first player wins", "draw", "second player wins" };
+        char line[MAX_CHARS];
+
+        try {
+            MnkBoard board(rows, cols, k);
+            DfpnSolver solver(static_cast<size_t>(std::max(0, entries)));
+            if (argc > 7)
+                solver.enableCheckpoints(argv[7], std::chrono::seconds(SOLVE_CHECKPOINT_SECONDS));
+            DfpnSolver::Result result = solver.solve(board, std::chrono::seconds(seconds));
+            sprintf_s(line, MAX_CHARS, SOLVE_RESULT, rows, cols, k, values[result.value]);
+            console.writeOutput(line);
+            if (result.bestMove >= 0) {
+                sprintf_s(line, MAX_CHARS, SOLVE_MOVE, result.bestMove / cols, result.bestMove % cols);
+                console.writeOutput(line);
+            }
+            sprintf_s(line, MAX_CHARS, SOLVE_SUMMARY, static_cast<unsigned long long>(result.nodes),
+                static_cast<unsigned long long>(result.peakEntries), static_cast<unsigned long long>(entries),
+                result.collections, result.milliseconds / 1000.0);
+            console.writeOutput(line);
+            if (argc > 7) {
+                sprintf_s(line, MAX_CHARS, SOLVE_CHECKPOINTS, result.resumed ? "resumed from checkpoint" : "new solve",
+                    result.checkpoints);
+                console.writeOutput(line);
+            }
+        }
+        catch (const std::exception& ex) {
+            console.writeOutput(ex.what());
+            return 1;
+        }
+        return 0;
+    }
+
+    // Random games of one rule variant - random empty square, & a random symbol if the rules allow either
+    template <class Board>
+    void playVariantGames(TicTacToeUI& console, const char* name, int games, std::mt19937& generator) {
+        std::uniform_int_distribution<int> squares(0, Board::SQUARES - 1);
+        std::uniform_int_distribution<int> symbols(TicTacToeBoard::X, TicTacToeBoard::O);
+        long long results[TicTacToeBoard::FORCED_DRAW + 1] = {};
+        long long moves = 0;
+        Board board;
+
+        auto start = std::chrono::steady_clock::now();
+        for (int game = 0; game < games; game++) {
+            board.reset();
+            while (board.getGameStatus() == TicTacToeBoard::IN_PROGRESS) {
+                int position = squares(generator);
+                if (!board.isSquareEmpty(position))
+                    continue;
+                TicTacToeBoard::Player symbol = static_cast<TicTacToeBoard::Player>(symbols(generator));
+                board.play(position, board.isSymbolAllowed(symbol) ? symbol : board.getPlayer());
+                moves++;
+            }
+            results[board.getGameStatus()]++;
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        double percent = (games > 0) ? 100.0 / games : 0.0;
+        char line[MAX_CHARS];
+        sprintf_s(line, MAX_CHARS, VARIANT_RESULT, name, results[TicTacToeBoard::X_WINS] * percent,
+            results[TicTacToeBoard::O_WINS] * percent,
+            (results[TicTacToeBoard::DRAW] + results[TicTacToeBoard::FORCED_DRAW]) * percent,
+            results[TicTacToeBoard::FORCED_DRAW] * percent, (games > 0) ? static_cast<double>(moves) / games : 0.0,
+            (seconds > 0) ? games / seconds / 1e6 : 0.0);
+        console.writeOutput(line);
+    }
+
+    // Each rule variant side by side - every variant is its own RuleVariantBoard class, no per move rule checks
+    int runVariantsMode(TicTacToeUI& console, int argc, char* argv[]) {
+        int games = std::max(0, intArgument(argc, argv, 2, 1000000));
+        std::mt19937 generator(std::random_device{}());
+
+        playVariantGames<StandardBoard>(console, "standard", games, generator);
+        playVariantGames<MisereBoard>(console, "misere", games, generator);
+        playVariantGames<WildBoard>(console, "wild", games, generator);
+        playVariantGames<OStartsBoard>(console, "O starts", games, generator);
+        playVariantGames<CentreTakenBoard>(console, "centre taken", games, generator);
+        return 0;
+    }
+
+    // Helper function - positions of the first plies moves of the game, empty board first
+    void addOpenings(const MnkBoard& board, int plies, std::vector<MnkBoard>& positions) {
+        positions.push_back(board);
+        if ((plies == 0) || (board.isWinner(TicTacToeBoard::X)) || (board.isWinner(TicTacToeBoard::O)) ||
+            board.isFull())
+            return;
+        for (int position = 0; position < board.getSquareCount(); position++) {
+            if (board.isSquareEmpty(position)) {
+                MnkBoard next = board;
+                next.play(position);
+                addOpenings(next, plies - 1, positions);
+            }
+        }
+    }
+
+    // Engine moves for the opening positions (CACHE_PLIES deep), two rounds through a shared move cache
+    //   the first round searches each symmetry class once, the second is answered from the cache - with a file
+    //   the cache is warm loaded from it first & saved to it at the end
+    int runCacheMode(TicTacToeUI& console, int argc, char* argv[]) {
+        int rows = intArgument(argc, argv, 2, 4);
+        int cols = intArgument(argc, argv, 3, 4);
+        int k = intArgument(argc, argv, 4, 4);
+        int milliseconds = std::max(1, intArgument(argc, argv, 5, 20));
+        char line[MAX_CHARS];
+
+        try {
+            std::vector<MnkBoard> positions;
+            addOpenings(MnkBoard(rows, cols, k), CACHE_PLIES, positions);
+            std::shared_ptr<MoveCache> cache = std::make_shared<MoveCache>();
+            if (argc > 6) {
+                sprintf_s(line, MAX_CHARS, CACHE_FILE, "warm loaded from", argv[6],
+                    static_cast<unsigned long long>(cache->load(argv[6])));
+                console.writeOutput(line);
+            }
+            // any cached depth is good enough, the cache was filled with the same time budget
+            AsyncMoveSearch engine(cache, 1);
+            sprintf_s(line, MAX_CHARS, CACHE_HEADER, rows, cols, k, static_cast<int>(positions.size()), milliseconds);
+            console.writeOutput(line);
+
+            const char* rounds[] = { "first round ", "second round" };
+            for (const char* round : rounds) {
+                MoveCache::Stats before = cache->getStats();
+                std::vector<double> latencies;
+                for (const MnkBoard& position : positions) {
+                    if (position.isFull() || position.isWinner(TicTacToeBoard::X) ||
+                        position.isWinner(TicTacToeBoard::O))
+                        continue;
+                    auto start = std::chrono::steady_clock::now();
+                    engine.requestMove(position, std::chrono::milliseconds(milliseconds)).get();
+                    latencies.push_back(std::chrono::duration<double, std::milli>(
+                        std::chrono::steady_clock::now() - start).count());
+                }
+                std::sort(latencies.begin(), latencies.end());
+                MoveCache::Stats after = cache->getStats();
+                sprintf_s(line, MAX_CHARS, CACHE_ROUND, round, latencies[latencies.size() / 2],
+                    latencies[(latencies.size() * 99) / 100], latencies.back(),
+                    static_cast<unsigned long long>(after.hits - before.hits),
+                    static_cast<unsigned long long>(after.misses - before.misses));
+                console.writeOutput(line);
+            }
+            if (argc > 6) {
+                sprintf_s(line, MAX_CHARS, CACHE_FILE, "saved to", argv[6],
+                    static_cast<unsigned long long>(cache->save(argv[6])));
+                console.writeOutput(line);
+            }
+        }
+        catch (const std::exception& ex) {
+            console.writeOutput(ex.what());
+            return 1;
+        }
+        return 0;
+    }
+
+    // Players against each other on a thread pool, Elo per pairing & against the field
+    //   sprt - a gauntlet (first player against the others) with each pairing stopped by SPRT once decided
+    int runTournamentMode(TicTacToeUI& console, int argc, char* argv[]) {
+        int games = intArgument(argc, argv, 2, 1000);
+        int threads = intArgument(argc, argv, 3, std::max(1, static_cast<int>(std::thread::hardware_concurrency())));
+        const char* schedule = (argc > 4) ? argv[4] : "round-robin";
+        const char* defaultPlayers[] = { "perfect", "mcts:1000", "mcts:100", "script:402681357", "random" };
+        char line[MAX_CHARS];
+
+        try {
+            std::vector<Tournament::Player> players;
+            if (argc > 5) {
+                for (int arg = 5; arg < argc; arg++)
+                    players.push_back(Tournament::parsePlayer(argv[arg]));
+            }
+            else {
+                for (const char* spec : defaultPlayers)
+                    players.push_back(Tournament::parsePlayer(spec));
+            }
+            bool sprt = (strcmp(schedule, "sprt") == 0);
+            if (!sprt && (strcmp(schedule, "round-robin") != 0) && (strcmp(schedule, "gauntlet") != 0)) {
+                console.writeOutput(USAGE_MESSAGE);
+                return 1;
+            }
+            Tournament tournament(players, (strcmp(schedule, "round-robin") == 0) ? Tournament::ROUND_ROBIN :
+                Tournament::GAUNTLET, threads);
+            if (sprt)
+                tournament.enableSprt(TOURNAMENT_ELO0, TOURNAMENT_ELO1, TOURNAMENT_ALPHA, TOURNAMENT_BETA);
+            sprintf_s(line, MAX_CHARS, TOURNAMENT_HEADER, static_cast<int>(players.size()), schedule, games,
+                std::max(1, threads));
+            console.writeOutput(line);
+
+            Tournament::Result result = tournament.run(games, std::random_device{}());
+            const char* decisions[] = { "undecided", "H0 accepted", "H1 accepted" };
+            for (const Tournament::Pairing& pairing : result.pairings) {
+                const Tournament::Rating& rating = pairing.rating;
+                sprintf_s(line, MAX_CHARS, TOURNAMENT_PAIRING, players[pairing.first].name.c_str(),
+                    players[pairing.second].name.c_str(), rating.wins, rating.draws, rating.losses, rating.elo,
+                    rating.eloLow, rating.eloHigh);
+                console.writeOutput(line);
+                if (sprt) {
+                    sprintf_s(line, MAX_CHARS, TOURNAMENT_SPRT, pairing.llr, decisions[pairing.sprt]);
+                    console.writeOutput(line);
+                }
+                console.writeOutput("\n");
+            }
+            for (size_t player = 0; player < players.size(); player++) {
+                const Tournament::Rating& rating = result.players[player];
+                sprintf_s(line, MAX_CHARS, TOURNAMENT_PLAYER, players[player].name.c_str(), rating.wins, rating.draws,
+                    rating.losses, rating.elo, rating.eloLow, rating.eloHigh);
+                console.writeOutput(line);
+            }
+            sprintf_s(line, MAX_CHARS, TOURNAMENT_SUMMARY, result.games, result.milliseconds / 1000.0,
+                (result.milliseconds > 0) ? result.games * 1000.0 / result.milliseconds : 0.0);
+            console.writeOutput(line);
+        }
+        catch (const std::invalid_argument& ex) {
+            console.writeOutput(ex.what());
+            return 1;
+        }
+        return 0;
+    }
+
+    // Helper function - random games into the trie, cells in the order played, X opening every game (the trie's
+    //   prefixes are from X's first move, so the player isn't carried over from the last game as main() does)
+    void addRandomGames(OpeningTrie& trie, long long games, unsigned seed) {
+        TicTacToeBoard board;
+        std::mt19937 rng(seed);
+        int cells[OpeningTrie::CELLS];
+        int emptySquares[OpeningTrie::CELLS];
+        for (long long game = 0; game < games; game++) {
+            int moves = 0;
+            TicTacToeBoard::GameStatus status = TicTacToeBoard::IN_PROGRESS;
+            while (status == TicTacToeBoard::IN_PROGRESS) {
+                int numEmpty = 0;
+                for (int square = 0; square < OpeningTrie::CELLS; square++)
+                    if (board.isSquareEmpty(square / TicTacToeBoard::BOARD_NUM_COLS, square % TicTacToeBoard::BOARD_NUM_COLS))
+                        emptySquares[numEmpty++] = square;
+                cells[moves] = emptySquares[rng() % numEmpty];
+                board.writeSquare(cells[moves] / TicTacToeBoard::BOARD_NUM_COLS,
+                    cells[moves] % TicTacToeBoard::BOARD_NUM_COLS, board.getPlayer());
+                moves++;
+                status = board.getGameStatus();
+                board.nextPlayer();
+            }
+            trie.addGame(cells, moves, status);
+            board.resetBoard();
+            if (board.getPlayer() != TicTacToeBoard::INITIAL_PLAYER)
+                board.nextPlayer();
+        }
+    }
+
+    // Opening statistics - random games split between the threads, or a thread per game log, each into its own
+    //   shard, then the shards merged & the results after each first move (& the most played reply) shown
+    int runOpeningsMode(TicTacToeUI& console, int argc, char* argv[]) {
+        long long games = std::max(0, intArgument(argc, argv, 2, 1000000));
+        int numThreads = std::max(1, intArgument(argc, argv, 3,
+            std::max(1, static_cast<int>(std::thread::hardware_concurrency()))));
+        int depth = intArgument(argc, argv, 4, 4);
+        int logs = std::max(0, argc - 5);
+        char line[MAX_CHARS];
+
+        try {
+            OpeningStats stats((logs > 0) ? logs : numThreads, depth);
+            std::vector<std::thread> workers;
+            std::vector<std::string> errors(stats.getShardCount());
+            auto start = std::chrono::steady_clock::now();
+            for (int shard = 0; shard < stats.getShardCount(); shard++) {
+                OpeningTrie& trie = stats.getShard(shard);
+                if (logs > 0) {
+                    const char* path = argv[5 + shard];
+                    workers.emplace_back([&trie, &errors, shard, path] {
+                        std::ifstream log(path);
+                        try {
+                            if (!log)
+                                throw std::runtime_error(std::string("Unable to open game log: ") + path + "\n");
+                            OpeningStats::ingestLog(log, trie);
+                        }
+                        catch (const std::exception& ex) { errors[shard] = ex.what(); }
+                    });
+                }
+                else {
+                    long long share = games / numThreads + ((shard < games % numThreads) ? 1 : 0);
+                    workers.emplace_back(addRandomGames, std::ref(trie), share, 7919u * static_cast<unsigned>(shard) + 1u);
+                }
+            }
+            for (std::thread& worker : workers)
+                worker.join();
+            for (const std::string& error : errors) {
+                if (!error.empty())
+                    throw std::runtime_error(error);
+            }
+            auto ingested = std::chrono::steady_clock::now();
+            const OpeningTrie& trie = stats.merge();
+            double ingestSeconds = std::chrono::duration<double>(ingested - start).count();
+            double mergeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - ingested).count();
+
+            OpeningTrie::Counts all = trie.query(nullptr, 0);
+            sprintf_s(line, MAX_CHARS, OPENINGS_HEADER, static_cast<unsigned long long>(all.getGames()),
+                (logs > 0) ? "game logs" : "random play", stats.getShardCount(), trie.getMaxDepth());
+            console.writeOutput(line);
+            for (const OpeningTrie::Continuation& first : trie.continuations(nullptr, 0)) {
+                sprintf_s(line, MAX_CHARS, OPENINGS_MOVE, "X", first.cell / TicTacToeBoard::BOARD_NUM_COLS,
+                    first.cell % TicTacToeBoard::BOARD_NUM_COLS, static_cast<unsigned long long>(first.counts.getGames()),
+                    100 * first.counts.getRate(first.counts.xWins), 100 * first.counts.getRate(first.counts.oWins),
+                    100 * first.counts.getRate(first.counts.draws));
+                console.writeOutput(line);
+
+                // the reply that does best for O
+                std::vector<OpeningTrie::Continuation> replies = trie.continuations(&first.cell, 1);
+                auto best = std::max_element(replies.begin(), replies.end(),
+                    [](const OpeningTrie::Continuation& a, const OpeningTrie::Continuation& b) {
+                        return a.counts.getRate(a.counts.oWins) < b.counts.getRate(b.counts.oWins);
+                    });
+                if (best != replies.end()) {
+                    sprintf_s(line, MAX_CHARS, OPENINGS_MOVE, "  best O reply", best->cell / TicTacToeBoard::BOARD_NUM_COLS,
+                        best->cell % TicTacToeBoard::BOARD_NUM_COLS, static_cast<unsigned long long>(best->counts.getGames()),
+                        100 * best->counts.getRate(best->counts.xWins), 100 * best->counts.getRate(best->counts.oWins),
+                        100 * best->counts.getRate(best->counts.draws));
+                    console.writeOutput(line);
+                }
+            }
+            sprintf_s(line, MAX_CHARS, OPENINGS_SUMMARY, static_cast<unsigned long long>(trie.getNodeCount()),
+                trie.getMemoryBytes() / 1048576.0, (ingestSeconds > 0) ? all.getGames() / ingestSeconds / 1000 : 0.0,
+                mergeMs);
+            console.writeOutput(line);
+        }
+        catch (const std::exception& ex) {
+            console.writeOutput(ex.what());
+            return 1;
+        }
+        return 0;
+    }
+
+    // Helper function - a random move for the player whose turn it is, returns the game's status after it
+    TicTacToeBoard::GameStatus playRandomMove(TicTacToeBoard& board, std::mt19937& generator) {
+        int emptySquares[TicTacToeBoard::BOARD_NUM_ROWS * TicTacToeBoard::BOARD_NUM_COLS];
+        int numEmpty = 0;
+        for (int square = 0; square < TicTacToeBoard::BOARD_NUM_ROWS * TicTacToeBoard::BOARD_NUM_COLS; square++)
+            if (board.isSquareEmpty(square / TicTacToeBoard::BOARD_NUM_COLS, square % TicTacToeBoard::BOARD_NUM_COLS))
+                emptySquares[numEmpty++] = square;
+        int square = emptySquares[generator() % numEmpty];
+        board.writeSquare(square / TicTacToeBoard::BOARD_NUM_COLS, square % TicTacToeBoard::BOARD_NUM_COLS,
+            board.getPlayer());
+        TicTacToeBoard::GameStatus status = board.getGameStatus();
+        board.nextPlayer();
+        return status;
+    }
+
+    // Persistent game store - the games in the file are reopened & all loaded (a new file is filled with games
+    //   of a few random moves), then a random move is saved to each of [moves] games in turn, finished games are
+    //   replaced by new ones & the store synced every STORE_SYNC_MOVES moves - run it again to see them restored
+    int runStoreMode(TicTacToeUI& console, int argc, char* argv[]) {
+        int games = std::max(1, intArgument(argc, argv, 3, 1000000));
+        int moves = std::max(0, intArgument(argc, argv, 4, games));
+        std::mt19937 generator(std::random_device{}());
+        char line[MAX_CHARS];
+
+        try {
+            auto start = std::chrono::steady_clock::now();
+            GameStore store(argv[2], static_cast<uint32_t>(games));
+            double openMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            sprintf_s(line, MAX_CHARS, STORE_OPENED, argv[2], store.getLiveCount(), store.getCapacity(), openMs,
+                store.wasRecovered() ? ", recovered (not synced)" : "");
+            console.writeOutput(line);
+
+            TicTacToeBoard board;
+            if (store.getLiveCount() == 0) {
+                // up to 4 moves, no-one can have won yet
+                for (uint32_t session = 1; session <= store.getCapacity(); session++) {
+                    board.resetBoard();
+                    if (board.getPlayer() != TicTacToeBoard::INITIAL_PLAYER)
+                        board.nextPlayer();
+                    for (int move = static_cast<int>(generator() % 5); move > 0; move--)
+                        playRandomMove(board, generator);
+                    store.add(session, board);
+                }
+                store.sync();
+            }
+            else {
+                int loaded = 0;
+                start = std::chrono::steady_clock::now();
+                for (uint32_t slot = 0; slot < store.getHighWater(); slot++)
+                    loaded += store.load(slot, board) ? 1 : 0;
+                double loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                sprintf_s(line, MAX_CHARS, STORE_LOADED, loadMs, (loaded > 0) ? loadMs * 1e6 / loaded : 0.0);
+                console.writeOutput(line);
+            }
+
+            int replaced = 0;
+            int syncs = 0;
+            double syncMs = 0;
+            uint32_t slot = 0;
+            start = std::chrono::steady_clock::now();
+            for (int move = 1; move <= moves; move++) {
+                while (!store.load(slot, board))
+                    slot = (slot + 1) % store.getHighWater();
+                if (playRandomMove(board, generator) == TicTacToeBoard::IN_PROGRESS)
+                    store.save(slot, board);
+                else {
+                    uint64_t session = store.getSessionId(slot);
+                    store.remove(slot);
+                    board.resetBoard();
+                    if (board.getPlayer() != TicTacToeBoard::INITIAL_PLAYER)
+                        board.nextPlayer();
+                    store.add(session + store.getCapacity(), board);
+                    replaced++;
+                }
+                slot = (slot + 1) % store.getHighWater();
+                if ((move % STORE_SYNC_MOVES == 0) || (move == moves)) {
+                    auto syncStart = std::chrono::steady_clock::now();
+                    store.sync();
+                    syncMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - syncStart).count();
+                    syncs++;
+                }
+            }
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            sprintf_s(line, MAX_CHARS, STORE_PLAYED, moves - replaced, replaced,
+                (seconds > 0) ? moves / seconds / 1000 : 0.0, syncs, syncMs);
+            console.writeOutput(line);
+        }
+        catch (const std::exception& ex) {
+            console.writeOutput(ex.what());
+            return 1;
+        }
+        return 0;
+    }
+
+    // Open line evaluation of [rows] x [cols], [k] in a row - the cost of keeping it current move by move against
+    //   counting it again for each position (random games, every square filled), then a search of the empty board
+    //   for [milliseconds] without & with it
+    int runEvaluateMode(TicTacToeUI& console, int argc, char* argv[]) {
+        int rows = intArgument(argc, argv, 2, 7);
+        int cols = intArgument(argc, argv, 3, 7);
+        int k = intArgument(argc, argv, 4, 4);
+        int budget = intArgument(argc, argv, 5, 1000);
+        char line[MAX_CHARS];
+
+        try {
+            MnkBoard board(rows, cols, k);
+            LineEvaluator evaluator(board);
+            sprintf_s(line, MAX_CHARS, EVALUATE_HEADER, rows, cols, k, evaluator.getLineCount(),
+                LineEvaluator::getKernelName());
+            console.writeOutput(line);
+
+            std::mt19937 generator(1);
+            std::vector<int> squares(board.getSquareCount());
+            for (int pos = 0; pos < board.getSquareCount(); pos++)
+                squares[pos] = pos;
+            long long checksum = 0;
+            long long moves = 0;
+            auto start = std::chrono::steady_clock::now();
+            for (int round = 0; round < EVALUATE_ROUNDS; round++) {
+                std::shuffle(squares.begin(), squares.end(), generator);
+                for (int pos : squares) {
+                    evaluator.play(pos, board.getPlayer());
+                    board.play(pos);
+                    checksum += evaluator.evaluate(board.getPlayer());
+                }
+                for (auto pos = squares.rbegin(); pos != squares.rend(); ++pos) {
+                    board.undo(*pos);
+                    evaluator.undo(*pos, board.getPlayer());
+                    checksum += evaluator.evaluate(board.getPlayer());
+                }
+                moves += 2 * squares.size();
+            }
+            double incremental = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+            // same games, the counts rebuilt from the board at every position
+            long long recounts = 0;
+            int rounds = std::max(1, EVALUATE_ROUNDS / 10);
+            start = std::chrono::steady_clock::now();
+            for (int round = 0; round < rounds; round++) {
+                std::shuffle(squares.begin(), squares.end(), generator);
+                for (int pos : squares) {
+                    board.play(pos);
+                    evaluator.reset(board);
+                    checksum -= evaluator.evaluate(board.getPlayer());
+                }
+                for (auto pos = squares.rbegin(); pos != squares.rend(); ++pos)
+                    board.undo(*pos);
+                recounts += squares.size();
+            }
+            double recount = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            double perMove = incremental / std::max(1LL, moves);
+            double perRecount = recount / std::max(1LL, recounts);
+            sprintf_s(line, MAX_CHARS, EVALUATE_UPDATE, perMove, perRecount, (perMove > 0) ? perRecount / perMove : 0.0,
+                checksum);
+            console.writeOutput(line);
+
+            const char* names[] = { "no evaluation", "open lines" };
+            for (SearchEngine::Evaluation evaluation : { SearchEngine::NO_EVALUATION, SearchEngine::OPEN_LINES }) {
+                SearchEngine engine(evaluation);
+                std::atomic<bool> cancel(false);
+                auto searchStart = std::chrono::steady_clock::now();
+                SearchEngine::Result result = engine.search(board, searchStart + std::chrono::milliseconds(budget), cancel);
+                double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - searchStart).count();
+                sprintf_s(line, MAX_CHARS, EVALUATE_SEARCH, names[evaluation], result.depth, result.exact ? " (exact)" : "",
+                    static_cast<unsigned long long>(result.nodes), (ms > 0) ? result.nodes / ms : 0.0,
+                    result.bestMove / cols, result.bestMove % cols, result.score);
+                console.writeOutput(line);
+            }
+        }
+        catch (const std::invalid_argument& ex) {
+            console.writeOutput(ex.what());
+            return 1;
+        }
+        return 0;
+    }
+
+    // Random games sharded over worker processes (this program again, --shard-worker) - the coordinator hands out
+    //   units over a local socket & merges their totals, with 1, 2, 4 ... up to [workers] (default all cores), then
+    //   again with [failing] of the workers dropping out after their first unit - totals checked against the first run
+    int runShardMode(TicTacToeUI& console, int argc, char* argv[]) {
+        int maxWorkers = std::max(1, intArgument(argc, argv, 2,
+            std::max(1, static_cast<int>(std::thread::hardware_concurrency()))));
+        long long games = std::max(1, intArgument(argc, argv, 3, 5000000));
+        int failing = std::max(0, std::min(maxWorkers - 1, intArgument(argc, argv, 4, 0)));
+        std::string socketPath = (argc > 5) ? argv[5] : SHARD_DEFAULT_SOCKET;
+        std::string program = WorkerProcess::currentProgram(argv[0]);
+        uint32_t unitGames = static_cast<uint32_t>(std::min<long long>(games, SHARD_UNIT_GAMES));
+        uint32_t units = static_cast<uint32_t>((games + unitGames - 1) / unitGames);
+        char line[MAX_CHARS];
+
+        try {
+            sprintf_s(line, MAX_CHARS, SHARD_HEADER, static_cast<unsigned long long>(units) * unitGames, units,
+                maxWorkers, socketPath.c_str());
+            console.writeOutput(line);
+
+            std::vector<int> runs;
+            for (int workers = 1; workers <= maxWorkers;
+                workers = ((workers < maxWorkers) && (workers * 2 > maxWorkers)) ? maxWorkers : workers * 2)
+                runs.push_back(workers);
+            if (failing > 0)
+                runs.push_back(-maxWorkers);        // negative: the run with failing workers
+
+            ShardTotals expected;
+            double baseRate = 0;
+            for (int run : runs) {
+                int workers = std::abs(run);
+                ShardCoordinator coordinator(socketPath, SHARD_SEED, units, unitGames);
+                std::vector<std::unique_ptr<WorkerProcess>> processes;
+                for (int worker = 0; worker < workers; worker++) {
+                    std::vector<std::string> arguments = { "--shard-worker", socketPath };
+                    if ((run < 0) && (worker < failing))
+                        arguments.push_back("1");
+                    processes.emplace_back(new WorkerProcess(program, arguments));
+                }
+                ShardCoordinator::Report report = coordinator.run();
+                for (std::unique_ptr<WorkerProcess>& process : processes)
+                    process->wait();
+
+                double rate = (report.seconds > 0) ? report.totals.games / report.seconds / 1e6 : 0.0;
+                if (run == 1) {
+                    expected = report.totals;
+                    baseRate = rate;
+                }
+                sprintf_s(line, MAX_CHARS, SHARD_RUN, workers, report.seconds, rate, (baseRate > 0) ? rate / baseRate : 0.0,
+                    report.workersLost, report.reassigned, (report.totals == expected) ? "match" : "DIFFER");
+                console.writeOutput(line);
+            }
+
+            double total = static_cast<double>(expected.games);
+            double moves = 0;
+            for (int length = 0; length <= ShardTotals::CELLS; length++)
+                moves += static_cast<double>(length) * expected.lengths[length];
+            uint64_t draws = expected.getResult(TicTacToeBoard::DRAW) + expected.getResult(TicTacToeBoard::FORCED_DRAW);
+            sprintf_s(line, MAX_CHARS, SHARD_TOTALS, 100 * expected.getResult(TicTacToeBoard::X_WINS) / total,
+                100 * expected.getResult(TicTacToeBoard::O_WINS) / total, 100 * draws / total,
+                100 * expected.getResult(TicTacToeBoard::FORCED_DRAW) / total, moves / total);
+            console.writeOutput(line);
+        }
+        catch (const std::exception& ex) {
+            console.writeOutput(ex.what());
+            return 1;
+        }
+        return 0;
+    }
+
+    // Worker process for --shard - plays the units the coordinator hands out until it's done
+    //   [fail after] units played, the worker drops the next one & exits, standing in for a crashed node
+    int runShardWorkerMode(TicTacToeUI& console, int argc, char* argv[]) {
+        int failAfter = intArgument(argc, argv, 3, -1);
+        try {
+            ShardWorker worker(argv[2]);
+            worker.run(failAfter);
+        }
+        catch (const std::exception& ex) {
+            console.writeOutput(ex.what());
+            return 1;
+        }
+        return 0;
+    }
 }
 
 
@@ -193,4 +1487,4 @@ Sample Use cases
     Input row & column for square already taken
         board responds with error
         Display error message, request user input for same player
-*/
\ No newline at end of file
+*/
@@ -0,0 +1,419 @@
+// Tournament.cpp
+//   Players against each other on TicTacToeBoard, matches spread over worker threads, Elo & SPRT
+//   <blank line>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include "Tournament.h"
+
+/*
+ * Instance variables (declared in header file)
+ *   players - the configured players, in the order given
+ *   pairings - who plays whom (schedule order), results & SPRT state filled in by run()
+ *   numThreads - worker threads playing matches
+ *   sprtEnabled, sprtScore0, sprtScore1, sprtLower, sprtUpper - SPRT hypotheses as expected scores & the bounds
+ */
+
+namespace {
+	constexpr int SQUARES = TicTacToeBoard::BOARD_NUM_ROWS * TicTacToeBoard::BOARD_NUM_COLS;
+	constexpr uint16_t FULL_BOARD = (1u << SQUARES) - 1;
+	constexpr int POSITIONS = 19683;              // 3^9
+	constexpr int8_t UNSOLVED = 2;
+	constexpr double MCTS_EXPLORATION = 1.41;
+	constexpr double Z_95 = 1.96;
+	constexpr double MIN_VARIANCE = 1e-6;         // all draws - keeps the likelihood ratio & interval finite
+	constexpr double PSEUDO_GAMES = Z_95 * Z_95 / 2;    // won & lost games added for the interval (Agresti-Coull)
+
+	int positionIndex(const uint16_t squares[2]) {
+		int index = 0;
+		for (int position = SQUARES - 1; position >= 0; position--) {
+			int contents = (squares[TicTacToeBoard::X] & (1u << position)) ? 1 :
+				(squares[TicTacToeBoard::O] & (1u << position)) ? 2 : 0;
+			index = index * 3 + contents;
+		}
+		return index;
+	}
+
+	// value of the position for the player to move: 1 win, 0 draw, -1 loss (the last move didn't end the game)
+	int8_t solve(uint16_t squares[2], int mover, std::vector<int8_t>& table) {
+		int8_t& value = table[positionIndex(squares) * 2 + mover];
+		if (value != UNSOLVED)
+			return value;
+		int8_t best = -1;
+		uint16_t empty = FULL_BOARD & ~(squares[0] | squares[1]);
+		if (empty == 0)
+			best = 0;
+		for (int position = 0; position < SQUARES; position++) {            // no cut off, every child is solved
+			if ((empty & (1u << position)) == 0)
+				continue;
+			squares[mover] |= static_cast<uint16_t>(1u << position);
+			int8_t child = TicTacToeBoard::containsWinningPattern(squares[mover]) ? 1 :
+				static_cast<int8_t>(-solve(squares, 1 - mover, table));
+			squares[mover] &= static_cast<uint16_t>(~(1u << position));
+			best = std::max(best, child);
+		}
+		value = best;
+		return best;
+	}
+
+	// every position's value, for either player to move - built once, read only after that (shared by threads)
+	const std::vector<int8_t>& perfectTable() {
+		static const std::vector<int8_t> table = [] {
+			std::vector<int8_t> values(POSITIONS * 2, UNSOLVED);
+			for (int mover = 0; mover < 2; mover++) {
+				uint16_t squares[2] = { 0, 0 };
+				solve(squares, mover, values);
+			}
+			return values;
+		}();
+		return table;
+	}
+
+	int randomSquare(uint16_t empty, std::mt19937& generator) {
+		int squares[SQUARES];
+		int count = 0;
+		for (int position = 0; position < SQUARES; position++) {
+			if (empty & (1u << position))
+				squares[count++] = position;
+		}
+		return squares[std::uniform_int_distribution<int>(0, count - 1)(generator)];
+	}
+
+	struct MctsNode {
+		int parent;
+		int move;                                 // square played to reach the node
+		int mover;                                // player who played it
+		int firstChild;                           // children are consecutive, -1 = not expanded
+		int childCount;
+		int visits;
+		double score;                             // for mover: 1 per win, 0.5 per draw
+	};
+
+	// UCT from the position, random playouts, the most visited move
+	int mctsMove(const uint16_t rootSquares[2], int rootMover, int playouts, std::mt19937& generator) {
+		std::vector<MctsNode> tree;
+		tree.reserve(static_cast<size_t>(playouts) * 2 + SQUARES + 1);
+		tree.push_back({ -1, -1, 1 - rootMover, -1, 0, 0, 0.0 });
+
+		for (int playout = 0; playout < playouts; playout++) {
+			uint16_t squares[2] = { rootSquares[0], rootSquares[1] };
+			int node = 0;
+			int mover = rootMover;
+			int winner = -1;
+
+			// selection - down the tree by UCT, an unvisited child first
+			while (tree[node].childCount > 0) {
+				int best = tree[node].firstChild;
+				double bestValue = -1;
+				for (int child = tree[node].firstChild; child < tree[node].firstChild + tree[node].childCount; child++) {
+					if (tree[child].visits == 0) {
+						best = child;
+						break;
+					}
+					double value = tree[child].score / tree[child].visits + MCTS_EXPLORATION *
+						std::sqrt(std::log(static_cast<double>(tree[node].visits)) / tree[child].visits);
+					if (value > bestValue) {
+						bestValue = value;
+						best = child;
+					}
+				}
+				node = best;
+				squares[mover] |= static_cast<uint16_t>(1u << tree[node].move);
+				if (TicTacToeBoard::containsWinningPattern(squares[mover]))
+					winner = mover;
+				mover = 1 - mover;
+			}
+
+			// expansion - every move of a node reached for the first time after its first visit
+			uint16_t empty = FULL_BOARD & ~(squares[0] | squares[1]);
+			if ((winner < 0) && (empty != 0) && ((node == 0) || (tree[node].visits > 0))) {
+				tree[node].firstChild = static_cast<int>(tree.size());
+				for (int position = 0; position < SQUARES; position++) {
+					if (empty & (1u << position)) {
+						tree.push_back({ node, position, mover, -1, 0, 0, 0.0 });
+						tree[node].childCount++;
+					}
+				}
+				node = tree[node].firstChild;
+				squares[mover] |= static_cast<uint16_t>(1u << tree[node].move);
+				if (TicTacToeBoard::containsWinningPattern(squares[mover]))
+					winner = mover;
+				mover = 1 - mover;
+				empty = FULL_BOARD & ~(squares[0] | squares[1]);
+			}
+
+			// playout - random moves to the end of the game
+			while ((winner < 0) && (empty != 0)) {
+				int position = randomSquare(empty, generator);
+				squares[mover] |= static_cast<uint16_t>(1u << position);
+				if (TicTacToeBoard::containsWinningPattern(squares[mover]))
+					winner = mover;
+				mover = 1 - mover;
+				empty = FULL_BOARD & ~(squares[0] | squares[1]);
+			}
+
+			// back up the result, each node scored for the player who moved into it
+			for (; node >= 0; node = tree[node].parent) {
+				tree[node].visits++;
+				tree[node].score += (winner < 0) ? 0.5 : (winner == tree[node].mover) ? 1.0 : 0.0;
+			}
+		}
+
+		int best = tree[0].firstChild;
+		for (int child = tree[0].firstChild; child < tree[0].firstChild + tree[0].childCount; child++) {
+			if (tree[child].visits > tree[best].visits)
+				best = child;
+		}
+		return tree[best].move;
+	}
+
+	double scoreFromElo(double elo) {
+		return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+	}
+
+	// per game score & its variance (wins 1, draws 0.5, losses 0)
+	void scoreStatistics(const Tournament::Rating& rating, double& score, double& variance) {
+		int games = rating.wins + rating.draws + rating.losses;
+		score = (games > 0) ? (rating.wins + 0.5 * rating.draws) / games : 0.5;
+		variance = (games > 0) ? (rating.wins * (1 - score) * (1 - score) + rating.draws * (0.5 - score) * (0.5 - score) +
+			rating.losses * score * score) / games : 0.0;
+	}
+}
+
+// Constructor - pairings by the schedule, first player of a pairing is the earlier one in players
+Tournament::Tournament(const std::vector<Player>& players, Schedule schedule, int threads)
+	: players(players), numThreads(std::max(1, threads)) {
+	if (players.size() < 2)
+		throw std::invalid_argument("A tournament needs at least two players\n");
+	for (int first = 0; first < static_cast<int>(players.size()); first++) {
+		for (int second = first + 1; second < static_cast<int>(players.size()); second++) {
+			if ((schedule == GAUNTLET) && (first > 0))
+				break;
+			Pairing pairing;
+			pairing.first = first;
+			pairing.second = second;
+			pairings.push_back(pairing);
+		}
+	}
+}
+
+// Player from its spec - see the header notes
+Tournament::Player Tournament::parsePlayer(const std::string& spec) {
+	Player player;
+	player.name = spec;
+	size_t colon = spec.find(':');
+	std::string kind = spec.substr(0, colon);
+	std::string argument = (colon == std::string::npos) ? "" : spec.substr(colon + 1);
+
+	if ((kind == "random") && argument.empty())
+		player.kind = RANDOM;
+	else if ((kind == "perfect") && argument.empty())
+		player.kind = PERFECT;
+	else if ((kind == "mcts") && !argument.empty() &&
+		(argument.find_first_not_of("0123456789") == std::string::npos) && (argument.size() < 9)) {
+		player.kind = MCTS;
+		player.playouts = std::stoi(argument);
+	}
+	else if ((kind == "script") && !argument.empty() && (argument.find_first_not_of("012345678") == std::string::npos)) {
+		player.kind = SCRIPTED;
+		for (char square : argument)
+			player.script.push_back(square - '0');
+	}
+	else
+		throw std::invalid_argument("Unknown player: " + spec +
+			" (random, perfect, mcts:<playouts>, script:<squares 0-8>)\n");
+	if ((player.kind == MCTS) && (player.playouts < 1))
+		throw std::invalid_argument("MCTS player needs at least one playout: " + spec + "\n");
+	return player;
+}
+
+// SPRT per pairing, H0: elo0 against H1: elo1, error rates alpha & beta
+void Tournament::enableSprt(double elo0, double elo1, double alpha, double beta) {
+	if ((elo1 <= elo0) || (alpha <= 0) || (alpha >= 1) || (beta <= 0) || (beta >= 1))
+		throw std::invalid_argument("SPRT needs elo0 < elo1 & error rates between 0 & 1\n");
+	sprtEnabled = true;
+	sprtScore0 = scoreFromElo(elo0);
+	sprtScore1 = scoreFromElo(elo1);
+	sprtLower = std::log(beta / (1 - alpha));
+	sprtUpper = std::log((1 - beta) / alpha);
+}
+
+// Plays every pairing's games (fewer if SPRT stops it), matches of MATCH_GAMES handed to the worker threads
+Tournament::Result Tournament::run(int gamesPerPairing, unsigned seed) {
+	int matchesPerPairing = (std::max(0, gamesPerPairing) + MATCH_GAMES - 1) / MATCH_GAMES;
+	int taskCount = matchesPerPairing * static_cast<int>(pairings.size());
+	for (Pairing& pairing : pairings) {
+		pairing.rating = Rating();
+		pairing.llr = 0;
+		pairing.sprt = CONTINUE;
+	}
+	std::atomic<int> nextTask(0);
+	std::mutex resultLock;                        // guards pairings
+
+	auto worker = [&] {
+		for (int task = nextTask.fetch_add(1); task < taskCount; task = nextTask.fetch_add(1)) {
+			int pairingIndex = task % static_cast<int>(pairings.size());
+			int match = task / static_cast<int>(pairings.size());
+			Pairing& pairing = pairings[pairingIndex];
+			{
+				std::lock_guard<std::mutex> guard(resultLock);
+				if (pairing.sprt != CONTINUE)
+					continue;
+			}
+			int games = std::min(MATCH_GAMES, gamesPerPairing - match * MATCH_GAMES);
+			Rating result = playMatch(players[pairing.first], players[pairing.second], (match % 2) == 0, games,
+				seed * 2654435761u + static_cast<unsigned>(task));
+
+			std::lock_guard<std::mutex> guard(resultLock);
+			pairing.rating.wins += result.wins;
+			pairing.rating.draws += result.draws;
+			pairing.rating.losses += result.losses;
+			if (sprtEnabled && (pairing.sprt == CONTINUE)) {
+				pairing.llr = logLikelihoodRatio(pairing.rating);
+				if (pairing.llr <= sprtLower)
+					pairing.sprt = ACCEPT_H0;
+				else if (pairing.llr >= sprtUpper)
+					pairing.sprt = ACCEPT_H1;
+			}
+		}
+	};
+
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::thread> pool;
+	for (int t = 0; t < numThreads; t++)
+		pool.emplace_back(worker);
+	for (std::thread& thread : pool)
+		thread.join();
+
+	Result result;
+	result.threads = numThreads;
+	result.players.resize(players.size());
+	for (Pairing& pairing : pairings) {
+		rate(pairing.rating);
+		result.games += pairing.rating.wins + pairing.rating.draws + pairing.rating.losses;
+		Rating& first = result.players[pairing.first];
+		Rating& second = result.players[pairing.second];
+		first.wins += pairing.rating.wins;
+		first.draws += pairing.rating.draws;
+		first.losses += pairing.rating.losses;
+		second.wins += pairing.rating.losses;
+		second.draws += pairing.rating.draws;
+		second.losses += pairing.rating.wins;
+	}
+	for (Rating& rating : result.players)
+		rate(rating);
+	result.pairings = pairings;
+	result.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	return result;
+}
+
+// Elo difference that scores score per game, score clamped (see notes)
+double Tournament::eloFromScore(double score) {
+	score = std::min(std::max(score, MIN_SCORE), 1 - MIN_SCORE);
+	return -400.0 * std::log10(1.0 / score - 1.0);
+}
+
+//                                     ***  Tournament helper functions ***
+
+// games on one board from X starting, next game started as main() does - results from first's side
+Tournament::Rating Tournament::playMatch(const Player& first, const Player& second, bool firstPlaysX, int games,
+	unsigned seed) const {
+	std::mt19937 generator(seed);
+	TicTacToeBoard board;                     // X starts (INITIAL_PLAYER)
+	TicTacToeBoard::Player firstSymbol = firstPlaysX ? TicTacToeBoard::X : TicTacToeBoard::O;
+	Rating rating;
+	for (int game = 0; game < games; ) {
+		const Player& toMove = (board.getPlayer() == firstSymbol) ? first : second;
+		int position = chooseMove(toMove, board, generator);
+		board.writeSquare(position / TicTacToeBoard::BOARD_NUM_COLS, position % TicTacToeBoard::BOARD_NUM_COLS,
+			board.getPlayer());
+
+		TicTacToeBoard::GameStatus status = board.getGameStatus();
+		if (status != TicTacToeBoard::IN_PROGRESS) {
+			if ((status != TicTacToeBoard::X_WINS) && (status != TicTacToeBoard::O_WINS))
+				rating.draws++;
+			else if (board.getPlayer() == firstSymbol)
+				rating.wins++;
+			else
+				rating.losses++;
+			board.resetBoard();
+			game++;
+		}
+		board.nextPlayer();                   // after a game: the player who didn't move last starts the next
+	}
+	return rating;
+}
+
+// The player's move for the player to move on the board (the game isn't over)
+int Tournament::chooseMove(const Player& player, const TicTacToeBoard& board, std::mt19937& generator) const {
+	TicTacToeBoard::Snapshot snapshot = board.getSnapshot();
+	uint16_t squares[2] = { snapshot.xSquares, snapshot.oSquares };
+	uint16_t empty = FULL_BOARD & ~(squares[0] | squares[1]);
+	int mover = board.getPlayer();
+
+	switch (player.kind) {
+	case PERFECT: {
+		const std::vector<int8_t>& table = perfectTable();
+		int best[SQUARES];
+		int count = 0;
+		int bestValue = -2;
+		for (int position = 0; position < SQUARES; position++) {
+			if ((empty & (1u << position)) == 0)
+				continue;
+			squares[mover] |= static_cast<uint16_t>(1u << position);
+			int value = TicTacToeBoard::containsWinningPattern(squares[mover]) ? 1 :
+				-table[positionIndex(squares) * 2 + (1 - mover)];
+			squares[mover] &= static_cast<uint16_t>(~(1u << position));
+			if (value > bestValue)
+				count = 0;
+			if (value >= bestValue) {
+				bestValue = value;
+				best[count++] = position;
+			}
+		}
+		return best[std::uniform_int_distribution<int>(0, count - 1)(generator)];
+	}
+	case MCTS:
+		return mctsMove(squares, mover, player.playouts, generator);
+	case SCRIPTED:
+		for (int position : player.script) {
+			if (empty & (1u << position))
+				return position;
+		}
+		return randomSquare(empty, generator);
+	default:
+		return randomSquare(empty, generator);
+	}
+}
+
+// Elo & 95% interval from the results
+//   the interval is centred on the score with PSEUDO_GAMES won & lost added, its variance taken with them too
+void Tournament::rate(Rating& rating) const {
+	double score;
+	double variance;
+	scoreStatistics(rating, score, variance);
+	int games = rating.wins + rating.draws + rating.losses;
+	double adjustedGames = games + 2 * PSEUDO_GAMES;
+	double adjustedScore = (score * games + PSEUDO_GAMES) / adjustedGames;
+	double adjustedVariance = (games * (variance + (score - adjustedScore) * (score - adjustedScore)) +
+		PSEUDO_GAMES * ((1 - adjustedScore) * (1 - adjustedScore) + adjustedScore * adjustedScore)) / adjustedGames;
+	double margin = Z_95 * std::sqrt(std::max(adjustedVariance, MIN_VARIANCE) / adjustedGames);
+	rating.elo = eloFromScore(score);
+	rating.eloLow = eloFromScore(adjustedScore - margin);
+	rating.eloHigh = eloFromScore(adjustedScore + margin);
+}
+
+// SPRT log likelihood ratio of H1 against H0, normal approximation (see notes)
+double Tournament::logLikelihoodRatio(const Rating& rating) const {
+	double score;
+	double variance;
+	scoreStatistics(rating, score, variance);
+	int games = rating.wins + rating.draws + rating.losses;
+	return games * (sprtScore1 - sprtScore0) * (2 * score - sprtScore0 - sprtScore1) /
+		(2 * std::max(variance, MIN_VARIANCE));
+}
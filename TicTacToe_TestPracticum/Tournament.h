@@ -0,0 +1,106 @@
+#pragma once
+/*****************************************************************//**
+ * \file   Tournament.h
+ * \brief  engine tournament - Tournament (parallel games, Elo & SPRT)
+ *     Scope - plays configured players against each other on TicTacToeBoard, round robin or gauntlet, on a pool
+ *        of worker threads, & rates them: Elo with a 95% confidence interval per pairing & against the field,
+ *        optional SPRT per pairing to stop as soon as the result is clear - used to gate engine changes
+ *
+ * \date   updated: October 2026
+ *
+ * Implementation notes:
+ *     - players (parsePlayer() spec): "random", "perfect" (minimax table of every position, a random move among
+ *          the best), "mcts:<playouts>" (UCT, random playouts, the most visited move), "script:<squares>" (the
+ *          first empty square of the list, e.g. script:402681357, random once the list is used up)
+ *     - schedules: ROUND_ROBIN every pair of players, GAUNTLET the first player against each of the others
+ *     - games are played in matches of MATCH_GAMES on one board, the next game started as main() does - by the
+ *          player who didn't make the last move (the loser after a win); the first player of the pairing plays X
+ *          in even matches, O in odd ones, X always starts a match
+ *     - thread pool: the worker threads take matches from an atomic counter, pairings interleaved so they all
+ *          progress together - each match has its own random seed (tournament seed & match #), so the games
+ *          don't depend on the # of threads (SPRT stopping aside, it depends on the order matches finish)
+ *     - Elo from the score s (wins + draws / 2 per game): -400 log10(1 / s - 1), s clamped to [MIN_SCORE, 1 - MIN_SCORE]
+ *          so a clean sweep stays finite; the 95% interval is Agresti-Coull style - 1.96^2 / 2 won & lost games are
+ *          added, the interval is the adjusted score +- 1.96 standard errors of its per game score (variance taken
+ *          with the added games, floored above 0), so a clean sweep still gets an interval of some width
+ *     - SPRT: H0 elo0 against H1 elo1, log likelihood ratio of the normal approximation
+ *          N (s1 - s0) (2 s - s0 - s1) / (2 variance), checked after every match - below log(beta / (1 - alpha))
+ *          accepts H0, above log((1 - beta) / alpha) accepts H1, the pairing's remaining matches are skipped
+ *
+ * Tournament(players, schedule, threads)      - throws invalid_argument for fewer than two players
+ * static Player parsePlayer(spec)             - see notes, throws invalid_argument for an unknown spec
+ * void enableSprt(elo0, elo1, alpha, beta)    - stop pairings early (off by default)
+ * Result run(gamesPerPairing, seed)           - plays the tournament, results per pairing & per player
+ **/
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+#include "TicTacToeBoard.h"
+
+class Tournament
+{
+public:
+	static constexpr int MATCH_GAMES = 10;
+	static constexpr double MIN_SCORE = 0.001;
+
+	enum Schedule { ROUND_ROBIN, GAUNTLET };
+	enum Kind { RANDOM, PERFECT, MCTS, SCRIPTED };
+	enum SprtState { CONTINUE, ACCEPT_H0, ACCEPT_H1 };
+
+	struct Player {
+		std::string name;                         // the spec it was parsed from
+		Kind kind = RANDOM;
+		int playouts = 0;                         // MCTS
+		std::vector<int> script;                  // SCRIPTED, positions 0-8 in order of preference
+	};
+
+	// Elo of the score & its 95% interval
+	struct Rating {
+		int wins = 0;
+		int draws = 0;
+		int losses = 0;
+		double elo = 0;
+		double eloLow = 0;
+		double eloHigh = 0;
+	};
+
+	struct Pairing {
+		int first = 0;                            // player indexes, results from the first player's side
+		int second = 0;
+		Rating rating;
+		double llr = 0;                           // SPRT log likelihood ratio
+		SprtState sprt = CONTINUE;
+	};
+
+	struct Result {
+		std::vector<Pairing> pairings;
+		std::vector<Rating> players;              // each player against the field
+		int games = 0;
+		int threads = 0;
+		double milliseconds = 0;
+	};
+
+	Tournament(const std::vector<Player>& players, Schedule schedule, int threads);
+	static Player parsePlayer(const std::string& spec);
+	void enableSprt(double elo0, double elo1, double alpha, double beta);
+	Result run(int gamesPerPairing, unsigned seed);
+
+	static double eloFromScore(double score);
+
+private:
+	std::vector<Player> players;
+	std::vector<Pairing> pairings;                // by the schedule, results filled in by run()
+	int numThreads;
+	bool sprtEnabled = false;
+	double sprtScore0 = 0.5;                      // expected scores of elo0 & elo1
+	double sprtScore1 = 0.5;
+	double sprtLower = 0;                         // log likelihood ratio bounds
+	double sprtUpper = 0;
+
+	Rating playMatch(const Player& first, const Player& second, bool firstPlaysX, int games, unsigned seed) const;
+	int chooseMove(const Player& player, const TicTacToeBoard& board, std::mt19937& generator) const;
+	void rate(Rating& rating) const;
+	double logLikelihoodRatio(const Rating& rating) const;
+};
@@ -0,0 +1,88 @@
+// TranspositionTable.cpp
+//   Fixed size, lock-free table of search results shared between search threads
+//   <blank line>
+
+#include <stdexcept>
+#include "TranspositionTable.h"
+
+/*
+ * Instance variables (declared in header file)
+ *   slots - the table, check & data word per slot, relaxed atomics (see header notes)
+ *   slotCount - # of slots
+ *   generation - current search, part of every entry stored, never 0 (0 is an empty slot)
+ *
+ * Packed entry (data word): bits 0-15 score + 32768, 16-23 depth, 24-31 bound, 32-39 move + 1,
+ *   40-47 generation
+ */
+
+// Constructor - allocates & clears the slots, throws invalid_argument for an empty table
+TranspositionTable::TranspositionTable(size_t size)
+	: slotCount(size) {
+	if (size == 0)
+		throw std::invalid_argument("TranspositionTable needs at least one slot\n");
+	slots.reset(new Slot[size]);
+	clear();
+}
+
+// The entry for the key, if the slot holds it & wasn't torn by concurrent writers
+bool TranspositionTable::probe(uint64_t key, Entry& entry) const {
+	const Slot& slot = slots[key % slotCount];
+	uint64_t data = slot.data.load(std::memory_order_relaxed);
+	uint64_t check = slot.check.load(std::memory_order_relaxed);
+	if ((data == 0) || ((check ^ data) != key))
+		return false;
+	entry = unpack(data);
+	return true;
+}
+
+// Same position: always replaced (newer result), another position: replaced if searched no deeper or from an
+//   earlier search - a race between two writers can lose an entry, never corrupt one
+void TranspositionTable::store(uint64_t key, const Entry& entry) {
+	Slot& slot = slots[key % slotCount];
+	uint64_t oldData = slot.data.load(std::memory_order_relaxed);
+	if (oldData != 0) {
+		uint64_t oldKey = slot.check.load(std::memory_order_relaxed) ^ oldData;
+		uint8_t oldGeneration = static_cast<uint8_t>(oldData >> 40);
+		if ((oldKey != key) && (oldGeneration == generation) && (unpack(oldData).depth > entry.depth))
+			return;
+	}
+	uint64_t data = pack(entry, generation);
+	slot.data.store(data, std::memory_order_relaxed);
+	slot.check.store(key ^ data, std::memory_order_relaxed);
+}
+
+// Call between searches (no search running) - entries of earlier searches become the first to be replaced
+void TranspositionTable::newSearch() {
+	generation = static_cast<uint8_t>((generation == 255) ? 1 : generation + 1);
+}
+
+// Empties every slot - no search may be running
+void TranspositionTable::clear() {
+	for (size_t i = 0; i < slotCount; i++) {
+		slots[i].data.store(0, std::memory_order_relaxed);
+		slots[i].check.store(0, std::memory_order_relaxed);
+	}
+}
+
+size_t TranspositionTable::size() const {
+	return slotCount;
+}
+
+//                                     ***  TranspositionTable helper functions ***
+
+uint64_t TranspositionTable::pack(const Entry& entry, uint8_t generation) {
+	return static_cast<uint64_t>(static_cast<uint16_t>(entry.score + 32768)) |
+		(static_cast<uint64_t>(static_cast<uint8_t>(entry.depth)) << 16) |
+		(static_cast<uint64_t>(entry.bound) << 24) |
+		(static_cast<uint64_t>(static_cast<uint8_t>(entry.move + 1)) << 32) |
+		(static_cast<uint64_t>(generation) << 40);
+}
+
+TranspositionTable::Entry TranspositionTable::unpack(uint64_t data) {
+	Entry entry;
+	entry.score = static_cast<int>(data & 0xFFFF) - 32768;
+	entry.depth = static_cast<int>((data >> 16) & 0xFF);
+	entry.bound = static_cast<Bound>((data >> 24) & 0xFF);
+	entry.move = static_cast<int>((data >> 32) & 0xFF) - 1;
+	return entry;
+}
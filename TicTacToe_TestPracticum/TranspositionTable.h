@@ -0,0 +1,63 @@
+#pragma once
+/*****************************************************************//**
+ * \file   TranspositionTable.h
+ * \brief  shared search results - TranspositionTable (fixed size, lock-free)
+ *     Scope - positions already searched (score, bound, depth, best move), shared by all threads of ParallelSearch
+ *
+ * \date   updated: October 2026
+ *
+ * Implementation notes:
+ *     - allocated once by the constructor, never resized - a slot per key (key modulo the # of slots)
+ *     - lock-free: an entry is packed into one 64 bit word, stored in a slot as two relaxed atomics, the packed
+ *          data & (key XOR data) - a reader recomputes the key from the pair, so a slot torn by two writers
+ *          (data of one, key of the other) fails the key check & reads as a miss, never as a wrong result
+ *     - depth-preferred replacement: an entry for another position only replaces a slot searched to the same
+ *          depth or less, or one left by an earlier search (generation, bumped by newSearch())
+ *     - the caller supplies the key (a hash of the position) & owns the meaning of scores & moves
+ *
+ * bool probe(key, entry)   - true & the entry if the position is in the table
+ * void store(key, entry)   - saves the entry, subject to the replacement rule
+ * void newSearch()         - starts a new generation, older entries are replaced first
+ **/
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+class TranspositionTable
+{
+public:
+	static constexpr int NO_MOVE = -1;
+
+	enum Bound : uint8_t { NONE, EXACT, LOWER, UPPER };
+
+	struct Entry {
+		int score = 0;                // -32768 .. 32767
+		int depth = 0;                // 0 .. 255
+		Bound bound = NONE;
+		int move = NO_MOVE;           // -1 .. 254
+	};
+
+	explicit TranspositionTable(size_t size);
+	TranspositionTable(const TranspositionTable&) = delete;
+	TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+	bool probe(uint64_t key, Entry& entry) const;
+	void store(uint64_t key, const Entry& entry);
+	void newSearch();
+	void clear();
+	size_t size() const;
+
+private:
+	struct Slot {
+		std::atomic<uint64_t> check;  // key ^ data
+		std::atomic<uint64_t> data;   // packed entry, 0 = empty
+	};
+
+	std::unique_ptr<Slot[]> slots;
+	size_t slotCount;
+	uint8_t generation = 1;
+
+	static uint64_t pack(const Entry& entry, uint8_t generation);
+	static Entry unpack(uint64_t data);
+};
@@ -0,0 +1,118 @@
+// UltimateBoard.cpp
+//   Ultimate Tic Tac Toe board - nine packed 3x3 sub-boards & the meta board, bitwise move generation & win checks
+//   <blank line>
+
+#include "UltimateBoard.h"
+
+/*
+ * Instance variables (declared in header file)
+ *   cells[player][sub-board] - 9 bit mask of the cells the player has taken in each sub-board
+ *   won[player] - meta board, 9 bit mask of the sub-boards the player has won
+ *   drawn - sub-boards full without a winner
+ *   nextBoard - sub-board the player to move is sent to, ANY_BOARD if it is closed (or first move)
+ *   player - player to move
+ *   moveCount - moves played
+ *   result - updated by play(), IN_PROGRESS until the meta board has a line or every sub-board is closed
+ */
+
+namespace {
+	// every 9 bit mask -> contains a winning pattern, from TicTacToeBoard's winPatterns
+	//   (winPatterns is a constexpr array, so it is initialized before this table is built)
+	struct LineTable {
+		bool hasLine[UltimateBoard::FULL + 1];
+		LineTable() {
+			for (int squares = 0; squares <= UltimateBoard::FULL; squares++)
+				hasLine[squares] = TicTacToeBoard::containsWinningPattern(static_cast<uint16_t>(squares));
+		}
+	};
+	const LineTable LINES;
+}
+
+UltimateBoard::UltimateBoard() {
+}
+
+// Current player plays the move (sub-board * 9 + cell) - false if the game is over or the move isn't legal
+//   a line in the sub-board wins it, a line of won sub-boards wins the game
+bool UltimateBoard::play(int move) {
+	if ((move < 0) || (move >= MAX_MOVES))
+		return false;
+	int subBoard = move / CELLS;
+	int cell = move % CELLS;
+	uint16_t bit = static_cast<uint16_t>(1u << cell);
+	if ((getLegalCells(subBoard) & bit) == 0)
+		return false;
+
+	uint16_t& mine = cells[player][subBoard];
+	mine |= bit;
+	if (isLine(mine)) {
+		won[player] |= static_cast<uint16_t>(1u << subBoard);
+		if (isLine(won[player]))
+			result = (player == TicTacToeBoard::X) ? X_WINS : O_WINS;
+	}
+	else if ((cells[TicTacToeBoard::X][subBoard] | cells[TicTacToeBoard::O][subBoard]) == FULL)
+		drawn |= static_cast<uint16_t>(1u << subBoard);
+
+	uint16_t closed = getClosedBoards();
+	if ((result == IN_PROGRESS) && (closed == FULL))
+		result = DRAW;
+	nextBoard = static_cast<int8_t>((closed & bit) ? ANY_BOARD : cell);
+	player = (player == TicTacToeBoard::X) ? TicTacToeBoard::O : TicTacToeBoard::X;
+	moveCount++;
+	return true;
+}
+
+// Writes every legal move to moves[], returns how many
+int UltimateBoard::getLegalMoves(uint8_t moves[MAX_MOVES]) const {
+	int count = 0;
+	int first = (nextBoard == ANY_BOARD) ? 0 : nextBoard;
+	int last = (nextBoard == ANY_BOARD) ? CELLS - 1 : nextBoard;
+	for (int subBoard = first; subBoard <= last; subBoard++) {
+		uint16_t legal = getLegalCells(subBoard);
+		for (int cell = 0; legal != 0; cell++, legal >>= 1) {
+			if (legal & 1)
+				moves[count++] = static_cast<uint8_t>(subBoard * CELLS + cell);
+		}
+	}
+	return count;
+}
+
+// Empty cells of the sub-board if the player to move may play there (game on, sub-board open & allowed)
+uint16_t UltimateBoard::getLegalCells(int subBoard) const {
+	if ((result != IN_PROGRESS) || (subBoard < 0) || (subBoard >= CELLS) ||
+		((nextBoard != ANY_BOARD) && (nextBoard != subBoard)) || (getClosedBoards() & (1u << subBoard)))
+		return 0;
+	return static_cast<uint16_t>(FULL & ~(cells[TicTacToeBoard::X][subBoard] | cells[TicTacToeBoard::O][subBoard]));
+}
+
+UltimateBoard::Result UltimateBoard::getResult() const {
+	return result;
+}
+
+UltimateBoard::Player UltimateBoard::getPlayer() const {
+	return player;
+}
+
+int UltimateBoard::getNextBoard() const {
+	return nextBoard;
+}
+
+uint16_t UltimateBoard::getCells(int subBoard, Player player) const {
+	return cells[player][subBoard];
+}
+
+uint16_t UltimateBoard::getWonBoards(Player player) const {
+	return won[player];
+}
+
+uint16_t UltimateBoard::getClosedBoards() const {
+	return won[TicTacToeBoard::X] | won[TicTacToeBoard::O] | drawn;
+}
+
+int UltimateBoard::getMoveCount() const {
+	return moveCount;
+}
+
+// Same check for a sub-board & the meta board - one table lookup
+bool UltimateBoard::isLine(uint16_t squares) {
+	return LINES.hasLine[squares & FULL];
+}
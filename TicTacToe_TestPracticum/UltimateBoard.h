@@ -0,0 +1,64 @@
+#pragma once
+/*****************************************************************//**
+ * \file   UltimateBoard.h
+ * \brief  Ultimate Tic Tac Toe - UltimateBoard (3x3 grid of 3x3 sub-boards)
+ *     Scope - board state, move generation & win detection for the Ultimate variant, used by UltimateMcts
+ *
+ * \date   updated: October 2026
+ *
+ * Implementation notes:
+ *     - state is nine packed sub-boards, 9 bits per player each (bit = row * 3 + column, as TicTacToeBoard),
+ *          plus the meta board: 9 bit masks of sub-boards won by X, won by O & drawn (full without a winner)
+ *     - the same 3x3 win logic is used on both levels - a 512 entry table built from
+ *          TicTacToeBoard::containsWinningPattern(), indexed by a 9 bit mask (sub-board or meta board)
+ *     - send to board rule: the cell played chooses the sub-board the opponent must play in next, if that
+ *          sub-board is already won or full the opponent may play in any open sub-board
+ *     - a move is a number 0 - 80: sub-board * 9 + cell, sub-boards numbered like cells
+ *     - no allocation anywhere: the board is a small value type (copied, not undone, by the search) &
+ *          legal moves are returned as 9 bit masks per sub-board or written to a caller's array
+ *
+ * bool play(move)                 - current player plays the move, false (board unchanged) if it isn't legal
+ * int getLegalMoves(moves[])      - writes the legal moves, returns how many (0 once the game is over)
+ * Result getResult()              - IN_PROGRESS, X_WINS, O_WINS or DRAW
+ **/
+
+#include <cstdint>
+#include "TicTacToeBoard.h"
+
+class UltimateBoard
+{
+public:
+	typedef TicTacToeBoard::Player Player;
+
+	static constexpr int CELLS = 9;                  // per sub-board, & sub-boards on the meta board
+	static constexpr int MAX_MOVES = CELLS * CELLS;
+	static constexpr int ANY_BOARD = -1;
+	static constexpr uint16_t FULL = 0x1FF;
+
+	enum Result { IN_PROGRESS, X_WINS, O_WINS, DRAW };
+
+	UltimateBoard();
+
+	bool play(int move);
+	int getLegalMoves(uint8_t moves[MAX_MOVES]) const;
+	uint16_t getLegalCells(int subBoard) const;      // cells the player to move may play in the sub-board
+	Result getResult() const;
+
+	Player getPlayer() const;
+	int getNextBoard() const;                        // sub-board the player to move must play in, or ANY_BOARD
+	uint16_t getCells(int subBoard, Player player) const;
+	uint16_t getWonBoards(Player player) const;      // meta board
+	uint16_t getClosedBoards() const;                // won or full sub-boards, no more moves there
+	int getMoveCount() const;
+
+	static bool isLine(uint16_t squares);            // 3x3 win check, either level
+
+private:
+	uint16_t cells[2][CELLS] = {};                   // [player][sub-board], 9 bits each
+	uint16_t won[2] = { 0, 0 };                      // [player], sub-boards won
+	uint16_t drawn = 0;                              // sub-boards full without a winner
+	int8_t nextBoard = ANY_BOARD;
+	Player player = TicTacToeBoard::INITIAL_PLAYER;
+	uint8_t moveCount = 0;
+	Result result = IN_PROGRESS;
+};
@@ -0,0 +1,151 @@
+// UltimateMcts.cpp
+//   Monte Carlo tree search for Ultimate Tic Tac Toe, preallocated node pool & xorshift random playouts
+//   <blank line>
+
+#include <cmath>
+#include <stdexcept>
+#include "UltimateMcts.h"
+
+/*
+ * Instance variables (declared in header file)
+ *   pool - tree nodes, allocated once, node 0 is the root of the current search
+ *   nodeCount - nodes in use, reset by each search
+ *   randomState - xorshift64* state, never 0
+ */
+
+// Constructor - allocates the node pool (at least the root & its children), the seed must not be 0
+//   (xorshift would only return 0)
+UltimateMcts::UltimateMcts(size_t poolNodes, uint64_t seed)
+	: pool(poolNodes < UltimateBoard::MAX_MOVES + 1 ? UltimateBoard::MAX_MOVES + 1 : poolNodes),
+	randomState(seed == 0 ? 1 : seed) {
+}
+
+// Search until the budget or the iteration limit, whichever comes first - returns the most visited move
+UltimateMcts::Result UltimateMcts::search(const UltimateBoard& root, std::chrono::milliseconds budget,
+	uint64_t maxIterations) {
+	if (root.getResult() != UltimateBoard::IN_PROGRESS)
+		throw std::invalid_argument("UltimateMcts::search called on a finished game\n");
+
+	auto start = std::chrono::steady_clock::now();
+	auto deadline = start + budget;
+	Result result;
+	nodeCount = 0;
+	UltimateBoard::Player opponent = (root.getPlayer() == TicTacToeBoard::X) ? TicTacToeBoard::O : TicTacToeBoard::X;
+	newNode(0, opponent);
+	expand(0, root);
+
+	uint32_t path[UltimateBoard::MAX_MOVES + 1];
+	while (result.iterations < maxIterations) {
+		// the clock is read every 64 iterations, a playout is a few microseconds
+		if (((result.iterations & 63) == 0) && (std::chrono::steady_clock::now() >= deadline) && (result.iterations > 0))
+			break;
+
+		// selection - down the tree by UCB1 to a node that isn't expanded
+		UltimateBoard board = root;
+		int depth = 0;
+		uint32_t node = 0;
+		path[depth++] = node;
+		while (pool[node].expanded && (pool[node].childCount > 0)) {
+			node = selectChild(pool[node]);
+			board.play(pool[node].move);
+			path[depth++] = node;
+		}
+
+		// expansion - a leaf seen before gets its children, one of them (the first, unvisited) is played
+		if ((board.getResult() == UltimateBoard::IN_PROGRESS) && (pool[node].visits > 0) && expand(node, board)) {
+			node = pool[node].firstChild;
+			board.play(pool[node].move);
+			path[depth++] = node;
+		}
+
+		// simulation & back up
+		UltimateBoard::Result outcome = playout(board);
+		for (int d = 0; d < depth; d++) {
+			Node& visited = pool[path[d]];
+			visited.visits++;
+			if (outcome == UltimateBoard::DRAW)
+				visited.score += 0.5f;
+			else if ((outcome == UltimateBoard::X_WINS) == (visited.mover == TicTacToeBoard::X))
+				visited.score += 1.0f;
+		}
+		result.iterations++;
+	}
+
+	// most visited child of the root
+	const Node& rootNode = pool[0];
+	uint32_t best = rootNode.firstChild;
+	for (uint32_t child = rootNode.firstChild; child < rootNode.firstChild + rootNode.childCount; child++) {
+		if (pool[child].visits > pool[best].visits)
+			best = child;
+	}
+	result.bestMove = pool[best].move;
+	result.winRate = (pool[best].visits > 0) ? pool[best].score / pool[best].visits : 0;
+	result.nodes = nodeCount;
+	result.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	return result;
+}
+
+// Random moves to the end of the game - the board is a copy, the caller's board is unchanged
+UltimateBoard::Result UltimateMcts::playout(UltimateBoard board) {
+	uint8_t moves[UltimateBoard::MAX_MOVES];
+	while (board.getResult() == UltimateBoard::IN_PROGRESS) {
+		int count = board.getLegalMoves(moves);
+		board.play(moves[nextRandom() % count]);
+	}
+	return board.getResult();
+}
+
+//                                     ***  UltimateMcts helper functions ***
+
+// Takes the next node from the pool - the caller checks there is room
+uint32_t UltimateMcts::newNode(int move, UltimateBoard::Player mover) {
+	Node& node = pool[nodeCount];
+	node.firstChild = 0;
+	node.visits = 0;
+	node.score = 0;
+	node.move = static_cast<uint8_t>(move);
+	node.childCount = 0;
+	node.mover = static_cast<uint8_t>(mover);
+	node.expanded = false;
+	return static_cast<uint32_t>(nodeCount++);
+}
+
+// Adds a child per legal move, contiguous in the pool - false if the pool is full (node stays a leaf)
+bool UltimateMcts::expand(uint32_t node, const UltimateBoard& board) {
+	uint8_t moves[UltimateBoard::MAX_MOVES];
+	int count = board.getLegalMoves(moves);
+	if ((count == 0) || (nodeCount + count > pool.size()))
+		return false;
+	pool[node].firstChild = static_cast<uint32_t>(nodeCount);
+	pool[node].childCount = static_cast<uint8_t>(count);
+	pool[node].expanded = true;
+	for (int i = 0; i < count; i++)
+		newNode(moves[i], board.getPlayer());
+	return true;
+}
+
+// UCB1 - an unvisited child first, otherwise the best average score plus the exploration term
+uint32_t UltimateMcts::selectChild(const Node& parent) const {
+	double logVisits = std::log(static_cast<double>(parent.visits));
+	uint32_t best = parent.firstChild;
+	double bestValue = -1;
+	for (uint32_t child = parent.firstChild; child < parent.firstChild + parent.childCount; child++) {
+		const Node& candidate = pool[child];
+		if (candidate.visits == 0)
+			return child;
+		double value = candidate.score / candidate.visits + EXPLORATION * std::sqrt(logVisits / candidate.visits);
+		if (value > bestValue) {
+			bestValue = value;
+			best = child;
+		}
+	}
+	return best;
+}
+
+// xorshift64* - fast & good enough for playouts
+uint64_t UltimateMcts::nextRandom() {
+	randomState ^= randomState >> 12;
+	randomState ^= randomState << 25;
+	randomState ^= randomState >> 27;
+	return randomState * 0x2545F4914F6CDD1Dull;
+}
@@ -0,0 +1,67 @@
+#pragma once
+/*****************************************************************//**
+ * \file   UltimateMcts.h
+ * \brief  Ultimate Tic Tac Toe engine - UltimateMcts (Monte Carlo tree search)
+ *     Scope - picks a move for the player to move on an UltimateBoard within a time / iteration budget
+ *
+ * \date   updated: October 2026
+ *
+ * Implementation notes:
+ *     - UCT: select children by UCB1 (EXPLORATION constant), expand a leaf the second time it is reached
+ *          (all its children at once), random playout to the end of the game, back up 1 / 0.5 / 0 per node
+ *          from the point of view of the player who made the node's move
+ *     - nodes come from a pool allocated once by the constructor (children of a node are contiguous, so a node
+ *          only stores its first child & child count) - the pool is reset, not freed, by each search; once it is
+ *          full the tree stops growing & the remaining iterations only add playouts
+ *     - playouts copy the board (a small value type) & pick moves with an xorshift generator - no allocation
+ *     - the best move is the most visited child of the root
+ *
+ * Result search(board, budget, maxIterations)  - throws invalid_argument if the game is already over
+ * UltimateBoard::Result playout(board)        - plays random moves to the end of the game
+ **/
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include "UltimateBoard.h"
+
+class UltimateMcts
+{
+public:
+	static constexpr size_t DEFAULT_POOL_NODES = 1 << 20;        // 16 MB
+	static constexpr double EXPLORATION = 1.41;
+	static constexpr uint64_t UNLIMITED_ITERATIONS = ~0ull;
+
+	struct Result {
+		int bestMove = -1;
+		uint64_t iterations = 0;      // playouts
+		size_t nodes = 0;             // tree size at the end of the search
+		double winRate = 0;           // of the best move, for the player to move (draws count half)
+		double milliseconds = 0;
+	};
+
+	explicit UltimateMcts(size_t poolNodes = DEFAULT_POOL_NODES, uint64_t seed = 0x9E3779B97F4A7C15ull);
+	Result search(const UltimateBoard& root, std::chrono::milliseconds budget,
+		uint64_t maxIterations = UNLIMITED_ITERATIONS);
+	UltimateBoard::Result playout(UltimateBoard board);
+
+private:
+	struct Node {
+		uint32_t firstChild;
+		uint32_t visits;
+		float score;                  // wins + draws / 2, for the player who made the move
+		uint8_t move;
+		uint8_t childCount;
+		uint8_t mover;                // player who made the move
+		bool expanded;
+	};
+
+	std::vector<Node> pool;
+	size_t nodeCount = 0;
+	uint64_t randomState;
+
+	uint32_t newNode(int move, UltimateBoard::Player mover);
+	bool expand(uint32_t node, const UltimateBoard& board);
+	uint32_t selectChild(const Node& parent) const;
+	uint64_t nextRandom();
+};